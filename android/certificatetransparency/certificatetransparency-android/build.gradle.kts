@@ -18,6 +18,13 @@ android {
         consumerProguardFiles("consumer-proguard-rules.pro")
     }
 
+    // Packages libcertificatetransparency_jni, which NativeLogVerifier loads, for every ABI
+    externalNativeBuild {
+        cmake {
+            path = file("../certificatetransparency/src/main/cpp/CMakeLists.txt")
+        }
+    }
+
     sourceSets {
         getByName<AndroidSourceSet>("main").java.srcDirs("src/main/kotlin")
         getByName<AndroidSourceSet>("test").java.srcDirs("src/test/kotlin")
@@ -87,6 +87,11 @@
 # Ensure chain cleaner classes are kept as they're loaded through reflection
 -keep class com.appmattus.certificatetransparency.chaincleaner.* { *; }
 
+# The JNI library binds to the native methods of the native verifier by name
+-keepclasseswithmembernames class com.appmattus.certificatetransparency.internal.verifier.NativeLogVerifier {
+    native <methods>;
+}
+
 
 # Specifically for ProGuard (not needed for R8)
 -dontwarn module-info
@@ -40,3 +40,18 @@ tasks.withType(KotlinCompile::class.java).all {
         freeCompilerArgs += "-opt-in=kotlin.RequiresOptIn"
     }
 }
+
+// Tests of the native verifier run when -PnativeLibraryPath points at the JNI library built from src/main/cpp, and are skipped otherwise
+tasks.withType<Test> {
+    findProperty("nativeLibraryPath")?.let { systemProperty("java.library.path", it) }
+}
+
+// Compares the Kotlin and native SCT verification; see NativeVerifierBenchmark
+tasks.register<JavaExec>("nativeVerifierBenchmark") {
+    group = "verification"
+    description = "Benchmarks NativeLogVerifier against LogSignatureVerifier"
+    classpath = sourceSets["test"].runtimeClasspath
+    mainClass.set("com.appmattus.certificatetransparency.benchmark.NativeVerifierBenchmark")
+    findProperty("nativeLibraryPath")?.let { systemProperty("java.library.path", it) }
+    findProperty("iterations")?.let { args(it) }
+}
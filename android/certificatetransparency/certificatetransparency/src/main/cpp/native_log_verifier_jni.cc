@@ -0,0 +1,218 @@
+// JNI bindings of NativeLogVerifier.kt over the C interface of the C++ core
+// in ios/. CMakeLists.txt next to this file builds it, for Android by the
+// externalNativeBuild of certificatetransparency-android, and for a desktop
+// JDK with:
+//
+//   cmake -S . -B build && cmake --build build
+//
+// The functions are static methods of NativeLogVerifier, which counts the
+// calls using a handle so that nativeFree() runs after the last of them.
+//
+// Certificates are read in place from direct ByteBuffers, and results are
+// written to a direct ByteBuffer of the caller, so the calls that verify
+// neither copy certificates nor allocate on the Java heap. Copying the DER
+// of an X509Certificate into those buffers is left to NativeLogVerifier.kt.
+
+#include <jni.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "crypto_sha256.h"
+#include "ct_c_api.h"
+
+namespace {
+
+using LogId = std::array<uint8_t, 32>;
+
+// A verifier and the ids of the logs it was created from, so that results
+// name a log by its index in the list given to nativeCreate().
+struct NativeVerifier {
+  ct_verifier* verifier = nullptr;
+  // Sorted by log id.
+  std::vector<std::pair<LogId, jint>> log_indices;
+
+  ~NativeVerifier() { ct_verifier_free(verifier); }
+
+  // Returns the index of the log with |log_id|, or -1 if there is none.
+  jint FindLog(const uint8_t* log_id) const {
+    LogId id;
+    std::copy(log_id, log_id + id.size(), id.begin());
+    auto it = std::lower_bound(
+        log_indices.begin(), log_indices.end(), id,
+        [](const auto& entry, const LogId& id) { return entry.first < id; });
+    return it != log_indices.end() && it->first == id ? it->second : -1;
+  }
+};
+
+// The layout of an SCT result written by nativeVerifyScts(), as read by
+// NativeLogVerifier.kt: the index of the log or -1, the timestamp, the
+// ct_sct_status, padding, and the log id. Numbers are big-endian.
+constexpr size_t kLogIndexOffset = 0;
+constexpr size_t kTimestampOffset = 4;
+constexpr size_t kStatusOffset = 12;
+constexpr size_t kLogIdOffset = 16;
+constexpr size_t kSctResultSize = kLogIdOffset + 32;
+
+// ct_verify_scts() reports at most this many SCTs.
+constexpr size_t kMaxSctResults = 16;
+
+NativeVerifier* FromHandle(jlong handle) {
+  return reinterpret_cast<NativeVerifier*>(static_cast<intptr_t>(handle));
+}
+
+void PutBigEndian(uint64_t value, size_t size, uint8_t* out) {
+  for (size_t i = 0; i < size; i++) {
+    out[i] = static_cast<uint8_t>(value >> (8 * (size - 1 - i)));
+  }
+}
+
+// Points |span| at |length| bytes from |offset| of direct |buffer|. Returns
+// false if |buffer| is not direct or too small.
+bool GetSpan(JNIEnv* env,
+             jobject buffer,
+             jint offset,
+             jint length,
+             ct_span* span) {
+  if (!buffer || offset < 0 || length < 0) {
+    return false;
+  }
+  const auto* data =
+      static_cast<const uint8_t*>(env->GetDirectBufferAddress(buffer));
+  const jlong capacity = env->GetDirectBufferCapacity(buffer);
+  if (!data || capacity < 0 ||
+      static_cast<jlong>(offset) + length > capacity) {
+    return false;
+  }
+  span->data = data + offset;
+  span->size = static_cast<size_t>(length);
+  return true;
+}
+
+bool GetChain(JNIEnv* env,
+              jobject leaf,
+              jint leaf_offset,
+              jint leaf_length,
+              jobject issuer,
+              jint issuer_offset,
+              jint issuer_length,
+              ct_chain* chain) {
+  return GetSpan(env, leaf, leaf_offset, leaf_length, &chain->leaf) &&
+         GetSpan(env, issuer, issuer_offset, issuer_length, &chain->issuer);
+}
+
+}  // namespace
+
+extern "C" {
+
+JNIEXPORT jlong JNICALL
+Java_com_appmattus_certificatetransparency_internal_verifier_NativeLogVerifier_nativeCreate(
+    JNIEnv* env,
+    jclass,
+    jobjectArray keys) {
+  const jsize count = keys ? env->GetArrayLength(keys) : 0;
+  std::vector<std::string> key_bytes(count);
+  std::vector<ct_span> key_spans(count);
+  auto verifier = std::make_unique<NativeVerifier>();
+  verifier->log_indices.resize(count);
+  for (jsize i = 0; i < count; i++) {
+    auto key = static_cast<jbyteArray>(env->GetObjectArrayElement(keys, i));
+    if (key) {
+      key_bytes[i].resize(env->GetArrayLength(key));
+      env->GetByteArrayRegion(key, 0, key_bytes[i].size(),
+                              reinterpret_cast<jbyte*>(&key_bytes[i][0]));
+      env->DeleteLocalRef(key);
+    }
+    key_spans[i] = {reinterpret_cast<const uint8_t*>(key_bytes[i].data()),
+                    key_bytes[i].size()};
+    certificate_transparency::SHA256(key_bytes[i].data(), key_bytes[i].size(),
+                                     verifier->log_indices[i].first.data());
+    verifier->log_indices[i].second = i;
+  }
+  std::sort(verifier->log_indices.begin(), verifier->log_indices.end());
+  // Fails on keys that don't parse and on an empty list.
+  verifier->verifier = ct_verifier_new_from_keys(key_spans.data(), count);
+  if (!verifier->verifier) {
+    return 0;
+  }
+  return static_cast<jlong>(reinterpret_cast<intptr_t>(verifier.release()));
+}
+
+JNIEXPORT void JNICALL
+Java_com_appmattus_certificatetransparency_internal_verifier_NativeLogVerifier_nativeFree(
+    JNIEnv*,
+    jclass,
+    jlong handle) {
+  delete FromHandle(handle);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_appmattus_certificatetransparency_internal_verifier_NativeLogVerifier_nativeVerify(
+    JNIEnv* env,
+    jclass,
+    jlong handle,
+    jobject leaf,
+    jint leaf_offset,
+    jint leaf_length,
+    jobject issuer,
+    jint issuer_offset,
+    jint issuer_length,
+    jlong now) {
+  ct_chain chain;
+  if (!handle || !GetChain(env, leaf, leaf_offset, leaf_length, issuer,
+                           issuer_offset, issuer_length, &chain)) {
+    return JNI_FALSE;
+  }
+  return ct_verify(FromHandle(handle)->verifier, &chain,
+                   static_cast<uint64_t>(now))
+             ? JNI_TRUE
+             : JNI_FALSE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_appmattus_certificatetransparency_internal_verifier_NativeLogVerifier_nativeVerifyScts(
+    JNIEnv* env,
+    jclass,
+    jlong handle,
+    jobject leaf,
+    jint leaf_offset,
+    jint leaf_length,
+    jobject issuer,
+    jint issuer_offset,
+    jint issuer_length,
+    jlong now,
+    jobject results) {
+  ct_chain chain;
+  auto* out = results ? static_cast<uint8_t*>(
+                            env->GetDirectBufferAddress(results))
+                      : nullptr;
+  const jlong capacity = results ? env->GetDirectBufferCapacity(results) : 0;
+  if (!handle || !out || capacity < 0 ||
+      !GetChain(env, leaf, leaf_offset, leaf_length, issuer, issuer_offset,
+                issuer_length, &chain)) {
+    return 0;
+  }
+  const NativeVerifier& verifier = *FromHandle(handle);
+  ct_sct_result sct_results[kMaxSctResults];
+  const size_t count = std::min(
+      {ct_verify_scts(verifier.verifier, &chain, static_cast<uint64_t>(now),
+                      sct_results, kMaxSctResults),
+       kMaxSctResults, static_cast<size_t>(capacity) / kSctResultSize});
+  for (size_t i = 0; i < count; i++, out += kSctResultSize) {
+    const ct_sct_result& result = sct_results[i];
+    std::fill(out, out + kSctResultSize, 0);
+    PutBigEndian(static_cast<uint32_t>(verifier.FindLog(result.log_id)), 4,
+                 out + kLogIndexOffset);
+    PutBigEndian(result.timestamp, 8, out + kTimestampOffset);
+    out[kStatusOffset] = static_cast<uint8_t>(result.status);
+    std::copy(result.log_id, result.log_id + 32, out + kLogIdOffset);
+  }
+  return static_cast<jint>(count);
+}
+
+}  // extern "C"
@@ -78,6 +78,16 @@ public class CTInterceptorBuilder {
         @JvmSynthetic get
         @JvmSynthetic set
 
+    /**
+     * Verify SCT signatures with the native C++ verifier when its JNI library, certificatetransparency_jni, can be loaded. [policy] and the
+     * validity of the logs apply to its results as usual. Certificates the policy rejects are verified again as usual to report why.
+     * certificatetransparency-android packages the library for every ABI; elsewhere it is loaded from java.library.path.
+     * Default: false
+     */
+    public var nativeVerification: Boolean = false
+        @JvmSynthetic get
+        @JvmSynthetic set
+
     /**
      * [CertificateChainCleanerFactory] used to provide the cleaner of the certificate chain
      * Default: null
@@ -183,6 +193,16 @@ public class CTInterceptorBuilder {
     @Suppress("unused")
     public fun setDiskCache(diskCache: DiskCache): CTInterceptorBuilder = apply { this.diskCache = diskCache }
 
+    /**
+     * Verify SCT signatures with the native C++ verifier when its JNI library, certificatetransparency_jni, can be loaded. [policy] and the
+     * validity of the logs apply to its results as usual. Certificates the policy rejects are verified again as usual to report why.
+     * certificatetransparency-android packages the library for every ABI; elsewhere it is loaded from java.library.path.
+     * Default: false
+     */
+    @Suppress("unused")
+    public fun setNativeVerification(nativeVerification: Boolean): CTInterceptorBuilder =
+        apply { this.nativeVerification = nativeVerification }
+
     /**
      * Verify certificate transparency for hosts that match [pattern].
      *
@@ -255,6 +275,7 @@ public class CTInterceptorBuilder {
         logListDataSource,
         policy,
         diskCache,
+        nativeVerification,
         failOnError,
         logger
     )
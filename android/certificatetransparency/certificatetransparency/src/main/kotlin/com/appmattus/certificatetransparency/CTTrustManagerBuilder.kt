@@ -74,6 +74,16 @@ public class CTTrustManagerBuilder(
         @JvmSynthetic get
         @JvmSynthetic set
 
+    /**
+     * Verify SCT signatures with the native C++ verifier when its JNI library, certificatetransparency_jni, can be loaded. [policy] and the
+     * validity of the logs apply to its results as usual. Certificates the policy rejects are verified again as usual to report why.
+     * certificatetransparency-android packages the library for every ABI; elsewhere it is loaded from java.library.path.
+     * Default: false
+     */
+    public var nativeVerification: Boolean = false
+        @JvmSynthetic get
+        @JvmSynthetic set
+
     /**
      * [CertificateChainCleanerFactory] used to provide the cleaner of the certificate chain
      * Default: null
@@ -161,6 +171,16 @@ public class CTTrustManagerBuilder(
     @Suppress("unused")
     public fun setDiskCache(diskCache: DiskCache): CTTrustManagerBuilder = apply { this.diskCache = diskCache }
 
+    /**
+     * Verify SCT signatures with the native C++ verifier when its JNI library, certificatetransparency_jni, can be loaded. [policy] and the
+     * validity of the logs apply to its results as usual. Certificates the policy rejects are verified again as usual to report why.
+     * certificatetransparency-android packages the library for every ABI; elsewhere it is loaded from java.library.path.
+     * Default: false
+     */
+    @Suppress("unused")
+    public fun setNativeVerification(nativeVerification: Boolean): CTTrustManagerBuilder =
+        apply { this.nativeVerification = nativeVerification }
+
     /**
      * Verify certificate transparency for common names that match [pattern].
      *
@@ -233,6 +253,7 @@ public class CTTrustManagerBuilder(
         logListDataSource,
         policy,
         diskCache,
+        nativeVerification,
         failOnError,
         logger
     )
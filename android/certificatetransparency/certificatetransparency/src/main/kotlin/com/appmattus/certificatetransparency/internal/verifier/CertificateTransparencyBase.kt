@@ -38,11 +38,13 @@ import com.appmattus.certificatetransparency.internal.verifier.model.Host
 import com.appmattus.certificatetransparency.loglist.LogListDataSourceFactory
 import com.appmattus.certificatetransparency.loglist.LogListResult
 import com.appmattus.certificatetransparency.loglist.LogListService
+import com.appmattus.certificatetransparency.loglist.LogServer
 import kotlinx.coroutines.runBlocking
 import java.io.IOException
 import java.security.KeyStore
 import java.security.cert.Certificate
 import java.security.cert.X509Certificate
+import java.util.concurrent.atomic.AtomicReference
 import javax.net.ssl.TrustManagerFactory
 import javax.net.ssl.X509TrustManager
 
@@ -55,7 +57,8 @@ internal open class CertificateTransparencyBase(
     logListService: LogListService? = null,
     logListDataSource: DataSource<LogListResult>? = null,
     policy: CTPolicy? = null,
-    diskCache: DiskCache? = null
+    diskCache: DiskCache? = null,
+    nativeVerification: Boolean = false
 ) {
     init {
         includeHosts.forEach {
@@ -82,6 +85,12 @@ internal open class CertificateTransparencyBase(
 
     private val policy = (policy ?: DefaultPolicy())
 
+    private val nativeVerification = nativeVerification && NativeLogVerifier.isAvailable
+
+    // The native verifier of the log list it was created for, or null if the list has no keys it accepts. Replaced, and closed, when the
+    // list changes
+    private val nativeVerifier = AtomicReference<Pair<LogListResult.Valid, NativeLogVerifier?>>()
+
     fun verifyCertificateTransparency(host: String, certificates: List<Certificate>): VerificationResult {
         return if (!enabledForCertificateTransparency(host)) {
             VerificationResult.Success.DisabledForHost(host)
@@ -116,8 +125,8 @@ internal open class CertificateTransparencyBase(
             LogListJsonFailedLoadingWithException(expected)
         }
 
-        val verifiers = when (result) {
-            is LogListResult.Valid -> result.servers.associateBy({ Base64.toBase64String(it.id) }) { LogSignatureVerifier(it) }
+        val logList = when (result) {
+            is LogListResult.Valid -> result
             is LogListResult.Invalid -> return VerificationResult.Failure.LogServersFailed(result)
             null -> return VerificationResult.Failure.LogServersFailed(NoLogServers)
         }
@@ -128,6 +137,16 @@ internal open class CertificateTransparencyBase(
             return VerificationResult.Failure.NoScts
         }
 
+        // The policy applies to the native results as to those below. Chains it rejects are checked again below, to report why
+        if (nativeVerification && certificates.size > 1) {
+            val nativeResult = nativeSctResults(logList, certificates)?.let { policy.policyVerificationResult(leafCertificate, it) }
+            if (nativeResult is VerificationResult.Success) {
+                return nativeResult
+            }
+        }
+
+        val verifiers = logList.servers.associateBy({ Base64.toBase64String(it.id) }) { LogSignatureVerifier(it) }
+
         return try {
             val sctResults = leafCertificate.signedCertificateTimestamps()
                 .associateBy { Base64.toBase64String(it.id.keyId) }
@@ -141,5 +160,49 @@ internal open class CertificateTransparencyBase(
         }
     }
 
+    /**
+     * The results of the SCTs in the leaf of [certificates] by log id, as [LogSignatureVerifier] would give them: the native verifier
+     * checks the signatures, and the [LogServer.validUntil] of their logs is checked here. A log with any valid SCT counts as valid. Returns
+     * null if there is no native verifier for [logList], or it was closed while in use.
+     */
+    private fun nativeSctResults(logList: LogListResult.Valid, certificates: List<X509Certificate>): Map<String, SctVerificationResult>? {
+        val now = System.currentTimeMillis()
+        val verifier = nativeVerifier(logList) ?: return null
+        // The verifier maps log ids to the servers of logList, so the only allocations here are this map and the results in it
+        val sctResults = HashMap<String, SctVerificationResult>()
+        val verified = verifier.forEachSct(certificates, now) { logId, logServer, timestamp, status ->
+            if (sctResults[logId] !is SctVerificationResult.Valid) {
+                sctResults[logId] = sctVerificationResult(logServer, timestamp, status, now)
+            }
+        }
+        return if (verified) sctResults else null
+    }
+
+    private fun sctVerificationResult(logServer: LogServer?, timestamp: Long, status: Int, now: Long): SctVerificationResult {
+        val validUntil = logServer?.validUntil
+        return when {
+            logServer == null || status == NativeLogVerifier.STATUS_UNKNOWN_LOG -> SctVerificationResult.Invalid.NoTrustedLogServerFound
+            status == NativeLogVerifier.STATUS_FUTURE_TIMESTAMP -> SctVerificationResult.Invalid.FutureTimestamp(timestamp, now)
+            status != NativeLogVerifier.STATUS_OK -> SctVerificationResult.Invalid.FailedVerification
+            validUntil != null && timestamp > validUntil -> SctVerificationResult.Invalid.LogServerUntrusted(timestamp, validUntil)
+            else -> SctVerificationResult.Valid
+        }
+    }
+
+    // Creates the native verifier, with its map from log ids to the servers of logList, once per log list. Of threads that create one for
+    // the same list at once, the first to store it wins and the others close theirs
+    private fun nativeVerifier(logList: LogListResult.Valid): NativeLogVerifier? {
+        while (true) {
+            val current = nativeVerifier.get()
+            if (current?.first === logList) return current.second
+            val created = NativeLogVerifier.create(logList.servers)
+            if (nativeVerifier.compareAndSet(current, logList to created)) {
+                current?.second?.close()
+                return created
+            }
+            created?.close()
+        }
+    }
+
     private fun enabledForCertificateTransparency(host: String) = !excludeHosts.any { it.matches(host) } || includeHosts.any { it.matches(host) }
 }
@@ -44,6 +44,7 @@ internal class CertificateTransparencyHostnameVerifier(
     logListDataSource: DataSource<LogListResult>?,
     policy: CTPolicy?,
     diskCache: DiskCache?,
+    nativeVerification: Boolean = false,
     private val failOnError: Boolean = true,
     private val logger: CTLogger? = null
 ) : HostnameVerifier, CertificateTransparencyBase(
@@ -54,7 +55,8 @@ internal class CertificateTransparencyHostnameVerifier(
     logListService,
     logListDataSource,
     policy,
-    diskCache
+    diskCache,
+    nativeVerification
 ) {
 
     override fun verify(host: String, sslSession: SSLSession): Boolean {
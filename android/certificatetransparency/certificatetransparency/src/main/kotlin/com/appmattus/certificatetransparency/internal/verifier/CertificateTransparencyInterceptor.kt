@@ -45,6 +45,7 @@ internal class CertificateTransparencyInterceptor(
     logListDataSource: DataSource<LogListResult>?,
     policy: CTPolicy?,
     diskCache: DiskCache? = null,
+    nativeVerification: Boolean = false,
     private val failOnError: Boolean = true,
     private val logger: CTLogger? = null
 ) : Interceptor, CertificateTransparencyBase(
@@ -55,7 +56,8 @@ internal class CertificateTransparencyInterceptor(
     logListService,
     logListDataSource,
     policy,
-    diskCache
+    diskCache,
+    nativeVerification
 ) {
 
     override fun intercept(chain: Interceptor.Chain): Response {
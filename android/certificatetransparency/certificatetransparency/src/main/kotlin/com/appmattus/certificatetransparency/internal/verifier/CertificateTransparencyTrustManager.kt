@@ -42,6 +42,7 @@ internal class CertificateTransparencyTrustManager(
     logListDataSource: DataSource<LogListResult>?,
     policy: CTPolicy?,
     diskCache: DiskCache?,
+    nativeVerification: Boolean = false,
     private val failOnError: Boolean = true,
     private val logger: CTLogger? = null
 ) : X509TrustManager, CertificateTransparencyBase(
@@ -52,7 +53,8 @@ internal class CertificateTransparencyTrustManager(
     logListService = logListService,
     logListDataSource = logListDataSource,
     policy = policy,
-    diskCache = diskCache
+    diskCache = diskCache,
+    nativeVerification = nativeVerification
 ) {
 
     private val checkServerTrustedMethod: Method? = try {
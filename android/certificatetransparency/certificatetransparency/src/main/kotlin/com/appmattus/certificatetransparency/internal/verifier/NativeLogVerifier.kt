@@ -0,0 +1,298 @@
+/*
+ * Copyright 2022 YANDEX LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appmattus.certificatetransparency.internal.verifier
+
+import com.appmattus.certificatetransparency.internal.utils.Base64
+import com.appmattus.certificatetransparency.loglist.LogServer
+import java.io.Closeable
+import java.lang.ref.PhantomReference
+import java.lang.ref.ReferenceQueue
+import java.nio.ByteBuffer
+import java.security.cert.X509Certificate
+import java.util.Collections
+import java.util.concurrent.ConcurrentHashMap
+import java.util.concurrent.atomic.AtomicBoolean
+import java.util.concurrent.atomic.AtomicInteger
+
+/**
+ * Verifies the Signed Certificate Timestamps embedded in a leaf certificate with the C++ verifier shared with iOS, through JNI.
+ *
+ * [verify] applies the verifier's own policy: the leaf must carry valid SCTs from two distinct logs, or from every log if there are fewer.
+ * [forEachSct] reports the signature check of each SCT instead, leaving the policy and the [LogServer.validUntil] of the logs to the caller.
+ *
+ * Create one with [create], once per log list: it hashes and parses the keys of the logs. [close] frees the native verifier once calls in
+ * progress on other threads return; a verifier that is never closed is freed by a later [create] once it is unreachable.
+ *
+ * @property logServers the logs trusted to issue SCTs
+ */
+internal class NativeLogVerifier private constructor(pointer: Long, val logServers: List<LogServer>) : Closeable {
+
+    private val handle = Handle(this, pointer)
+
+    // The Base64 log ids of logServers, computed once rather than per SCT
+    val logIds: Array<String> = Array(logServers.size) { Base64.toBase64String(logServers[it].id) }
+
+    /**
+     * Verifies the SCTs in the DER encoded leaf between the position and limit of [leaf], issued by the certificate in [issuer], at [now] in
+     * milliseconds since the epoch. Both buffers must be direct; they are read in place and their positions are left unchanged.
+     *
+     * @throws IllegalStateException if the verifier is closed
+     */
+    fun verify(leaf: ByteBuffer, issuer: ByteBuffer, now: Long): Boolean {
+        require(leaf.isDirect && issuer.isDirect) { "Certificates must be in direct buffers" }
+        check(handle.acquire()) { "Verifier is closed" }
+        try {
+            return nativeVerify(handle.pointer, leaf, leaf.position(), leaf.remaining(), issuer, issuer.position(), issuer.remaining(), now)
+        } finally {
+            handle.release()
+        }
+    }
+
+    /**
+     * Verifies the leaf of [certificates] issued by the second certificate, copying both into direct buffers reused by the calling thread.
+     *
+     * @throws IllegalStateException if the verifier is closed
+     */
+    fun verify(certificates: List<X509Certificate>, now: Long): Boolean {
+        val buffers = threadBuffers.get()!!
+        return verify(buffers.put(0, certificates[0]), buffers.put(1, certificates[1]), now)
+    }
+
+    /**
+     * Checks each SCT in the leaf of [certificates] issued by the second certificate at [now] in milliseconds since the epoch, as [verify]
+     * does but without stopping once two logs have passed, and calls [action] with the Base64 id of its log, the log if it is one of
+     * [logServers], its timestamp in milliseconds since the epoch and one of the `STATUS_` constants. Does nothing if the leaf has no
+     * well-formed SCT list. Returns false, without calling [action], if the verifier is closed.
+     *
+     * The certificates are copied into direct buffers reused by the calling thread, and the results are read from another, so only SCTs
+     * from unknown logs allocate.
+     */
+    inline fun forEachSct(
+        certificates: List<X509Certificate>,
+        now: Long,
+        action: (logId: String, logServer: LogServer?, timestamp: Long, status: Int) -> Unit
+    ): Boolean {
+        val results = verifyScts(certificates, now) ?: return false
+        for (index in 0 until results.limit() / SCT_RESULT_SIZE) {
+            val offset = index * SCT_RESULT_SIZE
+            val logIndex = results.getInt(offset + LOG_INDEX_OFFSET)
+            action(
+                if (logIndex >= 0) logIds[logIndex] else logId(results, offset),
+                if (logIndex >= 0) logServers[logIndex] else null,
+                results.getLong(offset + TIMESTAMP_OFFSET),
+                results.get(offset + STATUS_OFFSET).toInt()
+            )
+        }
+        return true
+    }
+
+    // Writes the results of the SCTs of the leaf of certificates into the calling thread's results buffer, returned with its limit after them,
+    // or returns null if the verifier is closed
+    fun verifyScts(certificates: List<X509Certificate>, now: Long): ByteBuffer? {
+        val buffers = threadBuffers.get()!!
+        val leaf = buffers.put(0, certificates[0])
+        val issuer = buffers.put(1, certificates[1])
+        if (!handle.acquire()) return null
+        val count = try {
+            nativeVerifyScts(
+                handle.pointer, leaf, leaf.position(), leaf.remaining(), issuer, issuer.position(), issuer.remaining(), now, buffers.results
+            )
+        } finally {
+            handle.release()
+        }
+        return buffers.results.apply {
+            clear()
+            limit(count * SCT_RESULT_SIZE)
+        }
+    }
+
+    /**
+     * Frees the native verifier once the calls in progress return. Later calls fail, and closing again does nothing.
+     */
+    override fun close() = handle.close()
+
+    /**
+     * The native verifier of a [NativeLogVerifier] and the count of its users: the verifier until it is closed, and each call in progress.
+     * The last user frees it. A verifier that becomes unreachable without being closed leaves its handle in [queue], for [create] to close.
+     */
+    private class Handle(verifier: NativeLogVerifier, val pointer: Long) : PhantomReference<NativeLogVerifier>(verifier, queue) {
+        private val users = AtomicInteger(1)
+        private val closed = AtomicBoolean()
+
+        init {
+            // A phantom reference is only enqueued while it is reachable itself
+            handles.add(this)
+        }
+
+        // Returns false if the native verifier is already freed
+        fun acquire(): Boolean {
+            while (true) {
+                val count = users.get()
+                if (count == 0) return false
+                if (users.compareAndSet(count, count + 1)) return true
+            }
+        }
+
+        fun release() {
+            if (users.decrementAndGet() == 0) {
+                handles.remove(this)
+                nativeFree(pointer)
+            }
+        }
+
+        fun close() {
+            if (closed.compareAndSet(false, true)) release()
+        }
+    }
+
+    /**
+     * Direct buffers that grow to the largest certificates seen, and one for the results of [nativeVerifyScts]. The DER of a certificate is
+     * copied again only when the certificate differs from the last one in its buffer, as the certificates of a cached chain don't.
+     */
+    private class DirectBuffers {
+        private val buffers = Array<ByteBuffer>(2) { ByteBuffer.allocateDirect(INITIAL_CAPACITY) }
+        private val certificates = arrayOfNulls<X509Certificate>(2)
+
+        val results: ByteBuffer = ByteBuffer.allocateDirect(MAX_SCT_RESULTS * SCT_RESULT_SIZE)
+
+        fun put(index: Int, certificate: X509Certificate): ByteBuffer {
+            if (certificates[index] !== certificate) {
+                // Forget the certificate first, in case encoding it throws
+                certificates[index] = null
+                val bytes = certificate.encoded
+                if (buffers[index].capacity() < bytes.size) {
+                    buffers[index] = ByteBuffer.allocateDirect(maxOf(bytes.size, buffers[index].capacity() * 2))
+                }
+                buffers[index].apply {
+                    clear()
+                    put(bytes)
+                    flip()
+                }
+                certificates[index] = certificate
+            }
+            return buffers[index]
+        }
+    }
+
+    companion object {
+        /**
+         * The name of the JNI library, built from src/main/cpp and loaded from java.library.path.
+         */
+        const val LIBRARY_NAME = "certificatetransparency_jni"
+
+        private const val INITIAL_CAPACITY = 4096
+
+        // As many SCTs as ct_verify_scts reports
+        private const val MAX_SCT_RESULTS = 16
+
+        private const val LOG_ID_SIZE = 32
+
+        // The layout of the results of nativeVerifyScts: the index of the log in logServers or -1, the timestamp, the status, padding and
+        // the log id, big-endian
+        const val LOG_INDEX_OFFSET = 0
+        const val TIMESTAMP_OFFSET = 4
+        const val STATUS_OFFSET = 12
+        private const val LOG_ID_OFFSET = 16
+        const val SCT_RESULT_SIZE = LOG_ID_OFFSET + LOG_ID_SIZE
+
+        /**
+         * The SCT is signed by its log.
+         */
+        const val STATUS_OK = 1
+
+        /**
+         * The SCT is not from a log of the verifier.
+         */
+        const val STATUS_UNKNOWN_LOG = 2
+
+        /**
+         * The timestamp of the SCT is after the time of the check.
+         */
+        const val STATUS_FUTURE_TIMESTAMP = 4
+
+        /**
+         * Whether the JNI library could be loaded.
+         */
+        val isAvailable: Boolean by lazy {
+            try {
+                System.loadLibrary(LIBRARY_NAME)
+                true
+            } catch (ignored: UnsatisfiedLinkError) {
+                false
+            }
+        }
+
+        // The handles of the verifiers not yet freed, and those of the verifiers that became unreachable
+        private val handles: MutableSet<Handle> = Collections.newSetFromMap(ConcurrentHashMap())
+        private val queue = ReferenceQueue<NativeLogVerifier>()
+
+        /**
+         * Creates a verifier for [logServers], or returns null if the native verifier rejects their keys or there are none. Requires
+         * [isAvailable].
+         */
+        fun create(logServers: List<LogServer>): NativeLogVerifier? {
+            while (true) {
+                (queue.poll() as Handle? ?: break).close()
+            }
+            val pointer = nativeCreate(Array(logServers.size) { logServers[it].key.encoded })
+            return if (pointer != 0L) NativeLogVerifier(pointer, logServers.toList()) else null
+        }
+
+        // The Base64 log id of the results at offset
+        fun logId(results: ByteBuffer, offset: Int): String =
+            Base64.toBase64String(ByteArray(LOG_ID_SIZE) { results.get(offset + LOG_ID_OFFSET + it) })
+
+        @JvmStatic
+        private external fun nativeCreate(keys: Array<ByteArray>): Long
+
+        @JvmStatic
+        private external fun nativeFree(pointer: Long)
+
+        @JvmStatic
+        @Suppress("LongParameterList")
+        private external fun nativeVerify(
+            pointer: Long,
+            leaf: ByteBuffer,
+            leafOffset: Int,
+            leafLength: Int,
+            issuer: ByteBuffer,
+            issuerOffset: Int,
+            issuerLength: Int,
+            now: Long
+        ): Boolean
+
+        // Writes SCT_RESULT_SIZE bytes per SCT from the start of the direct results buffer, laid out as read by forEachSct, as many as fit.
+        // Returns the number written
+        @JvmStatic
+        @Suppress("LongParameterList")
+        private external fun nativeVerifyScts(
+            pointer: Long,
+            leaf: ByteBuffer,
+            leafOffset: Int,
+            leafLength: Int,
+            issuer: ByteBuffer,
+            issuerOffset: Int,
+            issuerLength: Int,
+            now: Long,
+            results: ByteBuffer
+        ): Int
+
+        private val threadBuffers = object : ThreadLocal<DirectBuffers>() {
+            override fun initialValue() = DirectBuffers()
+        }
+    }
+}
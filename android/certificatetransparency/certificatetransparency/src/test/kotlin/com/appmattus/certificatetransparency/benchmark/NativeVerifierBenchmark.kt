@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022 YANDEX LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appmattus.certificatetransparency.benchmark
+
+import com.appmattus.certificatetransparency.SctVerificationResult
+import com.appmattus.certificatetransparency.internal.utils.signedCertificateTimestamps
+import com.appmattus.certificatetransparency.internal.verifier.LogSignatureVerifier
+import com.appmattus.certificatetransparency.internal.verifier.NativeLogVerifier
+import com.appmattus.certificatetransparency.loglist.LogServer
+import com.appmattus.certificatetransparency.utils.TestData
+import com.appmattus.certificatetransparency.utils.readPemFile
+import java.lang.management.ManagementFactory
+import java.nio.ByteBuffer
+import java.security.cert.X509Certificate
+import kotlin.system.exitProcess
+
+/**
+ * Compares verifying the SCTs embedded in a test certificate with [LogSignatureVerifier] and with [NativeLogVerifier], in time and in
+ * Java heap allocated per certificate. Runs on a desktop JDK with the JNI library built from src/main/cpp:
+ *
+ *   ./gradlew :certificatetransparency:nativeVerifierBenchmark -PnativeLibraryPath=<directory of libcertificatetransparency_jni.so>
+ *
+ * An argument, or -Piterations with Gradle, sets the number of certificates verified per measurement.
+ */
+@Suppress("MagicNumber")
+internal object NativeVerifierBenchmark {
+    private const val LEAF = "/testdata/test-embedded-cert.pem"
+
+    private class Result(val nanos: Double, val bytes: Double)
+
+    private val threadMXBean = ManagementFactory.getThreadMXBean() as com.sun.management.ThreadMXBean
+
+    private fun measure(iterations: Int, verify: () -> Boolean): Result {
+        // Warm up, and check that the chain verifies at all
+        repeat(iterations) {
+            check(verify()) { "Certificate did not verify" }
+        }
+        val threadId = Thread.currentThread().id
+        val bytesBefore = threadMXBean.getThreadAllocatedBytes(threadId)
+        val start = System.nanoTime()
+        repeat(iterations) {
+            verify()
+        }
+        val nanos = System.nanoTime() - start
+        val bytes = threadMXBean.getThreadAllocatedBytes(threadId) - bytesBefore
+        return Result(nanos.toDouble() / iterations, bytes.toDouble() / iterations)
+    }
+
+    private fun directBuffer(bytes: ByteArray): ByteBuffer = ByteBuffer.allocateDirect(bytes.size).apply {
+        put(bytes)
+        flip()
+    }
+
+    @JvmStatic
+    fun main(args: Array<String>) {
+        val iterations = args.firstOrNull()?.toInt() ?: 10_000
+        if (!NativeLogVerifier.isAvailable) {
+            System.err.println("Can't load ${NativeLogVerifier.LIBRARY_NAME} from java.library.path")
+            exitProcess(1)
+        }
+
+        val leaf = TestData.loadCertificates(LEAF)[0]
+        val issuer = TestData.loadCertificates(TestData.ROOT_CA_CERT)[0]
+        val chain: List<X509Certificate> = listOf(leaf, issuer)
+        val logServer = LogServer(TestData.file(TestData.TEST_LOG_KEY).readPemFile())
+
+        val kotlinVerifier = LogSignatureVerifier(logServer)
+        val nativeVerifier = checkNotNull(NativeLogVerifier.create(listOf(logServer))) { "Test log key rejected" }
+        val leafBuffer = directBuffer(leaf.encoded)
+        val issuerBuffer = directBuffer(issuer.encoded)
+
+        val results = linkedMapOf(
+            "kotlin" to measure(iterations) {
+                leaf.signedCertificateTimestamps().all { kotlinVerifier.verifySignature(it, chain) is SctVerificationResult.Valid }
+            },
+            "native, direct buffers" to measure(iterations) {
+                nativeVerifier.verify(leafBuffer, issuerBuffer, System.currentTimeMillis())
+            },
+            "native, from X509Certificate" to measure(iterations) {
+                nativeVerifier.verify(chain, System.currentTimeMillis())
+            },
+            "native, each SCT" to measure(iterations) {
+                var valid = true
+                nativeVerifier.forEachSct(chain, System.currentTimeMillis()) { _, _, _, status ->
+                    valid = valid && status == NativeLogVerifier.STATUS_OK
+                }
+                valid
+            }
+        )
+
+        println("$iterations certificates per measurement")
+        println(String.format("%-30s %12s %12s", "per certificate", "us", "heap bytes"))
+        results.forEach { (name, result) ->
+            println(String.format("%-30s %12.1f %12.0f", name, result.nanos / 1000, result.bytes))
+        }
+    }
+}
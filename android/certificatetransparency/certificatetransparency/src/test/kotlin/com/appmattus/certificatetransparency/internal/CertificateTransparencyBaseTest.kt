@@ -20,6 +20,7 @@
 
 package com.appmattus.certificatetransparency.internal
 
+import com.appmattus.certificatetransparency.CTPolicy
 import com.appmattus.certificatetransparency.SctVerificationResult
 import com.appmattus.certificatetransparency.VerificationResult
 import com.appmattus.certificatetransparency.chaincleaner.CertificateChainCleaner
@@ -29,6 +30,7 @@ import com.appmattus.certificatetransparency.internal.loglist.LogListJsonFailedL
 import com.appmattus.certificatetransparency.internal.serialization.CTConstants
 import com.appmattus.certificatetransparency.internal.utils.Base64
 import com.appmattus.certificatetransparency.internal.verifier.CertificateTransparencyBase
+import com.appmattus.certificatetransparency.internal.verifier.NativeLogVerifier
 import com.appmattus.certificatetransparency.internal.verifier.model.Host
 import com.appmattus.certificatetransparency.loglist.LogListResult
 import com.appmattus.certificatetransparency.utils.LogListDataSourceTestFactory
@@ -40,10 +42,13 @@ import com.appmattus.certificatetransparency.utils.TrustedSocketFactory
 import com.appmattus.certificatetransparency.utils.assertIsA
 import org.junit.Assert.assertEquals
 import org.junit.Assert.assertTrue
+import org.junit.Assume.assumeTrue
 import org.junit.Test
 import org.mockito.kotlin.spy
 import org.mockito.kotlin.whenever
 import java.security.cert.X509Certificate
+import java.util.Date
+import java.util.concurrent.TimeUnit
 import javax.net.ssl.SSLPeerUnverifiedException
 import javax.net.ssl.X509TrustManager
 
@@ -228,6 +233,94 @@ internal class CertificateTransparencyBaseTest {
         )
     }
 
+    @Test
+    fun policyAppliesWithNativeVerification() {
+        assumeNativeLibraryLoaded()
+
+        val ctb = CertificateTransparencyBase(
+            logListDataSource = LogListDataSourceTestFactory.logListDataSource,
+            policy = object : CTPolicy {
+                override fun policyVerificationResult(leafCertificate: X509Certificate, sctResults: Map<String, SctVerificationResult>) =
+                    VerificationResult.Failure.TooFewSctsTrusted(sctResults, Int.MAX_VALUE)
+            },
+            nativeVerification = true
+        )
+
+        val certsToCheck = TestData.loadCertificates(TEST_MITMPROXY_ORIGINAL_CHAIN)
+
+        assertIsA<VerificationResult.Failure.TooFewSctsTrusted>(ctb.verifyCertificateTransparency("www.appmattus.com", certsToCheck))
+    }
+
+    @Test
+    fun longLivedCertificateWithTwoSctsDisallowedWithNativeVerification() {
+        assumeNativeLibraryLoaded()
+
+        val ctb = CertificateTransparencyBase(
+            logListDataSource = LogListDataSourceTestFactory.logListDataSource,
+            nativeVerification = true
+        )
+
+        val certsToCheck = TestData.loadCertificates(TEST_MITMPROXY_ORIGINAL_CHAIN)
+
+        // Both SCTs are valid, but a certificate valid for three years needs four
+        val longLived = spy(certsToCheck.first()).apply {
+            whenever(notAfter).thenReturn(Date(notBefore.time + TimeUnit.DAYS.toMillis(3 * 365)))
+        }
+        val filtered = listOf(longLived, *certsToCheck.drop(1).toTypedArray())
+
+        val result = ctb.verifyCertificateTransparency("www.appmattus.com", filtered)
+        assertIsA<VerificationResult.Failure.TooFewSctsTrusted>(result)
+        assertEquals(4, (result as VerificationResult.Failure.TooFewSctsTrusted).minSctCount)
+    }
+
+    @Test
+    fun originalChainDisallowedWhenEmptyLogsWithNativeVerification() {
+        assumeNativeLibraryLoaded()
+
+        val ctb = CertificateTransparencyBase(
+            logListDataSource = LogListDataSourceTestFactory.emptySource,
+            nativeVerification = true
+        )
+
+        val certsToCheck = TestData.loadCertificates(TEST_MITMPROXY_ORIGINAL_CHAIN)
+
+        assertIsA<VerificationResult.Failure.TooFewSctsTrusted>(ctb.verifyCertificateTransparency("www.appmattus.com", certsToCheck))
+    }
+
+    @Test
+    fun originalChainAllowedWithNativeVerification() {
+        assumeNativeLibraryLoaded()
+
+        val ctb = CertificateTransparencyBase(
+            logListDataSource = LogListDataSourceTestFactory.logListDataSource,
+            nativeVerification = true
+        )
+
+        val certsToCheck = TestData.loadCertificates(TEST_MITMPROXY_ORIGINAL_CHAIN)
+
+        assertIsA<VerificationResult.Success.Trusted>(ctb.verifyCertificateTransparency("www.appmattus.com", certsToCheck))
+    }
+
+    @Test
+    fun mitmDisallowedWithNativeVerification() {
+        assumeNativeLibraryLoaded()
+
+        val ctb = CertificateTransparencyBase(
+            trustManager = mitmProxyTrustManager(),
+            logListDataSource = LogListDataSourceTestFactory.logListDataSource,
+            nativeVerification = true
+        )
+
+        val certsToCheck = TestData.loadCertificates(TEST_MITMPROXY_ATTACK_CHAIN)
+
+        assertIsA<VerificationResult.Failure.NoScts>(ctb.verifyCertificateTransparency("www.appmattus.com", certsToCheck))
+    }
+
+    // Without the JNI library, nativeVerification would quietly test the Kotlin verifier
+    private fun assumeNativeLibraryLoaded() {
+        assumeTrue("${NativeLogVerifier.LIBRARY_NAME} is not on java.library.path", NativeLogVerifier.isAvailable)
+    }
+
     private fun mitmProxyTrustManager(): X509TrustManager {
         val rootCerts = TestData.loadCertificates(TEST_MITMPROXY_ROOT_CERT)
         return TrustedSocketFactory().create(rootCerts).trustManager
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2022 YANDEX LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.appmattus.certificatetransparency.internal.verifier
+
+import com.appmattus.certificatetransparency.internal.utils.Base64
+import com.appmattus.certificatetransparency.loglist.LogServer
+import com.appmattus.certificatetransparency.utils.TestData
+import com.appmattus.certificatetransparency.utils.TestData.ROOT_CA_CERT
+import com.appmattus.certificatetransparency.utils.TestData.TEST_LOG_KEY
+import com.appmattus.certificatetransparency.utils.TestData.TEST_LOG_KEY_RSA
+import com.appmattus.certificatetransparency.utils.TestData.loadCertificates
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertFalse
+import org.junit.Assert.assertNull
+import org.junit.Assert.assertSame
+import org.junit.Assert.assertTrue
+import org.junit.Assume.assumeTrue
+import org.junit.Before
+import org.junit.Test
+
+/**
+ * Runs when the JNI library is on java.library.path, as with -PnativeLibraryPath, and is skipped otherwise.
+ */
+internal class NativeLogVerifierTest {
+
+    private val logServer = LogServer.fromKeyFile(TestData.fileName(TEST_LOG_KEY))
+
+    private val chain by lazy { loadCertificates(LEAF) + loadCertificates(ROOT_CA_CERT) }
+
+    @Before
+    fun nativeLibraryLoaded() {
+        assumeTrue("${NativeLogVerifier.LIBRARY_NAME} is not on java.library.path", NativeLogVerifier.isAvailable)
+    }
+
+    @Test
+    fun noLogsRejected() {
+        assertNull(NativeLogVerifier.create(emptyList()))
+    }
+
+    @Test
+    fun sctFromKnownLogReported() {
+        val verifier = NativeLogVerifier.create(listOf(logServer))!!
+        var count = 0
+
+        assertTrue(
+            verifier.forEachSct(chain, System.currentTimeMillis()) { logId, sctLogServer, timestamp, status ->
+                count++
+                assertEquals(Base64.toBase64String(logServer.id), logId)
+                assertSame(logServer, sctLogServer)
+                assertTrue(timestamp > 0)
+                assertEquals(NativeLogVerifier.STATUS_OK, status)
+            }
+        )
+        assertEquals(1, count)
+        assertTrue(verifier.verify(chain, System.currentTimeMillis()))
+    }
+
+    @Test
+    fun sctFromUnknownLogReported() {
+        val verifier = NativeLogVerifier.create(listOf(LogServer.fromKeyFile(TestData.fileName(TEST_LOG_KEY_RSA))))!!
+        var count = 0
+
+        verifier.forEachSct(chain, System.currentTimeMillis()) { logId, sctLogServer, _, status ->
+            count++
+            // The id still names the log that issued the SCT
+            assertEquals(Base64.toBase64String(logServer.id), logId)
+            assertNull(sctLogServer)
+            assertEquals(NativeLogVerifier.STATUS_UNKNOWN_LOG, status)
+        }
+        assertEquals(1, count)
+    }
+
+    @Test
+    fun closedVerifierRefusesCalls() {
+        val verifier = NativeLogVerifier.create(listOf(logServer))!!
+        verifier.close()
+        verifier.close()
+
+        assertFalse(verifier.forEachSct(chain, System.currentTimeMillis()) { _, _, _, _ -> throw AssertionError("SCT reported") })
+    }
+
+    @Test(expected = IllegalStateException::class)
+    fun closedVerifierThrowsOnVerify() {
+        val verifier = NativeLogVerifier.create(listOf(logServer))!!
+        verifier.close()
+
+        verifier.verify(chain, System.currentTimeMillis())
+    }
+
+    companion object {
+        private const val LEAF = "/testdata/test-embedded-cert.pem"
+    }
+}
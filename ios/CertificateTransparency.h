@@ -25,6 +25,10 @@ CERTIFICATE_TRANSPARENCY_EXPORT
 @property(nonatomic, copy, nullable) NSURL* updateURL;
 @property(nonatomic, copy, nullable) NSArray* customRoots;
 @property(nonatomic, copy, nullable) NSArray<NSData*>* logs;
+// Queue on which challenges received on the main thread are verified and
+// completed. By default they are verified on a global queue and completed on
+// the main queue.
+@property(nonatomic, strong, nullable) dispatch_queue_t verificationQueue;
 
 - (instancetype)init NS_DESIGNATED_INITIALIZER;
 
@@ -44,6 +48,11 @@ CERTIFICATE_TRANSPARENCY_EXPORT
                          (CertificateTransparencyCompletion)completionHandler;
 - (CertificateTransparencyVerifyResult)verifyTrust:(SecTrustRef)trust;
 
+// Loads the trust anchors and CT logs on a low-priority background queue, so
+// the first challenge does not have to. Challenges that arrive meanwhile wait
+// for it to finish. Calling it more than once is harmless.
+- (void)prewarm;
+
 @end
 
 NS_ASSUME_NONNULL_END
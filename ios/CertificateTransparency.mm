@@ -1,12 +1,18 @@
 #import "CertificateTransparency.h"
 
 #include <CommonCrypto/CommonDigest.h>
+#include <optional>
 #include <variant>
 
 #include "auto_update_log_verifier.h"
 #include "builtin_logs.h"
 #include "builtin_root_certs.h"
+#include "interned_log_store.h"
 #include "multi_log_verifier.h"
+#include "root_index.h"
+#include "single_flight_verifier.h"
+#include "trace.h"
+#include "verification_pipeline.h"
 
 #define STATIC_STORAGE(Type, storage) \
   alignas(Type) static std::byte storage[sizeof(Type)]
@@ -39,14 +45,15 @@ std::string_view ToView(CFDataRef data) {
   return std::string_view(buf, len);
 }
 
-std::vector<std::string> ToCppLogs(NSArray<NSData*>* logs) {
-  std::vector<std::string> cppLogs;
-  cppLogs.reserve([logs count]);
+// Views of the keys in |logs|, valid while |logs| is.
+std::vector<std::string_view> ToKeyViews(NSArray<NSData*>* logs) {
+  std::vector<std::string_view> keys;
+  keys.reserve([logs count]);
   for (NSData* data in logs) {
-    const char* buf = reinterpret_cast<const char*>([data bytes]);
-    cppLogs.push_back(std::string(buf, buf + [data length]));
+    keys.emplace_back(reinterpret_cast<const char*>([data bytes]),
+                      [data length]);
   }
-  return cppLogs;
+  return keys;
 }
 
 NSString* GeneratePrefKey(NSURL* url) {
@@ -62,39 +69,171 @@ NSString* GeneratePrefKey(NSURL* url) {
 
 struct DefaultCustomRoots {};
 
+struct CustomRoots {
+  NSArray* certs;
+  // Fingerprints of |certs|, to tell whether a chain ends in one of them.
+  ct::RootIndex index;
+  // |certs| grouped by normalized subject, to anchor a chain with the roots
+  // that can have issued its topmost certificate rather than all of them.
+  NSDictionary<NSData*, NSArray*>* certs_by_subject;
+};
+
+CustomRoots MakeCustomRoots(NSArray* certs) {
+  CustomRoots roots = {.certs = certs};
+  NSMutableDictionary<NSData*, NSMutableArray*>* certs_by_subject =
+      [[NSMutableDictionary alloc] init];
+  for (id cert in certs) {
+    CFDataRef data = SecCertificateCopyData((__bridge SecCertificateRef)cert);
+    if (data) {
+      roots.index.Add(ToView(data));
+      CFRelease(data);
+    }
+    NSData* subject =
+        CFBridgingRelease(SecCertificateCopyNormalizedSubjectSequence(
+            (__bridge SecCertificateRef)cert));
+    if (subject) {
+      if (!certs_by_subject[subject]) {
+        certs_by_subject[subject] = [[NSMutableArray alloc] init];
+      }
+      [certs_by_subject[subject] addObject:cert];
+    }
+  }
+  NSMutableDictionary<NSData*, NSArray*>* frozen =
+      [[NSMutableDictionary alloc] initWithCapacity:[certs_by_subject count]];
+  for (NSData* subject in certs_by_subject) {
+    frozen[subject] = [certs_by_subject[subject] copy];
+  }
+  roots.certs_by_subject = [frozen copy];
+  return roots;
+}
+
 struct CustomRootsVisitor {
-  NSArray* operator()(DefaultCustomRoots& tag) const {
-    static NSArray* roots = ct::GetBuiltinCerts();
-    return roots;
+  const CustomRoots& operator()(DefaultCustomRoots& tag) const {
+    STATIC_STORAGE(CustomRoots, storage);
+    static auto* roots =
+        new (storage) CustomRoots(MakeCustomRoots(ct::GetBuiltinCerts()));
+    return *roots;
+  }
+  const CustomRoots& operator()(CustomRoots& roots) const { return roots; }
+};
+
+// Evaluates a server trust against the custom roots with SecTrust.
+class SecTrustChainEvaluator : public ct::ChainEvaluator {
+ public:
+  SecTrustChainEvaluator(SecTrustRef trust, const CustomRoots* custom_roots)
+      : trust_(trust), custom_roots_(custom_roots) {}
+
+  ct::ChainEvaluation Evaluate() override {
+    ct::ChainEvaluation evaluation;
+    // SecTrust copies and searches every anchor it is given, so the chain is
+    // first anchored at the roots that can have issued its topmost
+    // certificate. Only if that fails, e.g. for a chain SecTrust completes
+    // through another root, are all of them tried.
+    NSArray* anchors = GetLikelyAnchors();
+    evaluation.trusted =
+        EvaluateWithAnchors(anchors ? anchors : custom_roots_->certs);
+    if (!evaluation.trusted && anchors) {
+      evaluation.trusted = EvaluateWithAnchors(custom_roots_->certs);
+    }
+
+    const CFIndex chain_length = SecTrustGetCertificateCount(trust_);
+    if (chain_length == 0) {
+      evaluation.trusted = false;
+      return evaluation;
+    }
+
+    CFDataRef root = GetCert(trust_, static_cast<int>(chain_length - 1));
+    evaluation.has_custom_root =
+        custom_roots_->index.Contains(ToView(root));
+    if (root) {
+      CFRelease(root);
+    }
+    if (evaluation.trusted && evaluation.has_custom_root) {
+      evaluation.leaf_cert = CopyCert(0);
+      if (chain_length > 1) {
+        evaluation.issuer_cert = CopyCert(1);
+      }
+    }
+    return evaluation;
+  }
+
+ private:
+  // Returns the custom roots whose subject is the issuer of the topmost
+  // certificate the server presented, or nil if there are none.
+  NSArray* _Nullable GetLikelyAnchors() const {
+    const CFIndex count = SecTrustGetCertificateCount(trust_);
+    SecCertificateRef top =
+        count > 0 ? SecTrustGetCertificateAtIndex(trust_, count - 1) : nullptr;
+    if (!top) {
+      return nil;
+    }
+    NSData* issuer =
+        CFBridgingRelease(SecCertificateCopyNormalizedIssuerSequence(top));
+    return issuer ? custom_roots_->certs_by_subject[issuer] : nil;
+  }
+
+  bool EvaluateWithAnchors(NSArray* anchors) const {
+    if (SecTrustSetAnchorCertificates(trust_, (__bridge CFArrayRef)anchors) !=
+            errSecSuccess ||
+        SecTrustSetAnchorCertificatesOnly(trust_, NO) != errSecSuccess) {
+      return false;
+    }
+    if (@available(iOS 12, tvOS 12, macOS 10.14, *)) {
+      return SecTrustEvaluateWithError(trust_, NULL);
+    }
+    SecTrustResultType trust_result = kSecTrustResultDeny;
+    return SecTrustEvaluate(trust_, &trust_result) == errSecSuccess &&
+           (trust_result == kSecTrustResultUnspecified ||
+            trust_result == kSecTrustResultProceed) &&
+           SecTrustGetCertificateCount(trust_) > 0;
+  }
+
+  std::string CopyCert(int index) const {
+    CFDataRef cert = GetCert(trust_, index);
+    std::string result(ToView(cert));
+    if (cert) {
+      CFRelease(cert);
+    }
+    return result;
   }
-  NSArray* operator()(NSArray* roots) const { return roots; }
+
+  SecTrustRef trust_;
+  const CustomRoots* custom_roots_;
 };
 
 struct DefaultVerifier {};
 
-struct VerifyVisitor {
+struct VerifyPreparedVisitor {
   bool operator()(DefaultVerifier& tag) const {
-    STATIC_STORAGE(ct::MultiLogVerifier, storage);
-    static auto* instance =
-        new (storage) ct::MultiLogVerifier(ct::GetBuiltinLogs());
-
-    return instance->Verify(leaf_cert, issuer_cert, now);
+    return ct::GetBuiltinLogVerifier().Verify(chain, now);
   }
   bool operator()(ct::AutoUpdateLogVerifier* verifier) const {
-    return verifier->Verify(leaf_cert, issuer_cert, now);
+    return verifier->Verify(chain, now);
   }
-  bool operator()(ct::MultiLogVerifier& verifier) const {
-    return verifier.Verify(leaf_cert, issuer_cert, now);
+  bool operator()(std::shared_ptr<const ct::MultiLogVerifier>& verifier)
+      const {
+    return verifier->Verify(chain, now);
   }
   bool operator()(std::shared_ptr<ct::AutoUpdateLogVerifier>& verifier) const {
-    return verifier->Verify(leaf_cert, issuer_cert, now);
+    return verifier->Verify(chain, now);
   }
 
-  std::string_view leaf_cert;
-  std::string_view issuer_cert;
+  const ct::PreparedChain& chain;
   uint64_t now;
 };
 
+struct PrewarmVisitor {
+  void operator()(DefaultVerifier& tag) const { ct::GetBuiltinLogVerifier(); }
+  void operator()(ct::AutoUpdateLogVerifier* verifier) const {
+    verifier->Prewarm();
+  }
+  void operator()(std::shared_ptr<const ct::MultiLogVerifier>& verifier)
+      const {}
+  void operator()(std::shared_ptr<ct::AutoUpdateLogVerifier>& verifier) const {
+    verifier->Prewarm();
+  }
+};
+
 }  // namespace
 
 @implementation CertificateTransparencyConfiguration
@@ -110,13 +249,18 @@ struct VerifyVisitor {
 @end
 
 @interface CertificateTransparency () {
-  std::variant<DefaultCustomRoots, NSArray*> custom_roots_;
+  std::variant<DefaultCustomRoots, CustomRoots> custom_roots_;
   std::variant<
       DefaultVerifier,
       ct::AutoUpdateLogVerifier*,
-      ct::MultiLogVerifier,
+      std::shared_ptr<const ct::MultiLogVerifier>,
       std::shared_ptr<ct::AutoUpdateLogVerifier>>
       verifier_;
+  // Parallel connections to the same host present the same chain, so
+  // identical verifications in flight are run once.
+  ct::SingleFlightVerifier single_flight_;
+  std::optional<ct::VerificationPipeline> pipeline_;
+  dispatch_queue_t _Nullable verification_queue_;
 }
 
 @end
@@ -134,25 +278,27 @@ struct VerifyVisitor {
   self = [super init];
   if (self) {
     if (configuration.customRoots) {
-      custom_roots_ = configuration.customRoots;
+      custom_roots_ = MakeCustomRoots(configuration.customRoots);
     } else {
       custom_roots_ = DefaultCustomRoots();
     }
 
     if (configuration.logs) {
       NSArray<NSData*>* logs = configuration.logs;
-      verifier_.emplace<ct::MultiLogVerifier>(ToCppLogs(logs));
+      // Instances with the same keys share one verifier and its parsed keys.
+      verifier_ = ct::InternedLogStore::Shared().GetVerifier(ToKeyViews(logs));
     } else {
       if (configuration.autoUpdate) {
         if (configuration.updateURL) {
           NSURL* updateURL = configuration.updateURL;
-          verifier_ = ct::AutoUpdateLogVerifier::Create(
+          // Instances with the same URL share one updater and its logs.
+          verifier_ = ct::AutoUpdateLogVerifier::GetShared(
               NSUserDefaults.standardUserDefaults, GeneratePrefKey(updateURL),
               updateURL);
         } else {
           STATIC_STORAGE(std::shared_ptr<ct::AutoUpdateLogVerifier>, storage);
-          static auto* verifier =
-              new (storage) std::shared_ptr(ct::AutoUpdateLogVerifier::Create(
+          static auto* verifier = new (storage)
+              std::shared_ptr(ct::AutoUpdateLogVerifier::GetShared(
                   NSUserDefaults.standardUserDefaults, kPrefsKey,
                   [NSURL URLWithString:kUpdateURL]));
 
@@ -162,6 +308,17 @@ struct VerifyVisitor {
         verifier_ = DefaultVerifier();
       }
     }
+
+    // SCTs are extracted and decoded on another thread while SecTrust
+    // evaluates the chain, mostly waiting on trustd.
+    pipeline_.emplace(
+        ct::VerificationLimits(), [](ct::VerificationPipeline::Task task) {
+          dispatch_async(
+              dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+                task();
+              });
+        });
+    verification_queue_ = configuration.verificationQueue;
   }
   return self;
 }
@@ -181,6 +338,13 @@ struct VerifyVisitor {
     return;
   }
 
+  if (verification_queue_) {
+    dispatch_async(verification_queue_, ^{
+      [self verify:protectionSpace completionHandler:completionHandler];
+    });
+    return;
+  }
+
   __auto_type work_queue =
       dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
   __auto_type completion =
@@ -196,6 +360,13 @@ struct VerifyVisitor {
   });
 }
 
+- (void)prewarm {
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+    std::visit(CustomRootsVisitor(), custom_roots_);
+    std::visit(PrewarmVisitor(), verifier_);
+  });
+}
+
 - (void)verify:(NSURLProtectionSpace*)protectionSpace
     completionHandler:(CertificateTransparencyCompletion)completionHandler {
   SecTrustRef trust = protectionSpace.serverTrust;
@@ -211,62 +382,37 @@ struct VerifyVisitor {
 }
 
 - (CertificateTransparencyVerifyResult)verifyTrust:(SecTrustRef)trust {
+  CT_TRACE_SPAN("verify_trust");
   if (!trust) {
     return {.trusted = false, .hasCustomRoot = false};
   }
 
-  NSArray* custom_roots = std::visit(CustomRootsVisitor(), custom_roots_);
-
-  if (SecTrustSetAnchorCertificates(trust, (CFArrayRef)custom_roots) !=
-          errSecSuccess ||
-      SecTrustSetAnchorCertificatesOnly(trust, NO) != errSecSuccess) {
-    return {.trusted = false, .hasCustomRoot = false};
-  }
-
-  bool trusted = false;
-  if (@available(iOS 12, tvOS 12, macOS 10.14, *)) {
-    trusted = SecTrustEvaluateWithError(trust, NULL);
-  } else {
-    SecTrustResultType trust_result = kSecTrustResultDeny;
-    trusted = SecTrustEvaluate(trust, &trust_result) == errSecSuccess &&
-              (trust_result == kSecTrustResultUnspecified ||
-               trust_result == kSecTrustResultProceed) &&
-              SecTrustGetCertificateCount(trust) > 0;
-  }
-
-  const CFIndex chain_length = SecTrustGetCertificateCount(trust);
-  if (chain_length == 0) {
-    return {.trusted = false, .hasCustomRoot = false};
-  }
-
-  bool has_custom_root = false;
-  id root = (id)SecTrustGetCertificateAtIndex(trust, chain_length - 1);
-  for (id custom_root in custom_roots) {
-    if ([custom_root isEqual:root]) {
-      has_custom_root = true;
-      break;
-    }
-  }
-  if (!trusted || !has_custom_root) {
-    return {.trusted = trusted, .hasCustomRoot = has_custom_root};
-  }
-  assert(has_custom_root);
-  if (chain_length < 2) {
-    return {.trusted = false, .hasCustomRoot = true};
-  }
+  const CustomRoots& custom_roots =
+      std::visit(CustomRootsVisitor(), custom_roots_);
 
+  // Until it is evaluated, the trust holds the chain as presented. That chain
+  // is prepared while SecTrust evaluates it.
   CFDataRef leaf = GetCert(trust, 0);
-  CFDataRef issuer = GetCert(trust, 1);
+  CFDataRef issuer =
+      SecTrustGetCertificateCount(trust) > 1 ? GetCert(trust, 1) : nullptr;
+  SecTrustChainEvaluator evaluator(trust, &custom_roots);
   uint64_t now = [[NSDate date] timeIntervalSince1970] * 1000;
-  trusted =
-      std::visit(VerifyVisitor {ToView(leaf), ToView(issuer), now}, verifier_);
+  auto* verifier = &verifier_;
+  auto& single_flight = single_flight_;
+  const ct::PipelineVerdict verdict = pipeline_->Verify(
+      &evaluator, ToView(leaf), ToView(issuer),
+      [verifier, &single_flight, now](const ct::PreparedChain& chain) {
+        return single_flight.Verify(chain.chain, [verifier, &chain, now] {
+          return std::visit(VerifyPreparedVisitor {chain, now}, *verifier);
+        });
+      });
   if (issuer) {
     CFRelease(issuer);
   }
   if (leaf) {
     CFRelease(leaf);
   }
-  return {.trusted = trusted, .hasCustomRoot = true};
+  return {.trusted = verdict.trusted, .hasCustomRoot = verdict.has_custom_root};
 }
 
 @end
@@ -3,16 +3,16 @@
 #import <Foundation/Foundation.h>
 
 #include <memory>
-#include <mutex>
 #include <string_view>
 
-#include "ct_log_downloader.h"
+#include "log_list_updater.h"
 #include "multi_log_verifier.h"
 
 namespace certificate_transparency {
 
-class AutoUpdateLogVerifier
-    : public std::enable_shared_from_this<AutoUpdateLogVerifier> {
+// Runs a LogListUpdater on Apple platforms: downloads with NSURLSession,
+// schedules on the main queue and keeps its state in NSUserDefaults.
+class AutoUpdateLogVerifier {
  public:
   AutoUpdateLogVerifier(
       NSUserDefaults* user_defaults,
@@ -23,25 +23,29 @@ class AutoUpdateLogVerifier
   static std::shared_ptr<AutoUpdateLogVerifier>
   Create(NSUserDefaults* user_defaults, NSString* pref_key, NSURL* update_url);
 
+  // Returns the updater shared by every caller with the same |update_url|,
+  // creating it if there is none.
+  static std::shared_ptr<AutoUpdateLogVerifier> GetShared(
+      NSUserDefaults* user_defaults,
+      NSString* pref_key,
+      NSURL* update_url);
+
   bool Verify(
       std::string_view leaf_cert,
       std::string_view issuer_cert,
       uint64_t now);
+  bool Verify(const PreparedChain& chain, uint64_t now);
 
- private:
-  NSDictionary* GetPrefs();
-  void SetPrefs(NSDictionary* dict);
-
-  void ScheduleDownload();
-  void StartDownload();
-  void OnDownloadFinished(CTLogDownloader::DownloadResult result);
+  // Returns the verifier for the current log list. It is never modified, so
+  // callers may keep using it after the list is updated.
+  std::shared_ptr<const MultiLogVerifier> GetVerifier();
 
-  NSUserDefaults* user_defaults_;
-  NSString* pref_key_;
+  // Reads the stored list and builds its verifier now rather than on the
+  // first verification.
+  void Prewarm();
 
-  std::mutex lock_ {};
-  CTLogDownloader downloader_;
-  std::shared_ptr<MultiLogVerifier> verifier_;
+ private:
+  std::shared_ptr<LogListUpdater> updater_;
 };
 
 }  // namespace certificate_transparency
@@ -1,30 +1,29 @@
 #include "auto_update_log_verifier.h"
 
-#include <chrono>
+#include <algorithm>
 #include <optional>
 #include <string>
-#include <variant>
 #include <vector>
 
-#include "builtin_logs.h"
+#include "ct_log_downloader.h"
+#include "log_updater_registry.h"
 
 namespace certificate_transparency {
 namespace {
 
-constexpr std::chrono::duration<double> kInitialDelay = std::chrono::seconds(2);
-constexpr std::chrono::seconds kSucceedUpdateInterval = std::chrono::hours(24);
-constexpr std::chrono::seconds kFailedUpdateInterval = std::chrono::hours(1);
-
 NSString* const kNextUpdate = @"next_update";
 NSString* const kTag = @"tag";
 NSString* const kLogs = @"logs";
+NSString* const kFailures = @"failures";
+NSString* const kRevocations = @"revocations";
 
-NSDate* GetNextUpdate(NSDictionary* dict) {
+std::optional<uint64_t> GetNextUpdate(NSDictionary* dict) {
   id date = dict[kNextUpdate];
   if (date && [date isKindOfClass:[NSDate class]]) {
-    return (NSDate*)date;
+    return static_cast<uint64_t>(
+        std::max(0.0, [(NSDate*)date timeIntervalSince1970] * 1000));
   } else {
-    return nil;
+    return {};
   }
 }
 
@@ -39,7 +38,7 @@ std::optional<std::string> GetTag(NSDictionary* dict) {
   }
 }
 
-std::vector<std::string> GetLogs(NSDictionary* dict) {
+std::optional<std::vector<std::string>> GetLogs(NSDictionary* dict) {
   id logs = dict[kLogs];
   if (logs && [logs isKindOfClass:[NSArray class]]) {
     std::vector<std::string> result;
@@ -54,17 +53,105 @@ std::vector<std::string> GetLogs(NSDictionary* dict) {
     }
     return result;
   } else {
-    return GetBuiltinLogs();
+    return {};
+  }
+}
+
+std::optional<std::string> GetRevocations(NSDictionary* dict) {
+  id revocations = dict[kRevocations];
+  if (revocations && [revocations isKindOfClass:[NSData class]]) {
+    NSData* revocations_data = (NSData*)revocations;
+    return std::string(
+        reinterpret_cast<const char*>([revocations_data bytes]),
+        [revocations_data length]);
+  } else {
+    return {};
+  }
+}
+
+uint32_t GetFailures(NSDictionary* dict) {
+  id failures = dict[kFailures];
+  if (failures && [failures isKindOfClass:[NSNumber class]]) {
+    return [(NSNumber*)failures unsignedIntValue];
+  } else {
+    return 0;
   }
 }
 
-NSTimeInterval CalculateDelay(NSDate* next_update) {
-  if (!next_update) {
-    return kInitialDelay.count();
+NSData* ToNSData(const std::string& str) {
+  return [NSData dataWithBytes:reinterpret_cast<const uint8_t*>(str.data())
+                        length:str.size()];
+}
+
+// Keeps the state in the layout AutoUpdateLogVerifier has always used, so
+// updating the library does not drop the downloaded list.
+class UserDefaultsStorage : public LogListStorage {
+ public:
+  UserDefaultsStorage(NSUserDefaults* user_defaults, NSString* pref_key)
+      : user_defaults_(user_defaults), pref_key_(pref_key) {}
+
+  LogListState Load() override {
+    NSDictionary* dict = [user_defaults_ dictionaryForKey:pref_key_];
+    LogListState state;
+    if (dict) {
+      state.next_update = GetNextUpdate(dict);
+      state.tag = GetTag(dict);
+      state.logs = GetLogs(dict);
+      state.failures = GetFailures(dict);
+      state.revocations = GetRevocations(dict);
+    }
+    return state;
+  }
+
+  void Save(const LogListState& state) override {
+    NSMutableDictionary* prefs = [[NSMutableDictionary alloc] init];
+    if (state.next_update) {
+      prefs[kNextUpdate] =
+          [NSDate dateWithTimeIntervalSince1970:*state.next_update / 1000.0];
+    }
+    if (state.tag) {
+      prefs[kTag] = ToNSData(*state.tag);
+    }
+    if (state.logs) {
+      NSMutableArray* logs =
+          [[NSMutableArray alloc] initWithCapacity:state.logs->size()];
+      for (const auto& log : *state.logs) {
+        [logs addObject:ToNSData(log)];
+      }
+      prefs[kLogs] = [logs copy];
+    }
+    if (state.failures) {
+      prefs[kFailures] = @(state.failures);
+    }
+    if (state.revocations) {
+      prefs[kRevocations] = ToNSData(*state.revocations);
+    }
+    [user_defaults_ setObject:[prefs copy] forKey:pref_key_];
+  }
+
+ private:
+  NSUserDefaults* user_defaults_;
+  NSString* pref_key_;
+};
+
+class DispatchClock : public UpdaterClock {
+ public:
+  uint64_t Now() override {
+    return static_cast<uint64_t>([[NSDate date] timeIntervalSince1970] * 1000);
+  }
+
+  void PostDelayed(uint64_t delay, std::function<void()> task) override {
+    dispatch_after(
+        dispatch_walltime(nullptr, static_cast<int64_t>(delay * NSEC_PER_MSEC)),
+        dispatch_get_main_queue(), ^{
+          task();
+        });
   }
+};
 
-  NSTimeInterval interval = [next_update timeIntervalSinceDate:[NSDate date]];
-  return std::max(interval, kInitialDelay.count());
+LogUpdaterRegistry<AutoUpdateLogVerifier>& GetRegistry() {
+  static auto* registry = new LogUpdaterRegistry<AutoUpdateLogVerifier>();
+  return *registry;
 }
 
 }  // namespace
@@ -73,9 +160,10 @@ AutoUpdateLogVerifier::AutoUpdateLogVerifier(
     NSUserDefaults* user_defaults,
     NSString* pref_key,
     NSURL* update_url)
-    : user_defaults_(user_defaults),
-      pref_key_(pref_key),
-      downloader_(update_url) {}
+    : updater_(LogListUpdater::Create(
+          std::make_unique<CTLogDownloader>(update_url),
+          std::make_shared<DispatchClock>(),
+          std::make_unique<UserDefaultsStorage>(user_defaults, pref_key))) {}
 
 AutoUpdateLogVerifier::~AutoUpdateLogVerifier() = default;
 
@@ -84,106 +172,39 @@ std::shared_ptr<AutoUpdateLogVerifier> AutoUpdateLogVerifier::Create(
     NSUserDefaults* user_defaults,
     NSString* pref_key,
     NSURL* update_url) {
-  auto result = std::make_shared<AutoUpdateLogVerifier>(
+  return std::make_shared<AutoUpdateLogVerifier>(
       user_defaults, pref_key, update_url);
-  result->ScheduleDownload();
-  return result;
+}
+
+// static
+std::shared_ptr<AutoUpdateLogVerifier> AutoUpdateLogVerifier::GetShared(
+    NSUserDefaults* user_defaults,
+    NSString* pref_key,
+    NSURL* update_url) {
+  return GetRegistry().Get(
+      [[update_url absoluteString] UTF8String],
+      [user_defaults, pref_key, update_url](const std::string&) {
+        return Create(user_defaults, pref_key, update_url);
+      });
 }
 
 bool AutoUpdateLogVerifier::Verify(
     std::string_view leaf_cert,
     std::string_view issuer_cert,
     uint64_t now) {
-  auto verifier = [this] {
-    std::lock_guard guard(lock_);
-    if (!verifier_) {
-      verifier_ = std::make_shared<MultiLogVerifier>(GetLogs(GetPrefs()));
-    }
-    return verifier_;
-  }();
-  return verifier->Verify(leaf_cert, issuer_cert, now);
-}
-
-void AutoUpdateLogVerifier::ScheduleDownload() {
-  auto delay = static_cast<int64_t>(
-      CalculateDelay(GetNextUpdate(GetPrefs())) * NSEC_PER_SEC);
-  std::weak_ptr weak_this = weak_from_this();
-  dispatch_after(
-      dispatch_walltime(nullptr, delay), dispatch_get_main_queue(), ^{
-        if (auto thiz = weak_this.lock()) {
-          thiz->StartDownload();
-        }
-      });
+  return updater_->Verify(leaf_cert, issuer_cert, now);
 }
 
-NSDictionary* AutoUpdateLogVerifier::GetPrefs() {
-  NSDictionary* dict = [user_defaults_ dictionaryForKey:pref_key_];
-  return dict ? dict : @ {};
+bool AutoUpdateLogVerifier::Verify(const PreparedChain& chain, uint64_t now) {
+  return updater_->Verify(chain, now);
 }
 
-void AutoUpdateLogVerifier::SetPrefs(NSDictionary* dict) {
-  [user_defaults_ setObject:dict forKey:pref_key_];
+std::shared_ptr<const MultiLogVerifier> AutoUpdateLogVerifier::GetVerifier() {
+  return updater_->GetVerifier();
 }
 
-void AutoUpdateLogVerifier::StartDownload() {
-  std::weak_ptr weak_this = weak_from_this();
-  downloader_.Download(
-      GetTag(GetPrefs()), [weak_this](CTLogDownloader::DownloadResult result) {
-        if (auto thiz = weak_this.lock()) {
-          thiz->OnDownloadFinished(std::move(result));
-        }
-      });
-}
-
-void AutoUpdateLogVerifier::OnDownloadFinished(
-    CTLogDownloader::DownloadResult result) {
-  struct ResultVisitor {
-    bool operator()(CTLogDownloader::ErrorCode code) const {
-      prefs[kNextUpdate] =
-          [NSDate dateWithTimeIntervalSinceNow:kFailedUpdateInterval.count()];
-      return false;
-    }
-    bool operator()(CTLogDownloader::NotModified) const {
-      prefs[kNextUpdate] =
-          [NSDate dateWithTimeIntervalSinceNow:kSucceedUpdateInterval.count()];
-      return false;
-    }
-    bool operator()(CTLogDownloader::Ok& ok) const {
-      prefs[kNextUpdate] =
-          [NSDate dateWithTimeIntervalSinceNow:kSucceedUpdateInterval.count()];
-
-      if (ok.tag) {
-        prefs[kTag] = [NSData
-            dataWithBytes:reinterpret_cast<const uint8_t*>(ok.tag->data())
-                   length:ok.tag->size()];
-      } else {
-        [prefs removeObjectForKey:kTag];
-      }
-
-      NSMutableArray* logs =
-          [[NSMutableArray alloc] initWithCapacity:ok.logs.size()];
-      for (const auto& log : ok.logs) {
-        [logs addObject:[NSData dataWithBytes:reinterpret_cast<const uint8_t*>(
-                                                  log.data())
-                                       length:log.size()]];
-      }
-      prefs[kLogs] = [logs copy];
-      return true;
-    }
-
-    NSMutableDictionary* prefs;
-  };
-
-  NSMutableDictionary* prefs = [GetPrefs() mutableCopy];
-  bool invalidate_verifier = std::visit(ResultVisitor {prefs}, result);
-
-  SetPrefs([prefs copy]);
-  ScheduleDownload();
-
-  if (invalidate_verifier) {
-    std::lock_guard guard(lock_);
-    verifier_.reset();
-  }
+void AutoUpdateLogVerifier::Prewarm() {
+  updater_->Prewarm();
 }
 
 }  // namespace certificate_transparency
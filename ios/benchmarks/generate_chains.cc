@@ -0,0 +1,144 @@
+// Generates chains with SCTs and the logs that signed them, as a recording
+// for replay_benchmark and a log list it can load:
+//
+//   c++ -std=c++17 -O2 -I. -Itests -o generate_chains
+//       benchmarks/generate_chains.cc tests/chain_generator.cc *.cc -pthread
+//   ./generate_chains out [--chains N] [--distinct D] [--seed S]
+//       [--ec-logs M] [--rsa-logs M] [--issuers I] [--scts N]
+//       [--extensions E]
+//   ./replay_benchmark out.rec --logs out.json
+//
+// With --distinct, only D distinct chains are generated and repeated in
+// turn, like the popular sites of a real mix. The same options always give
+// the same files.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "chain_generator.h"
+#include "chain_recorder.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+std::string EncodeBase64(std::string_view input) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  for (size_t i = 0; i < input.size(); i += 3) {
+    uint32_t group = static_cast<uint8_t>(input[i]) << 16;
+    if (i + 1 < input.size()) {
+      group |= static_cast<uint8_t>(input[i + 1]) << 8;
+    }
+    if (i + 2 < input.size()) {
+      group |= static_cast<uint8_t>(input[i + 2]);
+    }
+    out.push_back(kAlphabet[group >> 18]);
+    out.push_back(kAlphabet[(group >> 12) & 63]);
+    out.push_back(i + 1 < input.size() ? kAlphabet[(group >> 6) & 63] : '=');
+    out.push_back(i + 2 < input.size() ? kAlphabet[group & 63] : '=');
+  }
+  return out;
+}
+
+bool WriteLogList(const std::string& path,
+                  const std::vector<std::string>& logs) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  fprintf(file, "{\"operators\": [{\"name\": \"generated\", \"logs\": [\n");
+  for (size_t i = 0; i < logs.size(); i++) {
+    fprintf(file, "  {\"key\": \"%s\"}%s\n", EncodeBase64(logs[i]).c_str(),
+            i + 1 < logs.size() ? "," : "");
+  }
+  fprintf(file, "]}]}\n");
+  return fclose(file) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* out = nullptr;
+  uint64_t chains = 1000;
+  uint64_t distinct = 0;
+  test::ChainGeneratorOptions options;
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-') {
+      out = argv[i];
+      continue;
+    }
+    if (i + 1 == argc) {
+      out = nullptr;
+      break;
+    }
+    const uint64_t value = strtoull(argv[i + 1], nullptr, 10);
+    if (!strcmp(argv[i], "--chains")) {
+      chains = value;
+    } else if (!strcmp(argv[i], "--distinct")) {
+      distinct = value;
+    } else if (!strcmp(argv[i], "--seed")) {
+      options.seed = value;
+    } else if (!strcmp(argv[i], "--ec-logs")) {
+      options.ec_logs = value;
+    } else if (!strcmp(argv[i], "--rsa-logs")) {
+      options.rsa_logs = value;
+    } else if (!strcmp(argv[i], "--issuers")) {
+      options.issuers = value ? value : 1;
+    } else if (!strcmp(argv[i], "--scts")) {
+      options.scts_per_chain = value;
+    } else if (!strcmp(argv[i], "--extensions")) {
+      options.extensions = value;
+    } else {
+      out = nullptr;
+      break;
+    }
+    i++;
+  }
+  if (!out) {
+    fprintf(stderr,
+            "usage: %s out [--chains N] [--distinct D] [--seed S] "
+            "[--ec-logs M] [--rsa-logs M] [--issuers I] [--scts N] "
+            "[--extensions E]\n",
+            argv[0]);
+    return 2;
+  }
+
+  const std::string recording_path = std::string(out) + ".rec";
+  const std::string log_list_path = std::string(out) + ".json";
+  // The recorder appends, and a recording should hold one run.
+  remove(recording_path.c_str());
+  auto recorder = ct::ChainRecorder::Open(recording_path);
+  if (!recorder) {
+    fprintf(stderr, "can't create %s\n", recording_path.c_str());
+    return 1;
+  }
+
+  const test::ChainGenerator generator(options);
+  if (!WriteLogList(log_list_path, generator.logs())) {
+    fprintf(stderr, "can't write %s\n", log_list_path.c_str());
+    return 1;
+  }
+  // Verified just after the SCTs were issued.
+  const uint64_t now = options.sct_timestamp + 1000;
+  std::vector<test::GeneratedChain> repeated;
+  for (uint64_t i = 0; i < distinct && i < chains; i++) {
+    repeated.push_back(generator.Generate(i));
+  }
+  for (uint64_t i = 0; i < chains; i++) {
+    const test::GeneratedChain chain = repeated.empty()
+                                           ? generator.Generate(i)
+                                           : repeated[i % repeated.size()];
+    recorder->Record(chain.leaf_cert, chain.issuer_cert, now);
+  }
+  printf("%s: %llu chains, %s: %zu logs\n", recording_path.c_str(),
+         static_cast<unsigned long long>(recorder->recorded()),
+         log_list_path.c_str(), generator.logs().size());
+  return 0;
+}
@@ -0,0 +1,92 @@
+// Measures log key import and signature verification of the portable
+// backend:
+//
+//   c++ -std=c++17 -O2 -I. -Itests -o log_verifier_benchmark
+//       benchmarks/log_verifier_benchmark.cc tests/test_*_data.cc *.cc
+//
+// kLogList only holds EC logs today, so RSA verification runs against the
+// 2048 and 4096-bit test keys. RSA logs added to kLogList are picked up by
+// the import measurement automatically.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "log_verifier.h"
+#include "multi_log_verifier.h"
+#include "public_key.h"
+#include "test_certs_data.h"
+#include "test_keys_data.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+template <typename F>
+void Run(const char* name, int iterations, F&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  int ok = 0;
+  for (int i = 0; i < iterations; i++) {
+    ok += f() ? 1 : 0;
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  printf("%-32s %8d iterations %10.2f us/op %s\n", name, iterations,
+         elapsed.count() / iterations, ok == iterations ? "" : "(FAILED)");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 1000;
+
+  std::vector<std::string> rsa_logs;
+  std::vector<std::string> ec_logs;
+  for (auto& log : ct::GetBuiltinLogs()) {
+    const auto key = ct::PublicKey::Parse(log);
+    if (!key.IsValid()) {
+      continue;
+    }
+    (key.type() == ct::PublicKey::kRSA ? rsa_logs : ec_logs)
+        .push_back(std::move(log));
+  }
+  printf("kLogList: %zu EC logs, %zu RSA logs\n", ec_logs.size(),
+         rsa_logs.size());
+
+  for (const auto& log : ec_logs) {
+    Run("import EC log", iterations / 10 + 1,
+        [&] { return ct::PublicKey::Parse(log).IsValid(); });
+  }
+  for (const auto& log : rsa_logs) {
+    Run("import RSA log", iterations / 10 + 1,
+        [&] { return ct::PublicKey::Parse(log).IsValid(); });
+  }
+  Run("import RSA-2048 test log", iterations / 10 + 1,
+      [&] { return ct::PublicKey::Parse(test::RSA2048Key()).IsValid(); });
+  Run("import RSA-4096 test log", iterations / 10 + 1,
+      [&] { return ct::PublicKey::Parse(test::RSA4096Key()).IsValid(); });
+
+  const auto rsa2048 = ct::PublicKey::Parse(test::RSA2048Key());
+  Run("verify RSA-2048", iterations, [&] {
+    return rsa2048.VerifySignature(test::SignedMessage(),
+                                   test::RSA2048Signature());
+  });
+  const auto rsa4096 = ct::PublicKey::Parse(test::RSA4096Key());
+  Run("verify RSA-4096", iterations, [&] {
+    return rsa4096.VerifySignature(test::SignedMessage(),
+                                   test::RSA4096Signature());
+  });
+
+  const ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  Run("verify chain (EC logs)", iterations, [&] {
+    return verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                           std::numeric_limits<uint64_t>::max());
+  });
+  return 0;
+}
@@ -0,0 +1,138 @@
+// Measures the latency of verifying a chain with trust evaluation and SCT
+// checks run back to back, and with VerificationPipeline overlapping them:
+//
+//   c++ -std=c++17 -O2 -I. -Itests -o pipeline_benchmark
+//       benchmarks/pipeline_benchmark.cc tests/test_*_data.cc *.cc -pthread
+//   ./pipeline_benchmark [iterations] [evaluation latency in us]
+//
+// Trust evaluation is simulated by PresentedChainEvaluator, which sleeps for
+// the given latency; SecTrust spends most of its time waiting on trustd. The
+// gain is bounded by the time it takes to prepare the chain, reported first.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "multi_log_verifier.h"
+#include "presented_chain_evaluator.h"
+#include "root_index.h"
+#include "test_certs_data.h"
+#include "verification_pipeline.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+// Runs tasks in order on one thread, like a dispatch queue.
+class Worker {
+ public:
+  Worker() : thread_([this] { Loop(); }) {}
+  ~Worker() {
+    Post(nullptr);
+    thread_.join();
+  }
+
+  void Post(ct::VerificationPipeline::Task task) {
+    {
+      std::lock_guard guard(lock_);
+      tasks_.push_back(std::move(task));
+    }
+    posted_.notify_one();
+  }
+
+ private:
+  void Loop() {
+    while (true) {
+      ct::VerificationPipeline::Task task;
+      {
+        std::unique_lock guard(lock_);
+        posted_.wait(guard, [this] { return !tasks_.empty(); });
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      if (!task) {
+        return;
+      }
+      task();
+    }
+  }
+
+  std::mutex lock_;
+  std::condition_variable posted_;
+  std::deque<ct::VerificationPipeline::Task> tasks_;
+  std::thread thread_;
+};
+
+template <typename F>
+void Run(const char* name, int iterations, F&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  int ok = 0;
+  for (int i = 0; i < iterations; i++) {
+    ok += f() ? 1 : 0;
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  printf("%-32s %8d iterations %10.2f us/op %s\n", name, iterations,
+         elapsed.count() / iterations, ok == iterations ? "" : "(FAILED)");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 1000;
+  const std::chrono::microseconds latency(argc > 2 ? atoi(argv[2]) : 1000);
+
+  const ct::MultiLogVerifier& verifier = ct::GetBuiltinLogVerifier();
+  ct::RootIndex roots;
+  roots.Add(test::RootCA());
+  const std::vector<std::string_view> chain = {
+      test::ValidTimestampsLeaf(), test::SubRootCA(), test::RootCA()};
+
+  Run("prepare chain", iterations, [&] {
+    ct::PreparedChain prepared;
+    ct::PrepareChain(chain[0], chain[1], verifier.limits(), &prepared);
+    return prepared.valid;
+  });
+  Run("verify prepared chain", iterations, [&] {
+    ct::PreparedChain prepared;
+    ct::PrepareChain(chain[0], chain[1], verifier.limits(), &prepared);
+    return verifier.Verify(prepared, kFarFuture);
+  });
+
+  printf("evaluation latency %lld us\n",
+         static_cast<long long>(latency.count()));
+  Run("sequential", iterations, [&] {
+    ct::PresentedChainEvaluator evaluator(chain, &roots, latency);
+    const ct::ChainEvaluation evaluation = evaluator.Evaluate();
+    return evaluation.trusted && evaluation.has_custom_root &&
+           verifier.Verify(evaluation.leaf_cert, evaluation.issuer_cert,
+                           kFarFuture);
+  });
+
+  Worker worker;
+  ct::VerificationPipeline pipeline(
+      verifier.limits(), [&worker](ct::VerificationPipeline::Task task) {
+        worker.Post(std::move(task));
+      });
+  Run("pipelined", iterations, [&] {
+    ct::PresentedChainEvaluator evaluator(chain, &roots, latency);
+    return pipeline
+        .Verify(&evaluator, chain[0], chain[1],
+                [&](const ct::PreparedChain& prepared) {
+                  return verifier.Verify(prepared, kFarFuture);
+                })
+        .trusted;
+  });
+  return 0;
+}
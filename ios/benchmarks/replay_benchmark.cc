@@ -0,0 +1,199 @@
+// Replays chains recorded by ChainRecorder against MultiLogVerifier and
+// reports throughput and latency percentiles:
+//
+//   c++ -std=c++17 -O2 -I. -o replay_benchmark benchmarks/replay_benchmark.cc
+//       *.cc -pthread
+//   ./replay_benchmark recording [--threads N] [--rate R] [--repeat K]
+//       [--logs log_list.json] [--max-p99-us X] [--min-throughput Y]
+//
+// Each chain is verified at the time it was recorded at, with the builtin
+// logs or the log list given. Without --rate the threads verify back to
+// back. With --rate, chains arrive at R per second whether or not the
+// threads keep up, and latency counts from the arrival, so queueing shows
+// up in the percentiles. With --max-p99-us or --min-throughput the program
+// exits with 1 when the run misses them, to gate releases on a recording.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chain_recorder.h"
+#include "log_list_parser.h"
+#include "multi_log_verifier.h"
+
+namespace ct = certificate_transparency;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  const char* recording = nullptr;
+  int threads = 1;
+  double rate = 0;
+  int repeat = 1;
+  const char* logs = nullptr;
+  double max_p99_us = 0;
+  double min_throughput = 0;
+};
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; i++) {
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (argv[i][0] != '-') {
+      options->recording = argv[i];
+      continue;
+    }
+    if (!value) {
+      return false;
+    }
+    if (!strcmp(argv[i], "--threads")) {
+      options->threads = std::max(1, atoi(value));
+    } else if (!strcmp(argv[i], "--rate")) {
+      options->rate = atof(value);
+    } else if (!strcmp(argv[i], "--repeat")) {
+      options->repeat = std::max(1, atoi(value));
+    } else if (!strcmp(argv[i], "--logs")) {
+      options->logs = value;
+    } else if (!strcmp(argv[i], "--max-p99-us")) {
+      options->max_p99_us = atof(value);
+    } else if (!strcmp(argv[i], "--min-throughput")) {
+      options->min_throughput = atof(value);
+    } else {
+      return false;
+    }
+    i++;
+  }
+  return options->recording != nullptr;
+}
+
+std::optional<std::string> ReadFile(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    return std::nullopt;
+  }
+  std::string contents;
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.append(buffer, n);
+  }
+  fclose(file);
+  return contents;
+}
+
+// Returns the |percentile| of sorted |latencies|, rounding up.
+double Percentile(const std::vector<double>& latencies, double percentile) {
+  const size_t rank =
+      static_cast<size_t>(std::ceil(percentile / 100 * latencies.size()));
+  return latencies[std::min(std::max<size_t>(rank, 1), latencies.size()) - 1];
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "usage: %s recording [--threads N] [--rate R] [--repeat K] "
+            "[--logs log_list.json] [--max-p99-us X] [--min-throughput Y]\n",
+            argv[0]);
+    return 2;
+  }
+
+  const auto chains = ct::ReadChainRecording(options.recording);
+  if (!chains || chains->empty()) {
+    fprintf(stderr, "no chains in %s\n", options.recording);
+    return 2;
+  }
+  std::unique_ptr<ct::MultiLogVerifier> custom_verifier;
+  if (options.logs) {
+    const auto json = ReadFile(options.logs);
+    const auto logs = json ? ct::ParseLogList(*json) : std::nullopt;
+    if (!logs) {
+      fprintf(stderr, "can't parse %s\n", options.logs);
+      return 2;
+    }
+    custom_verifier = std::make_unique<ct::MultiLogVerifier>(*logs);
+  }
+  const ct::MultiLogVerifier& verifier =
+      custom_verifier ? *custom_verifier : ct::GetBuiltinLogVerifier();
+
+  const size_t total = chains->size() * options.repeat;
+  std::vector<std::vector<double>> latencies(options.threads);
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> verified{0};
+  const Clock::time_point start = Clock::now();
+  const std::chrono::duration<double> interval(
+      options.rate > 0 ? 1 / options.rate : 0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < options.threads; t++) {
+    threads.emplace_back([&, t] {
+      latencies[t].reserve(total / options.threads + 1);
+      size_t i;
+      while ((i = next.fetch_add(1, std::memory_order_relaxed)) < total) {
+        const ct::RecordedChain& chain = (*chains)[i % chains->size()];
+        Clock::time_point arrival = Clock::now();
+        if (options.rate > 0) {
+          arrival = start + std::chrono::duration_cast<Clock::duration>(
+                                interval * static_cast<double>(i));
+          std::this_thread::sleep_until(arrival);
+        }
+        if (verifier.Verify(chain.leaf_cert, chain.issuer_cert,
+                            chain.timestamp)) {
+          verified.fetch_add(1, std::memory_order_relaxed);
+        }
+        latencies[t].push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - arrival)
+                .count());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+  std::vector<double> all;
+  all.reserve(total);
+  for (const auto& thread_latencies : latencies) {
+    all.insert(all.end(), thread_latencies.begin(), thread_latencies.end());
+  }
+  std::sort(all.begin(), all.end());
+  const double throughput = total / elapsed.count();
+  const double p99 = Percentile(all, 99);
+
+  printf("%zu chains recorded, %zu verifications, %zu verified\n",
+         chains->size(), total, verified.load());
+  if (options.rate > 0) {
+    printf("threads %d, %.1f chains/s arriving\n", options.threads,
+           options.rate);
+  } else {
+    printf("threads %d, back to back\n", options.threads);
+  }
+  printf("throughput %.1f chains/s\n", throughput);
+  printf("latency us: p50 %.1f p99 %.1f p999 %.1f max %.1f\n",
+         Percentile(all, 50), p99, Percentile(all, 99.9), all.back());
+
+  bool passed = true;
+  if (options.max_p99_us > 0 && p99 > options.max_p99_us) {
+    printf("FAILED: p99 above %.1f us\n", options.max_p99_us);
+    passed = false;
+  }
+  if (options.min_throughput > 0 && throughput < options.min_throughput) {
+    printf("FAILED: throughput below %.1f chains/s\n",
+           options.min_throughput);
+    passed = false;
+  }
+  return passed ? 0 : 1;
+}
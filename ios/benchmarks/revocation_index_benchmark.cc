@@ -0,0 +1,153 @@
+// Measures the size of a RevocationIndex and the cost of its lookups:
+//
+//   c++ -std=c++17 -O2 -I. -Itests -o revocation_index_benchmark
+//       benchmarks/revocation_index_benchmark.cc tests/test_*_data.cc *.cc
+//   ./revocation_index_benchmark [--revoked N] [--issuers M] [--lookups K]
+//
+// N random 16 byte serial numbers are revoked by M issuers, about the size
+// of the CRLs of the public web PKI. Serial numbers that are not revoked
+// mostly stop at the Bloom filter, while revoked ones are searched for. A
+// chain is checked from its certificates or from its prepared entry.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ct_objects_extractor.h"
+#include "multi_log_verifier.h"
+#include "revocation_index.h"
+#include "test_certs_data.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  size_t revoked = 1000000;
+  size_t issuers = 200;
+  int lookups = 1000000;
+};
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; i++) {
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!value) {
+      return false;
+    }
+    if (!strcmp(argv[i], "--revoked")) {
+      options->revoked = std::max(1, atoi(value));
+    } else if (!strcmp(argv[i], "--issuers")) {
+      options->issuers = std::max(1, atoi(value));
+    } else if (!strcmp(argv[i], "--lookups")) {
+      options->lookups = std::max(1, atoi(value));
+    } else {
+      return false;
+    }
+    i++;
+  }
+  return true;
+}
+
+std::string RandomSerial(std::mt19937_64* random) {
+  std::string serial(16, '\0');
+  for (size_t i = 0; i < serial.size(); i += 8) {
+    const uint64_t bits = (*random)();
+    memcpy(&serial[i], &bits, 8);
+  }
+  // Positive and minimally encoded, as in certificates.
+  serial[0] = static_cast<char>((serial[0] & 0x7f) | 0x01);
+  return serial;
+}
+
+// Runs |f| |iterations| times, prints the time per call and returns how many
+// calls returned true.
+template <typename F>
+int Run(const char* name, int iterations, F&& f) {
+  const Clock::time_point start = Clock::now();
+  int found = 0;
+  for (int i = 0; i < iterations; i++) {
+    found += f(i) ? 1 : 0;
+  }
+  const std::chrono::duration<double, std::nano> elapsed =
+      Clock::now() - start;
+  printf("%-34s %10.1f ns/op\n", name, elapsed.count() / iterations);
+  return found;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "usage: %s [--revoked N] [--issuers M] [--lookups K]\n",
+            argv[0]);
+    return 2;
+  }
+
+  std::mt19937_64 random(1);
+  std::vector<ct::RevokedCertificate> revoked(options.revoked);
+  for (size_t i = 0; i < revoked.size(); i++) {
+    const size_t issuer = i % options.issuers;
+    revoked[i].issuer_key_hash.fill(0);
+    for (size_t j = 0; j < sizeof(uint32_t); j++) {
+      revoked[i].issuer_key_hash[31 - j] =
+          static_cast<uint8_t>(issuer >> 8 * j);
+    }
+    revoked[i].serial = RandomSerial(&random);
+  }
+
+  const Clock::time_point build_start = Clock::now();
+  const auto data = ct::RevocationIndex::Build(revoked);
+  const std::chrono::duration<double, std::milli> build_time =
+      Clock::now() - build_start;
+  auto index = data ? ct::RevocationIndex::Parse(*data) : nullptr;
+  if (!index) {
+    fprintf(stderr, "can't build the index\n");
+    return 1;
+  }
+  printf("%zu revoked by %zu issuers: %zu bytes, %.1f per serial, built in "
+         "%.0f ms\n",
+         index->size(), options.issuers, data->size(),
+         static_cast<double>(data->size()) / index->size(),
+         build_time.count());
+
+  std::vector<std::string> unrevoked(std::min(options.lookups, 1 << 16));
+  for (auto& serial : unrevoked) {
+    serial = RandomSerial(&random);
+  }
+  const int unrevoked_found =
+      Run("unrevoked serial", options.lookups, [&](int i) {
+        const auto& cert = revoked[i % revoked.size()];
+        return index->IsRevoked(cert.issuer_key_hash,
+                                unrevoked[i % unrevoked.size()]);
+      });
+  const int found = Run("revoked serial", options.lookups, [&](int i) {
+    const auto& cert = revoked[(i * 7919u) % revoked.size()];
+    return index->IsRevoked(cert.issuer_key_hash, cert.serial);
+  });
+  Run("unrevoked chain", options.lookups, [&](int) {
+    return index->IsRevoked(test::ValidTimestampsLeaf(), test::SubRootCA());
+  });
+  ct::PreparedChain prepared;
+  ct::PrepareChain(test::ValidTimestampsLeaf(), test::SubRootCA(), {},
+                   &prepared);
+  Run("unrevoked prepared chain", options.lookups,
+      [&](int) { return index->IsRevoked(prepared.entry); });
+
+  if (found != options.lookups || unrevoked_found != 0) {
+    printf("FAILED: %d of %d revoked serials found, %d unrevoked ones\n",
+           found, options.lookups, unrevoked_found);
+    return 1;
+  }
+  return 0;
+}
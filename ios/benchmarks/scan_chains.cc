@@ -0,0 +1,288 @@
+// Scans PEM bundles and DER files for chains, verifies them against
+// MultiLogVerifier and reports what it found:
+//
+//   c++ -std=c++17 -O2 -I. -o scan_chains benchmarks/scan_chains.cc *.cc
+//       -pthread
+//   ./scan_chains path... [--threads N] [--logs log_list.json]
+//       [--time MS] [--range-mb M] [--parse-only]
+//
+// Paths are files or directories, which are walked recursively. Files are
+// mapped rather than read, and bundles larger than --range-mb are split so
+// that their ranges are scanned by all the threads. Each thread decodes PEM
+// into its own arena, reused from one range to the next. Chains are verified
+// at --time, in milliseconds since the epoch, or now, with the builtin logs
+// or the log list given. --parse-only stops after finding the chains, to
+// measure ingestion alone.
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "certificate_bundle.h"
+#include "log_list_parser.h"
+#include "multi_log_verifier.h"
+
+namespace ct = certificate_transparency;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::vector<const char*> paths;
+  int threads = static_cast<int>(std::thread::hardware_concurrency());
+  const char* logs = nullptr;
+  uint64_t time = 0;
+  size_t range_size = 16 << 20;
+  bool parse_only = false;
+};
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; i++) {
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (argv[i][0] != '-') {
+      options->paths.push_back(argv[i]);
+      continue;
+    }
+    if (!strcmp(argv[i], "--parse-only")) {
+      options->parse_only = true;
+      continue;
+    }
+    if (!value) {
+      return false;
+    }
+    if (!strcmp(argv[i], "--threads")) {
+      options->threads = atoi(value);
+    } else if (!strcmp(argv[i], "--logs")) {
+      options->logs = value;
+    } else if (!strcmp(argv[i], "--time")) {
+      options->time = strtoull(value, nullptr, 10);
+    } else if (!strcmp(argv[i], "--range-mb")) {
+      options->range_size = static_cast<size_t>(atof(value) * (1 << 20));
+    } else {
+      return false;
+    }
+    i++;
+  }
+  options->threads = std::max(1, options->threads);
+  options->range_size = std::max<size_t>(options->range_size, 4096);
+  return !options->paths.empty();
+}
+
+std::optional<std::string> ReadFile(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    return std::nullopt;
+  }
+  std::string contents;
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.append(buffer, n);
+  }
+  fclose(file);
+  return contents;
+}
+
+struct InputFile {
+  std::string path;
+  size_t size;
+};
+
+// Appends the regular files at or below |path| to |files|. Returns false if
+// |path| does not exist.
+bool ListFiles(const std::string& path, std::vector<InputFile>* files) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    return false;
+  }
+  if (S_ISREG(st.st_mode)) {
+    files->push_back({path, static_cast<size_t>(st.st_size)});
+    return true;
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    return true;
+  }
+  DIR* dir = opendir(path.c_str());
+  if (!dir) {
+    return false;
+  }
+  std::vector<std::string> entries;
+  while (const dirent* entry = readdir(dir)) {
+    if (strcmp(entry->d_name, ".") && strcmp(entry->d_name, "..")) {
+      entries.push_back(path + "/" + entry->d_name);
+    }
+  }
+  closedir(dir);
+  // Walk in a stable order, so that runs are comparable.
+  std::sort(entries.begin(), entries.end());
+  for (const std::string& entry : entries) {
+    ListFiles(entry, files);
+  }
+  return true;
+}
+
+// A range of a file to scan. Small files are mapped by the thread that
+// scans them; large ones are mapped once up front and shared by their
+// ranges.
+struct WorkItem {
+  const InputFile* file;
+  std::shared_ptr<ct::MappedFile> mapped;
+  size_t begin;
+  size_t end;
+};
+
+struct Stats {
+  size_t certificates = 0;
+  size_t chains = 0;
+  size_t verified = 0;
+  size_t unverified = 0;
+  size_t no_issuer = 0;
+  size_t malformed = 0;
+  size_t unreadable = 0;
+
+  void Add(const Stats& other) {
+    certificates += other.certificates;
+    chains += other.chains;
+    verified += other.verified;
+    unverified += other.unverified;
+    no_issuer += other.no_issuer;
+    malformed += other.malformed;
+    unreadable += other.unreadable;
+  }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "usage: %s path... [--threads N] [--logs log_list.json] "
+            "[--time MS] [--range-mb M] [--parse-only]\n",
+            argv[0]);
+    return 2;
+  }
+
+  std::unique_ptr<ct::MultiLogVerifier> custom_verifier;
+  if (options.logs) {
+    const auto json = ReadFile(options.logs);
+    const auto logs = json ? ct::ParseLogList(*json) : std::nullopt;
+    if (!logs) {
+      fprintf(stderr, "can't parse %s\n", options.logs);
+      return 2;
+    }
+    custom_verifier = std::make_unique<ct::MultiLogVerifier>(*logs);
+  }
+  const ct::MultiLogVerifier& verifier =
+      custom_verifier ? *custom_verifier : ct::GetBuiltinLogVerifier();
+  const uint64_t now =
+      options.time ? options.time
+                   : std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+
+  const Clock::time_point start = Clock::now();
+  std::vector<InputFile> files;
+  for (const char* path : options.paths) {
+    if (!ListFiles(path, &files)) {
+      fprintf(stderr, "can't read %s\n", path);
+      return 2;
+    }
+  }
+
+  Stats total;
+  size_t bytes = 0;
+  std::vector<WorkItem> items;
+  for (const InputFile& file : files) {
+    bytes += file.size;
+    if (file.size <= options.range_size) {
+      items.push_back({&file, nullptr, 0, file.size});
+      continue;
+    }
+    std::shared_ptr<ct::MappedFile> mapped = ct::MappedFile::Open(file.path);
+    if (!mapped) {
+      total.unreadable++;
+      continue;
+    }
+    for (const auto& range :
+         ct::SplitBundle(mapped->contents(), options.range_size)) {
+      items.push_back({&file, mapped, range.first, range.second});
+    }
+  }
+
+  std::vector<Stats> stats(options.threads);
+  std::atomic<size_t> next{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < options.threads; t++) {
+    threads.emplace_back([&, t] {
+      ct::CertificateArena arena;
+      std::vector<ct::BundleChain> chains;
+      Stats& thread_stats = stats[t];
+      size_t i;
+      while ((i = next.fetch_add(1, std::memory_order_relaxed)) <
+             items.size()) {
+        const WorkItem& item = items[i];
+        std::shared_ptr<ct::MappedFile> mapped = item.mapped;
+        if (!mapped) {
+          mapped = ct::MappedFile::Open(item.file->path);
+          if (!mapped) {
+            thread_stats.unreadable++;
+            continue;
+          }
+        }
+        arena.Reset();
+        chains.clear();
+        thread_stats.malformed += ct::ScanBundle(
+            mapped->contents(), item.begin, item.end, &arena, &chains);
+        thread_stats.chains += chains.size();
+        for (const ct::BundleChain& chain : chains) {
+          thread_stats.certificates += chain.issuer.empty() ? 1 : 2;
+          if (chain.issuer.empty()) {
+            thread_stats.no_issuer++;
+          } else if (options.parse_only) {
+            continue;
+          } else if (verifier.Verify(chain.leaf, chain.issuer, now)) {
+            thread_stats.verified++;
+          } else {
+            thread_stats.unverified++;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+  for (const Stats& thread_stats : stats) {
+    total.Add(thread_stats);
+  }
+
+  printf("%zu files, %.1f MB, %zu ranges, threads %d\n", files.size(),
+         bytes / 1e6, items.size(), options.threads);
+  printf("%zu chains, %zu leaf and issuer certificates\n", total.chains,
+         total.certificates);
+  if (options.parse_only) {
+    printf("not verified (--parse-only)\n");
+  } else {
+    printf("verified %zu, not verified %zu\n", total.verified,
+           total.unverified);
+  }
+  printf("no issuer %zu, malformed certificates %zu, unreadable files %zu\n",
+         total.no_issuer, total.malformed, total.unreadable);
+  printf("%.3f s, %.1f MB/s, %.1f chains/s\n", elapsed.count(),
+         bytes / 1e6 / elapsed.count(), total.chains / elapsed.count());
+  return 0;
+}
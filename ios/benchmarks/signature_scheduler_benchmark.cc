@@ -0,0 +1,166 @@
+// Measures the throughput and latency of concurrent verifications with their
+// signature checks run on the calling threads and batched by
+// SignatureScheduler, for a range of batch windows:
+//
+//   c++ -std=c++17 -O2 -I. -Itests -o signature_scheduler_benchmark
+//       benchmarks/signature_scheduler_benchmark.cc tests/test_*_data.cc
+//       *.cc -pthread
+//   ./signature_scheduler_benchmark [--threads N] [--workers W] [--batch B]
+//       [--windows 0,50,200] [--verifications K]
+//
+// N threads each verify the same chain K times back to back. The batched
+// runs check the signatures on W workers in batches of at most B. Wider
+// windows make fuller batches, reported as the mean batch size, at the cost
+// of latency.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "multi_log_verifier.h"
+#include "signature_scheduler.h"
+#include "test_certs_data.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+struct Options {
+  int threads = 8;
+  size_t workers = 1;
+  size_t batch = 16;
+  std::vector<uint64_t> windows = {0, 25, 50, 100, 200, 500};
+  int verifications = 200;
+};
+
+bool ParseOptions(int argc, char** argv, Options* options) {
+  for (int i = 1; i < argc; i++) {
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!value) {
+      return false;
+    }
+    if (!strcmp(argv[i], "--threads")) {
+      options->threads = std::max(1, atoi(value));
+    } else if (!strcmp(argv[i], "--workers")) {
+      options->workers = std::max(1, atoi(value));
+    } else if (!strcmp(argv[i], "--batch")) {
+      options->batch = std::max(1, atoi(value));
+    } else if (!strcmp(argv[i], "--windows")) {
+      options->windows.clear();
+      for (const char* p = value; *p;) {
+        char* end;
+        options->windows.push_back(strtoull(p, &end, 10));
+        if (end == p || (*end && *end != ',')) {
+          return false;
+        }
+        p = *end ? end + 1 : end;
+      }
+    } else if (!strcmp(argv[i], "--verifications")) {
+      options->verifications = std::max(1, atoi(value));
+    } else {
+      return false;
+    }
+    i++;
+  }
+  return true;
+}
+
+// Returns the |percentile| of sorted |latencies|, rounding up.
+double Percentile(const std::vector<double>& latencies, double percentile) {
+  const size_t rank =
+      static_cast<size_t>(std::ceil(percentile / 100 * latencies.size()));
+  return latencies[std::min(std::max<size_t>(rank, 1), latencies.size()) - 1];
+}
+
+// Verifies from |options.threads| threads and prints a row of results.
+void Run(const char* name,
+         const Options& options,
+         std::shared_ptr<ct::SignatureScheduler> scheduler) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  if (scheduler) {
+    verifier.SetSignatureScheduler(scheduler);
+  }
+  std::vector<std::vector<double>> latencies(options.threads);
+  std::atomic<int> verified{0};
+  const Clock::time_point start = Clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < options.threads; t++) {
+    threads.emplace_back([&, t] {
+      latencies[t].reserve(options.verifications);
+      for (int i = 0; i < options.verifications; i++) {
+        const Clock::time_point begin = Clock::now();
+        verified += verifier.Verify(test::ValidTimestampsLeaf(),
+                                    test::SubRootCA(), kFarFuture);
+        latencies[t].push_back(
+            std::chrono::duration<double, std::micro>(Clock::now() - begin)
+                .count());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+  std::vector<double> all;
+  for (const auto& thread_latencies : latencies) {
+    all.insert(all.end(), thread_latencies.begin(), thread_latencies.end());
+  }
+  std::sort(all.begin(), all.end());
+  double mean_batch = 0;
+  if (scheduler) {
+    const auto stats = scheduler->stats();
+    mean_batch = stats.batches ? static_cast<double>(stats.checks) /
+                                     static_cast<double>(stats.batches)
+                               : 0;
+  }
+  printf("%-18s %12.1f %10.1f %10.1f %10.1f %8.2f%s\n", name,
+         all.size() / elapsed.count(), Percentile(all, 50),
+         Percentile(all, 99), all.back(), mean_batch,
+         verified == static_cast<int>(all.size()) ? "" : " FAILED");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, &options)) {
+    fprintf(stderr,
+            "usage: %s [--threads N] [--workers W] [--batch B] "
+            "[--windows 0,50,200] [--verifications K]\n",
+            argv[0]);
+    return 2;
+  }
+
+  printf("%d threads x %d verifications, %zu workers, batches of %zu\n",
+         options.threads, options.verifications, options.workers,
+         options.batch);
+  printf("%-18s %12s %10s %10s %10s %8s\n", "", "chains/s", "p50 us",
+         "p99 us", "max us", "batch");
+  Run("calling threads", options, nullptr);
+  for (uint64_t window : options.windows) {
+    char name[32];
+    snprintf(name, sizeof(name), "window %llu us",
+             static_cast<unsigned long long>(window));
+    Run(name, options,
+        std::make_shared<ct::SignatureScheduler>(
+            ct::SignatureScheduler::Options{options.workers, options.batch,
+                                            window}));
+  }
+  return 0;
+}
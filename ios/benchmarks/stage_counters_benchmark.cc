@@ -0,0 +1,345 @@
+// Reads hardware counters around each stage of a verification, to tell
+// whether a stage is bound by branch mispredictions, cache misses or
+// arithmetic:
+//
+//   c++ -std=c++17 -O2 -DCERTIFICATE_TRANSPARENCY_METRICS -I. -Itests
+//       -o stage_counters_benchmark benchmarks/stage_counters_benchmark.cc
+//       tests/test_*_data.cc *.cc -pthread
+//   ./stage_counters_benchmark [iterations] [leaf.der issuer.der]...
+//
+// The corpus is the test chains, or the DER encoded chains given. Counters
+// come from perf_event_open(2) on Linux and count user space only, which
+// perf_event_paranoid up to 2 allows. Counters the CPU or hypervisor does
+// not provide are reported as n/a; without any, only time is reported.
+// kVerify encloses the other stages, and reading the counters around the
+// inner stages adds to it despite the calibration.
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "metrics.h"
+#include "multi_log_verifier.h"
+#include "test_certs_data.h"
+
+#if !defined(CERTIFICATE_TRANSPARENCY_METRICS)
+#error "Build with -DCERTIFICATE_TRANSPARENCY_METRICS to observe stages."
+#endif
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+enum Counter {
+  kCycles,
+  kInstructions,
+  kBranchMisses,
+  kL1DMisses,
+  kLLCMisses,
+  kCounterCount,
+};
+
+const char* const kCounterNames[kCounterCount] = {
+    "cycles", "instructions", "branch-misses", "L1D-misses", "LLC-misses",
+};
+
+const char* const kStageNames[ct::kMetricsStageCount] = {
+    "extract_sct_list", "rebuild_tbs",     "decode_scts",
+    "lookup_log",       "check_signature", "verify",
+};
+
+struct Reading {
+  uint64_t counters[kCounterCount] = {};
+  uint64_t time_ns = 0;
+};
+
+// The counters of the calling thread, read together as one perf group.
+class CounterGroup {
+ public:
+  CounterGroup() {
+#if defined(__linux__)
+    const std::pair<uint32_t, uint64_t> kEvents[kCounterCount] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                 (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+                                 (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    };
+    for (int i = 0; i < kCounterCount; i++) {
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = kEvents[i].first;
+      attr.config = kEvents[i].second;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                         PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.disabled = leader_ < 0;
+      const int fd = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, leader_, 0));
+      if (fd < 0) {
+        // Unsupported events fail alone; the group goes on without them.
+        continue;
+      }
+      if (leader_ < 0) {
+        leader_ = fd;
+      }
+      fds_.push_back(fd);
+      slots_.push_back(i);
+    }
+    if (leader_ >= 0) {
+      ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  ~CounterGroup() {
+    for (int fd : fds_) {
+      close(fd);
+    }
+  }
+
+  CounterGroup(const CounterGroup&) = delete;
+  CounterGroup& operator=(const CounterGroup&) = delete;
+
+  bool available(int counter) const {
+    for (int slot : slots_) {
+      if (slot == counter) {
+        return true;
+      }
+    }
+    return false;
+  }
+  bool any_available() const { return !slots_.empty(); }
+  // Whether the kernel had to share the counters with other users, which
+  // makes the numbers estimates.
+  bool multiplexed() const { return multiplexed_; }
+
+  void Read(Reading* reading) {
+#if defined(__linux__)
+    if (leader_ >= 0) {
+      // nr, time_enabled, time_running, then one value per event.
+      uint64_t values[3 + kCounterCount];
+      const ssize_t size =
+          read(leader_, values, (3 + fds_.size()) * sizeof(uint64_t));
+      if (size > 0 && values[0] == fds_.size()) {
+        for (size_t i = 0; i < fds_.size(); i++) {
+          reading->counters[slots_[i]] = values[3 + i];
+        }
+        multiplexed_ |= values[2] < values[1];
+      }
+    }
+#endif
+    reading->time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count();
+  }
+
+ private:
+  int leader_ = -1;
+  std::vector<int> fds_;
+  // The Counter each of |fds_| counts.
+  std::vector<int> slots_;
+  bool multiplexed_ = false;
+};
+
+struct StageTotals {
+  uint64_t calls = 0;
+  double counters[kCounterCount] = {};
+  double time_ns = 0;
+};
+
+// Sums the counters over each stage, less the cost of reading them.
+class StageProfiler : public ct::StageObserver {
+ public:
+  explicit StageProfiler(CounterGroup* group) : group_(group) {}
+
+  // Measures what a pair of reads adds to a stage, to subtract it.
+  void Calibrate(int rounds) {
+    StageTotals empty;
+    for (int i = 0; i < rounds; i++) {
+      Reading start;
+      Reading end;
+      group_->Read(&start);
+      group_->Read(&end);
+      Accumulate(start, end, &empty);
+    }
+    for (int i = 0; i < kCounterCount; i++) {
+      overhead_.counters[i] = empty.counters[i] / rounds;
+    }
+    overhead_.time_ns = empty.time_ns / rounds;
+  }
+
+  void OnStageStart(ct::MetricsStage) override {
+    if (depth_ < kMaxDepth) {
+      group_->Read(&starts_[depth_]);
+    }
+    depth_++;
+  }
+
+  void OnStageEnd(ct::MetricsStage stage) override {
+    Reading end;
+    group_->Read(&end);
+    depth_--;
+    if (depth_ < kMaxDepth) {
+      Accumulate(starts_[depth_], end,
+                 &totals_[static_cast<size_t>(stage)]);
+    }
+  }
+
+  const StageTotals& totals(size_t stage) const { return totals_[stage]; }
+
+ private:
+  static constexpr int kMaxDepth = 8;
+
+  void Accumulate(const Reading& start,
+                  const Reading& end,
+                  StageTotals* totals) const {
+    totals->calls++;
+    for (int i = 0; i < kCounterCount; i++) {
+      const double delta = static_cast<double>(end.counters[i] -
+                                               start.counters[i]) -
+                           overhead_.counters[i];
+      totals->counters[i] += delta > 0 ? delta : 0;
+    }
+    const double time_ns =
+        static_cast<double>(end.time_ns - start.time_ns) - overhead_.time_ns;
+    totals->time_ns += time_ns > 0 ? time_ns : 0;
+  }
+
+  CounterGroup* const group_;
+  StageTotals overhead_;
+  StageTotals totals_[ct::kMetricsStageCount];
+  Reading starts_[kMaxDepth];
+  int depth_ = 0;
+};
+
+struct Chain {
+  std::string leaf;
+  std::string issuer;
+};
+
+bool ReadFile(const char* path, std::string* contents) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    return false;
+  }
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents->append(buffer, n);
+  }
+  fclose(file);
+  return true;
+}
+
+void PrintValue(bool available, double value) {
+  if (available) {
+    printf(" %10.1f", value);
+  } else {
+    printf(" %10s", "n/a");
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? atoi(argv[1]) : 1000;
+
+  std::vector<Chain> corpus;
+  for (int i = 2; i + 1 < argc; i += 2) {
+    Chain chain;
+    if (!ReadFile(argv[i], &chain.leaf) ||
+        !ReadFile(argv[i + 1], &chain.issuer)) {
+      fprintf(stderr, "can't read %s or %s\n", argv[i], argv[i + 1]);
+      return 1;
+    }
+    corpus.push_back(std::move(chain));
+  }
+  if (corpus.empty()) {
+    const std::string issuer(test::SubRootCA());
+    corpus.push_back({std::string(test::ValidTimestampsLeaf()), issuer});
+    corpus.push_back({std::string(test::NoTimestampsLeaf()), issuer});
+  }
+
+  const ct::MultiLogVerifier& verifier = ct::GetBuiltinLogVerifier();
+  int verified = 0;
+  for (const Chain& chain : corpus) {
+    verified += verifier.Verify(chain.leaf, chain.issuer, kFarFuture) ? 1 : 0;
+  }
+
+  CounterGroup group;
+  printf("corpus: %zu chains, %d verified; %d iterations\n", corpus.size(),
+         verified, iterations);
+  printf("counters:");
+  for (int i = 0; i < kCounterCount; i++) {
+    printf(" %s%s", kCounterNames[i], group.available(i) ? "" : " (n/a)");
+  }
+  printf("\n");
+  if (!group.any_available()) {
+    printf("no hardware counters (see perf_event_paranoid, or the VM may "
+           "not expose a PMU); reporting time only\n");
+  }
+
+  StageProfiler profiler(&group);
+  profiler.Calibrate(10000);
+  ct::SetStageObserver(&profiler);
+  for (int i = 0; i < iterations; i++) {
+    for (const Chain& chain : corpus) {
+      verifier.Verify(chain.leaf, chain.issuer, kFarFuture);
+    }
+  }
+  ct::SetStageObserver(nullptr);
+
+  // Per certificate, i.e. per leaf verified.
+  const double certificates =
+      static_cast<double>(iterations) * static_cast<double>(corpus.size());
+  printf("%-18s %10s %10s %10s %10s %10s %10s %10s\n", "per certificate",
+         "calls", "ns", "cycles", "IPC", "br-miss", "L1D-miss", "LLC-miss");
+  for (size_t stage = 0; stage < ct::kMetricsStageCount; stage++) {
+    const StageTotals& totals = profiler.totals(stage);
+    printf("%-18s %10.2f %10.1f", kStageNames[stage],
+           totals.calls / certificates, totals.time_ns / certificates);
+    PrintValue(group.available(kCycles),
+               totals.counters[kCycles] / certificates);
+    const double cycles = totals.counters[kCycles];
+    if (group.available(kCycles) && group.available(kInstructions)) {
+      printf(" %10.2f",
+             cycles > 0 ? totals.counters[kInstructions] / cycles : 0);
+    } else {
+      printf(" %10s", "n/a");
+    }
+    PrintValue(group.available(kBranchMisses),
+               totals.counters[kBranchMisses] / certificates);
+    PrintValue(group.available(kL1DMisses),
+               totals.counters[kL1DMisses] / certificates);
+    PrintValue(group.available(kLLCMisses),
+               totals.counters[kLLCMisses] / certificates);
+    printf("\n");
+  }
+  if (group.multiplexed()) {
+    printf("counters were multiplexed; values are estimates\n");
+  }
+  return 0;
+}
@@ -0,0 +1,395 @@
+#include "certificate_bundle.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+
+#include "crypto_bytestring.h"
+
+namespace certificate_transparency {
+namespace {
+
+constexpr size_t kMinBlockSize = 256 * 1024;
+
+constexpr std::string_view kBeginMarker = "-----BEGIN CERTIFICATE-----";
+constexpr std::string_view kEndMarker = "-----END CERTIFICATE-----";
+
+// Values of base64 characters, kSkip for whitespace and kInvalid for
+// anything else.
+constexpr uint8_t kSkip = 0x40;
+constexpr uint8_t kInvalid = 0x80;
+
+constexpr std::array<uint8_t, 256> MakeBase64Table() {
+  std::array<uint8_t, 256> table = {};
+  for (auto& value : table) {
+    value = kInvalid;
+  }
+  constexpr char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  for (uint8_t i = 0; i < 64; i++) {
+    table[static_cast<uint8_t>(kAlphabet[i])] = i;
+  }
+  table[' '] = table['\t'] = table['\r'] = table['\n'] = kSkip;
+  return table;
+}
+
+constexpr std::array<uint8_t, 256> kBase64Table = MakeBase64Table();
+
+// Decodes the base64 in |text|, which may be spread over lines, into |out|,
+// which must have room for 3 bytes per 4 characters. Returns the size
+// decoded, or 0 if |text| is not base64.
+size_t DecodePEMBody(std::string_view text, uint8_t* out) {
+  uint8_t* const start = out;
+  uint32_t group = 0;
+  size_t group_size = 0;
+  size_t padding = 0;
+  for (char c : text) {
+    if (c == '=') {
+      padding++;
+      group <<= 6;
+    } else {
+      const uint8_t value = kBase64Table[static_cast<uint8_t>(c)];
+      if (value == kSkip) {
+        continue;
+      }
+      if (value == kInvalid || padding) {
+        return 0;
+      }
+      group = (group << 6) | value;
+    }
+    if (++group_size == 4) {
+      *out++ = static_cast<uint8_t>(group >> 16);
+      *out++ = static_cast<uint8_t>(group >> 8);
+      *out++ = static_cast<uint8_t>(group);
+      group = 0;
+      group_size = 0;
+    }
+  }
+  if (group_size != 0 || padding > 2 || out - start < 3) {
+    return 0;
+  }
+  return out - start - padding;
+}
+
+struct Certificate {
+  std::string_view der;
+  std::string_view issuer;
+  std::string_view subject;
+};
+
+// Fills in the issuer and subject names of |cert->der|. Returns false if it
+// is not a certificate.
+bool ParseNames(Certificate* cert) {
+  CBS cert_cbs, cert_body, tbs_cert, unused, issuer, subject;
+  CBS_init(&cert_cbs, reinterpret_cast<const uint8_t*>(cert->der.data()),
+           cert->der.size());
+  constexpr unsigned kVersionTag =
+      CBS_ASN1_CONTEXT_SPECIFIC | CBS_ASN1_CONSTRUCTED | 0;
+  if (!CBS_get_asn1(&cert_cbs, &cert_body, CBS_ASN1_SEQUENCE) ||
+      CBS_len(&cert_cbs) != 0 ||
+      !CBS_get_asn1(&cert_body, &tbs_cert, CBS_ASN1_SEQUENCE) ||
+      (CBS_peek_asn1_tag(&tbs_cert, kVersionTag) &&
+       !CBS_get_asn1(&tbs_cert, &unused, kVersionTag)) ||
+      !CBS_get_asn1(&tbs_cert, &unused, CBS_ASN1_INTEGER) ||
+      !CBS_get_asn1(&tbs_cert, &unused, CBS_ASN1_SEQUENCE) ||
+      !CBS_get_asn1_element(&tbs_cert, &issuer, CBS_ASN1_SEQUENCE) ||
+      !CBS_get_asn1(&tbs_cert, &unused, CBS_ASN1_SEQUENCE) ||
+      !CBS_get_asn1_element(&tbs_cert, &subject, CBS_ASN1_SEQUENCE)) {
+    return false;
+  }
+  cert->issuer = std::string_view(
+      reinterpret_cast<const char*>(CBS_data(&issuer)), CBS_len(&issuer));
+  cert->subject = std::string_view(
+      reinterpret_cast<const char*>(CBS_data(&subject)), CBS_len(&subject));
+  return true;
+}
+
+bool Continues(const Certificate& previous, const Certificate& cert) {
+  return cert.subject == previous.issuer;
+}
+
+// Returns the position of the first BEGIN or END marker at or after |from|,
+// or npos, and sets |*is_end| to which it is.
+size_t FindMarker(std::string_view bundle, size_t from, bool* is_end) {
+  constexpr std::string_view kDashes = "-----";
+  for (size_t position = bundle.find(kDashes, from);
+       position != std::string_view::npos;
+       position = bundle.find(kDashes, position + 1)) {
+    const std::string_view rest = bundle.substr(position);
+    if (rest.substr(0, kEndMarker.size()) == kEndMarker ||
+        rest.substr(0, kBeginMarker.size()) == kBeginMarker) {
+      *is_end = rest[5] == 'E';
+      return position;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Decodes the PEM block beginning at |begin|, and sets |*next| to where the
+// search for the next block goes on. Returns false if the block is
+// malformed. A block without an END marker ends where the next one begins,
+// so that each byte is decoded at most once.
+bool DecodePEMBlock(std::string_view bundle,
+                    size_t begin,
+                    CertificateArena* arena,
+                    Certificate* cert,
+                    size_t* next) {
+  const size_t body = begin + kBeginMarker.size();
+  bool is_end = false;
+  const size_t end = FindMarker(bundle, body, &is_end);
+  if (!is_end) {
+    *next = end == std::string_view::npos ? bundle.size() : end;
+    return false;
+  }
+  *next = end + kEndMarker.size();
+  const std::string_view text = bundle.substr(body, end - body);
+  uint8_t* out = arena->Allocate(text.size() / 4 * 3 + 3);
+  const size_t size = DecodePEMBody(text, out);
+  if (size == 0) {
+    return false;
+  }
+  cert->der = std::string_view(reinterpret_cast<const char*>(out), size);
+  return ParseNames(cert);
+}
+
+// Chains are built leaf first; |pending| is a leaf waiting to see whether
+// the next certificate is its issuer.
+class ChainBuilder {
+ public:
+  explicit ChainBuilder(std::vector<BundleChain>* chains) : chains_(chains) {}
+
+  void SetPrevious(const Certificate* previous) {
+    if (previous) {
+      previous_ = *previous;
+      has_previous_ = true;
+    }
+  }
+
+  void Add(const Certificate& cert) {
+    if (has_previous_ && Continues(previous_, cert)) {
+      if (has_pending_) {
+        chains_->push_back({pending_.der, cert.der});
+        has_pending_ = false;
+      }
+    } else {
+      Flush();
+      pending_ = cert;
+      has_pending_ = true;
+    }
+    previous_ = cert;
+    has_previous_ = true;
+  }
+
+  void AddMalformed() {
+    Flush();
+    has_previous_ = false;
+  }
+
+  // Ends the chain being built, given the certificate after the range if
+  // there is one.
+  void Finish(const Certificate* next) {
+    if (has_pending_ && next && Continues(pending_, *next)) {
+      chains_->push_back({pending_.der, next->der});
+      has_pending_ = false;
+    }
+    Flush();
+  }
+
+  bool has_pending() const { return has_pending_; }
+
+ private:
+  void Flush() {
+    if (has_pending_) {
+      chains_->push_back({pending_.der, std::string_view()});
+      has_pending_ = false;
+    }
+  }
+
+  std::vector<BundleChain>* const chains_;
+  Certificate previous_;
+  bool has_previous_ = false;
+  Certificate pending_;
+  bool has_pending_ = false;
+};
+
+// Whether |bundle| starts with a DER SEQUENCE long enough to be a
+// certificate, which no text file does.
+bool IsDER(std::string_view bundle) {
+  return bundle.size() >= 2 && static_cast<uint8_t>(bundle[0]) == 0x30 &&
+         (static_cast<uint8_t>(bundle[1]) == 0x82 ||
+          static_cast<uint8_t>(bundle[1]) == 0x83);
+}
+
+size_t ScanDER(std::string_view bundle, std::vector<BundleChain>* chains) {
+  ChainBuilder builder(chains);
+  CBS cbs;
+  CBS_init(&cbs, reinterpret_cast<const uint8_t*>(bundle.data()),
+           bundle.size());
+  size_t malformed = 0;
+  while (CBS_len(&cbs) != 0) {
+    CBS element;
+    if (!CBS_get_asn1_element(&cbs, &element, CBS_ASN1_SEQUENCE)) {
+      // Nothing after a broken length can be found.
+      malformed++;
+      break;
+    }
+    Certificate cert;
+    cert.der = std::string_view(
+        reinterpret_cast<const char*>(CBS_data(&element)), CBS_len(&element));
+    if (ParseNames(&cert)) {
+      builder.Add(cert);
+    } else {
+      builder.AddMalformed();
+      malformed++;
+    }
+  }
+  builder.Finish(nullptr);
+  return malformed;
+}
+
+size_t ScanPEM(std::string_view bundle,
+               size_t begin,
+               size_t end,
+               CertificateArena* arena,
+               std::vector<BundleChain>* chains) {
+  // Only blocks that start in the range are looked for, so that the ranges
+  // inside a large block or a long run of text cost nothing.
+  const size_t search_end = std::min(bundle.size(), end + kBeginMarker.size());
+  size_t position =
+      begin < search_end
+          ? bundle.substr(0, search_end).find(kBeginMarker, begin)
+          : std::string_view::npos;
+  if (position == std::string_view::npos || position >= end) {
+    return 0;
+  }
+
+  ChainBuilder builder(chains);
+  // A block started before the range may be what the first block continues.
+  if (position > 0) {
+    const size_t previous = bundle.rfind(kBeginMarker, position - 1);
+    Certificate cert;
+    size_t unused_next;
+    if (previous != std::string_view::npos &&
+        DecodePEMBlock(bundle, previous, arena, &cert, &unused_next)) {
+      builder.SetPrevious(&cert);
+    }
+  }
+
+  size_t malformed = 0;
+  while (position != std::string_view::npos && position < end) {
+    Certificate cert;
+    size_t next;
+    if (DecodePEMBlock(bundle, position, arena, &cert, &next)) {
+      builder.Add(cert);
+    } else {
+      builder.AddMalformed();
+      malformed++;
+    }
+    position = bundle.find(kBeginMarker, next);
+  }
+
+  // The issuer of the last leaf may start after the range.
+  Certificate next_cert;
+  size_t unused_next;
+  const bool has_next =
+      builder.has_pending() && position != std::string_view::npos &&
+      DecodePEMBlock(bundle, position, arena, &next_cert, &unused_next);
+  builder.Finish(has_next ? &next_cert : nullptr);
+  return malformed;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<MappedFile> MappedFile::Open(const std::string& path) {
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    return nullptr;
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  void* mapping = nullptr;
+  if (size != 0) {
+    mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      close(fd);
+      return nullptr;
+    }
+    // Bundles are read front to back, once.
+    posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+  }
+  close(fd);
+  return std::unique_ptr<MappedFile>(new MappedFile(mapping, size));
+}
+
+MappedFile::MappedFile(void* mapping, size_t size)
+    : mapping_(mapping),
+      contents_(static_cast<const char*>(mapping), size) {}
+
+MappedFile::~MappedFile() {
+  if (mapping_) {
+    munmap(mapping_, contents_.size());
+  }
+}
+
+CertificateArena::CertificateArena() = default;
+CertificateArena::~CertificateArena() = default;
+
+uint8_t* CertificateArena::Allocate(size_t size) {
+  while (current_ < blocks_.size()) {
+    auto& block = blocks_[current_];
+    if (block.second - used_ >= size) {
+      uint8_t* out = block.first.get() + used_;
+      used_ += size;
+      return out;
+    }
+    current_++;
+    used_ = 0;
+  }
+  const size_t block_size = std::max(size, kMinBlockSize);
+  // Not zeroed: every byte handed out is written before it is read.
+  blocks_.emplace_back(new uint8_t[block_size], block_size);
+  capacity_ += block_size;
+  current_ = blocks_.size() - 1;
+  used_ = size;
+  return blocks_.back().first.get();
+}
+
+void CertificateArena::Reset() {
+  current_ = 0;
+  used_ = 0;
+}
+
+std::vector<std::pair<size_t, size_t>> SplitBundle(std::string_view bundle,
+                                                   size_t range_size) {
+  std::vector<std::pair<size_t, size_t>> ranges;
+  if (IsDER(bundle) || range_size == 0) {
+    ranges.emplace_back(0, bundle.size());
+    return ranges;
+  }
+  for (size_t begin = 0; begin < bundle.size(); begin += range_size) {
+    ranges.emplace_back(begin, std::min(bundle.size(), begin + range_size));
+  }
+  return ranges;
+}
+
+size_t ScanBundle(std::string_view bundle,
+                  size_t begin,
+                  size_t end,
+                  CertificateArena* arena,
+                  std::vector<BundleChain>* chains) {
+  if (IsDER(bundle)) {
+    return begin == 0 ? ScanDER(bundle, chains) : 0;
+  }
+  return ScanPEM(bundle, begin, std::min(end, bundle.size()), arena, chains);
+}
+
+}  // namespace certificate_transparency
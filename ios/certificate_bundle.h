@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace certificate_transparency {
+
+// A file mapped read-only into memory.
+class MappedFile {
+ public:
+  // Returns nullptr if |path| can't be opened or mapped.
+  static std::unique_ptr<MappedFile> Open(const std::string& path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  std::string_view contents() const { return contents_; }
+
+ private:
+  MappedFile(void* mapping, size_t size);
+
+  void* const mapping_;
+  const std::string_view contents_;
+};
+
+// Memory for certificates decoded from PEM. Blocks are kept across Reset(),
+// so a thread that reuses its arena stops allocating once the blocks fit its
+// largest input. Not thread-safe.
+class CertificateArena {
+ public:
+  CertificateArena();
+  ~CertificateArena();
+
+  CertificateArena(const CertificateArena&) = delete;
+  CertificateArena& operator=(const CertificateArena&) = delete;
+
+  // Returns |size| bytes, valid until Reset() or destruction.
+  uint8_t* Allocate(size_t size);
+
+  // Makes all the memory available again, invalidating what was returned.
+  void Reset();
+
+  // The bytes held in blocks, used or not.
+  size_t capacity() const { return capacity_; }
+
+ private:
+  std::vector<std::pair<std::unique_ptr<uint8_t[]>, size_t>> blocks_;
+  size_t current_ = 0;
+  size_t used_ = 0;
+  size_t capacity_ = 0;
+};
+
+// A leaf and its issuer found in a bundle. |issuer| is empty if the leaf was
+// not followed by its issuer.
+struct BundleChain {
+  std::string_view leaf;
+  std::string_view issuer;
+};
+
+// Returns the ranges to scan |bundle| in, one per |range_size| bytes or so,
+// to spread a large bundle over threads. Bundles of DER certificates can't
+// be split and come back as a single range.
+std::vector<std::pair<size_t, size_t>> SplitBundle(std::string_view bundle,
+                                                   size_t range_size);
+
+// Finds the chains in |bundle|, a PEM file or DER certificates one after
+// another, whose leaf starts in the range [|begin|, |end|). A certificate
+// continues the chain of the previous one if its subject is the previous
+// one's issuer, and starts a new chain otherwise. Each chain yields its first
+// two certificates; the rest are skipped.
+//
+// DER certificates are viewed in place in |bundle|. PEM certificates are
+// decoded into |arena|. Chains are appended to |chains|, and the number of
+// certificates that could not be decoded is returned.
+size_t ScanBundle(std::string_view bundle,
+                  size_t begin,
+                  size_t end,
+                  CertificateArena* arena,
+                  std::vector<BundleChain>* chains);
+
+}  // namespace certificate_transparency
@@ -0,0 +1,30 @@
+#include "chain_digest.h"
+
+namespace certificate_transparency {
+namespace {
+
+void AddLengthPrefixed(SHA256_CTX* ctx, std::string_view data) {
+  uint8_t length[8];
+  for (size_t i = 0; i < sizeof(length); i++) {
+    length[i] = static_cast<uint8_t>(static_cast<uint64_t>(data.size()) >>
+                                     (8 * (sizeof(length) - 1 - i)));
+  }
+  SHA256_Update(ctx, length, sizeof(length));
+  SHA256_Update(ctx, data.data(), data.size());
+}
+
+}  // namespace
+
+ChainDigest GetChainDigest(std::string_view leaf_cert,
+                           std::string_view issuer_cert) {
+  SHA256_CTX ctx;
+  SHA256_Init(&ctx);
+  AddLengthPrefixed(&ctx, leaf_cert);
+  AddLengthPrefixed(&ctx, issuer_cert);
+
+  ChainDigest digest;
+  SHA256_Final(digest.data(), &ctx);
+  return digest;
+}
+
+}  // namespace certificate_transparency
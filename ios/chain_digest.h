@@ -0,0 +1,18 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "crypto_sha256.h"
+
+namespace certificate_transparency {
+
+using ChainDigest = std::array<uint8_t, kSHA256DigestLength>;
+
+// Returns the SHA-256 of the length-prefixed leaf and issuer certificates,
+// identifying the chain a verdict was computed for.
+ChainDigest GetChainDigest(std::string_view leaf_cert,
+                           std::string_view issuer_cert);
+
+}  // namespace certificate_transparency
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+namespace certificate_transparency {
+
+struct ChainEvaluation {
+  bool trusted = false;
+  // Whether the chain ends in one of the configured custom roots.
+  bool has_custom_root = false;
+  // The leaf and its issuer in the chain the evaluator built, which need not
+  // be the chain the server presented. |issuer_cert| is empty if the chain
+  // has a single certificate.
+  std::string leaf_cert;
+  std::string issuer_cert;
+};
+
+// Decides whether a certificate chain is trusted, the way SecTrust does on
+// Apple platforms. An evaluator is made for one chain.
+class ChainEvaluator {
+ public:
+  virtual ~ChainEvaluator() = default;
+
+  virtual ChainEvaluation Evaluate() = 0;
+};
+
+}  // namespace certificate_transparency
@@ -0,0 +1,126 @@
+#include "chain_recorder.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <utility>
+
+#include "crypto_bytebuilder.h"
+#include "crypto_bytestring.h"
+
+namespace certificate_transparency {
+namespace {
+
+constexpr uint32_t kMagic = 0x43544352;  // "CTCR"
+constexpr uint8_t kVersion = 1;
+
+bool AddBytes(CBB* out, std::string_view bytes) {
+  CBB child;
+  return CBB_add_u24_length_prefixed(out, &child) &&
+         CBB_add_bytes(&child, reinterpret_cast<const uint8_t*>(bytes.data()),
+                       bytes.size()) &&
+         CBB_flush(out);
+}
+
+bool GetBytes(CBS* in, std::string* out) {
+  CBS bytes;
+  if (!CBS_get_u24_length_prefixed(in, &bytes)) {
+    return false;
+  }
+  out->assign(reinterpret_cast<const char*>(CBS_data(&bytes)),
+              CBS_len(&bytes));
+  return true;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<ChainRecorder> ChainRecorder::Open(const std::string& path,
+                                                   uint32_t sample_every) {
+  constexpr int kFlags = O_WRONLY | O_APPEND | O_CLOEXEC;
+  int fd = open(path.c_str(), kFlags | O_CREAT | O_EXCL, 0644);
+  if (fd >= 0) {
+    uint8_t header[5];
+    ScopedCBB cbb;
+    if (!CBB_init_fixed(cbb.get(), header, sizeof(header)) ||
+        !CBB_add_u32(cbb.get(), kMagic) || !CBB_add_u8(cbb.get(), kVersion) ||
+        write(fd, header, sizeof(header)) != sizeof(header)) {
+      close(fd);
+      unlink(path.c_str());
+      return nullptr;
+    }
+  } else if (errno == EEXIST) {
+    fd = open(path.c_str(), kFlags);
+  }
+  if (fd < 0) {
+    return nullptr;
+  }
+  return std::unique_ptr<ChainRecorder>(
+      new ChainRecorder(fd, sample_every ? sample_every : 1));
+}
+
+ChainRecorder::ChainRecorder(int fd, uint32_t sample_every)
+    : fd_(fd), sample_every_(sample_every) {}
+
+ChainRecorder::~ChainRecorder() {
+  close(fd_);
+}
+
+void ChainRecorder::Record(std::string_view leaf_cert,
+                           std::string_view issuer_cert,
+                           uint64_t now) {
+  if (seen_.fetch_add(1, std::memory_order_relaxed) % sample_every_ != 0) {
+    return;
+  }
+  ScopedCBB cbb;
+  if (!CBB_init(cbb.get(), leaf_cert.size() + issuer_cert.size() + 16) ||
+      !AddBytes(cbb.get(), leaf_cert) || !AddBytes(cbb.get(), issuer_cert) ||
+      !CBB_add_u64(cbb.get(), now) || !CBB_flush(cbb.get())) {
+    return;
+  }
+  const ssize_t size = static_cast<ssize_t>(CBB_len(cbb.get()));
+  if (write(fd_, CBB_data(cbb.get()), size) == size) {
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+std::optional<std::vector<RecordedChain>> ReadChainRecording(
+    const std::string& path) {
+  std::string contents;
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file) {
+    return std::nullopt;
+  }
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.append(buffer, n);
+  }
+  fclose(file);
+
+  CBS in;
+  CBS_init(&in, reinterpret_cast<const uint8_t*>(contents.data()),
+           contents.size());
+  uint32_t magic;
+  uint8_t version;
+  if (!CBS_get_u32(&in, &magic) || magic != kMagic ||
+      !CBS_get_u8(&in, &version) || version != kVersion) {
+    return std::nullopt;
+  }
+
+  std::vector<RecordedChain> chains;
+  while (CBS_len(&in) != 0) {
+    RecordedChain chain;
+    if (!GetBytes(&in, &chain.leaf_cert) ||
+        !GetBytes(&in, &chain.issuer_cert) ||
+        !CBS_get_u64(&in, &chain.timestamp)) {
+      break;
+    }
+    chains.push_back(std::move(chain));
+  }
+  return chains;
+}
+
+}  // namespace certificate_transparency
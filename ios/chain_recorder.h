@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace certificate_transparency {
+
+// Appends the chains it is given to a file, so that a production mix of
+// chains can be replayed later by benchmarks/replay_benchmark.cc. Each
+// record holds the leaf, the issuer and the time of verification, and is
+// appended with a single write, so processes can share a file and a crash
+// at most truncates the last record.
+class ChainRecorder {
+ public:
+  // Opens |path| for appending, creating it if needed, and records one chain
+  // in every |sample_every|. Returns nullptr on failure.
+  static std::unique_ptr<ChainRecorder> Open(const std::string& path,
+                                             uint32_t sample_every = 1);
+
+  ~ChainRecorder();
+
+  ChainRecorder(const ChainRecorder&) = delete;
+  ChainRecorder& operator=(const ChainRecorder&) = delete;
+
+  // Safe to call from any thread.
+  void Record(std::string_view leaf_cert,
+              std::string_view issuer_cert,
+              uint64_t now);
+
+  // The chains written so far.
+  uint64_t recorded() const {
+    return recorded_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  ChainRecorder(int fd, uint32_t sample_every);
+
+  const int fd_;
+  const uint32_t sample_every_;
+  std::atomic<uint64_t> seen_{0};
+  std::atomic<uint64_t> recorded_{0};
+};
+
+struct RecordedChain {
+  std::string leaf_cert;
+  std::string issuer_cert;
+  uint64_t timestamp = 0;
+};
+
+// Reads the chains recorded in |path|, ignoring a truncated last record.
+// Returns nullopt if the file can't be read or isn't a recording.
+std::optional<std::vector<RecordedChain>> ReadChainRecording(
+    const std::string& path);
+
+}  // namespace certificate_transparency
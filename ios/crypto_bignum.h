@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace certificate_transparency {
+
+// Limb helpers shared by the portable P-256 and RSA code. Multi-precision
+// values are arrays of little-endian 64-bit limbs.
+
+// bn_mul_add returns the low half of |a| * |b| + |c| + |d| and writes the
+// high half to |*hi|. The sum cannot overflow 128 bits.
+inline uint64_t bn_mul_add(uint64_t a,
+                           uint64_t b,
+                           uint64_t c,
+                           uint64_t d,
+                           uint64_t* hi) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 t = static_cast<unsigned __int128>(a) * b + c + d;
+  *hi = static_cast<uint64_t>(t >> 64);
+  return static_cast<uint64_t>(t);
+#else
+  const uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+  const uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+  const uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi;
+  const uint64_t p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+  const uint64_t mid = (p0 >> 32) + (p1 & 0xffffffff) + (p2 & 0xffffffff);
+  uint64_t lo = (p0 & 0xffffffff) | (mid << 32);
+  uint64_t high = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+  lo += c;
+  high += lo < c;
+  lo += d;
+  high += lo < d;
+  *hi = high;
+  return lo;
+#endif
+}
+
+// bn_sub_words sets |r| to |a| - |b| over |num| limbs and returns the borrow.
+inline uint64_t bn_sub_words(uint64_t* r,
+                             const uint64_t* a,
+                             const uint64_t* b,
+                             size_t num) {
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < num; i++) {
+    uint64_t t = a[i] - b[i];
+    uint64_t next_borrow = a[i] < b[i];
+    next_borrow |= t < borrow;
+    r[i] = t - borrow;
+    borrow = next_borrow;
+  }
+  return borrow;
+}
+
+// bn_from_bytes_be sets the |num| limbs of |r| to the big-endian |len| bytes
+// at |in|, which must fit.
+inline void bn_from_bytes_be(uint64_t* r,
+                             size_t num,
+                             const uint8_t* in,
+                             size_t len) {
+  for (size_t i = 0; i < num; i++) {
+    r[i] = 0;
+  }
+  for (size_t i = 0; i < len; i++) {
+    r[i / 8] |= static_cast<uint64_t>(in[len - 1 - i]) << (8 * (i % 8));
+  }
+}
+
+// bn_neg_inverse_u64 returns -|n|^-1 mod 2^64 for odd |n|.
+inline uint64_t bn_neg_inverse_u64(uint64_t n) {
+  // Newton's iteration doubles the number of correct low bits each step,
+  // starting from the three bits n * n == 1 mod 8 provides.
+  uint64_t inverse = n;
+  for (int i = 0; i < 5; i++) {
+    inverse *= 2 - n * inverse;
+  }
+  return 0 - inverse;
+}
+
+}  // namespace certificate_transparency
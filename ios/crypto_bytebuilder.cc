@@ -19,6 +19,7 @@
 #include <cstring>
 
 #include "crypto_bytestring.h"
+#include "crypto_mem.h"
 #include "safe_cstring.h"
 
 namespace certificate_transparency {
@@ -31,7 +32,8 @@ static int cbb_init(CBB* cbb, uint8_t* buf, size_t cap) {
   // This assumes that |cbb| has already been zeroed.
   struct cbb_buffer_st* base;
 
-  base = static_cast<cbb_buffer_st*>(malloc(sizeof(struct cbb_buffer_st)));
+  base =
+      static_cast<cbb_buffer_st*>(CT_malloc(sizeof(struct cbb_buffer_st)));
   if (base == NULL) {
     return 0;
   }
@@ -50,13 +52,13 @@ static int cbb_init(CBB* cbb, uint8_t* buf, size_t cap) {
 int CBB_init(CBB* cbb, size_t initial_capacity) {
   CBB_zero(cbb);
 
-  uint8_t* buf = reinterpret_cast<uint8_t*>(malloc(initial_capacity));
+  uint8_t* buf = reinterpret_cast<uint8_t*>(CT_malloc(initial_capacity));
   if (initial_capacity > 0 && buf == NULL) {
     return 0;
   }
 
   if (!cbb_init(cbb, buf, initial_capacity)) {
-    free(buf);
+    CT_free(buf);
     return 0;
   }
 
@@ -84,9 +86,9 @@ void CBB_cleanup(CBB* cbb) {
 
   if (cbb->base) {
     if (cbb->base->can_resize) {
-      free(cbb->base->buf);
+      CT_free(cbb->base->buf);
     }
-    free(cbb->base);
+    CT_free(cbb->base);
   }
   cbb->base = NULL;
 }
@@ -117,7 +119,7 @@ static int cbb_buffer_reserve(struct cbb_buffer_st* base,
     if (newcap < base->cap || newcap < newlen) {
       newcap = newlen;
     }
-    newbuf = reinterpret_cast<uint8_t*>(realloc(base->buf, newcap));
+    newbuf = reinterpret_cast<uint8_t*>(CT_realloc(base->buf, newcap));
     if (newbuf == NULL) {
       goto err;
     }
@@ -688,7 +690,8 @@ int CBB_flush_asn1_set_of(CBB* cbb) {
   size_t buf_len = CBB_len(cbb);
   uint8_t* buf =
       reinterpret_cast<uint8_t*>(safe_memdup(CBB_data(cbb), buf_len));
-  CBS* children = reinterpret_cast<CBS*>(malloc(num_children * sizeof(CBS)));
+  CBS* children =
+      reinterpret_cast<CBS*>(CT_malloc(num_children * sizeof(CBS)));
   if (buf == NULL || children == NULL) {
     goto err;
   }
@@ -712,8 +715,8 @@ int CBB_flush_asn1_set_of(CBB* cbb) {
   ret = 1;
 
 err:
-  free(buf);
-  free(children);
+  CT_free(buf);
+  CT_free(children);
   return ret;
 }
 
@@ -90,7 +90,7 @@ void CBB_cleanup(CBB* cbb);
 // CBB_finish completes any pending length prefix and sets |*out_data| to a
 // malloced buffer and |*out_len| to the length of that buffer. The caller
 // takes ownership of the buffer and, unless the buffer was fixed with
-// |CBB_init_fixed|, must call |OPENSSL_free| when done.
+// |CBB_init_fixed|, must call |CT_free| when done.
 //
 // It can only be called on a "top level" |CBB|, i.e. one initialised with
 // |CBB_init| or |CBB_init_fixed|. It returns one on success and zero on
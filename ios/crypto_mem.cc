@@ -0,0 +1,44 @@
+#include "crypto_mem.h"
+
+#include <atomic>
+#include <cstdlib>
+
+#include "metrics.h"
+
+namespace certificate_transparency {
+namespace {
+
+std::atomic<const AllocationHooks*> g_hooks{nullptr};
+
+}  // namespace
+
+void SetAllocationHooks(const AllocationHooks* hooks) {
+  g_hooks.store(hooks, std::memory_order_release);
+}
+
+void* CT_malloc(size_t size) {
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+  RecordAllocation(size);
+#endif
+  const AllocationHooks* hooks = g_hooks.load(std::memory_order_acquire);
+  return hooks ? hooks->malloc_fn(size) : malloc(size);
+}
+
+void* CT_realloc(void* ptr, size_t size) {
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+  RecordAllocation(size);
+#endif
+  const AllocationHooks* hooks = g_hooks.load(std::memory_order_acquire);
+  return hooks ? hooks->realloc_fn(ptr, size) : realloc(ptr, size);
+}
+
+void CT_free(void* ptr) {
+  const AllocationHooks* hooks = g_hooks.load(std::memory_order_acquire);
+  if (hooks) {
+    hooks->free_fn(ptr);
+  } else {
+    free(ptr);
+  }
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+namespace certificate_transparency {
+
+// Functions the library calls instead of malloc, realloc and free for the
+// memory it manages by hand: CBB buffers, safe_memdup() copies and the
+// buffers CBB_finish() hands out. C++ containers use operator new as usual.
+struct AllocationHooks {
+  void* (*malloc_fn)(size_t size);
+  void* (*realloc_fn)(void* ptr, size_t size);
+  void (*free_fn)(void* ptr);
+};
+
+// Routes the allocations above through |hooks|, or back to the C library if
+// |hooks| is null. |hooks| must outlive its use. Memory may be freed through
+// other hooks than it was allocated with, so hooks must ultimately allocate
+// with malloc, e.g. to count allocations.
+void SetAllocationHooks(const AllocationHooks* hooks);
+
+void* CT_malloc(size_t size);
+void* CT_realloc(void* ptr, size_t size);
+void CT_free(void* ptr);
+
+}  // namespace certificate_transparency
@@ -0,0 +1,573 @@
+#include "crypto_p256.h"
+
+#include <vector>
+
+#include "crypto_bignum.h"
+#include "crypto_bytestring.h"
+#include "safe_cstring.h"
+
+namespace certificate_transparency {
+namespace {
+
+// All multi-precision values are four little-endian 64-bit limbs.
+
+const uint64_t kP[4] = {0xffffffffffffffff, 0x00000000ffffffff,
+                        0x0000000000000000, 0xffffffff00000001};
+const uint64_t kN[4] = {0xf3b9cac2fc632551, 0xbce6faada7179e84,
+                        0xffffffffffffffff, 0xffffffff00000000};
+
+// -p^-1 mod 2^64 and -n^-1 mod 2^64.
+const uint64_t kP0 = 0x0000000000000001;
+const uint64_t kN0 = 0xccd1c8aaee00bc4f;
+
+// 2^512 mod p and 2^512 mod n, used to enter the Montgomery domain.
+const uint64_t kPRR[4] = {0x0000000000000003, 0xfffffffbffffffff,
+                          0xfffffffffffffffe, 0x00000004fffffffd};
+const uint64_t kNRR[4] = {0x83244c95be79eea2, 0x4699799c49bd6fa6,
+                          0x2845b2392b6bec59, 0x66e12d94f3d95620};
+
+// 1 in the Montgomery domain, that is 2^256 mod p and 2^256 mod n.
+const uint64_t kOneP[4] = {0x0000000000000001, 0xffffffff00000000,
+                           0xffffffffffffffff, 0x00000000fffffffe};
+const uint64_t kOneN[4] = {0x0c46353d039cdaaf, 0x4319055258e8617b,
+                           0x0000000000000000, 0x00000000ffffffff};
+
+// The curve coefficient b in the Montgomery domain.
+const uint64_t kB[4] = {0xd89cdf6229c4bddf, 0xacf005cd78843090,
+                        0xe5a220abf7212ed6, 0xdc30061d04874834};
+
+// The generator, as plain integers.
+const uint64_t kGx[4] = {0xf4a13945d898c296, 0x77037d812deb33a0,
+                         0xf8bce6e563a440f2, 0x6b17d1f2e12c4247};
+const uint64_t kGy[4] = {0xcbb6406837bf51f5, 0x2bce33576b315ece,
+                         0x8ee7eb4a7c0f9e16, 0x4fe342e2fe1a7f9b};
+
+// The generator comb has eight teeth spaced 32 bits apart.
+constexpr int kGeneratorTeeth = 8;
+constexpr int kGeneratorCombSize = (1 << kGeneratorTeeth) - 1;
+constexpr int kCombSpacing = 32;
+
+struct JacobianPoint {
+  uint64_t x[4];
+  uint64_t y[4];
+  // z == 0 is the point at infinity.
+  uint64_t z[4];
+};
+
+uint64_t AddLimbs(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; i++) {
+    uint64_t t = a[i] + carry;
+    carry = t < carry;
+    r[i] = t + b[i];
+    carry += r[i] < t;
+  }
+  return carry;
+}
+
+uint64_t SubLimbs(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+  return bn_sub_words(r, a, b, 4);
+}
+
+bool IsZero(const uint64_t a[4]) {
+  return (a[0] | a[1] | a[2] | a[3]) == 0;
+}
+
+bool IsEqual(const uint64_t a[4], const uint64_t b[4]) {
+  return ((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3])) == 0;
+}
+
+bool IsLess(const uint64_t a[4], const uint64_t b[4]) {
+  uint64_t unused[4];
+  return SubLimbs(unused, a, b) != 0;
+}
+
+bool TestBit(const uint64_t a[4], int bit) {
+  return (a[bit / 64] >> (bit % 64)) & 1;
+}
+
+void Copy(uint64_t r[4], const uint64_t a[4]) {
+  safe_memcpy(r, a, 4 * sizeof(uint64_t));
+}
+
+void FromBytes(uint64_t r[4], const uint8_t in[32]) {
+  bn_from_bytes_be(r, 4, in, 32);
+}
+
+// MontMul sets |r| to |a| * |b| / 2^256 mod |m|. |a| and |b| must be less
+// than |m| and the result is fully reduced.
+void MontMul(uint64_t r[4],
+             const uint64_t a[4],
+             const uint64_t b[4],
+             const uint64_t m[4],
+             uint64_t m0) {
+  uint64_t t[6] = {0, 0, 0, 0, 0, 0};
+  for (int i = 0; i < 4; i++) {
+    uint64_t carry = 0;
+    for (int j = 0; j < 4; j++) {
+      t[j] = bn_mul_add(a[j], b[i], t[j], carry, &carry);
+    }
+    t[4] += carry;
+    t[5] = t[4] < carry;
+
+    const uint64_t q = t[0] * m0;
+    bn_mul_add(q, m[0], t[0], 0, &carry);
+    for (int j = 1; j < 4; j++) {
+      t[j - 1] = bn_mul_add(q, m[j], t[j], carry, &carry);
+    }
+    t[3] = t[4] + carry;
+    t[4] = t[5] + (t[3] < carry);
+  }
+
+  // t < 2m here, so a single conditional subtraction is enough.
+  uint64_t reduced[4];
+  const uint64_t borrow = SubLimbs(reduced, t, m);
+  Copy(r, (t[4] != 0 || !borrow) ? reduced : t);
+}
+
+// MontInverse sets |r| to the inverse of |a| modulo the prime |m|, both in
+// the Montgomery domain, by raising |a| to m - 2.
+void MontInverse(uint64_t r[4],
+                 const uint64_t a[4],
+                 const uint64_t m[4],
+                 uint64_t m0,
+                 const uint64_t one[4]) {
+  uint64_t exponent[4];
+  Copy(exponent, m);
+  // Both moduli end in ...ffff and ...2551, so this cannot borrow.
+  exponent[0] -= 2;
+
+  uint64_t result[4];
+  Copy(result, one);
+  for (int i = 255; i >= 0; i--) {
+    MontMul(result, result, result, m, m0);
+    if (TestBit(exponent, i)) {
+      MontMul(result, result, a, m, m0);
+    }
+  }
+  Copy(r, result);
+}
+
+void FeMul(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+  MontMul(r, a, b, kP, kP0);
+}
+
+void FeSqr(uint64_t r[4], const uint64_t a[4]) {
+  MontMul(r, a, a, kP, kP0);
+}
+
+void FeAdd(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+  const uint64_t carry = AddLimbs(r, a, b);
+  if (carry || !IsLess(r, kP)) {
+    SubLimbs(r, r, kP);
+  }
+}
+
+void FeSub(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+  if (SubLimbs(r, a, b)) {
+    AddLimbs(r, r, kP);
+  }
+}
+
+void FeInverse(uint64_t r[4], const uint64_t a[4]) {
+  MontInverse(r, a, kP, kP0, kOneP);
+}
+
+void SetInfinity(JacobianPoint* r) {
+  Copy(r->x, kOneP);
+  Copy(r->y, kOneP);
+  safe_memset(r->z, 0, sizeof(r->z));
+}
+
+bool IsInfinity(const JacobianPoint* a) {
+  return IsZero(a->z);
+}
+
+// dbl-2001-b for a = -3. Doubling the point at infinity keeps z == 0, and the
+// group has no points of order two.
+void PointDouble(JacobianPoint* r, const JacobianPoint* a) {
+  uint64_t delta[4], gamma[4], beta[4], alpha[4], t0[4], t1[4];
+  FeSqr(delta, a->z);
+  FeSqr(gamma, a->y);
+  FeMul(beta, a->x, gamma);
+
+  FeSub(t0, a->x, delta);
+  FeAdd(t1, a->x, delta);
+  FeMul(t0, t0, t1);
+  FeAdd(alpha, t0, t0);
+  FeAdd(alpha, alpha, t0);
+
+  uint64_t x3[4], y3[4], z3[4];
+  FeAdd(t0, beta, beta);
+  FeAdd(t0, t0, t0);  // 4 * beta
+  FeSqr(x3, alpha);
+  FeSub(x3, x3, t0);
+  FeSub(x3, x3, t0);
+
+  FeAdd(z3, a->y, a->z);
+  FeSqr(z3, z3);
+  FeSub(z3, z3, gamma);
+  FeSub(z3, z3, delta);
+
+  FeSub(t0, t0, x3);
+  FeMul(y3, alpha, t0);
+  FeSqr(t1, gamma);
+  FeAdd(t1, t1, t1);
+  FeAdd(t1, t1, t1);
+  FeAdd(t1, t1, t1);  // 8 * gamma^2
+  FeSub(y3, y3, t1);
+
+  Copy(r->x, x3);
+  Copy(r->y, y3);
+  Copy(r->z, z3);
+}
+
+// FinishAdd completes add-2007-bl and madd-2007-bl once the shared
+// intermediate values are known. |h| must be non-zero.
+void FinishAdd(JacobianPoint* r,
+               const uint64_t u1[4],
+               const uint64_t s1[4],
+               const uint64_t h[4],
+               uint64_t rr[4],
+               const uint64_t z3[4]) {
+  uint64_t i[4], j[4], v[4], x3[4], y3[4];
+  FeAdd(i, h, h);
+  FeSqr(i, i);
+  FeMul(j, h, i);
+  FeAdd(rr, rr, rr);
+  FeMul(v, u1, i);
+
+  FeSqr(x3, rr);
+  FeSub(x3, x3, j);
+  FeSub(x3, x3, v);
+  FeSub(x3, x3, v);
+
+  FeSub(y3, v, x3);
+  FeMul(y3, y3, rr);
+  FeMul(j, j, s1);
+  FeAdd(j, j, j);
+  FeSub(y3, y3, j);
+
+  Copy(r->x, x3);
+  Copy(r->y, y3);
+  Copy(r->z, z3);
+}
+
+void PointAdd(JacobianPoint* r,
+              const JacobianPoint* a,
+              const JacobianPoint* b) {
+  if (IsInfinity(a)) {
+    *r = *b;
+    return;
+  }
+  if (IsInfinity(b)) {
+    *r = *a;
+    return;
+  }
+
+  uint64_t z1z1[4], z2z2[4], u1[4], u2[4], s1[4], s2[4], h[4], rr[4];
+  FeSqr(z1z1, a->z);
+  FeSqr(z2z2, b->z);
+  FeMul(u1, a->x, z2z2);
+  FeMul(u2, b->x, z1z1);
+  FeMul(s1, a->y, b->z);
+  FeMul(s1, s1, z2z2);
+  FeMul(s2, b->y, a->z);
+  FeMul(s2, s2, z1z1);
+  FeSub(h, u2, u1);
+  FeSub(rr, s2, s1);
+
+  if (IsZero(h)) {
+    if (IsZero(rr)) {
+      PointDouble(r, a);
+    } else {
+      SetInfinity(r);
+    }
+    return;
+  }
+
+  uint64_t z3[4];
+  FeAdd(z3, a->z, b->z);
+  FeSqr(z3, z3);
+  FeSub(z3, z3, z1z1);
+  FeSub(z3, z3, z2z2);
+  FeMul(z3, z3, h);
+  FinishAdd(r, u1, s1, h, rr, z3);
+}
+
+void PointAddMixed(JacobianPoint* r,
+                   const JacobianPoint* a,
+                   const P256_AFFINE_POINT* b) {
+  if (IsInfinity(a)) {
+    Copy(r->x, b->x);
+    Copy(r->y, b->y);
+    Copy(r->z, kOneP);
+    return;
+  }
+
+  uint64_t z1z1[4], u2[4], s2[4], h[4], rr[4];
+  FeSqr(z1z1, a->z);
+  FeMul(u2, b->x, z1z1);
+  FeMul(s2, b->y, a->z);
+  FeMul(s2, s2, z1z1);
+  FeSub(h, u2, a->x);
+  FeSub(rr, s2, a->y);
+
+  if (IsZero(h)) {
+    if (IsZero(rr)) {
+      PointDouble(r, a);
+    } else {
+      SetInfinity(r);
+    }
+    return;
+  }
+
+  uint64_t z3[4], hh[4];
+  FeSqr(hh, h);
+  FeAdd(z3, a->z, h);
+  FeSqr(z3, z3);
+  FeSub(z3, z3, z1z1);
+  FeSub(z3, z3, hh);
+  FinishAdd(r, a->x, a->y, h, rr, z3);
+}
+
+// BatchToAffine converts |count| points from |in| to |out| with a single
+// field inversion. It returns false if any of them is the point at infinity.
+bool BatchToAffine(P256_AFFINE_POINT* out,
+                   const JacobianPoint* in,
+                   size_t count) {
+  std::vector<uint64_t> products(4 * count);
+  for (size_t i = 0; i < count; i++) {
+    if (IsInfinity(&in[i])) {
+      return false;
+    }
+    if (i == 0) {
+      Copy(&products[0], in[0].z);
+    } else {
+      FeMul(&products[4 * i], &products[4 * (i - 1)], in[i].z);
+    }
+  }
+
+  uint64_t inverse[4];
+  FeInverse(inverse, &products[4 * (count - 1)]);
+  for (size_t i = count; i-- > 0;) {
+    uint64_t z_inverse[4], t[4];
+    if (i == 0) {
+      Copy(z_inverse, inverse);
+    } else {
+      FeMul(z_inverse, inverse, &products[4 * (i - 1)]);
+      FeMul(inverse, inverse, in[i].z);
+    }
+    FeSqr(t, z_inverse);
+    FeMul(out[i].x, in[i].x, t);
+    FeMul(t, t, z_inverse);
+    FeMul(out[i].y, in[i].y, t);
+  }
+  return true;
+}
+
+// BuildComb fills |out| with every non-empty sum of 2^(32 * t) * |base| for
+// teeth t in [first_tooth, first_tooth + teeth). The sum selected by the bits
+// of index i lives at |out|[i - 1].
+bool BuildComb(P256_AFFINE_POINT* out,
+               const JacobianPoint& base,
+               int first_tooth,
+               int teeth) {
+  JacobianPoint spaced[kGeneratorTeeth];
+  spaced[0] = base;
+  for (int i = 0; i < kCombSpacing * first_tooth; i++) {
+    PointDouble(&spaced[0], &spaced[0]);
+  }
+  for (int t = 1; t < teeth; t++) {
+    spaced[t] = spaced[t - 1];
+    for (int i = 0; i < kCombSpacing; i++) {
+      PointDouble(&spaced[t], &spaced[t]);
+    }
+  }
+
+  const size_t size = (size_t {1} << teeth) - 1;
+  std::vector<JacobianPoint> points(size);
+  for (size_t i = 1; i <= size; i++) {
+    int lowest = 0;
+    while (((i >> lowest) & 1) == 0) {
+      lowest++;
+    }
+    const size_t rest = i & (i - 1);
+    if (rest == 0) {
+      points[i - 1] = spaced[lowest];
+    } else {
+      PointAdd(&points[i - 1], &points[rest - 1], &spaced[lowest]);
+    }
+  }
+  return BatchToAffine(out, points.data(), size);
+}
+
+const P256_AFFINE_POINT* GeneratorComb() {
+  static P256_AFFINE_POINT table[kGeneratorCombSize];
+  static const bool initialized = [] {
+    JacobianPoint generator;
+    FeMul(generator.x, kGx, kPRR);
+    FeMul(generator.y, kGy, kPRR);
+    Copy(generator.z, kOneP);
+    return BuildComb(table, generator, 0, kGeneratorTeeth);
+  }();
+  (void)initialized;
+  return table;
+}
+
+unsigned CombIndex(const uint64_t scalar[4],
+                   int column,
+                   int first_tooth,
+                   int teeth) {
+  unsigned index = 0;
+  for (int t = 0; t < teeth; t++) {
+    index |= TestBit(scalar, column + kCombSpacing * (first_tooth + t)) << t;
+  }
+  return index;
+}
+
+// CombMul sets |r| to |g_scalar| * G + |q_scalar| * Q, sharing the doublings
+// between the generator comb and both halves of the key comb.
+void CombMul(JacobianPoint* r,
+             const uint64_t g_scalar[4],
+             const uint64_t q_scalar[4],
+             const P256_PUBLIC_KEY* key) {
+  const P256_AFFINE_POINT* g_comb = GeneratorComb();
+
+  SetInfinity(r);
+  for (int column = kCombSpacing - 1; column >= 0; column--) {
+    PointDouble(r, r);
+
+    unsigned index = CombIndex(g_scalar, column, 0, kGeneratorTeeth);
+    if (index != 0) {
+      PointAddMixed(r, r, &g_comb[index - 1]);
+    }
+    for (int half = 0; half < 2; half++) {
+      index = CombIndex(q_scalar, column, half * P256_COMB_TEETH,
+                        P256_COMB_TEETH);
+      if (index != 0) {
+        PointAddMixed(r, r, &key->comb[half][index - 1]);
+      }
+    }
+  }
+}
+
+bool IsOnCurve(const uint64_t x[4], const uint64_t y[4]) {
+  uint64_t lhs[4], rhs[4], t[4];
+  FeSqr(lhs, y);
+  FeSqr(rhs, x);
+  FeMul(rhs, rhs, x);
+  FeAdd(t, x, x);
+  FeAdd(t, t, x);
+  FeSub(rhs, rhs, t);
+  FeAdd(rhs, rhs, kB);
+  return IsEqual(lhs, rhs);
+}
+
+bool GetScalar(CBS* cbs, uint64_t out[4]) {
+  CBS integer;
+  if (!CBS_get_asn1(cbs, &integer, CBS_ASN1_INTEGER) ||
+      !CBS_is_unsigned_asn1_integer(&integer)) {
+    return false;
+  }
+
+  uint8_t leading;
+  if (CBS_len(&integer) > 1 && CBS_data(&integer)[0] == 0) {
+    CBS_get_u8(&integer, &leading);
+  }
+  if (CBS_len(&integer) > 32) {
+    return false;
+  }
+
+  uint8_t padded[32] = {};
+  safe_memcpy(padded + 32 - CBS_len(&integer), CBS_data(&integer),
+              CBS_len(&integer));
+  FromBytes(out, padded);
+  return !IsZero(out) && IsLess(out, kN);
+}
+
+bool ParseSignature(const uint8_t* sig,
+                    size_t sig_len,
+                    uint64_t r[4],
+                    uint64_t s[4]) {
+  CBS cbs, sequence;
+  CBS_init(&cbs, sig, sig_len);
+  return CBS_get_asn1(&cbs, &sequence, CBS_ASN1_SEQUENCE) &&
+         CBS_len(&cbs) == 0 && GetScalar(&sequence, r) &&
+         GetScalar(&sequence, s) && CBS_len(&sequence) == 0;
+}
+
+}  // namespace
+
+int P256_PUBLIC_KEY_init(P256_PUBLIC_KEY* key, const uint8_t* in, size_t len) {
+  if (len != 65 || in[0] != 4) {
+    return 0;
+  }
+
+  uint64_t x[4], y[4];
+  FromBytes(x, in + 1);
+  FromBytes(y, in + 33);
+  if (!IsLess(x, kP) || !IsLess(y, kP)) {
+    return 0;
+  }
+
+  JacobianPoint point;
+  FeMul(point.x, x, kPRR);
+  FeMul(point.y, y, kPRR);
+  Copy(point.z, kOneP);
+  if (!IsOnCurve(point.x, point.y)) {
+    return 0;
+  }
+
+  return BuildComb(key->comb[0], point, 0, P256_COMB_TEETH) &&
+         BuildComb(key->comb[1], point, P256_COMB_TEETH, P256_COMB_TEETH);
+}
+
+int P256_verify_digest(const P256_PUBLIC_KEY* key,
+                       const uint8_t digest[32],
+                       const uint8_t* sig,
+                       size_t sig_len) {
+  uint64_t r[4], s[4];
+  if (!ParseSignature(sig, sig_len, r, s)) {
+    return 0;
+  }
+
+  // The digest is as wide as n, so it needs at most one subtraction.
+  uint64_t e[4];
+  FromBytes(e, digest);
+  if (!IsLess(e, kN)) {
+    SubLimbs(e, e, kN);
+  }
+
+  // u1 = e / s and u2 = r / s. Multiplying plain values by the Montgomery
+  // form of 1 / s leaves the results as plain integers.
+  uint64_t s_inverse[4], u1[4], u2[4];
+  MontMul(s_inverse, s, kNRR, kN, kN0);
+  MontInverse(s_inverse, s_inverse, kN, kN0, kOneN);
+  MontMul(u1, e, s_inverse, kN, kN0);
+  MontMul(u2, r, s_inverse, kN, kN0);
+
+  JacobianPoint point;
+  CombMul(&point, u1, u2, key);
+  if (IsInfinity(&point)) {
+    return 0;
+  }
+
+  // Compare r with x = X / Z^2 without inverting Z. Since n < p, x may also
+  // have been reduced to r from r + n.
+  uint64_t zz[4], candidate[4], t[4];
+  FeSqr(zz, point.z);
+  FeMul(candidate, r, kPRR);
+  FeMul(t, candidate, zz);
+  if (IsEqual(t, point.x)) {
+    return 1;
+  }
+  if (AddLimbs(candidate, r, kN) != 0 || !IsLess(candidate, kP)) {
+    return 0;
+  }
+  FeMul(candidate, candidate, kPRR);
+  FeMul(t, candidate, zz);
+  return IsEqual(t, point.x) ? 1 : 0;
+}
+
+}  // namespace certificate_transparency
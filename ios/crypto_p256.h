@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace certificate_transparency {
+
+// ECDSA P-256 verification for the portable backend.
+//
+// CT log keys are long-lived, so every key carries two Lim-Lee comb tables for
+// its point, built once by |P256_PUBLIC_KEY_init|. Together with the shared
+// comb table for the generator, a verification is a single double-scalar
+// multiplication of 32 doublings and at most 96 mixed additions. None of the
+// inputs are secret, so nothing here attempts to be constant-time.
+
+// P256_COMB_TEETH is the number of teeth in each of the two per-key combs.
+#define P256_COMB_TEETH 4
+#define P256_COMB_SIZE ((1 << P256_COMB_TEETH) - 1)
+
+// P256_AFFINE_POINT is a point in affine coordinates with both coordinates in
+// the Montgomery domain, as four little-endian 64-bit limbs.
+struct P256_AFFINE_POINT {
+  uint64_t x[4];
+  uint64_t y[4];
+};
+
+struct P256_PUBLIC_KEY {
+  // comb[0][i - 1] is sum(bit(i, t) * 2^(32 * t) * Q) for t in [0, 4) and
+  // comb[1][i - 1] is the same for t in [4, 8). 1920 bytes per key.
+  P256_AFFINE_POINT comb[2][P256_COMB_SIZE];
+};
+
+// P256_PUBLIC_KEY_init parses |len| bytes from |in| as an uncompressed X9.62
+// point, checks it is on the curve and fills in the comb tables of |key|. It
+// returns one on success and zero otherwise.
+int P256_PUBLIC_KEY_init(P256_PUBLIC_KEY* key, const uint8_t* in, size_t len);
+
+// P256_verify_digest checks the DER-encoded ECDSA signature of |sig_len| bytes
+// at |sig| over the 32-byte |digest|. It returns one if the signature is valid
+// and zero otherwise.
+int P256_verify_digest(const P256_PUBLIC_KEY* key,
+                       const uint8_t digest[32],
+                       const uint8_t* sig,
+                       size_t sig_len);
+
+}  // namespace certificate_transparency
@@ -0,0 +1,185 @@
+#include "crypto_rsa.h"
+
+#include "crypto_bignum.h"
+#include "crypto_bytestring.h"
+#include "safe_cstring.h"
+
+namespace certificate_transparency {
+namespace {
+
+// The DER prefix of a DigestInfo with SHA-256, see RFC 8017, Section 9.2.
+const uint8_t kSHA256DigestInfoPrefix[] = {
+    0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+    0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20,
+};
+
+constexpr uint64_t kF4 = 65537;
+
+bool IsLess(const uint64_t* a, const uint64_t* b, size_t num) {
+  for (size_t i = num; i-- > 0;) {
+    if (a[i] != b[i]) {
+      return a[i] < b[i];
+    }
+  }
+  return false;
+}
+
+// ModDouble sets |r| to 2 * |r| mod |m|, where |r| < |m|.
+void ModDouble(uint64_t* r, const uint64_t* m, size_t num) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < num; i++) {
+    const uint64_t next_carry = r[i] >> 63;
+    r[i] = (r[i] << 1) | carry;
+    carry = next_carry;
+  }
+  if (carry || !IsLess(r, m, num)) {
+    bn_sub_words(r, r, m, num);
+  }
+}
+
+// MontMul sets |r| to |a| * |b| / 2^(64 * num) mod |key|->n using |t| as
+// |num| + 2 limbs of scratch space. |a| and |b| must be reduced. |r| may alias
+// either input.
+void MontMul(uint64_t* r,
+             const uint64_t* a,
+             const uint64_t* b,
+             const RSA_PUBLIC_KEY* key,
+             uint64_t* t) {
+  const size_t num = key->n.size();
+  const uint64_t* m = key->n.data();
+  safe_memset(t, 0, (num + 2) * sizeof(uint64_t));
+  for (size_t i = 0; i < num; i++) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < num; j++) {
+      t[j] = bn_mul_add(a[j], b[i], t[j], carry, &carry);
+    }
+    t[num] += carry;
+    t[num + 1] = t[num] < carry;
+
+    const uint64_t q = t[0] * key->n0;
+    bn_mul_add(q, m[0], t[0], 0, &carry);
+    for (size_t j = 1; j < num; j++) {
+      t[j - 1] = bn_mul_add(q, m[j], t[j], carry, &carry);
+    }
+    t[num - 1] = t[num] + carry;
+    t[num] = t[num + 1] + (t[num - 1] < carry);
+  }
+
+  // t < 2m here, so a single conditional subtraction is enough.
+  if (bn_sub_words(r, t, m, num) && t[num] == 0) {
+    safe_memcpy(r, t, num * sizeof(uint64_t));
+  }
+}
+
+bool ParseModulus(CBS* cbs, RSA_PUBLIC_KEY* key) {
+  CBS modulus;
+  if (!CBS_get_asn1(cbs, &modulus, CBS_ASN1_INTEGER) ||
+      !CBS_is_unsigned_asn1_integer(&modulus)) {
+    return false;
+  }
+  uint8_t leading;
+  if (CBS_len(&modulus) > 1 && CBS_data(&modulus)[0] == 0) {
+    CBS_get_u8(&modulus, &leading);
+  }
+
+  const size_t size = CBS_len(&modulus);
+  if (size * 8 < RSA_MIN_MODULUS_BITS || size * 8 > RSA_MAX_MODULUS_BITS ||
+      (CBS_data(&modulus)[size - 1] & 1) == 0) {
+    return false;
+  }
+
+  key->size = size;
+  key->n.resize((size + 7) / 8);
+  bn_from_bytes_be(key->n.data(), key->n.size(), CBS_data(&modulus), size);
+  return true;
+}
+
+}  // namespace
+
+int RSA_PUBLIC_KEY_init(RSA_PUBLIC_KEY* key, const uint8_t* in, size_t len) {
+  CBS cbs, public_key;
+  CBS_init(&cbs, in, len);
+  if (!CBS_get_asn1(&cbs, &public_key, CBS_ASN1_SEQUENCE) ||
+      CBS_len(&cbs) != 0 || !ParseModulus(&public_key, key) ||
+      !CBS_get_asn1_uint64(&public_key, &key->e) ||
+      CBS_len(&public_key) != 0 || key->e < 3 || (key->e & 1) == 0) {
+    return 0;
+  }
+
+  const size_t num = key->n.size();
+  key->n0 = bn_neg_inverse_u64(key->n[0]);
+
+  // 1 < n, so doubling it 128 * num times leaves 2^(128 * num) mod n.
+  key->rr.assign(num, 0);
+  key->rr[0] = 1;
+  for (size_t i = 0; i < 128 * num; i++) {
+    ModDouble(key->rr.data(), key->n.data(), num);
+  }
+  return 1;
+}
+
+int RSA_verify_pkcs1_sha256(const RSA_PUBLIC_KEY* key,
+                            const uint8_t digest[32],
+                            const uint8_t* sig,
+                            size_t sig_len) {
+  const size_t num = key->n.size();
+  if (sig_len != key->size) {
+    return 0;
+  }
+
+  uint64_t base[RSA_MAX_LIMBS], acc[RSA_MAX_LIMBS];
+  uint64_t scratch[RSA_MAX_LIMBS + 2];
+  bn_from_bytes_be(acc, num, sig, sig_len);
+  if (!IsLess(acc, key->n.data(), num)) {
+    return 0;
+  }
+
+  // Raise the signature to e in the Montgomery domain.
+  MontMul(base, acc, key->rr.data(), key, scratch);
+  safe_memcpy(acc, base, num * sizeof(uint64_t));
+  if (key->e == kF4) {
+    for (int i = 0; i < 16; i++) {
+      MontMul(acc, acc, acc, key, scratch);
+    }
+    MontMul(acc, acc, base, key, scratch);
+  } else {
+    int bit = 63;
+    while (((key->e >> bit) & 1) == 0) {
+      bit--;
+    }
+    while (bit-- > 0) {
+      MontMul(acc, acc, acc, key, scratch);
+      if ((key->e >> bit) & 1) {
+        MontMul(acc, acc, base, key, scratch);
+      }
+    }
+  }
+
+  // Leave the Montgomery domain by multiplying with 1.
+  safe_memset(base, 0, num * sizeof(uint64_t));
+  base[0] = 1;
+  MontMul(acc, acc, base, key, scratch);
+
+  // EM = 0x00 || 0x01 || PS || 0x00 || DigestInfo, RFC 8017, Section 9.2.
+  uint8_t em[RSA_MAX_MODULUS_BITS / 8];
+  for (size_t i = 0; i < sig_len; i++) {
+    em[sig_len - 1 - i] = static_cast<uint8_t>(acc[i / 8] >> (8 * (i % 8)));
+  }
+
+  const size_t t_len = sizeof(kSHA256DigestInfoPrefix) + 32;
+  const size_t ps_len = sig_len - 3 - t_len;
+  if (em[0] != 0x00 || em[1] != 0x01 || em[2 + ps_len] != 0x00) {
+    return 0;
+  }
+  for (size_t i = 0; i < ps_len; i++) {
+    if (em[2 + i] != 0xff) {
+      return 0;
+    }
+  }
+  const uint8_t* t = em + 3 + ps_len;
+  return safe_memcmp(t, kSHA256DigestInfoPrefix,
+                     sizeof(kSHA256DigestInfoPrefix)) == 0 &&
+         safe_memcmp(t + sizeof(kSHA256DigestInfoPrefix), digest, 32) == 0;
+}
+
+}  // namespace certificate_transparency
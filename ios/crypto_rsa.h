@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace certificate_transparency {
+
+// RSASSA-PKCS1-v1_5 with SHA-256 verification for the portable backend.
+//
+// The Montgomery constants of a log key are computed once by
+// |RSA_PUBLIC_KEY_init|, so a verification only runs the exponentiation. The
+// common public exponent 65537 takes a fixed chain of 16 squarings and one
+// multiplication. Nothing here attempts to be constant-time.
+
+// RSA_MIN_MODULUS_BITS matches the 2048-bit floor of the Security framework
+// backend. RSA_MAX_MODULUS_BITS bounds the work of a single verification.
+#define RSA_MIN_MODULUS_BITS 2048
+#define RSA_MAX_MODULUS_BITS 8192
+#define RSA_MAX_LIMBS (RSA_MAX_MODULUS_BITS / 64)
+
+struct RSA_PUBLIC_KEY {
+  // The modulus as little-endian 64-bit limbs.
+  std::vector<uint64_t> n;
+  // 2^(128 * n.size()) mod n, to enter the Montgomery domain.
+  std::vector<uint64_t> rr;
+  // -n^-1 mod 2^64.
+  uint64_t n0 = 0;
+  uint64_t e = 0;
+  // The length of the modulus, and of every signature, in bytes.
+  size_t size = 0;
+};
+
+// RSA_PUBLIC_KEY_init parses |len| bytes from |in| as a DER RSAPublicKey and
+// precomputes the Montgomery constants of |key|. It returns one on success and
+// zero otherwise.
+int RSA_PUBLIC_KEY_init(RSA_PUBLIC_KEY* key, const uint8_t* in, size_t len);
+
+// RSA_verify_pkcs1_sha256 checks the |sig_len| byte signature at |sig| over
+// the 32-byte SHA-256 |digest|. It returns one if the signature is valid and
+// zero otherwise.
+int RSA_verify_pkcs1_sha256(const RSA_PUBLIC_KEY* key,
+                            const uint8_t digest[32],
+                            const uint8_t* sig,
+                            size_t sig_len);
+
+}  // namespace certificate_transparency
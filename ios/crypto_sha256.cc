@@ -0,0 +1,162 @@
+#include "crypto_sha256.h"
+
+#if !defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+#include <CommonCrypto/CommonDigest.h>
+#endif
+
+#include "safe_cstring.h"
+
+namespace certificate_transparency {
+namespace {
+
+const uint32_t kK[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t RotateRight(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t LoadBE32(const uint8_t* in) {
+  return (static_cast<uint32_t>(in[0]) << 24) |
+         (static_cast<uint32_t>(in[1]) << 16) |
+         (static_cast<uint32_t>(in[2]) << 8) | static_cast<uint32_t>(in[3]);
+}
+
+inline void StoreBE32(uint8_t* out, uint32_t v) {
+  out[0] = static_cast<uint8_t>(v >> 24);
+  out[1] = static_cast<uint8_t>(v >> 16);
+  out[2] = static_cast<uint8_t>(v >> 8);
+  out[3] = static_cast<uint8_t>(v);
+}
+
+void ProcessBlocks(uint32_t* state, const uint8_t* data, size_t num_blocks) {
+  uint32_t w[64];
+  while (num_blocks--) {
+    for (int i = 0; i < 16; i++) {
+      w[i] = LoadBE32(data + 4 * i);
+    }
+    for (int i = 16; i < 64; i++) {
+      uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^
+                    (w[i - 15] >> 3);
+      uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^
+                    (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int i = 0; i < 64; i++) {
+      uint32_t s1 =
+          RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+      uint32_t ch = (e & f) ^ (~e & g);
+      uint32_t t1 = h + s1 + ch + kK[i] + w[i];
+      uint32_t s0 =
+          RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+      uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+      uint32_t t2 = s0 + maj;
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+    data += kSHA256BlockSize;
+  }
+}
+
+}  // namespace
+
+void SHA256_Init(SHA256_CTX* ctx) {
+  static const uint32_t kInitialState[8] = {
+      0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+  safe_memcpy(ctx->h, kInitialState, sizeof(kInitialState));
+  ctx->num_bytes = 0;
+  ctx->num = 0;
+}
+
+void SHA256_Update(SHA256_CTX* ctx, const void* in_data, size_t len) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(in_data);
+  ctx->num_bytes += len;
+
+  if (ctx->num != 0) {
+    size_t n = kSHA256BlockSize - ctx->num;
+    if (len < n) {
+      safe_memcpy(ctx->data + ctx->num, data, len);
+      ctx->num += len;
+      return;
+    }
+    safe_memcpy(ctx->data + ctx->num, data, n);
+    ProcessBlocks(ctx->h, ctx->data, 1);
+    data += n;
+    len -= n;
+    ctx->num = 0;
+  }
+
+  size_t num_blocks = len / kSHA256BlockSize;
+  if (num_blocks != 0) {
+    ProcessBlocks(ctx->h, data, num_blocks);
+    data += num_blocks * kSHA256BlockSize;
+    len -= num_blocks * kSHA256BlockSize;
+  }
+
+  safe_memcpy(ctx->data, data, len);
+  ctx->num = len;
+}
+
+void SHA256_Final(uint8_t out[kSHA256DigestLength], SHA256_CTX* ctx) {
+  const uint64_t num_bits = ctx->num_bytes * 8;
+
+  ctx->data[ctx->num++] = 0x80;
+  if (ctx->num > kSHA256BlockSize - 8) {
+    safe_memset(ctx->data + ctx->num, 0, kSHA256BlockSize - ctx->num);
+    ProcessBlocks(ctx->h, ctx->data, 1);
+    ctx->num = 0;
+  }
+  safe_memset(ctx->data + ctx->num, 0, kSHA256BlockSize - 8 - ctx->num);
+  StoreBE32(ctx->data + kSHA256BlockSize - 8,
+            static_cast<uint32_t>(num_bits >> 32));
+  StoreBE32(ctx->data + kSHA256BlockSize - 4, static_cast<uint32_t>(num_bits));
+  ProcessBlocks(ctx->h, ctx->data, 1);
+
+  for (int i = 0; i < 8; i++) {
+    StoreBE32(out + 4 * i, ctx->h[i]);
+  }
+}
+
+void SHA256(const void* data, size_t len, uint8_t out[kSHA256DigestLength]) {
+#if defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+  SHA256_CTX ctx;
+  SHA256_Init(&ctx);
+  SHA256_Update(&ctx, data, len);
+  SHA256_Final(out, &ctx);
+#else
+  CC_SHA256(data, static_cast<CC_LONG>(len), out);
+#endif
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ct_config.h"
+
+namespace certificate_transparency {
+
+constexpr size_t kSHA256DigestLength = 32;
+constexpr size_t kSHA256BlockSize = 64;
+
+struct SHA256_CTX {
+  uint32_t h[8];
+  uint64_t num_bytes;
+  uint8_t data[kSHA256BlockSize];
+  size_t num;
+};
+
+// SHA256_Init initialises |ctx|.
+void SHA256_Init(SHA256_CTX* ctx);
+
+// SHA256_Update adds |len| bytes from |data| to |ctx|.
+void SHA256_Update(SHA256_CTX* ctx, const void* data, size_t len);
+
+// SHA256_Final writes the digest of everything added to |ctx| to |out|, which
+// must have room for |kSHA256DigestLength| bytes.
+void SHA256_Final(uint8_t out[kSHA256DigestLength], SHA256_CTX* ctx);
+
+// SHA256 writes the digest of |len| bytes from |data| to |out|. On Apple
+// platforms it forwards to CommonCrypto.
+void SHA256(const void* data, size_t len, uint8_t out[kSHA256DigestLength]);
+
+}  // namespace certificate_transparency
@@ -0,0 +1,162 @@
+#include "ct_c_api.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "log_list_parser.h"
+#include "log_verifier.h"
+#include "multi_log_verifier.h"
+
+namespace ct = certificate_transparency;
+
+struct ct_verifier {
+  // Null for the builtin verifier, which is not owned.
+  std::unique_ptr<ct::MultiLogVerifier> owned;
+  const ct::MultiLogVerifier* verifier;
+};
+
+namespace {
+
+static_assert(static_cast<int>(ct::SCTStatus::kNotChecked) ==
+                      CT_SCT_NOT_CHECKED &&
+                  static_cast<int>(ct::SCTStatus::kOk) == CT_SCT_OK &&
+                  static_cast<int>(ct::SCTStatus::kUnknownLog) ==
+                      CT_SCT_UNKNOWN_LOG &&
+                  static_cast<int>(ct::SCTStatus::kBadParams) ==
+                      CT_SCT_BAD_PARAMS &&
+                  static_cast<int>(ct::SCTStatus::kFutureTimestamp) ==
+                      CT_SCT_FUTURE_TIMESTAMP &&
+                  static_cast<int>(ct::SCTStatus::kBadSignature) ==
+                      CT_SCT_BAD_SIGNATURE &&
+                  static_cast<int>(ct::SCTStatus::kDuplicateLog) ==
+                      CT_SCT_DUPLICATE_LOG,
+              "ct_sct_status must match SCTStatus");
+
+std::string_view View(const ct_span& span) {
+  if (!span.data) {
+    return std::string_view();
+  }
+  return std::string_view(reinterpret_cast<const char*>(span.data),
+                          span.size);
+}
+
+ct_verifier* NewVerifier(std::unique_ptr<ct::MultiLogVerifier> verifier) {
+  const ct::MultiLogVerifier* pointer = verifier.get();
+  return new ct_verifier{std::move(verifier), pointer};
+}
+
+bool VerifyChain(const ct_verifier* verifier,
+                 const ct_chain& chain,
+                 uint64_t now) {
+  return verifier->verifier->Verify(View(chain.leaf), View(chain.issuer), now);
+}
+
+}  // namespace
+
+uint32_t ct_c_api_version(void) {
+  return CT_C_API_VERSION;
+}
+
+ct_verifier* ct_verifier_new_from_log_list(const uint8_t* log_list,
+                                           size_t size) {
+  const std::optional<std::vector<std::string>> logs =
+      ct::ParseLogList(View({log_list, size}));
+  if (!logs) {
+    return nullptr;
+  }
+  std::vector<std::shared_ptr<const ct::LogVerifier>> valid_logs;
+  for (const std::string& key : *logs) {
+    auto log = std::make_shared<const ct::LogVerifier>(key);
+    if (log->IsValid()) {
+      valid_logs.push_back(std::move(log));
+    }
+  }
+  if (valid_logs.empty()) {
+    return nullptr;
+  }
+  return NewVerifier(std::make_unique<ct::MultiLogVerifier>(
+      std::move(valid_logs), ct::VerificationLimits()));
+}
+
+ct_verifier* ct_verifier_new_from_keys(const ct_span* keys, size_t count) {
+  if (count == 0) {
+    return nullptr;
+  }
+  std::vector<std::shared_ptr<const ct::LogVerifier>> logs;
+  logs.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    auto log = std::make_shared<const ct::LogVerifier>(View(keys[i]));
+    if (!log->IsValid()) {
+      return nullptr;
+    }
+    logs.push_back(std::move(log));
+  }
+  return NewVerifier(std::make_unique<ct::MultiLogVerifier>(
+      std::move(logs), ct::VerificationLimits()));
+}
+
+const ct_verifier* ct_verifier_builtin(void) {
+  static const auto* builtin =
+      new ct_verifier{nullptr, &ct::GetBuiltinLogVerifier()};
+  return builtin;
+}
+
+void ct_verifier_free(ct_verifier* verifier) {
+  if (verifier && verifier->owned) {
+    delete verifier;
+  }
+}
+
+int ct_verify(const ct_verifier* verifier,
+              const ct_chain* chain,
+              uint64_t now) {
+  return VerifyChain(verifier, *chain, now) ? 1 : 0;
+}
+
+size_t ct_verify_scts(const ct_verifier* verifier,
+                      const ct_chain* chain,
+                      uint64_t now,
+                      ct_sct_result* results,
+                      size_t capacity) {
+  const ct::MultiLogVerifier& multi_log_verifier = *verifier->verifier;
+  ct::PreparedChain prepared;
+  ct::PrepareChain(View(chain->leaf), View(chain->issuer),
+                   multi_log_verifier.limits(), &prepared);
+  if (!prepared.valid) {
+    return 0;
+  }
+  const ct::VerificationDetails details =
+      multi_log_verifier.CheckAllSCTs(prepared, now);
+  const size_t count = std::min(prepared.scts.size(), ct::kMaxReportedSCTs);
+  for (size_t i = 0; i < count && i < capacity; i++) {
+    const ct::SignedCertificateTimestamp& sct = prepared.scts[i];
+    ct_sct_result& result = results[i];
+    memset(result.log_id, 0, sizeof(result.log_id));
+    memcpy(result.log_id, sct.log_id.data(),
+           std::min(sct.log_id.size(), sizeof(result.log_id)));
+    result.timestamp = sct.timestamp;
+    result.status = static_cast<uint32_t>(details.sct_status[i]);
+  }
+  return count;
+}
+
+size_t ct_verify_batch(const ct_verifier* verifier,
+                       const ct_chain* chains,
+                       size_t count,
+                       uint64_t now,
+                       uint8_t* verdicts) {
+  memset(verdicts, 0, (count + 7) / 8);
+  size_t verified = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (VerifyChain(verifier, chains[i], now)) {
+      verdicts[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+      verified++;
+    }
+  }
+  return verified;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+// A C interface to MultiLogVerifier for callers that can't use C++, such as
+// Go and Rust services. Only the functions here are exported when the core
+// is built as a shared library with hidden visibility:
+//
+//   c++ -std=c++17 -O2 -fPIC -shared -fvisibility=hidden -fno-exceptions
+//       -fno-rtti -I. -o libcertificate_transparency.so *.cc -pthread
+//
+// The ABI only grows: functions and structs keep their meaning, and
+// CT_C_API_VERSION goes up when functions are added. Certificates are passed
+// as spans of caller-owned memory, read during the call and not copied or
+// kept. Verifiers are thread-safe.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__)
+#define CT_C_API_EXPORT __attribute__((visibility("default")))
+#else
+#define CT_C_API_EXPORT
+#endif
+
+#define CT_C_API_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ct_verifier ct_verifier;
+
+typedef struct ct_span {
+  const uint8_t* data;
+  size_t size;
+} ct_span;
+
+// A DER encoded leaf and the certificate that issued it.
+typedef struct ct_chain {
+  ct_span leaf;
+  ct_span issuer;
+} ct_chain;
+
+// What became of one SCT in ct_verify_scts().
+typedef enum ct_sct_status {
+  // Not looked at, because the verifier's signature checks were spent.
+  CT_SCT_NOT_CHECKED = 0,
+  CT_SCT_OK = 1,
+  // Not from a log of the verifier.
+  CT_SCT_UNKNOWN_LOG = 2,
+  // Signed with a hash or signature algorithm other than its log's.
+  CT_SCT_BAD_PARAMS = 3,
+  CT_SCT_FUTURE_TIMESTAMP = 4,
+  CT_SCT_BAD_SIGNATURE = 5,
+  // Not checked, because an SCT from the same log passed before.
+  CT_SCT_DUPLICATE_LOG = 6,
+} ct_sct_status;
+
+typedef struct ct_sct_result {
+  // The SHA-256 of the log's key, as in the SCT.
+  uint8_t log_id[32];
+  // In milliseconds since the epoch.
+  uint64_t timestamp;
+  // A ct_sct_status.
+  uint32_t status;
+} ct_sct_result;
+
+// Returns the CT_C_API_VERSION of the library, which may be newer than the
+// header the caller was built with.
+CT_C_API_EXPORT uint32_t ct_c_api_version(void);
+
+// Creates a verifier for the logs of a log list JSON document, as served at
+// the update URL. Returns NULL if |log_list| is not a log list or has no
+// valid logs: a verifier without logs would let every chain pass, so a list
+// that came out empty fails here rather than open.
+CT_C_API_EXPORT ct_verifier* ct_verifier_new_from_log_list(
+    const uint8_t* log_list,
+    size_t size);
+
+// Creates a verifier for |count| logs given by their DER encoded
+// SubjectPublicKeyInfo. Returns NULL if any of the keys doesn't parse, rather
+// than drop it and enforce fewer logs than asked, and if |count| is 0.
+CT_C_API_EXPORT ct_verifier* ct_verifier_new_from_keys(const ct_span* keys,
+                                                       size_t count);
+
+// Returns the verifier for the builtin logs. It lives as long as the
+// process; passing it to ct_verifier_free() does nothing.
+CT_C_API_EXPORT const ct_verifier* ct_verifier_builtin(void);
+
+CT_C_API_EXPORT void ct_verifier_free(ct_verifier* verifier);
+
+// Returns 1 if the SCTs embedded in |chain|'s leaf satisfy the verifier at
+// |now|, in milliseconds since the epoch, and 0 otherwise.
+CT_C_API_EXPORT int ct_verify(const ct_verifier* verifier,
+                              const ct_chain* chain,
+                              uint64_t now);
+
+// Checks the SCTs embedded in |chain|'s leaf against the verifier's logs at
+// |now|, for callers that apply a policy of their own: unlike ct_verify(),
+// it doesn't stop once two logs have passed. The SCTs that decode, at most
+// 16, are reported in the order of the leaf's list: the first |capacity| of
+// them are written to |results|, and their number, which may be larger, is
+// returned. Returns 0 if the leaf has no well-formed SCT list.
+CT_C_API_EXPORT size_t ct_verify_scts(const ct_verifier* verifier,
+                                      const ct_chain* chain,
+                                      uint64_t now,
+                                      ct_sct_result* results,
+                                      size_t capacity);
+
+// Verifies |count| chains in one call, which saves the cost of crossing
+// into the library per chain. The verdict of chain i is bit i % 8 of
+// |verdicts|[i / 8], which must hold (|count| + 7) / 8 bytes; unused bits
+// of the last byte are cleared. Returns the number of chains verified.
+CT_C_API_EXPORT size_t ct_verify_batch(const ct_verifier* verifier,
+                                       const ct_chain* chains,
+                                       size_t count,
+                                       uint64_t now,
+                                       uint8_t* verdicts);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
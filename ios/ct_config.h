@@ -0,0 +1,13 @@
+#pragma once
+
+// Apple platforms verify signatures and compute digests with the Security
+// framework and CommonCrypto. Everywhere else, or when the build defines
+// CERTIFICATE_TRANSPARENCY_PORTABLE explicitly, the self-contained portable
+// backend is used instead.
+#if !defined(__APPLE__) && !defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+#define CERTIFICATE_TRANSPARENCY_PORTABLE 1
+#endif
+
+// Per-stage latency histograms and counters (metrics.h) are recorded only
+// when the build defines CERTIFICATE_TRANSPARENCY_METRICS. Otherwise the
+// recording sites compile to nothing.
@@ -2,35 +2,20 @@
 
 #import <Foundation/Foundation.h>
 
-#include <functional>
 #include <optional>
 #include <string>
-#include <variant>
-#include <vector>
+
+#include "log_list_updater.h"
 
 namespace certificate_transparency {
 
-class CTLogDownloader {
+class CTLogDownloader : public LogListTransport {
  public:
-  struct Ok {
-    Ok();
-    Ok(const Ok& other);
-    ~Ok();
-
-    std::optional<std::string> tag;
-    std::vector<std::string> logs;
-  };
-  struct NotModified {};
-  using ErrorCode = int;
-
-  using DownloadResult = std::variant<Ok, NotModified, ErrorCode>;
-  using DownloadCallback = std::function<void(DownloadResult)>;
-
   explicit CTLogDownloader(NSURL* update_url);
-  ~CTLogDownloader();
+  ~CTLogDownloader() override;
 
-  void
-  Download(const std::optional<std::string>& tag, DownloadCallback callback);
+  void Fetch(const std::optional<std::string>& tag,
+             FetchCallback callback) override;
 
  private:
   NSURL* update_url_;
@@ -1,8 +1,11 @@
 #include "ct_log_downloader.h"
 
 #include <optional>
+#include <string_view>
+#include <utility>
 
 #include "ct_version.h"
+#include "log_list_parser.h"
 
 namespace certificate_transparency {
 namespace {
@@ -17,62 +20,39 @@ NSString* ToNSString(const std::string& str) {
   return [[NSString alloc] initWithUTF8String:str.c_str()];
 }
 
-std::optional<std::vector<std::string>> Parse(NSData* data) {
+// Parses the log list in |data| into |result|. The list is parsed as by the
+// portable transports, so a "revocations" member that doesn't decode fails
+// the whole document.
+bool Parse(NSData* data, LogListTransport::Ok* result) {
   if (!data) {
-    return {};
+    return false;
   }
-
-  id json = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
-  if (!json || ![json isKindOfClass:[NSDictionary class]]) {
-    return {};
+  auto logs = ParseLogList(
+      std::string_view(static_cast<const char*>([data bytes]), [data length]),
+      &result->revocations);
+  if (!logs) {
+    return false;
   }
+  result->logs = std::move(*logs);
+  return true;
+}
 
-  id operators = ((NSDictionary*)json)[@"operators"];
-  if (!operators || ![operators isKindOfClass:[NSArray class]]) {
-    return {};
+ScheduleHints GetScheduleHints(NSDictionary* headers) {
+  ScheduleHints hints;
+  id cache_control = headers[@"Cache-Control"];
+  if (cache_control && [cache_control isKindOfClass:[NSString class]]) {
+    hints.max_age =
+        ParseCacheControlMaxAge([(NSString*)cache_control UTF8String]);
   }
-
-  std::vector<std::string> result;
-  for (id op in (NSArray*)operators) {
-    if (![op isKindOfClass:[NSDictionary class]]) {
-      continue;
-    }
-
-    id logs = ((NSDictionary*)op)[@"logs"];
-    if (!logs || ![logs isKindOfClass:[NSArray class]]) {
-      continue;
-    }
-
-    for (id log in (NSArray*)logs) {
-      if (![log isKindOfClass:[NSDictionary class]]) {
-        continue;
-      }
-
-      id key = ((NSDictionary*)log)[@"key"];
-      if (!key || ![key isKindOfClass:[NSString class]]) {
-        continue;
-      }
-
-      NSData* key_data =
-          [[NSData alloc] initWithBase64EncodedString:(NSString*)key options:0];
-      if (!key_data) {
-        continue;
-      }
-
-      result.emplace_back(
-          reinterpret_cast<const char*>([key_data bytes]), [key_data length]);
-    }
+  id retry_after = headers[@"Retry-After"];
+  if (retry_after && [retry_after isKindOfClass:[NSString class]]) {
+    hints.retry_after = ParseRetryAfter([(NSString*)retry_after UTF8String]);
   }
-
-  return result;
+  return hints;
 }
 
 }  // namespace
 
-CTLogDownloader::Ok::Ok() = default;
-CTLogDownloader::Ok::Ok(const Ok& other) = default;
-CTLogDownloader::Ok::~Ok() = default;
-
 CTLogDownloader::CTLogDownloader(NSURL* update_url)
     : update_url_(update_url),
       user_agent_(GetUserAgent()),
@@ -84,9 +64,8 @@ CTLogDownloader::CTLogDownloader(NSURL* update_url)
 
 CTLogDownloader::~CTLogDownloader() = default;
 
-void CTLogDownloader::Download(
-    const std::optional<std::string>& tag,
-    DownloadCallback callback) {
+void CTLogDownloader::Fetch(const std::optional<std::string>& tag,
+                            FetchCallback callback) {
   NSMutableURLRequest* request =
       [[NSMutableURLRequest alloc] initWithURL:update_url_];
   [request setValue:user_agent_ forHTTPHeaderField:@"User-Agent"];
@@ -103,36 +82,34 @@ void CTLogDownloader::Download(
           current_task = nil;
 
           if (!response) {
-            callback(ErrorCode(-1));
+            callback(ErrorCode(-1), {});
             return;
           }
 
           NSHTTPURLResponse* http_response = (NSHTTPURLResponse*)response;
+          NSDictionary* headers = [http_response allHeaderFields];
+          const ScheduleHints hints = GetScheduleHints(headers);
           if (http_response.statusCode == 304) {
-            callback(NotModified());
+            callback(NotModified(), hints);
             return;
           }
           if (http_response.statusCode != 200) {
-            callback(ErrorCode(http_response.statusCode));
+            callback(ErrorCode(http_response.statusCode), hints);
             return;
           }
 
-          auto logs = Parse(data);
-          if (!logs) {
-            callback(ErrorCode(-2));
+          Ok result;
+          if (!Parse(data, &result)) {
+            callback(ErrorCode(-2), hints);
             return;
           }
 
-          Ok result;
-          result.logs = std::move(*logs);
-
-          NSDictionary* headers = [http_response allHeaderFields];
           NSString* response_tag = headers[@"ETag"];
           if (response_tag) {
             result.tag = [response_tag UTF8String];
           }
 
-          callback(std::move(result));
+          callback(std::move(result), hints);
         }];
   current_task = task;
   [task resume];
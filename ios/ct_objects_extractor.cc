@@ -1,10 +1,10 @@
 #include "ct_objects_extractor.h"
 
-#include <CommonCrypto/CommonDigest.h>
 #include <cassert>
 
 #include "crypto_bytebuilder.h"
 #include "crypto_bytestring.h"
+#include "crypto_sha256.h"
 #include "internal_types.h"
 
 namespace certificate_transparency {
@@ -57,15 +57,24 @@ bool CopyAfter(const CBS& outer, const CBS& inner, CBB* out) {
       CBS_data(&outer) + CBS_len(&outer) - CBS_data(&inner) - CBS_len(&inner));
 }
 
+// Finds the extension with |oid| in |extensions|. If |limit| is set, fails
+// once more than |limit|->max_extensions extensions have been seen.
 bool FindExtensionElement(const CBS& extensions,
                           const uint8_t* oid,
                           size_t oid_len,
+                          ExtensionLimit* limit,
                           CBS* out) {
   CBS extensions_copy = extensions;
   CBS result;
   CBS_init(&result, nullptr, 0);
   bool found = false;
+  size_t count = 0;
   while (CBS_len(&extensions_copy) > 0) {
+    if (limit && count++ == limit->max_extensions) {
+      limit->exceeded = true;
+      return false;
+    }
+
     CBS extension_element;
     if (!CBS_get_asn1_element(&extensions_copy, &extension_element,
                               CBS_ASN1_SEQUENCE)) {
@@ -96,9 +105,11 @@ bool FindExtensionElement(const CBS& extensions,
 bool ParseSCTListFromExtensions(const CBS& extensions,
                                 const uint8_t* oid,
                                 size_t oid_len,
+                                ExtensionLimit* limit,
                                 std::string* out_sct_list) {
   CBS extension_element, extension, extension_oid, value, sct_list;
-  if (!FindExtensionElement(extensions, oid, oid_len, &extension_element) ||
+  if (!FindExtensionElement(extensions, oid, oid_len, limit,
+                            &extension_element) ||
       !CBS_get_asn1(&extension_element, &extension, CBS_ASN1_SEQUENCE) ||
       !CBS_get_asn1(&extension, &extension_oid, CBS_ASN1_OBJECT) ||
       // Skip the optional critical element.
@@ -147,12 +158,34 @@ bool ExtractSPKIFromDERCert(std::string_view cert, std::string_view* spki_out) {
   return true;
 }
 
+// Reads the serialNumber from |tbs_cert|, which must be a TBSCertificate
+// body.
+bool GetSerialNumber(CBS* tbs_cert, std::string_view* serial) {
+  constexpr unsigned kVersionTag =
+      CBS_ASN1_CONTEXT_SPECIFIC | CBS_ASN1_CONSTRUCTED | 0;
+  CBS serial_cbs;
+  if (!SkipOptionalElement(tbs_cert, kVersionTag) ||
+      !CBS_get_asn1(tbs_cert, &serial_cbs, CBS_ASN1_INTEGER)) {
+    return false;
+  }
+  *serial =
+      std::string_view(reinterpret_cast<const char*>(CBS_data(&serial_cbs)),
+                       CBS_len(&serial_cbs));
+  return true;
+}
+
 }  // namespace
 
 SignedEntryData::SignedEntryData() = default;
 SignedEntryData::~SignedEntryData() = default;
 
 bool ExtractEmbeddedSCTList(std::string_view cert, std::string* sct_list) {
+  return ExtractEmbeddedSCTList(cert, nullptr, sct_list);
+}
+
+bool ExtractEmbeddedSCTList(std::string_view cert,
+                            ExtensionLimit* limit,
+                            std::string* sct_list) {
   CBS cert_cbs;
   CBS_init(&cert_cbs, reinterpret_cast<const uint8_t*>(cert.data()),
            cert.size());
@@ -170,12 +203,19 @@ bool ExtractEmbeddedSCTList(std::string_view cert, std::string* sct_list) {
   }
 
   return ParseSCTListFromExtensions(extensions, kEmbeddedSCTOid,
-                                    sizeof(kEmbeddedSCTOid), sct_list);
+                                    sizeof(kEmbeddedSCTOid), limit, sct_list);
 }
 
 bool GetPrecertSignedEntry(std::string_view leaf,
                            std::string_view issuer,
                            SignedEntryData* result) {
+  return GetPrecertSignedEntry(leaf, issuer, nullptr, result);
+}
+
+bool GetPrecertSignedEntry(std::string_view leaf,
+                           std::string_view issuer,
+                           ExtensionLimit* limit,
+                           SignedEntryData* result) {
   // Parse the TBSCertificate.
   CBS cert_cbs;
   CBS_init(&cert_cbs, reinterpret_cast<const uint8_t*>(leaf.data()),
@@ -210,7 +250,7 @@ bool GetPrecertSignedEntry(std::string_view leaf,
       !CBS_get_asn1(&extensions_wrap, &extensions, CBS_ASN1_SEQUENCE) ||
       CBS_len(&extensions_wrap) != 0 || CBS_len(&tbs_cert) != 0 ||
       !FindExtensionElement(extensions, kEmbeddedSCTOid,
-                            sizeof(kEmbeddedSCTOid), &sct_extension)) {
+                            sizeof(kEmbeddedSCTOid), limit, &sct_extension)) {
     return false;
   }
 
@@ -231,19 +271,45 @@ bool GetPrecertSignedEntry(std::string_view leaf,
   }
   UniquePtr<uint8_t> scoped_new_tbs_cert_der(new_tbs_cert_der);
 
-  // Extract the issuer's public key.
-  std::string_view issuer_key;
-  if (!ExtractSPKIFromDERCert(issuer, &issuer_key)) {
+  // Fill in the SignedEntryData.
+  if (!GetIssuerKeyHash(issuer, &result->issuer_key_hash)) {
     return false;
   }
-
-  // Fill in the SignedEntryData.
-  CC_SHA256(issuer_key.data(), issuer_key.size(),
-            result->issuer_key_hash.data());
   result->tbs_certificate.assign(
       reinterpret_cast<const char*>(new_tbs_cert_der), new_tbs_cert_len);
 
   return true;
 }
 
+bool ExtractSerialNumber(std::string_view cert, std::string_view* serial) {
+  CBS cert_cbs;
+  CBS_init(&cert_cbs, reinterpret_cast<const uint8_t*>(cert.data()),
+           cert.size());
+  CBS cert_body, tbs_cert;
+  return CBS_get_asn1(&cert_cbs, &cert_body, CBS_ASN1_SEQUENCE) &&
+         CBS_len(&cert_cbs) == 0 &&
+         CBS_get_asn1(&cert_body, &tbs_cert, CBS_ASN1_SEQUENCE) &&
+         GetSerialNumber(&tbs_cert, serial);
+}
+
+bool ExtractTBSSerialNumber(std::string_view tbs_cert,
+                            std::string_view* serial) {
+  CBS tbs_cbs;
+  CBS_init(&tbs_cbs, reinterpret_cast<const uint8_t*>(tbs_cert.data()),
+           tbs_cert.size());
+  CBS tbs_body;
+  return CBS_get_asn1(&tbs_cbs, &tbs_body, CBS_ASN1_SEQUENCE) &&
+         CBS_len(&tbs_cbs) == 0 && GetSerialNumber(&tbs_body, serial);
+}
+
+bool GetIssuerKeyHash(std::string_view issuer,
+                      std::array<uint8_t, 32>* issuer_key_hash) {
+  std::string_view issuer_key;
+  if (!ExtractSPKIFromDERCert(issuer, &issuer_key)) {
+    return false;
+  }
+  SHA256(issuer_key.data(), issuer_key.size(), issuer_key_hash->data());
+  return true;
+}
+
 }  // namespace certificate_transparency
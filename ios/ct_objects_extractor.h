@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <limits>
 #include <string>
 #include <string_view>
 
@@ -14,10 +16,37 @@ struct SignedEntryData {
   std::string tbs_certificate;
 };
 
+// Bounds the number of extensions scanned in a certificate.
+struct ExtensionLimit {
+  size_t max_extensions = std::numeric_limits<size_t>::max();
+  // Set when parsing stopped because the certificate has more extensions than
+  // |max_extensions|.
+  bool exceeded = false;
+};
+
 bool ExtractEmbeddedSCTList(std::string_view cert, std::string* sct_list);
+bool ExtractEmbeddedSCTList(std::string_view cert,
+                            ExtensionLimit* limit,
+                            std::string* sct_list);
 
 bool GetPrecertSignedEntry(std::string_view leaf,
                            std::string_view issuer,
                            SignedEntryData* result);
+bool GetPrecertSignedEntry(std::string_view leaf,
+                           std::string_view issuer,
+                           ExtensionLimit* limit,
+                           SignedEntryData* result);
+
+// Sets |*serial| to the contents octets of the serialNumber of |cert|, a DER
+// certificate, or of |tbs_cert|, a DER TBSCertificate. |*serial| points into
+// the input.
+bool ExtractSerialNumber(std::string_view cert, std::string_view* serial);
+bool ExtractTBSSerialNumber(std::string_view tbs_cert,
+                            std::string_view* serial);
+
+// Hashes the SubjectPublicKeyInfo of |issuer| with SHA-256, as in
+// SignedEntryData::issuer_key_hash.
+bool GetIssuerKeyHash(std::string_view issuer,
+                      std::array<uint8_t, 32>* issuer_key_hash);
 
 }  // namespace certificate_transparency
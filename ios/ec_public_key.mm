@@ -1,5 +1,7 @@
 #include "ec_public_key.h"
 
+#if !defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+
 #import <Foundation/Foundation.h>
 #import <Security/Security.h>
 
@@ -48,3 +50,5 @@ const ASN1Method kECASN1Method = {
     DecodeECPublicKey};
 
 }  // namespace certificate_transparency
+
+#endif  // !defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
@@ -0,0 +1,47 @@
+#include "ec_public_key.h"
+
+#if defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+
+#include <memory>
+
+#include "crypto_bytestring.h"
+#include "crypto_p256.h"
+
+namespace certificate_transparency {
+namespace {
+
+// 1.2.840.10045.3.1.7. CT logs only use P-256, so unlike the Security
+// framework backend the portable one accepts no other curve.
+const uint8_t kP256Oid[] = {0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07};
+
+int DecodeECPublicKey(PublicKey* out, CBS* params, CBS* key) {
+  CBS named_curve;
+  if (!CBS_get_asn1(params, &named_curve, CBS_ASN1_OBJECT) ||
+      CBS_len(params) != 0 ||
+      !CBS_mem_equal(&named_curve, kP256Oid, sizeof(kP256Oid))) {
+    return 0;
+  }
+
+  // Building the comb tables here keeps the per-verification work down to a
+  // single double-scalar multiplication.
+  auto public_key = std::make_unique<P256_PUBLIC_KEY>();
+  if (!P256_PUBLIC_KEY_init(public_key.get(), CBS_data(key), CBS_len(key))) {
+    return 0;
+  }
+
+  *out = PublicKey(std::move(public_key));
+  return 1;
+}
+
+}  // namespace
+
+const ASN1Method kECASN1Method = {
+    PublicKey::kEC,
+    // 1.2.840.10045.2.1
+    {0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01},
+    7,
+    DecodeECPublicKey};
+
+}  // namespace certificate_transparency
+
+#endif  // defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
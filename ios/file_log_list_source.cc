@@ -0,0 +1,173 @@
+#include "file_log_list_source.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+
+#include <cstdio>
+#include <utility>
+
+#include "log_list_parser.h"
+
+namespace certificate_transparency {
+namespace {
+
+// Log lists are a few kilobytes; refuse anything absurd.
+constexpr off_t kMaxFileSize = 16 * 1024 * 1024;
+
+std::string GetFileTag(const struct stat& st) {
+#if defined(__APPLE__)
+  const auto& mtime = st.st_mtimespec;
+#else
+  const auto& mtime = st.st_mtim;
+#endif
+  char tag[64];
+  snprintf(tag, sizeof(tag), "%lld.%09ld-%lld",
+           static_cast<long long>(mtime.tv_sec), mtime.tv_nsec,
+           static_cast<long long>(st.st_size));
+  return tag;
+}
+
+bool ReadFile(int fd, size_t size, std::string* out) {
+  out->resize(size);
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = read(fd, &(*out)[done], size - done);
+    if (n < 0) {
+      return false;
+    }
+    if (n == 0) {
+      break;
+    }
+    done += n;
+  }
+  out->resize(done);
+  return true;
+}
+
+}  // namespace
+
+FileLogListTransport::FileLogListTransport(std::string path)
+    : path_(std::move(path)) {}
+
+FileLogListTransport::~FileLogListTransport() = default;
+
+void FileLogListTransport::Fetch(const std::optional<std::string>& tag,
+                                 FetchCallback callback) {
+  int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    callback(kReadError, {});
+    return;
+  }
+
+  struct stat st;
+  std::string contents;
+  if (fstat(fd, &st) != 0 || st.st_size > kMaxFileSize ||
+      !ReadFile(fd, static_cast<size_t>(st.st_size), &contents)) {
+    close(fd);
+    callback(kReadError, {});
+    return;
+  }
+  close(fd);
+
+  std::string file_tag = GetFileTag(st);
+  if (tag && *tag == file_tag) {
+    callback(NotModified(), {});
+    return;
+  }
+
+  Ok result;
+  auto logs = ParseLogList(contents, &result.revocations);
+  if (!logs) {
+    callback(kParseError, {});
+    return;
+  }
+  result.tag = std::move(file_tag);
+  result.logs = std::move(*logs);
+  callback(std::move(result), {});
+}
+
+LogListFileWatcher::LogListFileWatcher(std::string path,
+                                       std::function<void()> on_change)
+    : path_(std::move(path)), on_change_(std::move(on_change)) {}
+
+LogListFileWatcher::~LogListFileWatcher() {
+  if (thread_.joinable()) {
+    const char stop = 0;
+    ssize_t ignored = write(stop_fds_[1], &stop, 1);
+    (void)ignored;
+    thread_.join();
+  }
+  for (int fd : {inotify_fd_, stop_fds_[0], stop_fds_[1]}) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+bool LogListFileWatcher::Start() {
+#if defined(__linux__)
+  if (thread_.joinable()) {
+    return true;
+  }
+
+  const size_t slash = path_.rfind('/');
+  const std::string directory =
+      slash == std::string::npos ? "." : path_.substr(0, slash + 1);
+  inotify_fd_ = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+  if (inotify_fd_ < 0 ||
+      inotify_add_watch(inotify_fd_, directory.c_str(),
+                        IN_CLOSE_WRITE | IN_MOVED_TO) < 0 ||
+      pipe(stop_fds_) != 0) {
+    return false;
+  }
+
+  thread_ = std::thread(&LogListFileWatcher::Run, this);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void LogListFileWatcher::Run() {
+#if defined(__linux__)
+  const size_t slash = path_.rfind('/');
+  const std::string name =
+      slash == std::string::npos ? path_ : path_.substr(slash + 1);
+
+  alignas(struct inotify_event) char buffer[4096];
+  while (true) {
+    struct pollfd fds[2] = {
+        {inotify_fd_, POLLIN, 0},
+        {stop_fds_[0], POLLIN, 0},
+    };
+    if (poll(fds, 2, -1) < 0) {
+      continue;
+    }
+    if (fds[1].revents) {
+      return;
+    }
+
+    ssize_t len = read(inotify_fd_, buffer, sizeof(buffer));
+    bool changed = false;
+    for (ssize_t offset = 0; offset < len;) {
+      const auto* event =
+          reinterpret_cast<const struct inotify_event*>(buffer + offset);
+      if (event->len > 0 && name == event->name) {
+        changed = true;
+      }
+      offset += sizeof(struct inotify_event) + event->len;
+    }
+    if (changed) {
+      on_change_();
+    }
+  }
+#endif
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "log_list_updater.h"
+
+namespace certificate_transparency {
+
+// Reads the log list from a local JSON file in the format of the update URL.
+// The tag is derived from the file's modification time and size, so an
+// unchanged file is reported as not modified.
+class FileLogListTransport : public LogListTransport {
+ public:
+  static constexpr ErrorCode kReadError = -1;
+  static constexpr ErrorCode kParseError = -2;
+
+  explicit FileLogListTransport(std::string path);
+  ~FileLogListTransport() override;
+
+  void Fetch(const std::optional<std::string>& tag,
+             FetchCallback callback) override;
+
+ private:
+  const std::string path_;
+};
+
+// Calls |on_change| whenever the file at |path| is written, replaced or
+// renamed into place. Pass LogListUpdater::UpdateNow to reload the list as
+// soon as it is deployed. Uses inotify and watches the directory, so the
+// file need not exist yet; elsewhere Start() fails and the updater's schedule
+// is the only way to notice changes.
+class LogListFileWatcher {
+ public:
+  LogListFileWatcher(std::string path, std::function<void()> on_change);
+  ~LogListFileWatcher();
+
+  LogListFileWatcher(const LogListFileWatcher&) = delete;
+  LogListFileWatcher& operator=(const LogListFileWatcher&) = delete;
+
+  // Starts watching on a thread of its own. Returns false if the directory
+  // cannot be watched.
+  bool Start();
+
+ private:
+  void Run();
+
+  const std::string path_;
+  const std::function<void()> on_change_;
+  int inotify_fd_ = -1;
+  // Written to by the destructor to wake the watching thread up.
+  int stop_fds_[2] = {-1, -1};
+  std::thread thread_;
+};
+
+}  // namespace certificate_transparency
@@ -0,0 +1,171 @@
+#include "file_log_list_storage.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <utility>
+
+#include "crypto_bytebuilder.h"
+#include "crypto_bytestring.h"
+
+namespace certificate_transparency {
+namespace {
+
+constexpr uint32_t kMagic = 0x43544c53;  // "CTLS"
+constexpr uint8_t kVersion = 1;
+
+constexpr uint8_t kHasNextUpdate = 1 << 0;
+constexpr uint8_t kHasTag = 1 << 1;
+constexpr uint8_t kHasLogs = 1 << 2;
+constexpr uint8_t kHasRevocations = 1 << 3;
+
+bool Encode(const LogListState& state, CBB* out) {
+  uint8_t flags = 0;
+  flags |= state.next_update ? kHasNextUpdate : 0;
+  flags |= state.tag && state.tag->size() <= 0xffff ? kHasTag : 0;
+  flags |= state.logs ? kHasLogs : 0;
+  flags |= state.revocations && state.revocations->size() <= 0xffffffff
+               ? kHasRevocations
+               : 0;
+  if (!CBB_add_u32(out, kMagic) || !CBB_add_u8(out, kVersion) ||
+      !CBB_add_u8(out, flags) ||
+      !CBB_add_u64(out, state.next_update.value_or(0)) ||
+      !CBB_add_u32(out, state.failures)) {
+    return false;
+  }
+
+  CBB tag;
+  const std::string empty;
+  const std::string& tag_value = (flags & kHasTag) ? *state.tag : empty;
+  if (!CBB_add_u16_length_prefixed(out, &tag) ||
+      !CBB_add_bytes(&tag, reinterpret_cast<const uint8_t*>(tag_value.data()),
+                     tag_value.size()) ||
+      !CBB_flush(out)) {
+    return false;
+  }
+
+  const size_t count = state.logs ? state.logs->size() : 0;
+  if (!CBB_add_u32(out, static_cast<uint32_t>(count))) {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    const std::string& log = (*state.logs)[i];
+    CBB child;
+    if (!CBB_add_u16_length_prefixed(out, &child) ||
+        !CBB_add_bytes(&child, reinterpret_cast<const uint8_t*>(log.data()),
+                       log.size()) ||
+        !CBB_flush(out)) {
+      return false;
+    }
+  }
+
+  // Indexes outgrow the 24-bit prefixes, so the length is written apart.
+  const std::string& revocations =
+      (flags & kHasRevocations) ? *state.revocations : empty;
+  return CBB_add_u32(out, static_cast<uint32_t>(revocations.size())) &&
+         CBB_add_bytes(out,
+                       reinterpret_cast<const uint8_t*>(revocations.data()),
+                       revocations.size());
+}
+
+bool Decode(CBS* in, LogListState* out) {
+  uint32_t magic, failures, count, revocations_size;
+  uint8_t version, flags;
+  uint64_t next_update;
+  CBS tag, revocations;
+  if (!CBS_get_u32(in, &magic) || magic != kMagic ||
+      !CBS_get_u8(in, &version) || version != kVersion ||
+      !CBS_get_u8(in, &flags) || !CBS_get_u64(in, &next_update) ||
+      !CBS_get_u32(in, &failures) || !CBS_get_u16_length_prefixed(in, &tag) ||
+      !CBS_get_u32(in, &count)) {
+    return false;
+  }
+
+  std::vector<std::string> logs;
+  for (uint32_t i = 0; i < count; i++) {
+    CBS log;
+    if (!CBS_get_u16_length_prefixed(in, &log)) {
+      return false;
+    }
+    logs.emplace_back(reinterpret_cast<const char*>(CBS_data(&log)),
+                      CBS_len(&log));
+  }
+  if (!CBS_get_u32(in, &revocations_size) ||
+      !CBS_get_bytes(in, &revocations, revocations_size) ||
+      CBS_len(in) != 0) {
+    return false;
+  }
+
+  if (flags & kHasNextUpdate) {
+    out->next_update = next_update;
+  }
+  if (flags & kHasTag) {
+    out->tag.emplace(reinterpret_cast<const char*>(CBS_data(&tag)),
+                     CBS_len(&tag));
+  }
+  if (flags & kHasLogs) {
+    out->logs = std::move(logs);
+  }
+  if (flags & kHasRevocations) {
+    out->revocations.emplace(
+        reinterpret_cast<const char*>(CBS_data(&revocations)),
+        CBS_len(&revocations));
+  }
+  out->failures = failures;
+  return true;
+}
+
+}  // namespace
+
+FileLogListStorage::FileLogListStorage(std::string path)
+    : path_(std::move(path)) {}
+
+FileLogListStorage::~FileLogListStorage() = default;
+
+LogListState FileLogListStorage::Load() {
+  std::string contents;
+  FILE* file = fopen(path_.c_str(), "rb");
+  if (!file) {
+    return {};
+  }
+  char buffer[4096];
+  size_t n;
+  while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.append(buffer, n);
+  }
+  fclose(file);
+
+  CBS in;
+  CBS_init(&in, reinterpret_cast<const uint8_t*>(contents.data()),
+           contents.size());
+  LogListState state;
+  if (!Decode(&in, &state)) {
+    return {};
+  }
+  return state;
+}
+
+void FileLogListStorage::Save(const LogListState& state) {
+  ScopedCBB cbb;
+  if (!CBB_init(cbb.get(), 1024) || !Encode(state, cbb.get())) {
+    return;
+  }
+
+  // Write a sibling file and rename it over the old one, so a crash leaves
+  // either the old state or the new one.
+  const std::string temporary_path = path_ + ".tmp";
+  FILE* file = fopen(temporary_path.c_str(), "wb");
+  if (!file) {
+    return;
+  }
+  const bool written =
+      fwrite(CBB_data(cbb.get()), 1, CBB_len(cbb.get()), file) ==
+          CBB_len(cbb.get()) &&
+      fflush(file) == 0 && fsync(fileno(file)) == 0;
+  if (fclose(file) != 0 || !written ||
+      rename(temporary_path.c_str(), path_.c_str()) != 0) {
+    unlink(temporary_path.c_str());
+  }
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+#include "log_list_updater.h"
+
+namespace certificate_transparency {
+
+// Keeps the updater state in a file, replaced atomically on every save. A
+// missing or corrupt file loads as the empty state.
+class FileLogListStorage : public LogListStorage {
+ public:
+  explicit FileLogListStorage(std::string path);
+  ~FileLogListStorage() override;
+
+  LogListState Load() override;
+  void Save(const LogListState& state) override;
+
+ private:
+  const std::string path_;
+};
+
+}  // namespace certificate_transparency
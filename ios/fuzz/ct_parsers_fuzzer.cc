@@ -0,0 +1,295 @@
+// Fuzzes the DER, TLS and PEM parsers for slow inputs as well as for memory
+// errors. With libFuzzer:
+//
+//   clang++ -std=c++17 -O1 -g -fsanitize=fuzzer,address -I. -Itests
+//       -o ct_parsers_fuzzer fuzz/ct_parsers_fuzzer.cc
+//       tests/adversarial_inputs.cc *.cc -pthread
+//   CT_FUZZ_CYCLES_PER_BYTE=2000 ./ct_parsers_fuzzer corpus/
+//
+// The first byte of an input picks the parser, the rest is its input. An
+// input that takes more than CT_FUZZ_BASE_CYCLES plus CT_FUZZ_CYCLES_PER_BYTE
+// for each of its bytes, on the best of three runs, is reported and aborts
+// the run, so that libFuzzer saves it. Cycles are counted by
+// perf_event_open(2) in user space, or, where it is not available, estimated
+// from the time at 3 cycles per nanosecond.
+//
+// Built with -DCT_FUZZ_REPLAY instead of -fsanitize=fuzzer, the target runs
+// the files given, e.g. a saved input, and --write-seeds writes the corpus
+// of tests/adversarial_inputs.h to a directory to start fuzzing from:
+//
+//   c++ -std=c++17 -O2 -DCT_FUZZ_REPLAY -I. -Itests -o ct_parsers_replay
+//       fuzz/ct_parsers_fuzzer.cc tests/adversarial_inputs.cc *.cc -pthread
+//   ./ct_parsers_replay --write-seeds corpus/
+//   ./ct_parsers_replay corpus/*
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "adversarial_inputs.h"
+#include "certificate_bundle.h"
+#include "crypto_bytestring.h"
+#include "ct_objects_extractor.h"
+#include "ct_serialization.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+enum Parser : uint8_t {
+  kCertificate,
+  kSCTList,
+  kBundle,
+  kElements,
+  kParserCount,
+};
+
+const char* const kParserNames[] = {"certificate", "sct list", "bundle",
+                                    "elements"};
+
+// Counts user space cycles of the calling thread.
+class CycleCounter {
+ public:
+  CycleCounter() {
+#if defined(__linux__)
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  bool has_counter() const { return fd_ >= 0; }
+
+  uint64_t Read() const {
+    uint64_t value = 0;
+    if (fd_ < 0 || read(fd_, &value, sizeof(value)) != sizeof(value)) {
+      const auto now = std::chrono::steady_clock::now().time_since_epoch();
+      return 3 * std::chrono::duration_cast<std::chrono::nanoseconds>(now)
+                     .count();
+    }
+    return value;
+  }
+
+ private:
+  int fd_ = -1;
+};
+
+uint64_t EnvOr(const char* name, uint64_t fallback) {
+  const char* value = getenv(name);
+  return value ? strtoull(value, nullptr, 10) : fallback;
+}
+
+ct::CBS MakeCBS(std::string_view input) {
+  ct::CBS cbs;
+  ct::CBS_init(&cbs, reinterpret_cast<const uint8_t*>(input.data()),
+               input.size());
+  return cbs;
+}
+
+void ParseCertificate(std::string_view input) {
+  std::string sct_list;
+  ct::SignedEntryData entry;
+  ct::ExtractEmbeddedSCTList(input, &sct_list);
+  ct::GetPrecertSignedEntry(input, input, &entry);
+}
+
+void ParseSCTList(std::string_view input) {
+  std::vector<std::string_view> scts;
+  if (!ct::DecodeSCTList(input, &scts)) {
+    return;
+  }
+  for (std::string_view sct : scts) {
+    ct::SignedCertificateTimestamp decoded_sct;
+    ct::DecodeSignedCertificateTimestamp(&sct, &decoded_sct);
+  }
+}
+
+void ParseBundle(std::string_view input) {
+  ct::CertificateArena arena;
+  std::vector<ct::BundleChain> whole;
+  const size_t malformed =
+      ct::ScanBundle(input, 0, input.size(), &arena, &whole);
+  // Scanning in ranges must find the same chains as scanning at once.
+  std::vector<ct::BundleChain> ranged;
+  size_t ranged_malformed = 0;
+  for (const auto& range : ct::SplitBundle(input, 64)) {
+    ranged_malformed +=
+        ct::ScanBundle(input, range.first, range.second, &arena, &ranged);
+  }
+  bool same = malformed == ranged_malformed && whole.size() == ranged.size();
+  for (size_t i = 0; same && i < whole.size(); i++) {
+    same = whole[i].leaf == ranged[i].leaf &&
+           whole[i].issuer == ranged[i].issuer;
+  }
+  if (!same) {
+    fprintf(stderr, "bundle scanned in ranges differs from a whole scan\n");
+    abort();
+  }
+}
+
+void ParseElements(std::string_view input) {
+  ct::CBS der = MakeCBS(input);
+  while (ct::CBS_get_any_asn1_element(&der, nullptr, nullptr, nullptr)) {
+  }
+  ct::CBS ber = MakeCBS(input);
+  int ber_found, indefinite;
+  while (ct::CBS_get_any_ber_asn1_element(&ber, nullptr, nullptr, nullptr,
+                                          &ber_found, &indefinite)) {
+  }
+}
+
+void Parse(Parser parser, std::string_view input) {
+  switch (parser) {
+    case kCertificate:
+      ParseCertificate(input);
+      break;
+    case kSCTList:
+      ParseSCTList(input);
+      break;
+    case kBundle:
+      ParseBundle(input);
+      break;
+    case kElements:
+      ParseElements(input);
+      break;
+    case kParserCount:
+      break;
+  }
+}
+
+// Runs |parser| on |input| and returns the cycles it took.
+uint64_t Measure(const CycleCounter& counter,
+                 Parser parser,
+                 std::string_view input) {
+  const uint64_t start = counter.Read();
+  Parse(parser, input);
+  return counter.Read() - start;
+}
+
+#if defined(CT_FUZZ_REPLAY)
+
+bool WriteFile(const std::string& path, const std::string& contents) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  const bool written =
+      fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+  return fclose(file) == 0 && written;
+}
+
+bool WriteSeeds(const std::string& directory) {
+  const std::string sct_list = test::SCTListWithSCTs(2);
+  const std::pair<Parser, std::string> seeds[] = {
+      {kCertificate, test::CertificateWithExtensions(4000, sct_list)},
+      {kCertificate, test::CertificateWithNestedSubject(4000, sct_list)},
+      {kSCTList, test::SCTListWithSCTs(1337)},
+      {kSCTList, test::SCTListWithItems(21845)},
+      {kBundle, test::PEMWithMarkers(2000)},
+      {kBundle, test::PEMWithGiantBlock(1 << 16)},
+      {kElements, test::ElementRun(500)},
+      {kElements, test::IndefiniteLengthRun(20000)},
+  };
+  int index = 0;
+  for (const auto& seed : seeds) {
+    const std::string path =
+        directory + "/seed-" + std::to_string(index++);
+    if (!WriteFile(path, static_cast<char>(seed.first) + seed.second)) {
+      fprintf(stderr, "can't write %s\n", path.c_str());
+      return false;
+    }
+  }
+  printf("%d seeds written to %s\n", index, directory.c_str());
+  return true;
+}
+
+#endif  // defined(CT_FUZZ_REPLAY)
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  static const CycleCounter* counter = new CycleCounter();
+  static const uint64_t base_cycles = EnvOr("CT_FUZZ_BASE_CYCLES", 200000);
+  static const uint64_t cycles_per_byte =
+      EnvOr("CT_FUZZ_CYCLES_PER_BYTE", 2000);
+  if (size == 0) {
+    return 0;
+  }
+  const Parser parser = static_cast<Parser>(data[0] % kParserCount);
+  const std::string_view input(reinterpret_cast<const char*>(data + 1),
+                               size - 1);
+  const uint64_t budget = base_cycles + cycles_per_byte * input.size();
+
+  uint64_t cycles = Measure(*counter, parser, input);
+  // Rerun before reporting, in case the thread was preempted.
+  for (int run = 0; run < 2 && cycles > budget; run++) {
+    cycles = std::min(cycles, Measure(*counter, parser, input));
+  }
+  if (cycles > budget) {
+    fprintf(stderr,
+            "%s parser took %llu cycles for %zu bytes, %.1f per byte, over "
+            "the budget of %llu\n",
+            kParserNames[parser], static_cast<unsigned long long>(cycles),
+            input.size(),
+            input.empty() ? 0.0 : static_cast<double>(cycles) / input.size(),
+            static_cast<unsigned long long>(budget));
+    abort();
+  }
+  return 0;
+}
+
+#if defined(CT_FUZZ_REPLAY)
+
+int main(int argc, char** argv) {
+  if (argc == 3 && !strcmp(argv[1], "--write-seeds")) {
+    return WriteSeeds(argv[2]) ? 0 : 1;
+  }
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s input... | --write-seeds directory\n",
+            argv[0]);
+    return 2;
+  }
+  if (!CycleCounter().has_counter()) {
+    printf("no cycle counter, estimating cycles from time\n");
+  }
+  for (int i = 1; i < argc; i++) {
+    FILE* file = fopen(argv[i], "rb");
+    if (!file) {
+      fprintf(stderr, "can't read %s\n", argv[i]);
+      return 1;
+    }
+    std::string contents;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      contents.append(buffer, n);
+    }
+    fclose(file);
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(contents.data()),
+                           contents.size());
+    printf("%s: %zu bytes within budget\n", argv[i], contents.size());
+  }
+  return 0;
+}
+
+#endif  // defined(CT_FUZZ_REPLAY)
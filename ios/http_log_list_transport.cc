@@ -0,0 +1,78 @@
+#include "http_log_list_transport.h"
+
+#include <strings.h>
+
+#include "ct_version.h"
+#include "log_list_parser.h"
+
+namespace certificate_transparency {
+namespace {
+
+const std::string* FindHeader(const HttpLogListTransport::Headers& headers,
+                              const char* name) {
+  for (const auto& header : headers) {
+    if (strcasecmp(header.first.c_str(), name) == 0) {
+      return &header.second;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+HttpLogListTransport::HttpLogListTransport(std::string update_url,
+                                           Client client)
+    : update_url_(std::move(update_url)), client_(std::move(client)) {}
+
+HttpLogListTransport::~HttpLogListTransport() = default;
+
+void HttpLogListTransport::Fetch(const std::optional<std::string>& tag,
+                                 FetchCallback callback) {
+  Request request;
+  request.url = update_url_;
+  request.headers.emplace_back("User-Agent",
+                               std::string("CertificateTransparency/") +
+                                   CERTIFICATE_TRANSPARENCY_VERSION);
+  if (tag) {
+    request.headers.emplace_back("If-None-Match", *tag);
+  }
+
+  client_(std::move(request), [callback](Response response) {
+    ScheduleHints hints;
+    if (const std::string* value =
+            FindHeader(response.headers, "Cache-Control")) {
+      hints.max_age = ParseCacheControlMaxAge(*value);
+    }
+    if (const std::string* value =
+            FindHeader(response.headers, "Retry-After")) {
+      hints.retry_after = ParseRetryAfter(*value);
+    }
+
+    if (response.status == 0) {
+      callback(kNoResponse, hints);
+      return;
+    }
+    if (response.status == 304) {
+      callback(NotModified(), hints);
+      return;
+    }
+    if (response.status != 200) {
+      callback(ErrorCode(response.status), hints);
+      return;
+    }
+
+    Ok result;
+    auto logs = ParseLogList(response.body, &result.revocations);
+    if (!logs) {
+      callback(kParseError, hints);
+      return;
+    }
+    result.logs = std::move(*logs);
+    if (const std::string* etag = FindHeader(response.headers, "ETag")) {
+      result.tag = *etag;
+    }
+    callback(std::move(result), hints);
+  });
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "log_list_updater.h"
+
+namespace certificate_transparency {
+
+// Fetches the log list from the update URL with conditional requests, like
+// CTLogDownloader, over whatever HTTP client the embedder has. The portable
+// core has none of its own.
+class HttpLogListTransport : public LogListTransport {
+ public:
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  struct Request {
+    std::string url;
+    Headers headers;
+  };
+
+  struct Response {
+    // Zero if no response was received.
+    int status = 0;
+    Headers headers;
+    std::string body;
+  };
+
+  using ResponseCallback = std::function<void(Response)>;
+  // Sends a GET request and calls back with the response, on any thread.
+  using Client = std::function<void(Request, ResponseCallback)>;
+
+  static constexpr ErrorCode kNoResponse = -1;
+  static constexpr ErrorCode kParseError = -2;
+
+  HttpLogListTransport(std::string update_url, Client client);
+  ~HttpLogListTransport() override;
+
+  void Fetch(const std::optional<std::string>& tag,
+             FetchCallback callback) override;
+
+ private:
+  const std::string update_url_;
+  const Client client_;
+};
+
+}  // namespace certificate_transparency
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdlib>
 #include <memory>
 
+#include "crypto_mem.h"
+
 namespace certificate_transparency {
 namespace internal {
 
@@ -10,7 +13,7 @@ struct Deleter;
 
 template <>
 struct Deleter<uint8_t> {
-  void operator()(uint8_t* ptr) { free(ptr); }
+  void operator()(uint8_t* ptr) { CT_free(ptr); }
 };
 
 template <typename T,
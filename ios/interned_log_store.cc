@@ -0,0 +1,115 @@
+#include "interned_log_store.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "crypto_sha256.h"
+
+namespace certificate_transparency {
+namespace {
+
+std::string LogID(std::string_view public_key) {
+  uint8_t digest[kSHA256DigestLength];
+  SHA256(public_key.data(), public_key.size(), digest);
+  return std::string(std::begin(digest), std::end(digest));
+}
+
+template <typename Map>
+void EraseExpired(Map* map) {
+  for (auto it = map->begin(); it != map->end();) {
+    if (it->second.expired()) {
+      it = map->erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+template <typename Map>
+size_t CountAlive(const Map& map) {
+  size_t result = 0;
+  for (const auto& entry : map) {
+    result += !entry.second.expired();
+  }
+  return result;
+}
+
+}  // namespace
+
+InternedLogStore::InternedLogStore() = default;
+InternedLogStore::~InternedLogStore() = default;
+
+// static
+InternedLogStore& InternedLogStore::Shared() {
+  static auto* store = new InternedLogStore();
+  return *store;
+}
+
+std::shared_ptr<const LogVerifier> InternedLogStore::GetLog(
+    std::string_view public_key) {
+  const std::string log_id = LogID(public_key);
+  std::lock_guard guard(lock_);
+  return GetLogLocked(public_key, log_id);
+}
+
+std::shared_ptr<const MultiLogVerifier> InternedLogStore::GetVerifier(
+    const std::vector<std::string_view>& public_keys) {
+  // Hashed outside the lock, which lookups of other key sets wait for.
+  std::vector<std::pair<std::string, std::string_view>> keys;
+  keys.reserve(public_keys.size());
+  for (std::string_view public_key : public_keys) {
+    keys.emplace_back(LogID(public_key), public_key);
+  }
+  std::sort(keys.begin(), keys.end());
+  std::string set_id;
+  set_id.reserve(keys.size() * kSHA256DigestLength);
+  for (const auto& key : keys) {
+    set_id += key.first;
+  }
+
+  std::lock_guard guard(lock_);
+  auto it = verifiers_.find(set_id);
+  if (it != verifiers_.end()) {
+    if (auto verifier = it->second.lock()) {
+      return verifier;
+    }
+  }
+  // Only misses pay for dropping what has expired.
+  EraseExpired(&verifiers_);
+  std::vector<std::shared_ptr<const LogVerifier>> logs;
+  logs.reserve(keys.size());
+  for (const auto& key : keys) {
+    logs.push_back(GetLogLocked(key.second, key.first));
+  }
+  auto verifier = std::make_shared<const MultiLogVerifier>(
+      std::move(logs), VerificationLimits());
+  verifiers_[set_id] = verifier;
+  return verifier;
+}
+
+size_t InternedLogStore::log_count() {
+  std::lock_guard guard(lock_);
+  return CountAlive(logs_);
+}
+
+size_t InternedLogStore::verifier_count() {
+  std::lock_guard guard(lock_);
+  return CountAlive(verifiers_);
+}
+
+std::shared_ptr<const LogVerifier> InternedLogStore::GetLogLocked(
+    std::string_view public_key,
+    const std::string& log_id) {
+  auto it = logs_.find(log_id);
+  if (it != logs_.end()) {
+    if (auto log = it->second.lock()) {
+      return log;
+    }
+  }
+  EraseExpired(&logs_);
+  auto log = std::make_shared<const LogVerifier>(public_key);
+  logs_[log_id] = log;
+  return log;
+}
+
+}  // namespace certificate_transparency
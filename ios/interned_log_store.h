@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "log_verifier.h"
+#include "multi_log_verifier.h"
+
+namespace certificate_transparency {
+
+// Shares the logs, and the verifiers built from them, among everything that
+// is configured with the same public keys.
+//
+// Logs are keyed by the SHA-256 of their SubjectPublicKeyInfo, which is also
+// their log ID, and verifiers by the sorted log IDs of their keys. Like
+// LogUpdaterRegistry, the store only holds weak references: a log or
+// verifier lives for as long as a caller keeps it, and is built afresh by
+// the next caller after that. Asking for a verifier that is alive costs
+// hashing the keys and a lookup; no key is parsed again.
+class InternedLogStore {
+ public:
+  InternedLogStore();
+  ~InternedLogStore();
+
+  InternedLogStore(const InternedLogStore&) = delete;
+  InternedLogStore& operator=(const InternedLogStore&) = delete;
+
+  // The store of the process.
+  static InternedLogStore& Shared();
+
+  // Returns the log with the DER SubjectPublicKeyInfo |public_key|. The log
+  // is not valid if the key can't be parsed.
+  std::shared_ptr<const LogVerifier> GetLog(std::string_view public_key);
+
+  // Returns a verifier with default VerificationLimits for the logs with
+  // |public_keys|, in any order.
+  std::shared_ptr<const MultiLogVerifier> GetVerifier(
+      const std::vector<std::string_view>& public_keys);
+
+  // The number of logs and verifiers alive.
+  size_t log_count();
+  size_t verifier_count();
+
+ private:
+  std::shared_ptr<const LogVerifier> GetLogLocked(std::string_view public_key,
+                                                  const std::string& log_id);
+
+  std::mutex lock_;
+  std::unordered_map<std::string, std::weak_ptr<const LogVerifier>> logs_;
+  std::unordered_map<std::string, std::weak_ptr<const MultiLogVerifier>>
+      verifiers_;
+};
+
+}  // namespace certificate_transparency
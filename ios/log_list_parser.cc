@@ -0,0 +1,395 @@
+#include "log_list_parser.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace certificate_transparency {
+namespace {
+
+// Log lists nest four levels deep; anything much deeper is not one.
+constexpr int kMaxDepth = 32;
+
+struct JsonValue {
+  enum Type { NONE, LITERAL, NUMBER, STRING, ARRAY, OBJECT };
+
+  Type type = NONE;
+  std::string string;
+  std::vector<JsonValue> elements;
+  // Members of an object, in order, with the values in |elements|.
+  std::vector<std::string> keys;
+
+  const JsonValue* Find(std::string_view key) const {
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (keys[i] == key) {
+        return &elements[i];
+      }
+    }
+    return nullptr;
+  }
+};
+
+class JsonParser {
+ public:
+  explicit JsonParser(std::string_view input) : input_(input) {}
+
+  bool Parse(JsonValue* out) {
+    if (!ParseValue(out, 0)) {
+      return false;
+    }
+    SkipWhitespace();
+    return pos_ == input_.size();
+  }
+
+ private:
+  void SkipWhitespace() {
+    while (pos_ < input_.size() &&
+           (input_[pos_] == ' ' || input_[pos_] == '\t' ||
+            input_[pos_] == '\n' || input_[pos_] == '\r')) {
+      pos_++;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (pos_ < input_.size() && input_[pos_] == c) {
+      pos_++;
+      return true;
+    }
+    return false;
+  }
+
+  bool ConsumeLiteral(std::string_view literal) {
+    if (input_.substr(pos_, literal.size()) != literal) {
+      return false;
+    }
+    pos_ += literal.size();
+    return true;
+  }
+
+  bool ParseValue(JsonValue* out, int depth) {
+    if (depth > kMaxDepth) {
+      return false;
+    }
+    SkipWhitespace();
+    if (pos_ == input_.size()) {
+      return false;
+    }
+
+    switch (input_[pos_]) {
+      case '{':
+        return ParseObject(out, depth);
+      case '[':
+        return ParseArray(out, depth);
+      case '"':
+        out->type = JsonValue::STRING;
+        return ParseString(&out->string);
+      case 't':
+        out->type = JsonValue::LITERAL;
+        return ConsumeLiteral("true");
+      case 'f':
+        out->type = JsonValue::LITERAL;
+        return ConsumeLiteral("false");
+      case 'n':
+        out->type = JsonValue::LITERAL;
+        return ConsumeLiteral("null");
+      default:
+        out->type = JsonValue::NUMBER;
+        return ParseNumber();
+    }
+  }
+
+  bool ParseObject(JsonValue* out, int depth) {
+    out->type = JsonValue::OBJECT;
+    pos_++;
+    if (Consume('}')) {
+      return true;
+    }
+    do {
+      SkipWhitespace();
+      std::string key;
+      if (pos_ == input_.size() || input_[pos_] != '"' || !ParseString(&key) ||
+          !Consume(':')) {
+        return false;
+      }
+      out->keys.push_back(std::move(key));
+      out->elements.emplace_back();
+      if (!ParseValue(&out->elements.back(), depth + 1)) {
+        return false;
+      }
+    } while (Consume(','));
+    return Consume('}');
+  }
+
+  bool ParseArray(JsonValue* out, int depth) {
+    out->type = JsonValue::ARRAY;
+    pos_++;
+    if (Consume(']')) {
+      return true;
+    }
+    do {
+      out->elements.emplace_back();
+      if (!ParseValue(&out->elements.back(), depth + 1)) {
+        return false;
+      }
+    } while (Consume(','));
+    return Consume(']');
+  }
+
+  bool ParseDigits() {
+    const size_t start = pos_;
+    while (pos_ < input_.size() && input_[pos_] >= '0' && input_[pos_] <= '9') {
+      pos_++;
+    }
+    return pos_ != start;
+  }
+
+  bool ParseNumber() {
+    if (pos_ < input_.size() && input_[pos_] == '-') {
+      pos_++;
+    }
+    if (!ParseDigits()) {
+      return false;
+    }
+    if (pos_ < input_.size() && input_[pos_] == '.') {
+      pos_++;
+      if (!ParseDigits()) {
+        return false;
+      }
+    }
+    if (pos_ < input_.size() && (input_[pos_] == 'e' || input_[pos_] == 'E')) {
+      pos_++;
+      if (pos_ < input_.size() &&
+          (input_[pos_] == '+' || input_[pos_] == '-')) {
+        pos_++;
+      }
+      if (!ParseDigits()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ParseHex4(uint32_t* out) {
+    if (input_.size() - pos_ < 4) {
+      return false;
+    }
+    *out = 0;
+    for (int i = 0; i < 4; i++) {
+      const char c = input_[pos_++];
+      uint32_t digit;
+      if (c >= '0' && c <= '9') {
+        digit = c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        digit = c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        digit = c - 'A' + 10;
+      } else {
+        return false;
+      }
+      *out = (*out << 4) | digit;
+    }
+    return true;
+  }
+
+  static void AppendUTF8(uint32_t code_point, std::string* out) {
+    if (code_point < 0x80) {
+      out->push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+      out->push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+      out->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    } else if (code_point < 0x10000) {
+      out->push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+      out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+      out->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    } else {
+      out->push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+      out->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+      out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+      out->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+    }
+  }
+
+  bool ParseString(std::string* out) {
+    pos_++;
+    while (pos_ < input_.size()) {
+      const char c = input_[pos_++];
+      if (c == '"') {
+        return true;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return false;
+      }
+      if (c != '\\') {
+        out->push_back(c);
+        continue;
+      }
+
+      if (pos_ == input_.size()) {
+        return false;
+      }
+      switch (input_[pos_++]) {
+        case '"':
+          out->push_back('"');
+          break;
+        case '\\':
+          out->push_back('\\');
+          break;
+        case '/':
+          out->push_back('/');
+          break;
+        case 'b':
+          out->push_back('\b');
+          break;
+        case 'f':
+          out->push_back('\f');
+          break;
+        case 'n':
+          out->push_back('\n');
+          break;
+        case 'r':
+          out->push_back('\r');
+          break;
+        case 't':
+          out->push_back('\t');
+          break;
+        case 'u': {
+          uint32_t code_point;
+          if (!ParseHex4(&code_point)) {
+            return false;
+          }
+          if (code_point >= 0xd800 && code_point < 0xdc00) {
+            uint32_t low;
+            if (!ConsumeLiteral("\\u") || !ParseHex4(&low) || low < 0xdc00 ||
+                low >= 0xe000) {
+              return false;
+            }
+            code_point = 0x10000 + ((code_point - 0xd800) << 10) +
+                         (low - 0xdc00);
+          } else if (code_point >= 0xdc00 && code_point < 0xe000) {
+            return false;
+          }
+          AppendUTF8(code_point, out);
+          break;
+        }
+        default:
+          return false;
+      }
+    }
+    return false;
+  }
+
+  std::string_view input_;
+  size_t pos_ = 0;
+};
+
+int Base64Value(char c) {
+  if (c >= 'A' && c <= 'Z') {
+    return c - 'A';
+  }
+  if (c >= 'a' && c <= 'z') {
+    return c - 'a' + 26;
+  }
+  if (c >= '0' && c <= '9') {
+    return c - '0' + 52;
+  }
+  if (c == '+') {
+    return 62;
+  }
+  if (c == '/') {
+    return 63;
+  }
+  return -1;
+}
+
+}  // namespace
+
+std::optional<std::string> DecodeBase64(std::string_view input) {
+  if (input.size() % 4 != 0) {
+    return {};
+  }
+
+  std::string result;
+  result.reserve(input.size() / 4 * 3);
+  for (size_t i = 0; i < input.size(); i += 4) {
+    const bool last = i + 4 == input.size();
+    int padding = 0;
+    uint32_t group = 0;
+    for (size_t j = 0; j < 4; j++) {
+      const char c = input[i + j];
+      if (c == '=' && last && j >= 2) {
+        padding++;
+        group <<= 6;
+        continue;
+      }
+      const int value = Base64Value(c);
+      if (value < 0 || padding != 0) {
+        return {};
+      }
+      group = (group << 6) | static_cast<uint32_t>(value);
+    }
+    result.push_back(static_cast<char>(group >> 16));
+    if (padding < 2) {
+      result.push_back(static_cast<char>(group >> 8));
+    }
+    if (padding < 1) {
+      result.push_back(static_cast<char>(group));
+    }
+  }
+  return result;
+}
+
+std::optional<std::vector<std::string>> ParseLogList(std::string_view json) {
+  std::optional<std::string> revocations;
+  return ParseLogList(json, &revocations);
+}
+
+std::optional<std::vector<std::string>> ParseLogList(
+    std::string_view json,
+    std::optional<std::string>* revocations) {
+  JsonValue root;
+  if (!JsonParser(json).Parse(&root) || root.type != JsonValue::OBJECT) {
+    return {};
+  }
+
+  const JsonValue* operators = root.Find("operators");
+  if (!operators || operators->type != JsonValue::ARRAY) {
+    return {};
+  }
+
+  revocations->reset();
+  if (const JsonValue* value = root.Find("revocations")) {
+    if (value->type != JsonValue::STRING) {
+      return {};
+    }
+    *revocations = DecodeBase64(value->string);
+    if (!*revocations) {
+      return {};
+    }
+  }
+
+  std::vector<std::string> result;
+  for (const auto& op : operators->elements) {
+    const JsonValue* logs =
+        op.type == JsonValue::OBJECT ? op.Find("logs") : nullptr;
+    if (!logs || logs->type != JsonValue::ARRAY) {
+      continue;
+    }
+
+    for (const auto& log : logs->elements) {
+      const JsonValue* key =
+          log.type == JsonValue::OBJECT ? log.Find("key") : nullptr;
+      if (!key || key->type != JsonValue::STRING) {
+        continue;
+      }
+
+      auto key_data = DecodeBase64(key->string);
+      if (!key_data) {
+        continue;
+      }
+      result.push_back(std::move(*key_data));
+    }
+  }
+  return result;
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace certificate_transparency {
+
+// Extracts the DER-encoded keys of every log in a log list JSON document, in
+// the format served at the update URL: {"operators": [{"logs": [{"key":
+// "<base64>"}]}]}. Entries of an unexpected shape are skipped, like in the
+// downloader. Returns nullopt if |json| is not a JSON object with an
+// "operators" array.
+std::optional<std::vector<std::string>> ParseLogList(std::string_view json);
+
+// ParseLogList() that also sets |*revocations| to the RevocationIndex the
+// document carries in base64, as {"revocations": "<base64>"}, or to nullopt
+// if it carries none. A "revocations" member that is not a base64 string
+// fails the whole document rather than being taken for no revocations.
+std::optional<std::vector<std::string>> ParseLogList(
+    std::string_view json,
+    std::optional<std::string>* revocations);
+
+// Decodes standard, padded base64. Returns nullopt on any invalid input.
+std::optional<std::string> DecodeBase64(std::string_view input);
+
+}  // namespace certificate_transparency
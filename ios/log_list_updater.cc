@@ -0,0 +1,241 @@
+#include "log_list_updater.h"
+
+#include <random>
+#include <utility>
+
+#include "builtin_logs.h"
+#include "metrics.h"
+
+namespace certificate_transparency {
+
+LogListTransport::Ok::Ok() = default;
+LogListTransport::Ok::Ok(const Ok& other) = default;
+LogListTransport::Ok::Ok(Ok&& other) = default;
+LogListTransport::Ok& LogListTransport::Ok::operator=(const Ok& other) =
+    default;
+LogListTransport::Ok& LogListTransport::Ok::operator=(Ok&& other) = default;
+LogListTransport::Ok::~Ok() = default;
+
+LogListTransport::~LogListTransport() = default;
+
+UpdaterClock::~UpdaterClock() = default;
+
+double UpdaterClock::RandomFraction() {
+  thread_local std::mt19937_64 generator(std::random_device {}());
+  return std::uniform_real_distribution<double>(0, 1)(generator);
+}
+
+LogListState::LogListState() = default;
+LogListState::LogListState(const LogListState& other) = default;
+LogListState& LogListState::operator=(const LogListState& other) = default;
+LogListState::~LogListState() = default;
+
+LogListStorage::~LogListStorage() = default;
+
+LogListUpdater::LogListUpdater(std::unique_ptr<LogListTransport> transport,
+                               std::shared_ptr<UpdaterClock> clock,
+                               std::unique_ptr<LogListStorage> storage)
+    : transport_(std::move(transport)),
+      clock_(std::move(clock)),
+      storage_(std::move(storage)),
+      state_(storage_->Load()) {}
+
+LogListUpdater::~LogListUpdater() = default;
+
+// static
+std::shared_ptr<LogListUpdater> LogListUpdater::Create(
+    std::unique_ptr<LogListTransport> transport,
+    std::shared_ptr<UpdaterClock> clock,
+    std::unique_ptr<LogListStorage> storage) {
+  auto result = std::make_shared<LogListUpdater>(
+      std::move(transport), std::move(clock), std::move(storage));
+
+  result->ScheduleUpdate(GetInitialUpdateDelay(
+      result->state_.next_update, result->clock_->Now(),
+      result->clock_->RandomFraction()));
+  return result;
+}
+
+bool LogListUpdater::Verify(std::string_view leaf_cert,
+                            std::string_view issuer_cert,
+                            uint64_t now) {
+  std::shared_ptr<const MultiLogVerifier> verifier;
+  std::shared_ptr<const RevocationIndex> revocations;
+  GetCurrent(&verifier, &revocations);
+  if (revocations && revocations->IsRevoked(leaf_cert, issuer_cert)) {
+    CT_METRICS_INCREMENT(kRevokedChains);
+    return false;
+  }
+  return verifier->Verify(leaf_cert, issuer_cert, now);
+}
+
+bool LogListUpdater::Verify(const PreparedChain& chain, uint64_t now) {
+  std::shared_ptr<const MultiLogVerifier> verifier;
+  std::shared_ptr<const RevocationIndex> revocations;
+  GetCurrent(&verifier, &revocations);
+  if (revocations && chain.valid && revocations->IsRevoked(chain.entry)) {
+    CT_METRICS_INCREMENT(kRevokedChains);
+    return false;
+  }
+  return verifier->Verify(chain, now);
+}
+
+std::shared_ptr<const MultiLogVerifier> LogListUpdater::GetVerifier() {
+  std::shared_ptr<const MultiLogVerifier> verifier;
+  std::shared_ptr<const RevocationIndex> revocations;
+  GetCurrent(&verifier, &revocations);
+  return verifier;
+}
+
+std::shared_ptr<const RevocationIndex> LogListUpdater::GetRevocationIndex() {
+  std::shared_ptr<const MultiLogVerifier> verifier;
+  std::shared_ptr<const RevocationIndex> revocations;
+  GetCurrent(&verifier, &revocations);
+  return revocations;
+}
+
+void LogListUpdater::Prewarm() {
+  GetVerifier();
+}
+
+uint64_t LogListUpdater::verifier_builds() {
+  std::lock_guard guard(lock_);
+  return verifier_builds_;
+}
+
+void LogListUpdater::GetCurrent(
+    std::shared_ptr<const MultiLogVerifier>* verifier,
+    std::shared_ptr<const RevocationIndex>* revocations) {
+  std::lock_guard guard(lock_);
+  if (!verifier_) {
+    verifier_ = std::make_shared<const MultiLogVerifier>(
+        state_.logs ? *state_.logs : GetBuiltinLogs());
+    if (state_.revocations) {
+      revocations_ = RevocationIndex::Parse(*state_.revocations);
+    }
+    verifier_builds_++;
+  }
+  *verifier = verifier_;
+  *revocations = revocations_;
+}
+
+void LogListUpdater::UpdateNow() {
+  StartUpdate();
+}
+
+void LogListUpdater::ScheduleUpdate(uint64_t delay) {
+  uint64_t schedule_id;
+  {
+    std::lock_guard guard(lock_);
+    schedule_id = ++schedule_id_;
+  }
+
+  std::weak_ptr weak_this = weak_from_this();
+  clock_->PostDelayed(delay, [weak_this, schedule_id] {
+    auto thiz = weak_this.lock();
+    if (!thiz) {
+      return;
+    }
+    {
+      std::lock_guard guard(thiz->lock_);
+      if (thiz->schedule_id_ != schedule_id) {
+        return;
+      }
+    }
+    thiz->StartUpdate();
+  });
+}
+
+void LogListUpdater::StartUpdate() {
+  std::optional<std::string> tag;
+  {
+    std::lock_guard guard(lock_);
+    if (fetching_) {
+      update_requested_ = true;
+      return;
+    }
+    fetching_ = true;
+    tag = state_.tag;
+  }
+
+  CT_METRICS_INCREMENT(kLogListFetches);
+  std::weak_ptr weak_this = weak_from_this();
+  transport_->Fetch(tag, [weak_this](LogListTransport::FetchResult result,
+                                     const ScheduleHints& hints) {
+    if (auto thiz = weak_this.lock()) {
+      thiz->OnFetchFinished(std::move(result), hints);
+    }
+  });
+}
+
+void LogListUpdater::OnFetchFinished(LogListTransport::FetchResult result,
+                                     const ScheduleHints& hints) {
+  struct ResultVisitor {
+    bool operator()(LogListTransport::ErrorCode) const {
+      CT_METRICS_INCREMENT(kLogListFetchFailures);
+      return false;
+    }
+    bool operator()(LogListTransport::NotModified) const {
+      CT_METRICS_INCREMENT(kLogListNotModified);
+      return true;
+    }
+    bool operator()(LogListTransport::Ok& ok) const {
+      // Parse the new list before taking the lock, so verification keeps
+      // using the previous one meanwhile.
+      if (ok.revocations) {
+        *revocations = RevocationIndex::Parse(*ok.revocations);
+        // Keep the previous index rather than drop revocation checks.
+        if (!*revocations) {
+          CT_METRICS_INCREMENT(kLogListFetchFailures);
+          return false;
+        }
+      }
+      CT_METRICS_INCREMENT(kLogListUpdates);
+      *verifier = std::make_shared<const MultiLogVerifier>(ok.logs);
+      new_list->emplace(std::move(ok));
+      return true;
+    }
+
+    std::shared_ptr<const MultiLogVerifier>* verifier;
+    std::shared_ptr<const RevocationIndex>* revocations;
+    std::optional<LogListTransport::Ok>* new_list;
+  };
+
+  std::shared_ptr<const MultiLogVerifier> verifier;
+  std::shared_ptr<const RevocationIndex> revocations;
+  std::optional<LogListTransport::Ok> new_list;
+  const bool succeeded = std::visit(
+      ResultVisitor {&verifier, &revocations, &new_list}, result);
+
+  LogListState state;
+  uint64_t delay;
+  bool update_requested;
+  {
+    std::lock_guard guard(lock_);
+    state_.failures = succeeded ? 0 : state_.failures + 1;
+    delay = succeeded
+                ? GetSuccessUpdateDelay(hints, clock_->RandomFraction())
+                : GetFailureUpdateDelay(state_.failures, hints,
+                                        clock_->RandomFraction());
+    state_.next_update = clock_->Now() + delay;
+    if (new_list) {
+      state_.tag = std::move(new_list->tag);
+      state_.logs = std::move(new_list->logs);
+      state_.revocations = std::move(new_list->revocations);
+      verifier_ = std::move(verifier);
+      revocations_ = std::move(revocations);
+      verifier_builds_++;
+    }
+    state = state_;
+    fetching_ = false;
+    update_requested = std::exchange(update_requested_, false);
+  }
+
+  storage_->Save(state);
+  ScheduleUpdate(delay);
+  if (update_requested) {
+    StartUpdate();
+  }
+}
+
+}  // namespace certificate_transparency
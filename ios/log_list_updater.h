@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "multi_log_verifier.h"
+#include "revocation_index.h"
+#include "update_schedule.h"
+
+namespace certificate_transparency {
+
+// Where log lists come from.
+class LogListTransport {
+ public:
+  struct Ok {
+    Ok();
+    Ok(const Ok& other);
+    Ok(Ok&& other);
+    Ok& operator=(const Ok& other);
+    Ok& operator=(Ok&& other);
+    ~Ok();
+
+    std::optional<std::string> tag;
+    std::vector<std::string> logs;
+    // The serialized RevocationIndex the list carries, if any.
+    std::optional<std::string> revocations;
+  };
+  struct NotModified {};
+  using ErrorCode = int;
+
+  using FetchResult = std::variant<Ok, NotModified, ErrorCode>;
+  using FetchCallback =
+      std::function<void(FetchResult result, const ScheduleHints& hints)>;
+
+  virtual ~LogListTransport();
+
+  // Fetches the log list unless it still has |tag|. |callback| may run on any
+  // thread, including the calling one before Fetch() returns.
+  virtual void Fetch(const std::optional<std::string>& tag,
+                     FetchCallback callback) = 0;
+};
+
+// Tells time and runs delayed tasks.
+class UpdaterClock {
+ public:
+  virtual ~UpdaterClock();
+
+  // Milliseconds since the Unix epoch.
+  virtual uint64_t Now() = 0;
+
+  // Runs |task| on any thread after |delay| milliseconds.
+  virtual void PostDelayed(uint64_t delay, std::function<void()> task) = 0;
+
+  // Returns a number uniformly distributed in [0, 1), to jitter delays with.
+  virtual double RandomFraction();
+};
+
+// What the updater remembers across restarts.
+struct LogListState {
+  LogListState();
+  LogListState(const LogListState& other);
+  LogListState& operator=(const LogListState& other);
+  ~LogListState();
+
+  // In milliseconds since the Unix epoch.
+  std::optional<uint64_t> next_update;
+  std::optional<std::string> tag;
+  // Unset until a list has been downloaded, in which case the builtin logs
+  // are used.
+  std::optional<std::vector<std::string>> logs;
+  // The serialized RevocationIndex that came with |logs|, if any.
+  std::optional<std::string> revocations;
+  // Fetches failed since the last successful one.
+  uint32_t failures = 0;
+};
+
+class LogListStorage {
+ public:
+  virtual ~LogListStorage();
+
+  virtual LogListState Load() = 0;
+  virtual void Save(const LogListState& state) = 0;
+};
+
+// Keeps the log list current and verifies chains against it.
+//
+// Fetches follow the schedule in update_schedule.h: the stored next update
+// time, max-age or a day after a success, and Retry-After or exponential
+// backoff after failures, all jittered. A new list is parsed into a new
+// verifier before it replaces the previous one, so verification never waits
+// for an update. A list may carry a RevocationIndex, which is replaced with
+// it; a list whose index doesn't parse counts as a failed fetch.
+class LogListUpdater : public std::enable_shared_from_this<LogListUpdater> {
+ public:
+  LogListUpdater(std::unique_ptr<LogListTransport> transport,
+                 std::shared_ptr<UpdaterClock> clock,
+                 std::unique_ptr<LogListStorage> storage);
+  ~LogListUpdater();
+
+  // Creates an updater and schedules its first fetch.
+  static std::shared_ptr<LogListUpdater> Create(
+      std::unique_ptr<LogListTransport> transport,
+      std::shared_ptr<UpdaterClock> clock,
+      std::unique_ptr<LogListStorage> storage);
+
+  // Chains whose leaf is in the current revocation index fail before their
+  // SCTs are looked at.
+  bool Verify(std::string_view leaf_cert,
+              std::string_view issuer_cert,
+              uint64_t now);
+  bool Verify(const PreparedChain& chain, uint64_t now);
+
+  // Returns the verifier for the current log list. It is never modified, so
+  // callers may keep using it after the list is updated.
+  std::shared_ptr<const MultiLogVerifier> GetVerifier();
+
+  // Returns the revocation index the current log list carries, or null if
+  // it carries none.
+  std::shared_ptr<const RevocationIndex> GetRevocationIndex();
+
+  // Builds the verifier for the stored list now rather than on the first
+  // verification. A verification arriving meanwhile waits for it.
+  void Prewarm();
+
+  // The number of verifiers built so far, for the stored list and for
+  // updates.
+  uint64_t verifier_builds();
+
+  // Fetches the list now instead of at the scheduled time, for sources that
+  // know when they change. A fetch already in progress is followed by another.
+  void UpdateNow();
+
+ private:
+  // Sets |*verifier| and |*revocations| to those of the current list,
+  // building them for the stored list the first time.
+  void GetCurrent(std::shared_ptr<const MultiLogVerifier>* verifier,
+                  std::shared_ptr<const RevocationIndex>* revocations);
+  void ScheduleUpdate(uint64_t delay);
+  void StartUpdate();
+  void OnFetchFinished(LogListTransport::FetchResult result,
+                       const ScheduleHints& hints);
+
+  std::unique_ptr<LogListTransport> transport_;
+  std::shared_ptr<UpdaterClock> clock_;
+  std::unique_ptr<LogListStorage> storage_;
+
+  std::mutex lock_;
+  LogListState state_;
+  std::shared_ptr<const MultiLogVerifier> verifier_;
+  // Built along with |verifier_|.
+  std::shared_ptr<const RevocationIndex> revocations_;
+  uint64_t verifier_builds_ = 0;
+  // Timers posted before the last ScheduleUpdate() do nothing.
+  uint64_t schedule_id_ = 0;
+  bool fetching_ = false;
+  bool update_requested_ = false;
+};
+
+}  // namespace certificate_transparency
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace certificate_transparency {
+
+// Shares one updater per update URL among everything that asks for it.
+//
+// The registry only holds weak references: an updater lives for as long as
+// some caller keeps the shared_ptr returned by Get(), and the next Get() for
+// its URL after that creates a fresh one. Updaters are expected to publish
+// immutable verifier snapshots, so sharing one also shares the parsed logs.
+template <typename Updater>
+class LogUpdaterRegistry {
+ public:
+  using Factory =
+      std::function<std::shared_ptr<Updater>(const std::string& update_url)>;
+
+  LogUpdaterRegistry() = default;
+  LogUpdaterRegistry(const LogUpdaterRegistry&) = delete;
+  LogUpdaterRegistry& operator=(const LogUpdaterRegistry&) = delete;
+
+  // Returns the live updater for |update_url|, or one made by |create|.
+  std::shared_ptr<Updater> Get(const std::string& update_url,
+                               const Factory& create) {
+    std::lock_guard guard(lock_);
+    for (auto it = updaters_.begin(); it != updaters_.end();) {
+      if (it->second.expired()) {
+        it = updaters_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    auto& entry = updaters_[update_url];
+    if (auto updater = entry.lock()) {
+      return updater;
+    }
+    auto updater = create(update_url);
+    entry = updater;
+    return updater;
+  }
+
+  // The number of URLs with a live updater.
+  size_t size() {
+    std::lock_guard guard(lock_);
+    size_t result = 0;
+    for (const auto& entry : updaters_) {
+      result += !entry.second.expired();
+    }
+    return result;
+  }
+
+ private:
+  std::mutex lock_;
+  std::map<std::string, std::weak_ptr<Updater>> updaters_;
+};
+
+}  // namespace certificate_transparency
@@ -1,6 +1,6 @@
 #include "log_verifier.h"
 
-#include <CommonCrypto/CommonDigest.h>
+#include "crypto_sha256.h"
 
 namespace certificate_transparency {
 
@@ -11,7 +11,7 @@ LogVerifier::LogVerifier(std::string_view public_key)
   }
 
   uint8_t key_id[32];
-  CC_SHA256(public_key.data(), public_key.size(), key_id);
+  SHA256(public_key.data(), public_key.size(), key_id);
   key_id_.assign(std::begin(key_id), std::end(key_id));
 
   switch (key_.type()) {
@@ -18,13 +18,17 @@ class LogVerifier {
 
   bool IsValid() const;
   const std::string& key_id() const { return key_id_; }
+  PublicKey::Type key_type() const { return key_.type(); }
 
   bool Verify(const SignedEntryData& entry,
               const SignedCertificateTimestamp& sct) const;
 
- private:
+  // Returns true if |signature| uses the hash and signature algorithms of
+  // this log.
   bool SignatureParametersMatch(const DigitallySigned& signature) const;
 
+ private:
+
   PublicKey key_;
   std::string key_id_;
   DigitallySigned::HashAlgorithm hash_algorithm_ =
@@ -0,0 +1,271 @@
+#include "metrics.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace certificate_transparency {
+namespace {
+
+const char* const kCounterNames[kMetricsCounterCount] = {
+    "ct_chains_checked_total",
+    "ct_chains_verified_total",
+    "ct_verdict_store_hits_total",
+    "ct_verdict_store_misses_total",
+    "ct_coalesced_verifications_total",
+    "ct_speculation_misses_total",
+    "ct_log_list_fetches_total",
+    "ct_log_list_updates_total",
+    "ct_log_list_not_modified_total",
+    "ct_log_list_fetch_failures_total",
+    "ct_revoked_chains_total",
+};
+
+const char* const kStageNames[kMetricsStageCount] = {
+    "extract_sct_list", "rebuild_tbs",     "decode_scts",
+    "lookup_log",       "check_signature", "verify",
+};
+
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+
+// Written only by the owning thread, read by any thread taking a snapshot.
+struct ThreadMetrics {
+  std::atomic<uint64_t> counters[kMetricsCounterCount] = {};
+  std::atomic<uint64_t> buckets[kMetricsStageCount][kLatencyBucketCount] = {};
+  std::atomic<uint64_t> sums_ns[kMetricsStageCount] = {};
+  std::atomic<uint64_t> allocations[kMetricsStageCount] = {};
+  std::atomic<uint64_t> allocated_bytes[kMetricsStageCount] = {};
+
+  void AddTo(MetricsSnapshot* snapshot) const {
+    for (size_t i = 0; i < kMetricsCounterCount; i++) {
+      snapshot->counters[i] += counters[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < kMetricsStageCount; i++) {
+      StageLatency& stage = snapshot->stages[i];
+      for (size_t j = 0; j < kLatencyBucketCount; j++) {
+        const uint64_t count = buckets[i][j].load(std::memory_order_relaxed);
+        stage.buckets[j] += count;
+        stage.count += count;
+      }
+      stage.sum_ns += sums_ns[i].load(std::memory_order_relaxed);
+      snapshot->allocations[i].count +=
+          allocations[i].load(std::memory_order_relaxed);
+      snapshot->allocations[i].bytes +=
+          allocated_bytes[i].load(std::memory_order_relaxed);
+    }
+  }
+};
+
+inline void Add(std::atomic<uint64_t>* value, uint64_t n) {
+  // There is a single writer, so a plain load and store cannot lose updates
+  // and avoid the cost of a locked instruction.
+  value->store(value->load(std::memory_order_relaxed) + n,
+               std::memory_order_relaxed);
+}
+
+struct Registry {
+  std::mutex lock;
+  std::vector<const ThreadMetrics*> threads;
+  // The totals of threads that have exited.
+  MetricsSnapshot exited;
+};
+
+Registry& GetRegistry() {
+  // Never destroyed, so threads exiting after main() can still unregister.
+  static auto* registry = new Registry();
+  return *registry;
+}
+
+class ThreadRegistration {
+ public:
+  ThreadRegistration() {
+    Registry& registry = GetRegistry();
+    std::lock_guard guard(registry.lock);
+    registry.threads.push_back(&metrics_);
+  }
+
+  ~ThreadRegistration() {
+    Registry& registry = GetRegistry();
+    std::lock_guard guard(registry.lock);
+    metrics_.AddTo(&registry.exited);
+    for (auto& thread : registry.threads) {
+      if (thread == &metrics_) {
+        thread = registry.threads.back();
+        registry.threads.pop_back();
+        break;
+      }
+    }
+  }
+
+  ThreadMetrics& metrics() { return metrics_; }
+
+ private:
+  ThreadMetrics metrics_;
+};
+
+ThreadMetrics& GetThreadMetrics() {
+  thread_local ThreadRegistration registration;
+  return registration.metrics();
+}
+
+// kCount while no stage runs. Trivially initialized, unlike the metrics, so
+// RecordAllocation() may read it from inside an allocation made while the
+// metrics are being set up.
+thread_local MetricsStage g_current_stage = MetricsStage::kCount;
+
+std::atomic<StageObserver*> g_stage_observer{nullptr};
+
+size_t GetLatencyBucket(uint64_t duration_ns) {
+  uint64_t duration_us = duration_ns / 1000;
+  size_t bucket = 0;
+  while (duration_us != 0 && bucket < kLatencyBucketCount - 1) {
+    duration_us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+#endif  // defined(CERTIFICATE_TRANSPARENCY_METRICS)
+
+}  // namespace
+
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+
+void IncrementMetricsCounter(MetricsCounter counter) {
+  Add(&GetThreadMetrics().counters[static_cast<size_t>(counter)], 1);
+}
+
+void RecordStageLatency(MetricsStage stage, uint64_t duration_ns) {
+  ThreadMetrics& metrics = GetThreadMetrics();
+  const size_t index = static_cast<size_t>(stage);
+  Add(&metrics.buckets[index][GetLatencyBucket(duration_ns)], 1);
+  Add(&metrics.sums_ns[index], duration_ns);
+}
+
+void RecordAllocation(size_t bytes) {
+  const MetricsStage stage = g_current_stage;
+  if (stage == MetricsStage::kCount) {
+    return;
+  }
+  // EnterStage() set up the metrics before setting a stage.
+  ThreadMetrics& metrics = GetThreadMetrics();
+  const size_t index = static_cast<size_t>(stage);
+  Add(&metrics.allocations[index], 1);
+  Add(&metrics.allocated_bytes[index], bytes);
+}
+
+MetricsStage EnterStage(MetricsStage stage) {
+  GetThreadMetrics();
+  const MetricsStage previous_stage = std::exchange(g_current_stage, stage);
+  if (StageObserver* observer =
+          g_stage_observer.load(std::memory_order_acquire)) {
+    observer->OnStageStart(stage);
+  }
+  return previous_stage;
+}
+
+void LeaveStage(MetricsStage previous_stage) {
+  if (StageObserver* observer =
+          g_stage_observer.load(std::memory_order_acquire)) {
+    observer->OnStageEnd(g_current_stage);
+  }
+  g_current_stage = previous_stage;
+}
+
+StageObserver::~StageObserver() = default;
+
+void SetStageObserver(StageObserver* observer) {
+  g_stage_observer.store(observer, std::memory_order_release);
+}
+
+MetricsSnapshot GetMetricsSnapshot() {
+  Registry& registry = GetRegistry();
+  std::lock_guard guard(registry.lock);
+  MetricsSnapshot snapshot = registry.exited;
+  for (const ThreadMetrics* thread : registry.threads) {
+    thread->AddTo(&snapshot);
+  }
+  return snapshot;
+}
+
+#else
+
+MetricsSnapshot GetMetricsSnapshot() {
+  return MetricsSnapshot();
+}
+
+#endif  // defined(CERTIFICATE_TRANSPARENCY_METRICS)
+
+std::string ExportMetricsText(const MetricsSnapshot& snapshot) {
+  std::string text;
+  char line[256];
+  for (size_t i = 0; i < kMetricsCounterCount; i++) {
+    snprintf(line, sizeof(line), "# TYPE %s counter\n%s %" PRIu64 "\n",
+             kCounterNames[i], kCounterNames[i], snapshot.counters[i]);
+    text += line;
+  }
+
+  text += "# TYPE ct_stage_duration_seconds histogram\n";
+  for (size_t i = 0; i < kMetricsStageCount; i++) {
+    const StageLatency& stage = snapshot.stages[i];
+    uint64_t cumulative = 0;
+    for (size_t j = 0; j < kLatencyBucketCount - 1; j++) {
+      cumulative += stage.buckets[j];
+      snprintf(line, sizeof(line),
+               "ct_stage_duration_seconds_bucket{stage=\"%s\",le=\"%g\"} "
+               "%" PRIu64 "\n",
+               kStageNames[i], static_cast<double>(uint64_t{1} << j) / 1e6,
+               cumulative);
+      text += line;
+    }
+    snprintf(line, sizeof(line),
+             "ct_stage_duration_seconds_bucket{stage=\"%s\",le=\"+Inf\"} "
+             "%" PRIu64 "\n"
+             "ct_stage_duration_seconds_sum{stage=\"%s\"} %.9f\n"
+             "ct_stage_duration_seconds_count{stage=\"%s\"} %" PRIu64 "\n",
+             kStageNames[i], stage.count, kStageNames[i],
+             static_cast<double>(stage.sum_ns) / 1e9, kStageNames[i],
+             stage.count);
+    text += line;
+  }
+
+  text += "# TYPE ct_stage_allocations_total counter\n";
+  for (size_t i = 0; i < kMetricsStageCount; i++) {
+    snprintf(line, sizeof(line),
+             "ct_stage_allocations_total{stage=\"%s\"} %" PRIu64 "\n",
+             kStageNames[i], snapshot.allocations[i].count);
+    text += line;
+  }
+  text += "# TYPE ct_stage_allocated_bytes_total counter\n";
+  for (size_t i = 0; i < kMetricsStageCount; i++) {
+    snprintf(line, sizeof(line),
+             "ct_stage_allocated_bytes_total{stage=\"%s\"} %" PRIu64 "\n",
+             kStageNames[i], snapshot.allocations[i].bytes);
+    text += line;
+  }
+  return text;
+}
+
+bool WriteMetricsTextFile(const std::string& path) {
+  const std::string text = ExportMetricsText(GetMetricsSnapshot());
+  // Scrapers must never see a partly written file.
+  const std::string temporary_path = path + ".tmp";
+  FILE* file = fopen(temporary_path.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  const bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+  if (fclose(file) != 0 || !written ||
+      rename(temporary_path.c_str(), path.c_str()) != 0) {
+    unlink(temporary_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ct_config.h"
+
+namespace certificate_transparency {
+
+// The steps of a verification, timed separately.
+enum class MetricsStage {
+  // Finding the SCT list among the leaf's extensions.
+  kExtractSCTList,
+  // Rebuilding the precertificate TBSCertificate the SCTs sign.
+  kRebuildTBS,
+  kDecodeSCTs,
+  // Finding the log of an SCT by its key id.
+  kLookupLog,
+  kCheckSignature,
+  // MultiLogVerifier::Verify() as a whole, verdict store included.
+  kVerify,
+  kCount,
+};
+
+// Calls to MultiLogVerifier::Verify() are counted by its kVerify stage.
+enum class MetricsCounter {
+  // Chains whose SCTs were checked, rather than found in the verdict store,
+  // and those of them that passed.
+  kChainsChecked,
+  kChainsVerified,
+  kVerdictStoreHits,
+  kVerdictStoreMisses,
+  // Verifications that waited for the same chain in flight.
+  kCoalescedVerifications,
+  // Pipelined verifications that had to prepare the chain again.
+  kSpeculationMisses,
+  kLogListFetches,
+  kLogListUpdates,
+  kLogListNotModified,
+  kLogListFetchFailures,
+  // Chains failed by LogListUpdater because their leaf is revoked.
+  kRevokedChains,
+  kCount,
+};
+
+constexpr size_t kMetricsStageCount = static_cast<size_t>(MetricsStage::kCount);
+constexpr size_t kMetricsCounterCount =
+    static_cast<size_t>(MetricsCounter::kCount);
+// Bucket 0 holds durations under a microsecond, bucket i those under 2^i
+// microseconds and the last bucket everything longer.
+constexpr size_t kLatencyBucketCount = 16;
+
+struct StageLatency {
+  std::array<uint64_t, kLatencyBucketCount> buckets = {};
+  uint64_t count = 0;
+  uint64_t sum_ns = 0;
+};
+
+// Allocations made while a stage was the innermost one running on a thread.
+struct StageAllocations {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+struct MetricsSnapshot {
+  std::array<uint64_t, kMetricsCounterCount> counters = {};
+  std::array<StageLatency, kMetricsStageCount> stages = {};
+  std::array<StageAllocations, kMetricsStageCount> allocations = {};
+
+  uint64_t counter(MetricsCounter counter) const {
+    return counters[static_cast<size_t>(counter)];
+  }
+  const StageLatency& stage(MetricsStage stage) const {
+    return stages[static_cast<size_t>(stage)];
+  }
+  const StageAllocations& stage_allocations(MetricsStage stage) const {
+    return allocations[static_cast<size_t>(stage)];
+  }
+};
+
+// Sums the metrics recorded by every thread so far, including threads that
+// have exited. Without CERTIFICATE_TRANSPARENCY_METRICS everything is zero.
+MetricsSnapshot GetMetricsSnapshot();
+
+// Formats |snapshot| in the Prometheus text exposition format.
+std::string ExportMetricsText(const MetricsSnapshot& snapshot);
+
+// Writes the current metrics to |path| in the text format, replacing the file
+// atomically, e.g. for the textfile collector of the node exporter.
+bool WriteMetricsTextFile(const std::string& path);
+
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+
+// Recording only touches the calling thread's own metrics, without locks or
+// atomic read-modify-writes. Use the CT_METRICS_* macros below instead, which
+// vanish when metrics are compiled out.
+void IncrementMetricsCounter(MetricsCounter counter);
+void RecordStageLatency(MetricsStage stage, uint64_t duration_ns);
+
+// Counts an allocation of |bytes| against the stage running on the calling
+// thread, if any. CT_malloc() calls it; an embedder that replaces operator
+// new can call it too, so that C++ allocations are counted as well.
+void RecordAllocation(size_t bytes);
+
+// Makes |stage| the one allocations are counted against, returning the one
+// it replaces. Prefer ScopedStageTimer.
+MetricsStage EnterStage(MetricsStage stage);
+void LeaveStage(MetricsStage previous_stage);
+
+// Told on the running thread when each stage starts and ends, e.g. to read
+// hardware counters around it. Stages nest: kVerify encloses the others.
+class StageObserver {
+ public:
+  virtual ~StageObserver();
+  virtual void OnStageStart(MetricsStage stage) = 0;
+  virtual void OnStageEnd(MetricsStage stage) = 0;
+};
+
+// Installs |observer| for all threads, or removes it if null. |observer|
+// must outlive the stages running while it is installed.
+void SetStageObserver(StageObserver* observer);
+
+class ScopedStageTimer {
+ public:
+  explicit ScopedStageTimer(MetricsStage stage)
+      : stage_(stage),
+        previous_stage_(EnterStage(stage)),
+        start_(std::chrono::steady_clock::now()) {}
+  ~ScopedStageTimer() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    LeaveStage(previous_stage_);
+    RecordStageLatency(
+        stage_,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  }
+
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+ private:
+  const MetricsStage stage_;
+  const MetricsStage previous_stage_;
+  const std::chrono::steady_clock::time_point start_;
+};
+
+#define CT_METRICS_INCREMENT(counter)                 \
+  ::certificate_transparency::IncrementMetricsCounter( \
+      ::certificate_transparency::MetricsCounter::counter)
+// Times the rest of the enclosing scope, which may time only one stage.
+#define CT_METRICS_TIME_STAGE(stage)                          \
+  ::certificate_transparency::ScopedStageTimer ct_stage_timer( \
+      ::certificate_transparency::MetricsStage::stage)
+
+#else
+
+#define CT_METRICS_INCREMENT(counter) \
+  do {                                \
+  } while (0)
+#define CT_METRICS_TIME_STAGE(stage) \
+  do {                               \
+  } while (0)
+
+#endif
+
+}  // namespace certificate_transparency
@@ -1,72 +1,451 @@
 #include "multi_log_verifier.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+#include "builtin_logs.h"
+#include "crypto_sha256.h"
+#include "metrics.h"
+#include "trace.h"
 
 namespace certificate_transparency {
+namespace {
 
-MultiLogVerifier::MultiLogVerifier(const std::vector<std::string>& logs) {
-  logs_.reserve(logs.size());
+// PrepareChain() without the chain digest, which only the callers that key
+// something by the chain need.
+void PrepareEntryAndSCTs(std::string_view leaf_cert,
+                         std::string_view issuer_cert,
+                         const VerificationLimits& limits,
+                         PreparedChain* prepared) {
+  std::string encoded_sct_list;
+  ExtensionLimit extension_limit;
+  extension_limit.max_extensions = limits.max_extensions;
+  {
+    CT_METRICS_TIME_STAGE(kExtractSCTList);
+    CT_TRACE_SPAN("extract_sct_list");
+    prepared->valid =
+        ExtractEmbeddedSCTList(leaf_cert, &extension_limit, &encoded_sct_list);
+  }
+  if (prepared->valid) {
+    CT_METRICS_TIME_STAGE(kRebuildTBS);
+    CT_TRACE_SPAN("rebuild_tbs");
+    prepared->valid = GetPrecertSignedEntry(leaf_cert, issuer_cert,
+                                            &extension_limit, &prepared->entry);
+  }
+  prepared->extension_limit_exceeded = extension_limit.exceeded;
+  if (!prepared->valid) {
+    return;
+  }
+
+  CT_METRICS_TIME_STAGE(kDecodeSCTs);
+  CT_TRACE_SPAN("decode_scts");
+  std::vector<std::string_view> sct_list;
+  if (!DecodeSCTList(encoded_sct_list, &sct_list)) {
+    prepared->valid = false;
+    return;
+  }
+  if (sct_list.size() > limits.max_scts) {
+    sct_list.resize(limits.max_scts);
+    prepared->sct_limit_exceeded = true;
+  }
+  prepared->scts.reserve(sct_list.size());
+  for (auto sct : sct_list) {
+    SignedCertificateTimestamp decoded_sct;
+    if (DecodeSignedCertificateTimestamp(&sct, &decoded_sct)) {
+      prepared->scts.push_back(std::move(decoded_sct));
+    } else {
+      prepared->undecodable_scts++;
+    }
+  }
+}
+
+std::vector<std::shared_ptr<const LogVerifier>> ImportLogs(
+    const std::vector<std::string>& logs) {
+  std::vector<std::shared_ptr<const LogVerifier>> result;
+  result.reserve(logs.size());
   for (const auto& log : logs) {
-    LogVerifier verifier(log);
-    if (!verifier.IsValid()) {
+    result.push_back(std::make_shared<const LogVerifier>(log));
+  }
+  return result;
+}
+
+}  // namespace
+
+PreparedChain::PreparedChain() = default;
+PreparedChain::~PreparedChain() = default;
+
+PreparedChain::PreparedChain(PreparedChain&&) = default;
+PreparedChain& PreparedChain::operator=(PreparedChain&&) = default;
+
+void PrepareChain(std::string_view leaf_cert,
+                  std::string_view issuer_cert,
+                  const VerificationLimits& limits,
+                  PreparedChain* prepared) {
+  prepared->chain = GetChainDigest(leaf_cert, issuer_cert);
+  prepared->leaf_cert = leaf_cert;
+  prepared->issuer_cert = issuer_cert;
+  PrepareEntryAndSCTs(leaf_cert, issuer_cert, limits, prepared);
+}
+
+MultiLogVerifier::MultiLogVerifier(const std::vector<std::string>& logs)
+    : MultiLogVerifier(logs, VerificationLimits()) {}
+
+MultiLogVerifier::MultiLogVerifier(const std::vector<std::string>& logs,
+                                   const VerificationLimits& limits)
+    : MultiLogVerifier(ImportLogs(logs), limits) {}
+
+MultiLogVerifier::MultiLogVerifier(
+    std::vector<std::shared_ptr<const LogVerifier>> logs,
+    const VerificationLimits& limits)
+    : limits_(limits) {
+  logs_.reserve(logs.size());
+  for (auto& log : logs) {
+    if (!log || !log->IsValid()) {
       continue;
     }
 
-    std::string key_id = verifier.key_id();
-    logs_.emplace_back(std::move(key_id), std::move(verifier));
+    std::string key_id = log->key_id();
+    logs_.emplace_back(std::move(key_id), std::move(log));
   }
   std::sort(logs_.begin(), logs_.end(), [](const auto& lhs, const auto& rhs) {
     return lhs.first < rhs.first;
   });
+
+  SHA256_CTX ctx;
+  SHA256_Init(&ctx);
+  for (const auto& log : logs_) {
+    SHA256_Update(&ctx, log.first.data(), log.first.size());
+  }
+  const uint64_t limit_values[] = {
+      limits_.max_scts,
+      limits_.max_signature_checks,
+      limits_.one_verification_per_log,
+      limits_.max_extensions,
+  };
+  SHA256_Update(&ctx, limit_values, sizeof(limit_values));
+  uint8_t digest[kSHA256DigestLength];
+  SHA256_Final(digest, &ctx);
+  for (size_t i = 0; i < sizeof(generation_); i++) {
+    generation_ = (generation_ << 8) | digest[i];
+  }
 }
 
 MultiLogVerifier::~MultiLogVerifier() = default;
 
+void MultiLogVerifier::SetVerdictStore(std::shared_ptr<VerdictStore> store,
+                                       uint64_t ttl) {
+  verdict_store_ = std::move(store);
+  verdict_ttl_ = ttl;
+}
+
+void MultiLogVerifier::SetChainRecorder(
+    std::shared_ptr<ChainRecorder> recorder) {
+  chain_recorder_ = std::move(recorder);
+}
+
+void MultiLogVerifier::SetSignatureScheduler(
+    std::shared_ptr<SignatureScheduler> scheduler) {
+  signature_scheduler_ = std::move(scheduler);
+}
+
 bool MultiLogVerifier::Verify(std::string_view leaf_cert,
                               std::string_view issuer_cert,
                               uint64_t now) const {
+  return VerifyDetailed(leaf_cert, issuer_cert, now).verified;
+}
+
+bool MultiLogVerifier::Verify(const PreparedChain& chain, uint64_t now) const {
+  return VerifyDetailed(chain, now).verified;
+}
+
+VerificationDetails MultiLogVerifier::VerifyDetailed(
+    std::string_view leaf_cert,
+    std::string_view issuer_cert,
+    uint64_t now) const {
+  if (chain_recorder_) {
+    chain_recorder_->Record(leaf_cert, issuer_cert, now);
+  }
+  CT_METRICS_TIME_STAGE(kVerify);
+  CT_TRACE_SPAN("verify");
   if (logs_.empty()) {
-    return true;
+    VerificationDetails details;
+    details.verified = true;
+    return details;
+  }
+  if (!verdict_store_) {
+    return VerifyUncached(leaf_cert, issuer_cert, now);
   }
 
-  SignedEntryData data;
-  std::string encoded_sct_list;
-  std::vector<std::string_view> sct_list;
-  if (!ExtractEmbeddedSCTList(leaf_cert, &encoded_sct_list) ||
-      !GetPrecertSignedEntry(leaf_cert, issuer_cert, &data) ||
-      !DecodeSCTList(encoded_sct_list, &sct_list)) {
-    return false;
+  return VerifyWithStore(GetChainDigest(leaf_cert, issuer_cert), now, [&] {
+    return VerifyUncached(leaf_cert, issuer_cert, now);
+  });
+}
+
+VerificationDetails MultiLogVerifier::VerifyDetailed(const PreparedChain& chain,
+                                                     uint64_t now) const {
+  if (chain_recorder_ && !chain.leaf_cert.empty()) {
+    chain_recorder_->Record(chain.leaf_cert, chain.issuer_cert, now);
+  }
+  CT_METRICS_TIME_STAGE(kVerify);
+  CT_TRACE_SPAN("verify");
+  if (logs_.empty()) {
+    VerificationDetails details;
+    details.verified = true;
+    return details;
+  }
+  if (!verdict_store_) {
+    return VerifyPrepared(chain, now);
   }
 
-  std::vector<std::string_view> embedded_log_ids;
-  for (auto sct : sct_list) {
-    SignedCertificateTimestamp decoded_sct;
-    if (!DecodeSignedCertificateTimestamp(&sct, &decoded_sct)) {
-      continue;
-    }
+  return VerifyWithStore(chain.chain, now,
+                         [&] { return VerifyPrepared(chain, now); });
+}
 
-    auto it = std::lower_bound(
-        logs_.begin(), logs_.end(), decoded_sct.log_id,
-        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs; });
-    if (it == logs_.end() || it->first != decoded_sct.log_id) {
-      continue;
-    }
-    if (!it->second.Verify(data, decoded_sct)) {
+template <typename VerifyFunction>
+VerificationDetails MultiLogVerifier::VerifyWithStore(
+    const ChainDigest& chain,
+    uint64_t now,
+    const VerifyFunction& verify) const {
+  VerificationDetails details;
+  if (verdict_store_->Lookup(chain, generation_, now, &details.verified)) {
+    CT_METRICS_INCREMENT(kVerdictStoreHits);
+    details.from_verdict_store = true;
+    return details;
+  }
+  CT_METRICS_INCREMENT(kVerdictStoreMisses);
+  details = verify();
+  if (!details.verified && details.future_timestamps > 0) {
+    return details;
+  }
+  const uint64_t expiry =
+      now > UINT64_MAX - verdict_ttl_ ? UINT64_MAX : now + verdict_ttl_;
+  verdict_store_->Store(chain, generation_, now, expiry, details.verified);
+  return details;
+}
+
+VerificationDetails MultiLogVerifier::VerifyUncached(
+    std::string_view leaf_cert,
+    std::string_view issuer_cert,
+    uint64_t now) const {
+  PreparedChain chain;
+  PrepareEntryAndSCTs(leaf_cert, issuer_cert, limits_, &chain);
+  return VerifyPrepared(chain, now);
+}
+
+VerificationDetails MultiLogVerifier::CheckAllSCTs(const PreparedChain& chain,
+                                                   uint64_t now) const {
+  CT_METRICS_TIME_STAGE(kVerify);
+  CT_TRACE_SPAN("verify");
+  return VerifyPrepared(chain, now, /*stop_at_quorum=*/false);
+}
+
+VerificationDetails MultiLogVerifier::VerifyPrepared(
+    const PreparedChain& chain,
+    uint64_t now,
+    bool stop_at_quorum) const {
+  CT_METRICS_INCREMENT(kChainsChecked);
+  VerificationDetails details;
+  if (chain.extension_limit_exceeded) {
+    extension_limit_hits_.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (!chain.valid) {
+    details.malformed = true;
+    return details;
+  }
+  if (chain.sct_limit_exceeded) {
+    sct_limit_hits_.fetch_add(1, std::memory_order_relaxed);
+  }
+  details.sct_count = static_cast<uint8_t>(std::min<size_t>(
+      chain.scts.size(), std::numeric_limits<uint8_t>::max()));
+  details.undecodable_scts = static_cast<uint8_t>(std::min<size_t>(
+      chain.undecodable_scts, std::numeric_limits<uint8_t>::max()));
+
+  const size_t required_logs = std::min<size_t>(2, logs_.size());
+  // The SCTs from known logs with a timestamp in the past, which may need a
+  // signature check.
+  std::vector<SCTCheck> pending;
+  pending.reserve(chain.scts.size());
+  for (size_t i = 0; i < chain.scts.size(); i++) {
+    const auto& decoded_sct = chain.scts[i];
+    SCTStatus unused_status;
+    SCTStatus& status =
+        i < kMaxReportedSCTs ? details.sct_status[i] : unused_status;
+    TraceSpan sct_span("sct");
+    auto it = FindLog(decoded_sct.log_id);
+    if (it == logs_.end()) {
+      status = SCTStatus::kUnknownLog;
       continue;
     }
+    sct_span.SetLog(decoded_sct.log_id,
+                    it->second->key_type() == PublicKey::kRSA ? "RSA" : "EC");
     if (decoded_sct.timestamp > now) {
+      status = SCTStatus::kFutureTimestamp;
+      if (details.future_timestamps < std::numeric_limits<uint8_t>::max()) {
+        details.future_timestamps++;
+      }
       continue;
     }
+    pending.push_back({i, it});
+  }
 
-    embedded_log_ids.push_back(it->first);
+  // Indices into |logs_| of the logs whose SCTs were checked, and of the
+  // ones that passed.
+  std::vector<size_t> checked_logs;
+  checked_logs.reserve(pending.size());
+  std::vector<size_t> embedded_logs;
+  embedded_logs.reserve(pending.size());
+  bool duplicate_log_skipped = false;
+  bool limit_reached = false;
+  // Each round checks the first pending SCT of every log, all at once. A
+  // log's later SCTs wait for the next round, which only runs if the quorum
+  // hasn't passed and |one_verification_per_log| is not set.
+  std::vector<SCTCheck> round;
+  round.reserve(pending.size());
+  std::vector<SCTCheck> later;
+  while (!pending.empty() && !limit_reached &&
+         !(stop_at_quorum && embedded_logs.size() >= required_logs)) {
+    round.clear();
+    later.clear();
+    for (const SCTCheck& check : pending) {
+      SCTStatus unused_status;
+      SCTStatus& status = check.sct_index < kMaxReportedSCTs
+                              ? details.sct_status[check.sct_index]
+                              : unused_status;
+      const size_t log_index = check.log - logs_.begin();
+      const auto& seen_logs =
+          limits_.one_verification_per_log ? checked_logs : embedded_logs;
+      if (std::find(seen_logs.begin(), seen_logs.end(), log_index) !=
+          seen_logs.end()) {
+        status = SCTStatus::kDuplicateLog;
+        duplicate_log_skipped = true;
+        continue;
+      }
+      if (std::any_of(round.begin(), round.end(), [&](const SCTCheck& other) {
+            return other.log == check.log;
+          })) {
+        later.push_back(check);
+        continue;
+      }
+      // A mismatch costs no public key operation, so it is recorded without
+      // spending the budget or counting as the log's check.
+      if (!check.log->second->SignatureParametersMatch(
+              chain.scts[check.sct_index].signature)) {
+        status = SCTStatus::kBadParams;
+        continue;
+      }
+      if (checked_logs.size() == limits_.max_signature_checks) {
+        limit_reached = true;
+        break;
+      }
+      checked_logs.push_back(log_index);
+      round.push_back(check);
+    }
+
+    const auto record = [&](const SCTCheck& check, bool valid) {
+      details.signature_checks++;
+      if (check.sct_index < kMaxReportedSCTs) {
+        details.sct_status[check.sct_index] =
+            valid ? SCTStatus::kOk : SCTStatus::kBadSignature;
+      }
+      if (valid) {
+        embedded_logs.push_back(check.log - logs_.begin());
+      }
+    };
+    if (signature_scheduler_) {
+      const std::vector<char> valid = CheckSignatures(chain, round);
+      for (size_t i = 0; i < round.size(); i++) {
+        record(round[i], valid[i]);
+      }
+    } else {
+      for (const SCTCheck& check : round) {
+        record(check, CheckSignature(*check.log->second, chain.entry,
+                                     chain.scts[check.sct_index]));
+        if (stop_at_quorum && embedded_logs.size() >= required_logs) {
+          break;
+        }
+      }
+    }
+    pending.swap(later);
+  }
+  // The limit only counts when it stopped checks the verdict needed.
+  if (limit_reached &&
+      !(stop_at_quorum && embedded_logs.size() >= required_logs)) {
+    signature_limit_hits_.fetch_add(1, std::memory_order_relaxed);
   }
 
-  std::sort(embedded_log_ids.begin(), embedded_log_ids.end());
-  embedded_log_ids.erase(
-      std::unique(embedded_log_ids.begin(), embedded_log_ids.end()),
-      embedded_log_ids.end());
+  if (duplicate_log_skipped) {
+    duplicate_log_skips_.fetch_add(1, std::memory_order_relaxed);
+  }
+  details.distinct_logs = static_cast<uint8_t>(embedded_logs.size());
+  if (embedded_logs.size() < required_logs) {
+    return details;
+  }
+  CT_METRICS_INCREMENT(kChainsVerified);
+  details.verified = true;
+  return details;
+}
+
+MultiLogVerifier::LogIterator MultiLogVerifier::FindLog(
+    const std::string& log_id) const {
+  CT_METRICS_TIME_STAGE(kLookupLog);
+  CT_TRACE_SPAN("lookup_log");
+  auto it = std::lower_bound(
+      logs_.begin(), logs_.end(), log_id,
+      [](const auto& lhs, const auto& rhs) { return lhs.first < rhs; });
+  return it != logs_.end() && it->first == log_id ? it : logs_.end();
+}
+
+bool MultiLogVerifier::CheckSignature(
+    const LogVerifier& log,
+    const SignedEntryData& entry,
+    const SignedCertificateTimestamp& sct) const {
+  CT_METRICS_TIME_STAGE(kCheckSignature);
+  CT_TRACE_SPAN("check_signature");
+  return log.Verify(entry, sct);
+}
+
+std::vector<char> MultiLogVerifier::CheckSignatures(
+    const PreparedChain& chain,
+    const std::vector<SCTCheck>& checks) const {
+  CT_METRICS_TIME_STAGE(kCheckSignature);
+  CT_TRACE_SPAN("check_signatures");
+  std::vector<char> valid(checks.size());
+  std::mutex lock;
+  std::condition_variable done;
+  size_t remaining = checks.size();
+  for (size_t i = 0; i < checks.size(); i++) {
+    signature_scheduler_->Submit(
+        *checks[i].log->second, chain.entry, chain.scts[checks[i].sct_index],
+        [&, i](bool result) {
+          std::lock_guard guard(lock);
+          valid[i] = result;
+          if (--remaining == 0) {
+            done.notify_one();
+          }
+        });
+  }
+  std::unique_lock guard(lock);
+  done.wait(guard, [&] { return remaining == 0; });
+  return valid;
+}
+
+VerificationLimitCounters MultiLogVerifier::limit_counters() const {
+  VerificationLimitCounters counters;
+  counters.sct_limit_hits = sct_limit_hits_.load(std::memory_order_relaxed);
+  counters.signature_limit_hits =
+      signature_limit_hits_.load(std::memory_order_relaxed);
+  counters.duplicate_log_skips =
+      duplicate_log_skips_.load(std::memory_order_relaxed);
+  counters.extension_limit_hits =
+      extension_limit_hits_.load(std::memory_order_relaxed);
+  return counters;
+}
 
-  return embedded_log_ids.size() >= std::min(2ul, logs_.size());
+const MultiLogVerifier& GetBuiltinLogVerifier() {
+  static const auto* verifier = new MultiLogVerifier(GetBuiltinLogs());
+  return *verifier;
 }
 
 }  // namespace certificate_transparency
@@ -1,25 +1,229 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "chain_digest.h"
+#include "chain_recorder.h"
+#include "ct_objects_extractor.h"
+#include "ct_serialization.h"
 #include "log_verifier.h"
+#include "signature_scheduler.h"
+#include "verdict_store.h"
 
 namespace certificate_transparency {
 
+// Bounds the work a single chain can cause, so a hostile or broken server
+// cannot make Verify() run dozens of public key operations.
+struct VerificationLimits {
+  // SCTs after the first |max_scts| in the embedded list are ignored.
+  size_t max_scts = 16;
+  // Signature checks after the first |max_signature_checks| are not run.
+  // SCTs whose algorithms don't match their log's are rejected without a
+  // check and don't count.
+  size_t max_signature_checks = 8;
+  // If set, at most one SCT per log is checked, even if it fails, so a log
+  // whose first SCT is bad doesn't count for the chain. Otherwise, as before
+  // the limits, the log's later SCTs are checked until one passes.
+  bool one_verification_per_log = false;
+  // Leaves with more extensions are rejected without looking further.
+  size_t max_extensions = 64;
+};
+
+// The number of Verify() calls that hit each of the VerificationLimits.
+struct VerificationLimitCounters {
+  uint64_t sct_limit_hits = 0;
+  uint64_t signature_limit_hits = 0;
+  uint64_t duplicate_log_skips = 0;
+  uint64_t extension_limit_hits = 0;
+};
+
+// The part of a chain's verification that depends on the certificates alone:
+// the SCTs embedded in the leaf, decoded, and the precertificate entry they
+// sign. It needs neither the logs nor the trust decision, so it can be done
+// while the chain is still being evaluated.
+struct PreparedChain {
+  PreparedChain();
+  ~PreparedChain();
+
+  PreparedChain(PreparedChain&&);
+  PreparedChain& operator=(PreparedChain&&);
+
+  ChainDigest chain = {};
+  // The certificates the chain was prepared from, for a ChainRecorder. They
+  // are views, so they are cleared when the certificates go away first.
+  std::string_view leaf_cert;
+  std::string_view issuer_cert;
+  // False if the leaf has no well-formed SCT list or precertificate entry.
+  bool valid = false;
+  bool extension_limit_exceeded = false;
+  bool sct_limit_exceeded = false;
+  SignedEntryData entry;
+  // The first |max_scts| SCTs of the list, without the undecodable ones.
+  std::vector<SignedCertificateTimestamp> scts;
+  size_t undecodable_scts = 0;
+};
+
+// Fills |prepared| for the chain of |leaf_cert| and |issuer_cert|, applying
+// the |max_extensions| and |max_scts| of |limits|.
+void PrepareChain(std::string_view leaf_cert,
+                  std::string_view issuer_cert,
+                  const VerificationLimits& limits,
+                  PreparedChain* prepared);
+
+// What became of one SCT of a verified chain.
+enum class SCTStatus : uint8_t {
+  // Not looked at, because enough logs had passed or the signature checks
+  // allowed by VerificationLimits were spent.
+  kNotChecked,
+  kOk,
+  // Not from a log in the list.
+  kUnknownLog,
+  // Signed with a hash or signature algorithm other than its log's.
+  kBadParams,
+  kFutureTimestamp,
+  kBadSignature,
+  // Skipped, because an SCT from the same log was checked before.
+  kDuplicateLog,
+};
+
+constexpr size_t kMaxReportedSCTs = 16;
+
+// Explains a verdict, for tuning the quorum and caching policies. It is small
+// enough to return by value.
+struct VerificationDetails {
+  bool verified = false;
+  // The verdict came from the verdict store. Nothing else is filled in.
+  bool from_verdict_store = false;
+  // The leaf has no well-formed SCT list or precertificate entry.
+  bool malformed = false;
+  // The SCTs looked at, after |max_scts| and without the undecodable ones.
+  // The status of the first kMaxReportedSCTs of them is in |sct_status|.
+  uint8_t sct_count = 0;
+  uint8_t undecodable_scts = 0;
+  // SCTs dated after the time of the verification. They may pass later, so
+  // a verdict that failed with them is not stored.
+  uint8_t future_timestamps = 0;
+  // Public key operations spent.
+  uint8_t signature_checks = 0;
+  // Logs with an SCT that passed.
+  uint8_t distinct_logs = 0;
+  std::array<SCTStatus, kMaxReportedSCTs> sct_status = {};
+};
+
 class MultiLogVerifier {
  public:
   explicit MultiLogVerifier(const std::vector<std::string>& logs);
+  MultiLogVerifier(const std::vector<std::string>& logs,
+                   const VerificationLimits& limits);
+  // Uses |logs|, which may be shared with other verifiers, as they are.
+  // Invalid logs are skipped.
+  MultiLogVerifier(std::vector<std::shared_ptr<const LogVerifier>> logs,
+                   const VerificationLimits& limits);
   ~MultiLogVerifier();
 
   bool Verify(std::string_view leaf_cert,
               std::string_view issuer_cert,
               uint64_t now) const;
+  // Same, for a chain prepared with the limits() of this verifier.
+  bool Verify(const PreparedChain& chain, uint64_t now) const;
+
+  // Verify() with the outcome of each SCT and the work spent on them.
+  VerificationDetails VerifyDetailed(std::string_view leaf_cert,
+                                     std::string_view issuer_cert,
+                                     uint64_t now) const;
+  VerificationDetails VerifyDetailed(const PreparedChain& chain,
+                                     uint64_t now) const;
+
+  // VerifyDetailed() that goes on checking the SCTs of other logs once the
+  // quorum has passed, for callers that apply a policy of their own to
+  // |sct_status|. It doesn't use the verdict store.
+  VerificationDetails CheckAllSCTs(const PreparedChain& chain,
+                                   uint64_t now) const;
+
+  const VerificationLimits& limits() const { return limits_; }
+  VerificationLimitCounters limit_counters() const;
+
+  // Identifies the set of valid logs and the limits, which together determine
+  // every verdict. Verifiers built from the same list share a generation.
+  uint64_t generation() const { return generation_; }
+
+  // Makes Verify() consult |store| first and record its verdicts there for
+  // |ttl| milliseconds. Failures that depend on the time of the verification
+  // are not recorded. Must be called before the first Verify().
+  void SetVerdictStore(std::shared_ptr<VerdictStore> store, uint64_t ttl);
+
+  // Makes Verify() pass the leaf and issuer to |recorder| first, for
+  // replaying later. Prepared chains are recorded from their |leaf_cert| and
+  // |issuer_cert|, unless those were cleared. Must be called before the
+  // first Verify().
+  void SetChainRecorder(std::shared_ptr<ChainRecorder> recorder);
+
+  // Makes Verify() run its signature checks on |scheduler|, batched with
+  // those of concurrent calls. The SCTs of a chain from different logs are
+  // submitted together and waited for once, so a chain waits for one batch
+  // window rather than one per SCT, at the cost of checking SCTs past the
+  // quorum. Must be called before the first Verify().
+  void SetSignatureScheduler(std::shared_ptr<SignatureScheduler> scheduler);
 
  private:
-  std::vector<std::pair<std::string, LogVerifier>> logs_;
+  VerificationDetails VerifyUncached(std::string_view leaf_cert,
+                                     std::string_view issuer_cert,
+                                     uint64_t now) const;
+  // Checks SCTs until |chain| has passed the quorum or, if
+  // |stop_at_quorum| is false, until they run out.
+  VerificationDetails VerifyPrepared(const PreparedChain& chain,
+                                     uint64_t now,
+                                     bool stop_at_quorum = true) const;
+
+  using LogIterator = std::vector<
+      std::pair<std::string, std::shared_ptr<const LogVerifier>>>::
+      const_iterator;
+  // Returns the log with |log_id|, or the end of |logs_|.
+  LogIterator FindLog(const std::string& log_id) const;
+  bool CheckSignature(const LogVerifier& log,
+                      const SignedEntryData& entry,
+                      const SignedCertificateTimestamp& sct) const;
+  // An SCT of a prepared chain and its log.
+  struct SCTCheck {
+    size_t sct_index;
+    LogIterator log;
+  };
+  // Submits all of |checks| to |signature_scheduler_| and waits for them
+  // once. Returns whether each signature is valid.
+  std::vector<char> CheckSignatures(const PreparedChain& chain,
+                                    const std::vector<SCTCheck>& checks) const;
+  // Looks |chain| up in |verdict_store_| or, if it is not there, verifies it
+  // with |verify| and stores the verdict.
+  template <typename VerifyFunction>
+  VerificationDetails VerifyWithStore(const ChainDigest& chain,
+                                      uint64_t now,
+                                      const VerifyFunction& verify) const;
+
+  std::vector<std::pair<std::string, std::shared_ptr<const LogVerifier>>>
+      logs_;
+  VerificationLimits limits_;
+  uint64_t generation_ = 0;
+  std::shared_ptr<VerdictStore> verdict_store_;
+  uint64_t verdict_ttl_ = 0;
+  std::shared_ptr<ChainRecorder> chain_recorder_;
+  std::shared_ptr<SignatureScheduler> signature_scheduler_;
+
+  mutable std::atomic<uint64_t> sct_limit_hits_{0};
+  mutable std::atomic<uint64_t> signature_limit_hits_{0};
+  mutable std::atomic<uint64_t> duplicate_log_skips_{0};
+  mutable std::atomic<uint64_t> extension_limit_hits_{0};
 };
 
+// Returns the verifier for the builtin logs, built on first use. Callers that
+// race with the first use wait for it rather than build their own.
+const MultiLogVerifier& GetBuiltinLogVerifier();
+
 }  // namespace certificate_transparency
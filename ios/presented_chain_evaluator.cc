@@ -0,0 +1,33 @@
+#include "presented_chain_evaluator.h"
+
+#include <thread>
+
+namespace certificate_transparency {
+
+PresentedChainEvaluator::PresentedChainEvaluator(
+    const std::vector<std::string_view>& chain,
+    const RootIndex* roots,
+    std::chrono::microseconds latency)
+    : chain_(chain), roots_(roots), latency_(latency) {}
+
+PresentedChainEvaluator::~PresentedChainEvaluator() = default;
+
+ChainEvaluation PresentedChainEvaluator::Evaluate() {
+  if (latency_.count() > 0) {
+    std::this_thread::sleep_for(latency_);
+  }
+
+  ChainEvaluation evaluation;
+  if (chain_.empty()) {
+    return evaluation;
+  }
+  evaluation.trusted = roots_->Contains(chain_.back());
+  evaluation.has_custom_root = evaluation.trusted;
+  evaluation.leaf_cert = std::string(chain_[0]);
+  if (chain_.size() > 1) {
+    evaluation.issuer_cert = std::string(chain_[1]);
+  }
+  return evaluation;
+}
+
+}  // namespace certificate_transparency
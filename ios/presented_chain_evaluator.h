@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "chain_evaluator.h"
+#include "root_index.h"
+
+namespace certificate_transparency {
+
+// Stands in for SecTrust where there is none, for tests and benchmarks. The
+// presented chain is taken as built and is trusted if its last certificate is
+// in |roots|, which also serve as the custom roots. No signatures, names or
+// validity periods are checked.
+//
+// Evaluate() first sleeps for |latency|, in place of the path building and
+// the round trip to the trust daemon that SecTrust spends its time on.
+class PresentedChainEvaluator : public ChainEvaluator {
+ public:
+  PresentedChainEvaluator(const std::vector<std::string_view>& chain,
+                          const RootIndex* roots,
+                          std::chrono::microseconds latency);
+  ~PresentedChainEvaluator() override;
+
+  ChainEvaluation Evaluate() override;
+
+ private:
+  const std::vector<std::string_view> chain_;
+  const RootIndex* const roots_;
+  const std::chrono::microseconds latency_;
+};
+
+}  // namespace certificate_transparency
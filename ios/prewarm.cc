@@ -0,0 +1,45 @@
+#include "prewarm.h"
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <thread>
+#include <utility>
+
+#include "multi_log_verifier.h"
+
+namespace certificate_transparency {
+namespace {
+
+void LowerThreadPriority() {
+#if defined(__APPLE__)
+  pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#elif defined(__linux__)
+  // Linux applies nice values to threads, not whole processes.
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+}
+
+}  // namespace
+
+void PrewarmInBackground(std::shared_ptr<LogListUpdater> updater,
+                         std::function<void()> done) {
+  std::thread([updater = std::move(updater), done = std::move(done)] {
+    LowerThreadPriority();
+    GetBuiltinLogVerifier();
+    if (updater) {
+      updater->Prewarm();
+    }
+    if (done) {
+      done();
+    }
+  }).detach();
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "log_list_updater.h"
+
+namespace certificate_transparency {
+
+// Takes verifier setup off the first handshake: builds the builtin log
+// verifier and, if |updater| is set, the verifier for its stored list, on a
+// new thread at background priority. Verifications that need them meanwhile
+// wait for the work in progress rather than repeat it. |done|, if set, runs
+// on that thread when everything is built.
+void PrewarmInBackground(std::shared_ptr<LogListUpdater> updater,
+                         std::function<void()> done = nullptr);
+
+}  // namespace certificate_transparency
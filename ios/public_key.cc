@@ -0,0 +1,67 @@
+#include "public_key.h"
+
+#include "crypto_bytestring.h"
+#include "ec_public_key.h"
+#include "rsa_public_key.h"
+#include "safe_cstring.h"
+
+namespace certificate_transparency {
+namespace {
+
+const ASN1Method* const kASN1Methods[] = {&kECASN1Method, &kRSAASN1Method};
+
+const ASN1Method* ParseKeyMethod(CBS* cbs) {
+  CBS oid;
+  if (!CBS_get_asn1(cbs, &oid, CBS_ASN1_OBJECT)) {
+    return nullptr;
+  }
+
+  for (const auto* method : kASN1Methods) {
+    if (CBS_len(&oid) == method->oid_len &&
+        safe_memcmp(CBS_data(&oid), method->oid, method->oid_len) == 0) {
+      return method;
+    }
+  }
+
+  return nullptr;
+}
+
+PublicKey ParsePublicKey(CBS* cbs) {
+  CBS spki, algorithm, key;
+  uint8_t padding;
+  if (!CBS_get_asn1(cbs, &spki, CBS_ASN1_SEQUENCE) ||
+      !CBS_get_asn1(&spki, &algorithm, CBS_ASN1_SEQUENCE) ||
+      !CBS_get_asn1(&spki, &key, CBS_ASN1_BITSTRING) || CBS_len(&spki) != 0) {
+    return {};
+  }
+  const ASN1Method* method = ParseKeyMethod(&algorithm);
+  if (!method || !method->pub_decode) {
+    return {};
+  }
+  if (!CBS_get_u8(&key, &padding) || padding != 0) {
+    return {};
+  }
+
+  PublicKey result;
+  if (!method->pub_decode(&result, &algorithm, &key)) {
+    return {};
+  }
+
+  return result;
+}
+
+}  // namespace
+
+// static
+PublicKey PublicKey::Parse(std::string_view data) {
+  CBS cbs;
+  CBS_init(&cbs, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+  auto key = ParsePublicKey(&cbs);
+  if (!key.IsValid() || CBS_len(&cbs) != 0) {
+    return {};
+  }
+
+  return key;
+}
+
+}  // namespace certificate_transparency
@@ -1,9 +1,17 @@
 #pragma once
 
-#import <Security/Security.h>
+#include <memory>
 #include <string_view>
 
 #include "crypto_bytestring.h"
+#include "ct_config.h"
+
+#if defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+#include "crypto_p256.h"
+#include "crypto_rsa.h"
+#else
+#import <Security/Security.h>
+#endif
 
 namespace certificate_transparency {
 
@@ -27,7 +35,12 @@ class PublicKey {
   static PublicKey Parse(std::string_view data);
 
   PublicKey();
+#if defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+  explicit PublicKey(std::unique_ptr<P256_PUBLIC_KEY> ec_key);
+  explicit PublicKey(std::unique_ptr<RSA_PUBLIC_KEY> rsa_key);
+#else
   PublicKey(Type type, SecKeyRef key);
+#endif
   PublicKey(const PublicKey&) = delete;
   PublicKey(PublicKey&& other);
   PublicKey& operator=(const PublicKey&) = delete;
@@ -41,7 +54,14 @@ class PublicKey {
 
  private:
   Type type_ = kEC;
+#if defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+  // Own the comb tables or Montgomery constants built at import time. Only
+  // the one matching |type_| is set.
+  std::unique_ptr<P256_PUBLIC_KEY> ec_key_;
+  std::unique_ptr<RSA_PUBLIC_KEY> rsa_key_;
+#else
   SecKeyRef key_ = nullptr;
+#endif
 };
 
 }  // namespace certificate_transparency
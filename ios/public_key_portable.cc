@@ -0,0 +1,54 @@
+#include "public_key.h"
+
+#if defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+
+#include <cassert>
+#include <utility>
+
+#include "crypto_sha256.h"
+
+namespace certificate_transparency {
+
+PublicKey::PublicKey() = default;
+
+PublicKey::PublicKey(std::unique_ptr<P256_PUBLIC_KEY> ec_key)
+    : type_(kEC), ec_key_(std::move(ec_key)) {}
+
+PublicKey::PublicKey(std::unique_ptr<RSA_PUBLIC_KEY> rsa_key)
+    : type_(kRSA), rsa_key_(std::move(rsa_key)) {}
+
+PublicKey::PublicKey(PublicKey&& other) = default;
+PublicKey& PublicKey::operator=(PublicKey&& rhs) = default;
+
+PublicKey::~PublicKey() = default;
+
+bool PublicKey::IsValid() const {
+  return ec_key_ != nullptr || rsa_key_ != nullptr;
+}
+
+bool PublicKey::VerifySignature(
+    std::string_view data,
+    std::string_view signature) const {
+  assert(IsValid());
+
+  uint8_t digest[kSHA256DigestLength];
+  SHA256(data.data(), data.size(), digest);
+
+  switch (type_) {
+    case kEC:
+      return P256_verify_digest(
+          ec_key_.get(), digest,
+          reinterpret_cast<const uint8_t*>(signature.data()),
+          signature.size());
+    case kRSA:
+      return RSA_verify_pkcs1_sha256(
+          rsa_key_.get(), digest,
+          reinterpret_cast<const uint8_t*>(signature.data()),
+          signature.size());
+  }
+  return false;
+}
+
+}  // namespace certificate_transparency
+
+#endif  // defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
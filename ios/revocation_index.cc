@@ -0,0 +1,436 @@
+#include "revocation_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "certificate_bundle.h"
+#include "safe_cstring.h"
+
+namespace certificate_transparency {
+namespace {
+
+// The serialized index, with integers in big-endian:
+//
+//   u32 magic, u8 version, u8 hash count, u16 zero,
+//   u32 Bloom filter blocks, u32 issuers, u32 runs, u32 serial numbers,
+//   u32 size of the entries,
+//   the Bloom filter blocks, of kBloomBlockSize bytes each,
+//   the issuers, each a 32 byte key hash, u32 first run, u32 serial numbers,
+//   the runs, each the u32 offset of its first entry and the first 8 bytes of
+//   its first serial number, padded with zeros,
+//   the entries, each a u8 count of bytes shared with the previous serial
+//   number in the run, a u8 count of the bytes that follow, and those bytes.
+constexpr uint32_t kMagic = 0x43545256;  // "CTRV"
+constexpr uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = 28;
+constexpr size_t kIssuerSize = 40;
+constexpr size_t kRunSize = 12;
+constexpr size_t kRunKeySize = 8;
+
+// A block is a cache line, which holds all the bits of a serial number.
+constexpr size_t kBloomBlockSize = 64;
+constexpr size_t kBloomBlockBits = kBloomBlockSize * 8;
+// About a 1% false positive rate.
+constexpr size_t kBloomBitsPerSerial = 12;
+constexpr uint8_t kBloomHashCount = 6;
+constexpr uint8_t kMaxBloomHashCount = 16;
+
+uint32_t ReadU32(const uint8_t* in) {
+  return (static_cast<uint32_t>(in[0]) << 24) |
+         (static_cast<uint32_t>(in[1]) << 16) |
+         (static_cast<uint32_t>(in[2]) << 8) | static_cast<uint32_t>(in[3]);
+}
+
+uint64_t ReadU64(const uint8_t* in) {
+  return (static_cast<uint64_t>(ReadU32(in)) << 32) | ReadU32(in + 4);
+}
+
+// The first bytes of |serial| as a number. Serial numbers whose keys differ
+// are in the same order as their keys.
+uint64_t SerialKey(std::string_view serial) {
+  uint64_t key = 0;
+  for (size_t i = 0; i < kRunKeySize; i++) {
+    key = (key << 8) |
+          (i < serial.size() ? static_cast<uint8_t>(serial[i]) : 0);
+  }
+  return key;
+}
+
+void AppendU32(std::string* out, uint32_t value) {
+  out->push_back(static_cast<char>(value >> 24));
+  out->push_back(static_cast<char>(value >> 16));
+  out->push_back(static_cast<char>(value >> 8));
+  out->push_back(static_cast<char>(value));
+}
+
+// FNV-1a, finished so that every bit depends on every byte. Serial numbers
+// are often random already, but small CAs number theirs in sequence.
+uint64_t HashSerial(std::string_view serial) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (char c : serial) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccd;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Calls |visit| with the byte offset and mask of each bit of |serial| in a
+// filter of |blocks| blocks, until it returns false. Returns whether it
+// never did.
+template <typename Visit>
+bool ForEachBloomBit(std::string_view serial,
+                     size_t blocks,
+                     uint8_t hash_count,
+                     const Visit& visit) {
+  const uint64_t hash = HashSerial(serial);
+  const size_t block = static_cast<size_t>(((hash >> 32) * blocks) >> 32);
+  const uint32_t low = static_cast<uint32_t>(hash);
+  const uint32_t step = (low >> 9) | 1;
+  for (uint32_t i = 0; i < hash_count; i++) {
+    const uint32_t bit = (low + i * step) % kBloomBlockBits;
+    if (!visit(block * kBloomBlockSize + bit / 8,
+               static_cast<uint8_t>(1 << (bit % 8)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t SharedPrefix(std::string_view a, std::string_view b) {
+  const size_t limit = std::min(a.size(), b.size());
+  size_t shared = 0;
+  while (shared < limit && a[shared] == b[shared]) {
+    shared++;
+  }
+  return shared;
+}
+
+}  // namespace
+
+// static
+std::optional<std::string> RevocationIndex::Build(
+    std::vector<RevokedCertificate> revoked) {
+  for (const auto& cert : revoked) {
+    if (cert.serial.empty() || cert.serial.size() > kMaxSerialSize) {
+      return {};
+    }
+  }
+  const auto key = [](const RevokedCertificate& cert) {
+    return std::tie(cert.issuer_key_hash, cert.serial);
+  };
+  std::sort(revoked.begin(), revoked.end(),
+            [&](const RevokedCertificate& a, const RevokedCertificate& b) {
+              return key(a) < key(b);
+            });
+  const auto same = [&](const RevokedCertificate& a,
+                        const RevokedCertificate& b) {
+    return key(a) == key(b);
+  };
+  revoked.erase(std::unique(revoked.begin(), revoked.end(), same),
+                revoked.end());
+
+  const size_t bloom_blocks = std::max<size_t>(
+      1, (revoked.size() * kBloomBitsPerSerial + kBloomBlockBits - 1) /
+             kBloomBlockBits);
+  std::string bloom(bloom_blocks * kBloomBlockSize, '\0');
+  std::string issuers;
+  std::string runs;
+  std::string entries;
+  size_t issuer_count = 0;
+  size_t run_count = 0;
+  for (size_t begin = 0, end; begin < revoked.size(); begin = end) {
+    const auto& issuer_key_hash = revoked[begin].issuer_key_hash;
+    for (end = begin; end < revoked.size() &&
+                      revoked[end].issuer_key_hash == issuer_key_hash;
+         end++) {
+    }
+    issuers.append(reinterpret_cast<const char*>(issuer_key_hash.data()),
+                   issuer_key_hash.size());
+    AppendU32(&issuers, static_cast<uint32_t>(run_count));
+    AppendU32(&issuers, static_cast<uint32_t>(end - begin));
+    issuer_count++;
+
+    for (size_t i = begin; i < end; i++) {
+      const std::string& serial = revoked[i].serial;
+      size_t shared = 0;
+      if ((i - begin) % kRestartInterval == 0) {
+        AppendU32(&runs, static_cast<uint32_t>(entries.size()));
+        const uint64_t key = SerialKey(serial);
+        AppendU32(&runs, static_cast<uint32_t>(key >> 32));
+        AppendU32(&runs, static_cast<uint32_t>(key));
+        run_count++;
+      } else {
+        shared = SharedPrefix(revoked[i - 1].serial, serial);
+      }
+      entries.push_back(static_cast<char>(shared));
+      entries.push_back(static_cast<char>(serial.size() - shared));
+      entries.append(serial, shared);
+      ForEachBloomBit(serial, bloom_blocks, kBloomHashCount,
+                      [&](size_t byte, uint8_t mask) {
+                        bloom[byte] |= mask;
+                        return true;
+                      });
+    }
+  }
+  if (std::max({bloom_blocks, revoked.size(), entries.size()}) >
+      std::numeric_limits<uint32_t>::max()) {
+    return {};
+  }
+
+  std::string out;
+  out.reserve(kHeaderSize + bloom.size() + issuers.size() + runs.size() +
+              entries.size());
+  AppendU32(&out, kMagic);
+  out.push_back(static_cast<char>(kVersion));
+  out.push_back(static_cast<char>(kBloomHashCount));
+  out.append(2, '\0');
+  AppendU32(&out, static_cast<uint32_t>(bloom_blocks));
+  AppendU32(&out, static_cast<uint32_t>(issuer_count));
+  AppendU32(&out, static_cast<uint32_t>(run_count));
+  AppendU32(&out, static_cast<uint32_t>(revoked.size()));
+  AppendU32(&out, static_cast<uint32_t>(entries.size()));
+  out += bloom;
+  out += issuers;
+  out += runs;
+  out += entries;
+  return out;
+}
+
+// static
+std::unique_ptr<RevocationIndex> RevocationIndex::Parse(std::string data) {
+  std::unique_ptr<RevocationIndex> index(
+      new RevocationIndex(std::move(data), nullptr));
+  return index->Init() ? std::move(index) : nullptr;
+}
+
+// static
+std::unique_ptr<RevocationIndex> RevocationIndex::Open(
+    const std::string& path) {
+  auto mapped = MappedFile::Open(path);
+  if (!mapped) {
+    return nullptr;
+  }
+  std::unique_ptr<RevocationIndex> index(
+      new RevocationIndex(std::string(), std::move(mapped)));
+  return index->Init() ? std::move(index) : nullptr;
+}
+
+RevocationIndex::RevocationIndex(std::string owned,
+                                 std::unique_ptr<MappedFile> mapped)
+    : owned_(std::move(owned)),
+      mapped_(std::move(mapped)),
+      data_(mapped_ ? mapped_->contents() : std::string_view(owned_)) {}
+
+RevocationIndex::~RevocationIndex() = default;
+
+bool RevocationIndex::IsRevoked(const std::array<uint8_t, 32>& issuer_key_hash,
+                                std::string_view serial) const {
+  if (!MayContain(serial)) {
+    return false;
+  }
+  size_t first_run, serial_count;
+  if (!FindIssuer(issuer_key_hash, &first_run, &serial_count)) {
+    return false;
+  }
+
+  // Find the last run that starts at or before |serial|, by the keys in the
+  // runs, which spares reading the entries unless two keys are equal.
+  const uint64_t key = SerialKey(serial);
+  size_t low = 0;
+  size_t high = (serial_count + kRestartInterval - 1) / kRestartInterval;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const uint64_t run_key =
+        ReadU64(runs_ + (first_run + middle) * kRunSize + 4);
+    if (run_key != key ? run_key < key
+                       : RunStart(first_run + middle) <= serial) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == 0) {
+    return false;
+  }
+
+  // Then walk it. Each serial number in it is below |serial| until one is
+  // found, and |matched| is how many bytes the last one has in common with
+  // it, so only the bytes from there on need comparing.
+  const size_t run = first_run + low - 1;
+  const size_t in_run =
+      std::min(kRestartInterval, serial_count - (low - 1) * kRestartInterval);
+  size_t offset = ReadU32(runs_ + run * kRunSize);
+  const size_t end = run + 1 < run_count_
+                         ? ReadU32(runs_ + (run + 1) * kRunSize)
+                         : entries_.size();
+  size_t matched = 0;
+  size_t previous_size = 0;
+  for (size_t i = 0; i < in_run; i++) {
+    if (end - offset < 2) {
+      return false;
+    }
+    const size_t shared = static_cast<uint8_t>(entries_[offset]);
+    const size_t rest = static_cast<uint8_t>(entries_[offset + 1]);
+    offset += 2;
+    if (shared > previous_size || end - offset < rest) {
+      return false;
+    }
+    const std::string_view suffix = entries_.substr(offset, rest);
+    offset += rest;
+    previous_size = shared + rest;
+    // Sharing more with the previous serial number than |serial| does, it
+    // is below |serial| as well; sharing less, it is above.
+    if (shared != matched) {
+      if (shared < matched) {
+        return false;
+      }
+      continue;
+    }
+    const std::string_view remaining = serial.substr(matched);
+    const size_t common = SharedPrefix(suffix, remaining);
+    if (common == suffix.size()) {
+      if (common == remaining.size()) {
+        return true;
+      }
+    } else if (common == remaining.size() ||
+               static_cast<uint8_t>(suffix[common]) >
+                   static_cast<uint8_t>(remaining[common])) {
+      return false;
+    }
+    matched += common;
+  }
+  return false;
+}
+
+bool RevocationIndex::IsRevoked(std::string_view leaf_cert,
+                                std::string_view issuer_cert) const {
+  std::string_view serial;
+  if (!ExtractSerialNumber(leaf_cert, &serial) || !MayContain(serial)) {
+    return false;
+  }
+  std::array<uint8_t, 32> issuer_key_hash;
+  return GetIssuerKeyHash(issuer_cert, &issuer_key_hash) &&
+         IsRevoked(issuer_key_hash, serial);
+}
+
+bool RevocationIndex::IsRevoked(const SignedEntryData& entry) const {
+  std::string_view serial;
+  return ExtractTBSSerialNumber(entry.tbs_certificate, &serial) &&
+         IsRevoked(entry.issuer_key_hash, serial);
+}
+
+bool RevocationIndex::Init() {
+  if (data_.size() < kHeaderSize) {
+    return false;
+  }
+  const uint8_t* header = reinterpret_cast<const uint8_t*>(data_.data());
+  hash_count_ = header[5];
+  bloom_blocks_ = ReadU32(header + 8);
+  issuer_count_ = ReadU32(header + 12);
+  run_count_ = ReadU32(header + 16);
+  serial_count_ = ReadU32(header + 20);
+  const size_t entries_size = ReadU32(header + 24);
+  if (ReadU32(header) != kMagic || header[4] != kVersion ||
+      hash_count_ == 0 || hash_count_ > kMaxBloomHashCount ||
+      bloom_blocks_ == 0) {
+    return false;
+  }
+  const uint64_t size = kHeaderSize +
+                        uint64_t{bloom_blocks_} * kBloomBlockSize +
+                        uint64_t{issuer_count_} * kIssuerSize +
+                        uint64_t{run_count_} * kRunSize + entries_size;
+  if (size != data_.size()) {
+    return false;
+  }
+  bloom_ = header + kHeaderSize;
+  issuers_ = bloom_ + bloom_blocks_ * kBloomBlockSize;
+  runs_ = issuers_ + issuer_count_ * kIssuerSize;
+  entries_ = std::string_view(
+      reinterpret_cast<const char*>(runs_ + run_count_ * kRunSize),
+      entries_size);
+
+  // The issuers are in order, and their runs follow one another.
+  size_t runs = 0;
+  size_t serials = 0;
+  for (size_t i = 0; i < issuer_count_; i++) {
+    const uint8_t* issuer = issuers_ + i * kIssuerSize;
+    const size_t serial_count = ReadU32(issuer + 36);
+    if ((i > 0 && safe_memcmp(issuer - kIssuerSize, issuer, 32) >= 0) ||
+        ReadU32(issuer + 32) != runs || serial_count == 0) {
+      return false;
+    }
+    runs += (serial_count + kRestartInterval - 1) / kRestartInterval;
+    serials += serial_count;
+    if (runs > run_count_) {
+      return false;
+    }
+  }
+  if (runs != run_count_ || serials != serial_count_) {
+    return false;
+  }
+
+  // The runs are in order and start within the entries.
+  for (size_t i = 0; i < run_count_; i++) {
+    const size_t offset = ReadU32(runs_ + i * kRunSize);
+    if (offset >= entries_size ||
+        (i == 0 ? offset != 0
+                : offset <= ReadU32(runs_ + (i - 1) * kRunSize))) {
+      return false;
+    }
+  }
+  return run_count_ != 0 || entries_size == 0;
+}
+
+bool RevocationIndex::MayContain(std::string_view serial) const {
+  return ForEachBloomBit(serial, bloom_blocks_, hash_count_,
+                         [this](size_t byte, uint8_t mask) {
+                           return (bloom_[byte] & mask) != 0;
+                         });
+}
+
+bool RevocationIndex::FindIssuer(
+    const std::array<uint8_t, 32>& issuer_key_hash,
+    size_t* first_run,
+    size_t* serial_count) const {
+  size_t low = 0;
+  size_t high = issuer_count_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const uint8_t* issuer = issuers_ + middle * kIssuerSize;
+    const int comparison = safe_memcmp(issuer, issuer_key_hash.data(), 32);
+    if (comparison == 0) {
+      *first_run = ReadU32(issuer + 32);
+      *serial_count = ReadU32(issuer + 36);
+      return true;
+    }
+    if (comparison < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return false;
+}
+
+std::string_view RevocationIndex::RunStart(size_t run) const {
+  const size_t offset = ReadU32(runs_ + run * kRunSize);
+  const size_t end = run + 1 < run_count_
+                         ? ReadU32(runs_ + (run + 1) * kRunSize)
+                         : entries_.size();
+  // A first entry that shares bytes is malformed, and sorts first.
+  if (end - offset < 2 || entries_[offset] != 0 ||
+      end - offset - 2 < static_cast<uint8_t>(entries_[offset + 1])) {
+    return {};
+  }
+  return entries_.substr(offset + 2,
+                         static_cast<uint8_t>(entries_[offset + 1]));
+}
+
+}  // namespace certificate_transparency
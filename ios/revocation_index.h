@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ct_objects_extractor.h"
+
+namespace certificate_transparency {
+
+class MappedFile;
+
+// A certificate its issuer has revoked.
+struct RevokedCertificate {
+  // The SHA-256 of the issuer's SubjectPublicKeyInfo, as in SignedEntryData.
+  std::array<uint8_t, 32> issuer_key_hash;
+  // The contents octets of the certificate's serialNumber, as encoded in it.
+  std::string serial;
+};
+
+// A set of revoked certificates, keyed by issuer key hash and serial number,
+// checked without going to the network.
+//
+// The serialized index is used where it lies, in memory or in a mapped file,
+// after checking only its tables. It begins with a blocked Bloom filter on
+// serial numbers, which answers a lookup of a certificate that is not revoked
+// with one cache line and no hashing of the issuer. The issuers follow,
+// sorted by key hash, each with its serial numbers sorted and
+// prefix-compressed in runs of kRestartInterval. A serial number that passes
+// the filter costs the issuer's key hash, a binary search over the issuers
+// and one over the runs.
+class RevocationIndex {
+ public:
+  static constexpr size_t kRestartInterval = 16;
+  static constexpr size_t kMaxSerialSize = 255;
+
+  // Serializes |revoked|, dropping duplicates, e.g. for the log list to
+  // carry. Returns nullopt if a serial number is empty or longer than
+  // kMaxSerialSize.
+  static std::optional<std::string> Build(
+      std::vector<RevokedCertificate> revoked);
+
+  // Returns nullptr if |data| is not a well-formed index.
+  static std::unique_ptr<RevocationIndex> Parse(std::string data);
+
+  // Maps the index in the file at |path|. Returns nullptr if the file can't
+  // be mapped or is not a well-formed index.
+  static std::unique_ptr<RevocationIndex> Open(const std::string& path);
+
+  ~RevocationIndex();
+
+  RevocationIndex(const RevocationIndex&) = delete;
+  RevocationIndex& operator=(const RevocationIndex&) = delete;
+
+  bool IsRevoked(const std::array<uint8_t, 32>& issuer_key_hash,
+                 std::string_view serial) const;
+
+  // Returns true if |leaf_cert|, issued by |issuer_cert|, is revoked.
+  // Certificates that don't parse are not.
+  bool IsRevoked(std::string_view leaf_cert,
+                 std::string_view issuer_cert) const;
+
+  // Returns true if the certificate |entry| was extracted from is revoked,
+  // reading its serial number from |entry.tbs_certificate|.
+  bool IsRevoked(const SignedEntryData& entry) const;
+
+  // The number of revoked certificates.
+  size_t size() const { return serial_count_; }
+
+ private:
+  RevocationIndex(std::string owned, std::unique_ptr<MappedFile> mapped);
+
+  // Checks the tables of |data_| and finds them. Serial numbers are checked
+  // as they are read.
+  bool Init();
+
+  // Returns false if no certificate with |serial| is revoked, by any issuer.
+  bool MayContain(std::string_view serial) const;
+
+  // Returns the position in the runs of the serial numbers revoked by the
+  // issuer with |issuer_key_hash|, or false if it revoked none.
+  bool FindIssuer(const std::array<uint8_t, 32>& issuer_key_hash,
+                  size_t* first_run,
+                  size_t* serial_count) const;
+
+  // Returns the serial number that begins |run|, which is stored whole, or
+  // an empty one if the run is malformed.
+  std::string_view RunStart(size_t run) const;
+
+  std::string owned_;
+  std::unique_ptr<MappedFile> mapped_;
+  std::string_view data_;
+
+  uint8_t hash_count_ = 0;
+  size_t bloom_blocks_ = 0;
+  size_t issuer_count_ = 0;
+  size_t run_count_ = 0;
+  size_t serial_count_ = 0;
+  const uint8_t* bloom_ = nullptr;
+  const uint8_t* issuers_ = nullptr;
+  const uint8_t* runs_ = nullptr;
+  std::string_view entries_;
+};
+
+}  // namespace certificate_transparency
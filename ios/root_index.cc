@@ -0,0 +1,39 @@
+#include "root_index.h"
+
+#include "safe_cstring.h"
+
+namespace certificate_transparency {
+namespace {
+
+CertDigest GetCertDigest(std::string_view cert) {
+  CertDigest digest;
+  SHA256(cert.data(), cert.size(), digest.data());
+  return digest;
+}
+
+}  // namespace
+
+RootIndex::RootIndex() = default;
+RootIndex::~RootIndex() = default;
+
+RootIndex::RootIndex(RootIndex&&) = default;
+RootIndex& RootIndex::operator=(RootIndex&&) = default;
+
+void RootIndex::Add(std::string_view cert) {
+  digests_.insert(GetCertDigest(cert));
+}
+
+bool RootIndex::Contains(std::string_view cert) const {
+  if (digests_.empty()) {
+    return false;
+  }
+  return digests_.count(GetCertDigest(cert)) != 0;
+}
+
+size_t RootIndex::DigestHash::operator()(const CertDigest& digest) const {
+  size_t hash;
+  safe_memcpy(&hash, digest.data(), sizeof(hash));
+  return hash;
+}
+
+}  // namespace certificate_transparency
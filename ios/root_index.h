@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_set>
+
+#include "crypto_sha256.h"
+
+namespace certificate_transparency {
+
+using CertDigest = std::array<uint8_t, kSHA256DigestLength>;
+
+// A set of trust anchors keyed by the SHA-256 of their DER encoding.
+//
+// Built once per configuration, it answers whether a chain ends in one of the
+// anchors with a single hash lookup, however many anchors are configured.
+class RootIndex {
+ public:
+  RootIndex();
+  ~RootIndex();
+
+  RootIndex(RootIndex&&);
+  RootIndex& operator=(RootIndex&&);
+
+  // Adds the DER-encoded certificate |cert|. Adding it again has no effect.
+  void Add(std::string_view cert);
+
+  // Returns true if |cert| is byte-for-byte one of the added certificates.
+  bool Contains(std::string_view cert) const;
+
+  size_t size() const { return digests_.size(); }
+
+ private:
+  // The digests are uniformly distributed, so any eight bytes make a hash.
+  struct DigestHash {
+    size_t operator()(const CertDigest& digest) const;
+  };
+
+  std::unordered_set<CertDigest, DigestHash> digests_;
+};
+
+}  // namespace certificate_transparency
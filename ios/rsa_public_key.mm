@@ -1,5 +1,7 @@
 #include "rsa_public_key.h"
 
+#if !defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+
 #import <Foundation/Foundation.h>
 #import <Security/Security.h>
 
@@ -50,3 +52,5 @@ const ASN1Method kRSAASN1Method = {
     DecodeRSAPublicKey};
 
 }  // namespace certificate_transparency
+
+#endif  // !defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
@@ -0,0 +1,43 @@
+#include "rsa_public_key.h"
+
+#if defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
+
+#include <memory>
+
+#include "crypto_bytestring.h"
+#include "crypto_rsa.h"
+
+namespace certificate_transparency {
+namespace {
+
+int DecodeRSAPublicKey(PublicKey* out, CBS* params, CBS* key) {
+  // The parameters must be NULL.
+  CBS null;
+  if (!CBS_get_asn1(params, &null, CBS_ASN1_NULL) || CBS_len(&null) != 0 ||
+      CBS_len(params) != 0) {
+    return 0;
+  }
+
+  // Requires RSA keys of at least 2048 bits, and keeps the Montgomery
+  // constants for every later verification.
+  auto public_key = std::make_unique<RSA_PUBLIC_KEY>();
+  if (!RSA_PUBLIC_KEY_init(public_key.get(), CBS_data(key), CBS_len(key))) {
+    return 0;
+  }
+
+  *out = PublicKey(std::move(public_key));
+  return 1;
+}
+
+}  // namespace
+
+const ASN1Method kRSAASN1Method = {
+    PublicKey::kRSA,
+    // 1.2.840.113549.1.1.1
+    {0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01},
+    9,
+    DecodeRSAPublicKey};
+
+}  // namespace certificate_transparency
+
+#endif  // defined(CERTIFICATE_TRANSPARENCY_PORTABLE)
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 
+#include "crypto_mem.h"
+
 namespace certificate_transparency {
 
 static inline const uint8_t* safe_memchr(const uint8_t* s, int c, size_t n) {
@@ -49,7 +53,7 @@ static inline void* safe_memdup(const void* data, size_t size) {
     return NULL;
   }
 
-  void* ret = malloc(size);
+  void* ret = CT_malloc(size);
   if (ret == NULL) {
     return NULL;
   }
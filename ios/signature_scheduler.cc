@@ -0,0 +1,128 @@
+#include "signature_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace certificate_transparency {
+
+SignatureScheduler::SignatureScheduler(const Options& options)
+    : options_{std::max<size_t>(options.worker_threads, 1),
+               std::max<size_t>(options.max_batch_size, 1),
+               options.batch_window_us} {
+  workers_.reserve(options_.worker_threads);
+  for (size_t i = 0; i < options_.worker_threads; i++) {
+    workers_.emplace_back([this] { RunWorker(); });
+  }
+}
+
+SignatureScheduler::~SignatureScheduler() {
+  {
+    std::lock_guard guard(lock_);
+    stopping_ = true;
+  }
+  queued_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void SignatureScheduler::Submit(const LogVerifier& log,
+                                const SignedEntryData& entry,
+                                const SignedCertificateTimestamp& sct,
+                                Callback callback) {
+  Enqueue({&log, &entry, &sct, std::move(callback), nullptr, nullptr,
+           Clock::now()});
+}
+
+bool SignatureScheduler::Check(const LogVerifier& log,
+                               const SignedEntryData& entry,
+                               const SignedCertificateTimestamp& sct) {
+  bool result = false;
+  bool done = false;
+  Enqueue({&log, &entry, &sct, nullptr, &result, &done, Clock::now()});
+  std::unique_lock guard(lock_);
+  done_.wait(guard, [&done] { return done; });
+  return result;
+}
+
+SignatureScheduler::Stats SignatureScheduler::stats() const {
+  std::lock_guard guard(lock_);
+  return stats_;
+}
+
+void SignatureScheduler::Enqueue(Item item) {
+  {
+    std::lock_guard guard(lock_);
+    queue_.push_back(std::move(item));
+  }
+  queued_.notify_one();
+}
+
+void SignatureScheduler::RunWorker() {
+  const std::chrono::microseconds window(options_.batch_window_us);
+  std::vector<Item> batch;
+  batch.reserve(options_.max_batch_size);
+  std::vector<bool> results;
+
+  std::unique_lock guard(lock_);
+  while (true) {
+    queued_.wait(guard, [this] { return stopping_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+    // Wait for the batch to fill, or for the window of its oldest check to
+    // close. Checks left when stopping are run without waiting.
+    const Clock::time_point deadline = queue_.front().queued + window;
+    queued_.wait_until(guard, deadline, [this] {
+      return stopping_ || queue_.size() >= options_.max_batch_size;
+    });
+    if (queue_.empty()) {
+      // Another worker took the batch.
+      continue;
+    }
+
+    const size_t size = std::min(queue_.size(), options_.max_batch_size);
+    stats_.checks += size;
+    stats_.batches++;
+    stats_.full_batches += size == options_.max_batch_size;
+    batch.assign(std::make_move_iterator(queue_.begin()),
+                 std::make_move_iterator(queue_.begin() + size));
+    queue_.erase(queue_.begin(), queue_.begin() + size);
+    if (!queue_.empty()) {
+      // The rest may be a batch for another worker already.
+      queued_.notify_one();
+    }
+    guard.unlock();
+
+    std::stable_sort(batch.begin(), batch.end(),
+                     [](const Item& lhs, const Item& rhs) {
+                       return std::less<const LogVerifier*>()(lhs.log,
+                                                              rhs.log);
+                     });
+    results.resize(batch.size());
+    bool has_waiters = false;
+    for (size_t i = 0; i < batch.size(); i++) {
+      results[i] = batch[i].log->Verify(*batch[i].entry, *batch[i].sct);
+      has_waiters = has_waiters || batch[i].done;
+    }
+    for (size_t i = 0; i < batch.size(); i++) {
+      if (batch[i].callback) {
+        batch[i].callback(results[i]);
+      }
+    }
+
+    guard.lock();
+    for (size_t i = 0; i < batch.size(); i++) {
+      if (batch[i].done) {
+        *batch[i].result = results[i];
+        *batch[i].done = true;
+      }
+    }
+    batch.clear();
+    if (has_waiters) {
+      done_.notify_all();
+    }
+  }
+}
+
+}  // namespace certificate_transparency
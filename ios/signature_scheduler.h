@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "log_verifier.h"
+
+namespace certificate_transparency {
+
+// Runs the signature checks of concurrent verifications in small batches on
+// worker threads of its own.
+//
+// Each chain costs two to five public key operations, and under load every
+// handshake runs them on its own thread. With a scheduler, a check is queued
+// instead. A worker waits until |max_batch_size| checks are queued or the
+// oldest one has waited |batch_window_us|, takes them and runs them grouped
+// by log, so that the checks under one key run back to back while its tables
+// are in cache. A batch is also where a multi-buffer kernel would take over;
+// the portable backend has none yet.
+//
+// The window adds up to |batch_window_us| to each check, so it trades latency
+// for throughput; benchmarks/signature_scheduler_benchmark.cc sweeps it.
+class SignatureScheduler {
+ public:
+  struct Options {
+    size_t worker_threads = 1;
+    size_t max_batch_size = 16;
+    // 0 runs whatever is queued as soon as a worker is free.
+    uint64_t batch_window_us = 50;
+  };
+
+  struct Stats {
+    uint64_t checks = 0;
+    uint64_t batches = 0;
+    // Batches that were run because they reached |max_batch_size|, rather
+    // than because the window closed.
+    uint64_t full_batches = 0;
+  };
+
+  using Callback = std::function<void(bool valid)>;
+
+  explicit SignatureScheduler(const Options& options);
+  // Runs the checks still queued, then stops the workers.
+  ~SignatureScheduler();
+
+  SignatureScheduler(const SignatureScheduler&) = delete;
+  SignatureScheduler& operator=(const SignatureScheduler&) = delete;
+
+  // Queues the check of |sct| over |entry| with |log| and calls |callback|
+  // with the result on a worker thread. The arguments must stay alive until
+  // then.
+  void Submit(const LogVerifier& log,
+              const SignedEntryData& entry,
+              const SignedCertificateTimestamp& sct,
+              Callback callback);
+
+  // Queues the check and waits for its result.
+  bool Check(const LogVerifier& log,
+             const SignedEntryData& entry,
+             const SignedCertificateTimestamp& sct);
+
+  const Options& options() const { return options_; }
+  Stats stats() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // A queued check. Checks made with Check() have no callback and report to
+  // |result| and |done| instead, under |lock_|.
+  struct Item {
+    const LogVerifier* log;
+    const SignedEntryData* entry;
+    const SignedCertificateTimestamp* sct;
+    Callback callback;
+    bool* result;
+    bool* done;
+    Clock::time_point queued;
+  };
+
+  void Enqueue(Item item);
+  void RunWorker();
+
+  const Options options_;
+
+  mutable std::mutex lock_;
+  // Signalled when a check is queued and when stopping.
+  std::condition_variable queued_;
+  // Signalled when checks made with Check() are done.
+  std::condition_variable done_;
+  std::deque<Item> queue_;
+  bool stopping_ = false;
+  Stats stats_;
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace certificate_transparency
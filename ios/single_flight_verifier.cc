@@ -0,0 +1,126 @@
+#include "single_flight_verifier.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metrics.h"
+
+namespace certificate_transparency {
+
+struct SingleFlightVerifier::State {
+  struct Flight {
+    bool done = false;
+    bool verified = false;
+    std::vector<Callback> callbacks;
+  };
+
+  explicit State(VerifyFunction verify) : verify(std::move(verify)) {}
+
+  // Looks up the flight for |digest|, starting one if there is none. Returns
+  // true if the flight was started by this call. |lock| must be held.
+  bool Join(const ChainDigest& digest, std::shared_ptr<Flight>* flight) {
+    auto it = flights.find(digest);
+    if (it != flights.end()) {
+      coalesced_count++;
+      CT_METRICS_INCREMENT(kCoalescedVerifications);
+      *flight = it->second;
+      return false;
+    }
+    *flight = std::make_shared<Flight>();
+    flights.emplace(digest, *flight);
+    return true;
+  }
+
+  // Runs |run_verify| for a flight started by Join() and hands the verdict
+  // to everyone waiting for it.
+  bool Run(const ChainDigest& digest,
+           const std::shared_ptr<Flight>& flight,
+           const std::function<bool()>& run_verify) {
+    const bool verified = run_verify();
+
+    std::vector<Callback> callbacks;
+    {
+      std::lock_guard guard(lock);
+      flights.erase(digest);
+      flight->done = true;
+      flight->verified = verified;
+      callbacks.swap(flight->callbacks);
+    }
+    done.notify_all();
+
+    for (auto& callback : callbacks) {
+      callback(verified);
+    }
+    return verified;
+  }
+
+  const VerifyFunction verify;
+
+  std::mutex lock;
+  std::condition_variable done;
+  std::map<ChainDigest, std::shared_ptr<Flight>> flights;
+  uint64_t coalesced_count = 0;
+};
+
+SingleFlightVerifier::SingleFlightVerifier()
+    : SingleFlightVerifier(VerifyFunction()) {}
+
+SingleFlightVerifier::SingleFlightVerifier(VerifyFunction verify)
+    : state_(std::make_shared<State>(std::move(verify))) {}
+
+SingleFlightVerifier::~SingleFlightVerifier() = default;
+
+bool SingleFlightVerifier::Verify(std::string_view leaf_cert,
+                                  std::string_view issuer_cert,
+                                  uint64_t now) {
+  return Verify(GetChainDigest(leaf_cert, issuer_cert), [&] {
+    return state_->verify(leaf_cert, issuer_cert, now);
+  });
+}
+
+bool SingleFlightVerifier::Verify(const ChainDigest& chain,
+                                  const std::function<bool()>& verify) {
+  std::shared_ptr<State::Flight> flight;
+  {
+    std::unique_lock guard(state_->lock);
+    if (!state_->Join(chain, &flight)) {
+      state_->done.wait(guard, [&flight] { return flight->done; });
+      return flight->verified;
+    }
+  }
+  return state_->Run(chain, flight, verify);
+}
+
+void SingleFlightVerifier::VerifyAsync(std::string_view leaf_cert,
+                                       std::string_view issuer_cert,
+                                       uint64_t now,
+                                       const Executor& executor,
+                                       Callback callback) {
+  const ChainDigest digest = GetChainDigest(leaf_cert, issuer_cert);
+  std::shared_ptr<State::Flight> flight;
+  {
+    std::lock_guard guard(state_->lock);
+    const bool started = state_->Join(digest, &flight);
+    flight->callbacks.push_back(std::move(callback));
+    if (!started) {
+      return;
+    }
+  }
+
+  executor([state = state_, digest, flight, leaf = std::string(leaf_cert),
+            issuer = std::string(issuer_cert), now] {
+    state->Run(digest, flight,
+               [&] { return state->verify(leaf, issuer, now); });
+  });
+}
+
+uint64_t SingleFlightVerifier::coalesced_count() const {
+  std::lock_guard guard(state_->lock);
+  return state_->coalesced_count;
+}
+
+}  // namespace certificate_transparency
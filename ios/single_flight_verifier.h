@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string_view>
+
+#include "chain_digest.h"
+
+namespace certificate_transparency {
+
+// Coalesces concurrent verifications of the same chain.
+//
+// A page opening many connections to one host triggers a challenge per
+// connection, all for the same leaf and issuer. The first request for a chain
+// runs |verify|; requests for that chain made before it finishes attach to it
+// and receive the same verdict. Verdicts are not kept once the computation
+// completes.
+//
+// Requests that attach reuse the |now| of the request that started the
+// computation, which is at most one verification older than their own.
+class SingleFlightVerifier {
+ public:
+  using VerifyFunction = std::function<bool(std::string_view leaf_cert,
+                                            std::string_view issuer_cert,
+                                            uint64_t now)>;
+  using Task = std::function<void()>;
+  // Runs a task, possibly on another thread.
+  using Executor = std::function<void(Task task)>;
+  using Callback = std::function<void(bool verified)>;
+
+  // Without a VerifyFunction, only the overloads that are given the
+  // verification to run may be called.
+  SingleFlightVerifier();
+  explicit SingleFlightVerifier(VerifyFunction verify);
+  ~SingleFlightVerifier();
+
+  SingleFlightVerifier(const SingleFlightVerifier&) = delete;
+  SingleFlightVerifier& operator=(const SingleFlightVerifier&) = delete;
+
+  // Verifies the chain on the calling thread, or waits for the verification
+  // of the same chain that is already in flight.
+  bool Verify(std::string_view leaf_cert,
+              std::string_view issuer_cert,
+              uint64_t now);
+
+  // Same, but runs |verify| instead of the VerifyFunction when this call
+  // starts the verification of |chain|, the GetChainDigest() of the chain.
+  // Both overloads join the same flights.
+  bool Verify(const ChainDigest& chain, const std::function<bool()>& verify);
+
+  // Posts the verification of the chain to |executor| and runs |callback| with
+  // the verdict on the thread that computed it. If the same chain is already
+  // in flight, nothing is posted and |callback| joins the waiting ones. The
+  // certificates are copied, so they need not outlive the call; pending tasks
+  // keep the shared state alive, so the verifier itself need not either.
+  void VerifyAsync(std::string_view leaf_cert,
+                   std::string_view issuer_cert,
+                   uint64_t now,
+                   const Executor& executor,
+                   Callback callback);
+
+  // The number of requests that attached to a computation in flight instead
+  // of starting one.
+  uint64_t coalesced_count() const;
+
+ private:
+  struct State;
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace certificate_transparency
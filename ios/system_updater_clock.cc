@@ -0,0 +1,62 @@
+#include "system_updater_clock.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace certificate_transparency {
+
+SystemUpdaterClock::SystemUpdaterClock()
+    : thread_(&SystemUpdaterClock::Run, this) {}
+
+SystemUpdaterClock::~SystemUpdaterClock() {
+  {
+    std::lock_guard guard(lock_);
+    stopping_ = true;
+  }
+  changed_.notify_all();
+  thread_.join();
+}
+
+uint64_t SystemUpdaterClock::Now() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void SystemUpdaterClock::PostDelayed(uint64_t delay,
+                                     std::function<void()> task) {
+  // Delays of days are common, but anything beyond a year is a bug upstream
+  // and would overflow the steady clock.
+  const auto when = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(std::min<uint64_t>(
+                        delay, 365ull * 24 * 60 * 60 * 1000));
+  {
+    std::lock_guard guard(lock_);
+    tasks_.emplace(when, std::move(task));
+  }
+  changed_.notify_all();
+}
+
+void SystemUpdaterClock::Run() {
+  std::unique_lock guard(lock_);
+  while (!stopping_) {
+    if (tasks_.empty()) {
+      changed_.wait(guard);
+      continue;
+    }
+
+    auto next = tasks_.begin();
+    if (next->first > std::chrono::steady_clock::now()) {
+      changed_.wait_until(guard, next->first);
+      continue;
+    }
+
+    std::function<void()> task = std::move(next->second);
+    tasks_.erase(next);
+    guard.unlock();
+    task();
+    guard.lock();
+  }
+}
+
+}  // namespace certificate_transparency
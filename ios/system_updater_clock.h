@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "log_list_updater.h"
+
+namespace certificate_transparency {
+
+// An UpdaterClock that reads the system clock and runs delayed tasks on a
+// thread of its own. Tasks still pending on destruction are dropped.
+class SystemUpdaterClock : public UpdaterClock {
+ public:
+  SystemUpdaterClock();
+  ~SystemUpdaterClock() override;
+
+  uint64_t Now() override;
+  void PostDelayed(uint64_t delay, std::function<void()> task) override;
+
+ private:
+  void Run();
+
+  std::mutex lock_;
+  std::condition_variable changed_;
+  std::multimap<std::chrono::steady_clock::time_point, std::function<void()>>
+      tasks_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
+
+}  // namespace certificate_transparency
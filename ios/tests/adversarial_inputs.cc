@@ -0,0 +1,198 @@
+#include "adversarial_inputs.h"
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace certificate_transparency {
+namespace test {
+namespace {
+
+constexpr std::string_view kSequence = "\x30";
+constexpr std::string_view kSet = "\x31";
+constexpr std::string_view kInteger = "\x02";
+constexpr std::string_view kOID = "\x06";
+constexpr std::string_view kOctetString = "\x04";
+constexpr std::string_view kBitString = "\x03";
+constexpr std::string_view kUTF8String = "\x0c";
+constexpr std::string_view kUTCTime = "\x17";
+constexpr std::string_view kVersionTag = "\xa0";
+constexpr std::string_view kExtensionsTag = "\xa3";
+// [131071], constructed and primitive: the largest tag numbers the parser
+// takes, in four bytes.
+constexpr std::string_view kHighConstructedTag("\xbf\x87\xff\x7f", 4);
+constexpr std::string_view kHighPrimitiveTag("\x9f\x87\xff\x7f", 4);
+
+// 1.3.6.1.4.1.11129.2.4.2, the embedded SCT list extension.
+constexpr std::string_view kSCTListOID =
+    "\x2b\x06\x01\x04\x01\xd6\x79\x02\x04\x02";
+// Long enough for any length around it to take the long form.
+constexpr size_t kPadding = 128;
+
+size_t LengthSize(size_t length) {
+  size_t size = 1;
+  if (length >= 0x80) {
+    for (; length; length >>= 8) {
+      size++;
+    }
+  }
+  return size;
+}
+
+void AppendLength(std::string* out, size_t length) {
+  const size_t size = LengthSize(length);
+  if (size == 1) {
+    out->push_back(static_cast<char>(length));
+    return;
+  }
+  out->push_back(static_cast<char>(0x80 | (size - 1)));
+  for (size_t i = size - 1; i-- > 0;) {
+    out->push_back(static_cast<char>(length >> (8 * i)));
+  }
+}
+
+std::string Element(std::string_view tag, std::string_view contents) {
+  std::string out(tag);
+  AppendLength(&out, contents.size());
+  out.append(contents);
+  return out;
+}
+
+std::string Name() {
+  const std::string attribute =
+      Element(kSequence, Element(kOID, "\x55\x04\x03") +
+                             Element(kUTF8String, std::string(kPadding, 'n')));
+  return Element(kSequence, Element(kSet, attribute));
+}
+
+std::string SignatureAlgorithm() {
+  // ecdsa-with-SHA256
+  return Element(kSequence, Element(kOID, "\x2a\x86\x48\xce\x3d\x04\x03\x02"));
+}
+
+std::string SCTListExtension(const std::string& sct_list) {
+  return Element(kSequence,
+                 Element(kOID, kSCTListOID) +
+                     Element(kOctetString, Element(kOctetString, sct_list)));
+}
+
+std::string Certificate(const std::string& subject,
+                        const std::string& extensions) {
+  const std::string validity =
+      Element(kSequence, Element(kUTCTime, "250101000000Z") +
+                             Element(kUTCTime, "350101000000Z"));
+  const std::string spki =
+      Element(kSequence, SignatureAlgorithm() +
+                             Element(kBitString, std::string(kPadding, '\0')));
+  const std::string tbs = Element(
+      kSequence, Element(kVersionTag, Element(kInteger, "\x02")) +
+                     Element(kInteger, std::string(kPadding, '\x01')) +
+                     SignatureAlgorithm() + Name() + validity + subject +
+                     spki +
+                     Element(kExtensionsTag, Element(kSequence, extensions)));
+  return Element(kSequence, tbs + SignatureAlgorithm() +
+                                Element(kBitString, std::string(1, '\0')));
+}
+
+}  // namespace
+
+std::string CertificateWithExtensions(size_t count,
+                                      const std::string& sct_list) {
+  const std::string extension =
+      Element(kSequence, Element(kOID, "\x2a") + Element(kOctetString, ""));
+  std::string extensions;
+  extensions.reserve(count * extension.size());
+  for (size_t i = 0; i < count; i++) {
+    extensions += extension;
+  }
+  return Certificate(Name(), extensions + SCTListExtension(sct_list));
+}
+
+std::string CertificateWithNestedSubject(size_t depth,
+                                         const std::string& sct_list) {
+  // Lengths from the innermost element out, so that the headers can be
+  // written outside in without copying the contents at every level.
+  std::vector<size_t> lengths = {kPadding};
+  for (size_t i = 0; i < depth; i++) {
+    lengths.push_back(lengths.back() + kHighConstructedTag.size() +
+                      LengthSize(lengths.back()));
+  }
+  std::string subject(kSequence);
+  AppendLength(&subject, lengths.back());
+  for (size_t i = depth; i-- > 0;) {
+    subject.append(kHighConstructedTag);
+    AppendLength(&subject, lengths[i]);
+  }
+  subject.append(kPadding, 's');
+  return Certificate(subject, SCTListExtension(sct_list));
+}
+
+std::string SCTListWithItems(size_t count) {
+  std::string items;
+  for (size_t i = 0; i < count; i++) {
+    items.append("\x00\x01\x00", 3);
+  }
+  std::string list;
+  list.push_back(static_cast<char>(items.size() >> 8));
+  list.push_back(static_cast<char>(items.size()));
+  return list + items;
+}
+
+std::string SCTListWithSCTs(size_t count) {
+  // Version 1, a log ID, a timestamp, no extensions, SHA-256 with ECDSA and
+  // an empty signature.
+  std::string sct(1, '\0');
+  sct.append(32, '\x11');
+  sct.append(8, '\0');
+  sct.append("\x00\x00\x04\x03\x00\x00", 6);
+  std::string items;
+  for (size_t i = 0; i < count; i++) {
+    items.push_back(static_cast<char>(sct.size() >> 8));
+    items.push_back(static_cast<char>(sct.size()));
+    items += sct;
+  }
+  std::string list;
+  list.push_back(static_cast<char>(items.size() >> 8));
+  list.push_back(static_cast<char>(items.size()));
+  return list + items;
+}
+
+std::string ElementRun(size_t count) {
+  const std::string element =
+      Element(kHighPrimitiveTag, std::string(kPadding, 'e'));
+  std::string out;
+  out.reserve(count * element.size());
+  for (size_t i = 0; i < count; i++) {
+    out += element;
+  }
+  return out;
+}
+
+std::string IndefiniteLengthRun(size_t count) {
+  std::string out;
+  out.reserve(count * 2);
+  for (size_t i = 0; i < count; i++) {
+    out.append("\x30\x80", 2);
+  }
+  return out;
+}
+
+std::string PEMWithMarkers(size_t count) {
+  std::string out;
+  for (size_t i = 0; i < count; i++) {
+    out += "-----BEGIN CERTIFICATE-----\n";
+  }
+  return out + "-----END CERTIFICATE-----\n";
+}
+
+std::string PEMWithGiantBlock(size_t size) {
+  std::string out = "-----BEGIN CERTIFICATE-----\n";
+  for (size_t i = 0; i < size; i += 64) {
+    out.append(std::min<size_t>(64, size - i), 'A');
+    out += '\n';
+  }
+  return out + "-----END CERTIFICATE-----\n";
+}
+
+}  // namespace test
+}  // namespace certificate_transparency
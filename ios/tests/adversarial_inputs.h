@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace certificate_transparency {
+namespace test {
+
+// Worst-case inputs for the DER, TLS and PEM parsers, each growing with its
+// argument. They are well-formed as far as the parsers look, so that every
+// byte is walked, and every length that can be is in long form.
+
+// A certificate with |count| tiny extensions before the SCT list extension,
+// which holds |sct_list|.
+std::string CertificateWithExtensions(size_t count,
+                                      const std::string& sct_list);
+
+// A certificate whose subject is |depth| elements nested in one another,
+// with high tag numbers and long-form lengths.
+std::string CertificateWithNestedSubject(size_t depth,
+                                         const std::string& sct_list);
+
+// An SCT list of |count| items of one byte. At most 21845 fit.
+std::string SCTListWithItems(size_t count);
+
+// An SCT list of |count| minimal SCTs that decode. At most 1337 fit.
+std::string SCTListWithSCTs(size_t count);
+
+// |count| sibling elements with high tag numbers and long-form lengths.
+std::string ElementRun(size_t count);
+
+// |count| BER indefinite-length headers, one after another.
+std::string IndefiniteLengthRun(size_t count);
+
+// A PEM bundle of |count| BEGIN markers and a single END marker.
+std::string PEMWithMarkers(size_t count);
+
+// A PEM bundle holding one block of |size| bytes of base64.
+std::string PEMWithGiantBlock(size_t size);
+
+}  // namespace test
+}  // namespace certificate_transparency
@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <limits>
+
+#include "allocation_tracker.h"
+#include "builtin_logs.h"
+#include "crypto_bytebuilder.h"
+#include "crypto_mem.h"
+#include "metrics.h"
+#include "multi_log_verifier.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+// Budgets for verifying ValidTimestampsLeaf(), with some headroom over what
+// it takes today: 45 allocations of 19 KB in all. A change that blows one
+// should either be fixed or raise the budget on purpose.
+constexpr uint64_t kVerifyAllocations = 64;
+constexpr uint64_t kVerifyBytes = 24 * 1024;
+
+}  // namespace
+
+TEST(VerifyStaysWithinAllocationBudget) {
+  const ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  // Leaves out whatever the first verification sets up once.
+  EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                              kFarFuture));
+
+  test::AllocationTracker tracker;
+  EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                              kFarFuture));
+  EXPECT_TRUE(tracker.allocations() <= kVerifyAllocations);
+  EXPECT_TRUE(tracker.bytes() <= kVerifyBytes);
+  // Rebuilding the TBS certificate goes through the hooks.
+  EXPECT_TRUE(tracker.hooked_allocations() > 0);
+}
+
+TEST(AllocationHooksSeeBytebuilderBuffers) {
+  test::AllocationTracker tracker;
+  ct::CBB cbb;
+  EXPECT_TRUE(ct::CBB_init(&cbb, 4));
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(ct::CBB_add_u8(&cbb, static_cast<uint8_t>(i)));
+  }
+  uint8_t* data = nullptr;
+  size_t len = 0;
+  EXPECT_TRUE(ct::CBB_finish(&cbb, &data, &len));
+  EXPECT_EQ(len, 100u);
+  ct::CT_free(data);
+  // The initial buffer and at least one time it grew.
+  EXPECT_TRUE(tracker.hooked_allocations() >= 2);
+  EXPECT_EQ(tracker.hooked_allocations(), tracker.allocations());
+}
+
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+
+TEST(VerifyStagesStayWithinAllocationBudgets) {
+  const ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+
+  const ct::MetricsSnapshot before = ct::GetMetricsSnapshot();
+  test::AllocationTracker tracker;
+  verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+  const ct::MetricsSnapshot after = ct::GetMetricsSnapshot();
+
+  using Stage = ct::MetricsStage;
+  auto allocations = [&](Stage stage) {
+    return after.stage_allocations(stage).count -
+           before.stage_allocations(stage).count;
+  };
+  auto bytes = [&](Stage stage) {
+    return after.stage_allocations(stage).bytes -
+           before.stage_allocations(stage).bytes;
+  };
+  // Today: 1, 3, 19, 0, 18 and 4 allocations.
+  EXPECT_TRUE(allocations(Stage::kExtractSCTList) <= 2);
+  EXPECT_TRUE(allocations(Stage::kRebuildTBS) <= 6);
+  EXPECT_TRUE(allocations(Stage::kDecodeSCTs) <= 24);
+  EXPECT_EQ(allocations(Stage::kLookupLog), 0u);
+  EXPECT_TRUE(allocations(Stage::kCheckSignature) <= 24);
+  EXPECT_TRUE(allocations(Stage::kVerify) <= 8);
+  EXPECT_TRUE(bytes(Stage::kCheckSignature) <= 18 * 1024);
+
+  // Every allocation is counted against the innermost stage.
+  uint64_t total = 0;
+  for (size_t i = 0; i < ct::kMetricsStageCount; i++) {
+    total += after.allocations[i].count - before.allocations[i].count;
+  }
+  EXPECT_EQ(total, tracker.allocations());
+}
+
+#endif
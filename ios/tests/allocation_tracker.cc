@@ -0,0 +1,182 @@
+#include "allocation_tracker.h"
+
+#include <cstdlib>
+#include <new>
+
+#include "crypto_mem.h"
+#include "metrics.h"
+
+namespace certificate_transparency {
+namespace test {
+namespace {
+
+// Trivially initialized, so that they can be used from the first allocation
+// a thread makes.
+thread_local uint64_t g_allocations = 0;
+thread_local uint64_t g_bytes = 0;
+thread_local uint64_t g_hooked_allocations = 0;
+
+void Count(size_t size) {
+  g_allocations++;
+  g_bytes += size;
+}
+
+void* Allocate(size_t size) {
+  Count(size);
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+  RecordAllocation(size);
+#endif
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) {
+    abort();
+  }
+  return ptr;
+}
+
+void* AllocateAligned(size_t size, std::align_val_t alignment) {
+  Count(size);
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+  RecordAllocation(size);
+#endif
+  const size_t align = static_cast<size_t>(alignment);
+  void* ptr = aligned_alloc(align, (size + align - 1) / align * align);
+  if (!ptr) {
+    abort();
+  }
+  return ptr;
+}
+
+// CT_malloc() and CT_realloc() record their allocations themselves.
+void* HookedMalloc(size_t size) {
+  Count(size);
+  g_hooked_allocations++;
+  return malloc(size);
+}
+
+void* HookedRealloc(void* ptr, size_t size) {
+  Count(size);
+  g_hooked_allocations++;
+  return realloc(ptr, size);
+}
+
+const AllocationHooks kCountingHooks = {HookedMalloc, HookedRealloc, free};
+
+struct HooksInstaller {
+  HooksInstaller() { SetAllocationHooks(&kCountingHooks); }
+};
+
+const HooksInstaller g_hooks_installer;
+
+}  // namespace
+
+AllocationTracker::AllocationTracker()
+    : start_allocations_(g_allocations),
+      start_bytes_(g_bytes),
+      start_hooked_allocations_(g_hooked_allocations) {}
+
+AllocationTracker::~AllocationTracker() = default;
+
+uint64_t AllocationTracker::allocations() const {
+  return g_allocations - start_allocations_;
+}
+
+uint64_t AllocationTracker::bytes() const {
+  return g_bytes - start_bytes_;
+}
+
+uint64_t AllocationTracker::hooked_allocations() const {
+  return g_hooked_allocations - start_hooked_allocations_;
+}
+
+}  // namespace test
+}  // namespace certificate_transparency
+
+namespace test = certificate_transparency::test;
+
+void* operator new(size_t size) {
+  return test::Allocate(size);
+}
+
+void* operator new[](size_t size) {
+  return test::Allocate(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return test::Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return test::Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return test::AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return test::AllocateAligned(size, alignment);
+}
+
+void* operator new(size_t size,
+                   std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return test::AllocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size,
+                     std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return test::AllocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr,
+                     std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr,
+                       std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  free(ptr);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace certificate_transparency {
+namespace test {
+
+// Counts the allocations made on the calling thread while it is alive, both
+// through operator new, which the test binary replaces, and through the
+// library's AllocationHooks, which it installs.
+class AllocationTracker {
+ public:
+  AllocationTracker();
+  ~AllocationTracker();
+
+  AllocationTracker(const AllocationTracker&) = delete;
+  AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+  uint64_t allocations() const;
+  uint64_t bytes() const;
+  // Only the allocations that went through the library's hooks.
+  uint64_t hooked_allocations() const;
+
+ private:
+  const uint64_t start_allocations_;
+  const uint64_t start_bytes_;
+  const uint64_t start_hooked_allocations_;
+};
+
+}  // namespace test
+}  // namespace certificate_transparency
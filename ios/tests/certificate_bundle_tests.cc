@@ -0,0 +1,191 @@
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "certificate_bundle.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+std::string Base64(std::string_view bytes) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  for (size_t i = 0; i < bytes.size(); i += 3) {
+    uint32_t group = static_cast<uint8_t>(bytes[i]) << 16;
+    if (i + 1 < bytes.size()) {
+      group |= static_cast<uint8_t>(bytes[i + 1]) << 8;
+    }
+    if (i + 2 < bytes.size()) {
+      group |= static_cast<uint8_t>(bytes[i + 2]);
+    }
+    out += kAlphabet[(group >> 18) & 63];
+    out += kAlphabet[(group >> 12) & 63];
+    out += i + 1 < bytes.size() ? kAlphabet[(group >> 6) & 63] : '=';
+    out += i + 2 < bytes.size() ? kAlphabet[group & 63] : '=';
+  }
+  return out;
+}
+
+// |der| as a PEM block, in lines of 64 characters.
+std::string PEM(std::string_view der) {
+  const std::string body = Base64(der);
+  std::string out = "-----BEGIN CERTIFICATE-----\n";
+  for (size_t i = 0; i < body.size(); i += 64) {
+    out += body.substr(i, 64) + "\n";
+  }
+  return out + "-----END CERTIFICATE-----\n";
+}
+
+// Two chains, the first with its root, the second a leaf alone.
+std::string TwoChainsPEM() {
+  return "Subject: leaf\n" + PEM(test::ValidTimestampsLeaf()) +
+         PEM(test::SubRootCA()) + PEM(test::RootCA()) + "\n" +
+         PEM(test::NoTimestampsLeaf()) + PEM(test::SubRootCA());
+}
+
+bool SameChains(const std::vector<ct::BundleChain>& a,
+                const std::vector<ct::BundleChain>& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].leaf != b[i].leaf || a[i].issuer != b[i].issuer) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// A file with the given contents, removed with the object.
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(std::string_view contents) {
+    char path[] = "/tmp/certificate_bundle_XXXXXX";
+    const int fd = mkstemp(path);
+    write(fd, contents.data(), contents.size());
+    close(fd);
+    path_ = path;
+  }
+  ~TemporaryFile() { unlink(path_.c_str()); }
+
+  const std::string& get() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+}  // namespace
+
+TEST(BundleScansPEMChains) {
+  const std::string bundle = TwoChainsPEM();
+  ct::CertificateArena arena;
+  std::vector<ct::BundleChain> chains;
+  EXPECT_EQ(ct::ScanBundle(bundle, 0, bundle.size(), &arena, &chains), 0u);
+  EXPECT_EQ(chains.size(), 2u);
+  EXPECT_TRUE(chains[0].leaf == test::ValidTimestampsLeaf());
+  EXPECT_TRUE(chains[0].issuer == test::SubRootCA());
+  EXPECT_TRUE(chains[1].leaf == test::NoTimestampsLeaf());
+  EXPECT_TRUE(chains[1].issuer == test::SubRootCA());
+}
+
+TEST(BundleRangesFindTheSameChains) {
+  const std::string bundle = TwoChainsPEM();
+  ct::CertificateArena whole_arena;
+  std::vector<ct::BundleChain> whole;
+  ct::ScanBundle(bundle, 0, bundle.size(), &whole_arena, &whole);
+
+  // Every split point, including ones inside blocks and markers.
+  bool all_same = true;
+  for (size_t split = 1; split < bundle.size(); split++) {
+    ct::CertificateArena arena;
+    std::vector<ct::BundleChain> chains;
+    ct::ScanBundle(bundle, 0, split, &arena, &chains);
+    ct::ScanBundle(bundle, split, bundle.size(), &arena, &chains);
+    all_same = all_same && SameChains(chains, whole);
+  }
+  EXPECT_TRUE(all_same);
+
+  ct::CertificateArena arena;
+  std::vector<ct::BundleChain> chains;
+  const auto ranges = ct::SplitBundle(bundle, 1000);
+  EXPECT_EQ(ranges.size(), (bundle.size() + 999) / 1000);
+  for (const auto& range : ranges) {
+    ct::ScanBundle(bundle, range.first, range.second, &arena, &chains);
+  }
+  EXPECT_TRUE(SameChains(chains, whole));
+}
+
+TEST(BundleViewsDERInPlace) {
+  const std::string bundle = std::string(test::ValidTimestampsLeaf()) +
+                             std::string(test::SubRootCA()) +
+                             std::string(test::NoTimestampsLeaf());
+  EXPECT_EQ(ct::SplitBundle(bundle, 100).size(), 1u);
+  ct::CertificateArena arena;
+  std::vector<ct::BundleChain> chains;
+  EXPECT_EQ(ct::ScanBundle(bundle, 0, bundle.size(), &arena, &chains), 0u);
+  EXPECT_EQ(arena.capacity(), 0u);
+  EXPECT_EQ(chains.size(), 2u);
+  EXPECT_TRUE(chains[0].leaf.data() == bundle.data());
+  EXPECT_TRUE(chains[0].issuer == test::SubRootCA());
+  EXPECT_TRUE(chains[1].leaf == test::NoTimestampsLeaf());
+  EXPECT_TRUE(chains[1].issuer.empty());
+
+  // Trailing bytes that are not a certificate.
+  chains.clear();
+  const std::string truncated = bundle + "\x30\x82\x01";
+  EXPECT_EQ(ct::ScanBundle(truncated, 0, truncated.size(), &arena, &chains),
+            1u);
+  EXPECT_EQ(chains.size(), 2u);
+}
+
+TEST(BundleCountsMalformedBlocks) {
+  const std::string bundle =
+      PEM(test::ValidTimestampsLeaf()) +
+      "-----BEGIN CERTIFICATE-----\nnot*base64\n-----END CERTIFICATE-----\n" +
+      PEM("not a certificate") + PEM(test::SubRootCA()) +
+      "-----BEGIN CERTIFICATE-----\nAAAA\n";
+  ct::CertificateArena arena;
+  std::vector<ct::BundleChain> chains;
+  EXPECT_EQ(ct::ScanBundle(bundle, 0, bundle.size(), &arena, &chains), 3u);
+  // A malformed block ends the chain of the leaf before it.
+  EXPECT_EQ(chains.size(), 2u);
+  EXPECT_TRUE(chains[0].leaf == test::ValidTimestampsLeaf());
+  EXPECT_TRUE(chains[0].issuer.empty());
+  EXPECT_TRUE(chains[1].leaf == test::SubRootCA());
+}
+
+TEST(BundleArenaReusesBlocks) {
+  ct::CertificateArena arena;
+  uint8_t* first = arena.Allocate(100);
+  arena.Allocate(1 << 20);
+  const size_t capacity = arena.capacity();
+  EXPECT_TRUE(capacity >= (1u << 20) + 100);
+  arena.Reset();
+  EXPECT_TRUE(arena.Allocate(100) == first);
+  arena.Allocate(1 << 20);
+  EXPECT_EQ(arena.capacity(), capacity);
+}
+
+TEST(BundleMapsFiles) {
+  const std::string bundle = TwoChainsPEM();
+  TemporaryFile file(bundle);
+  auto mapped = ct::MappedFile::Open(file.get());
+  EXPECT_TRUE(mapped != nullptr);
+  EXPECT_TRUE(mapped->contents() == bundle);
+
+  TemporaryFile empty("");
+  mapped = ct::MappedFile::Open(empty.get());
+  EXPECT_TRUE(mapped != nullptr);
+  EXPECT_TRUE(mapped->contents().empty());
+
+  EXPECT_TRUE(ct::MappedFile::Open("/nonexistent/bundle.pem") == nullptr);
+  EXPECT_TRUE(ct::MappedFile::Open("/tmp") == nullptr);
+}
@@ -0,0 +1,869 @@
+#include "chain_generator.h"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+#include "crypto_bignum.h"
+#include "crypto_bytebuilder.h"
+#include "crypto_bytestring.h"
+#include "crypto_sha256.h"
+
+namespace certificate_transparency {
+namespace test {
+namespace {
+
+// Little-endian 64-bit limbs, as in crypto_bignum.h, of any length.
+using Limbs = std::vector<uint64_t>;
+
+constexpr uint64_t kRSAExponent = 65537;
+constexpr size_t kRSAPrimeLimbs = 16;
+
+// Writing to a growable CBB only fails when out of memory, which a test
+// generator doesn't try to survive.
+void Require(int ok) {
+  if (!ok) {
+    abort();
+  }
+}
+
+std::string ToString(CBB* cbb) {
+  Require(CBB_flush(cbb));
+  return std::string(reinterpret_cast<const char*>(CBB_data(cbb)),
+                     CBB_len(cbb));
+}
+
+void AddBytes(CBB* out, std::string_view bytes) {
+  Require(CBB_add_bytes(out, reinterpret_cast<const uint8_t*>(bytes.data()),
+                        bytes.size()));
+}
+
+// Deterministic bytes: SHA-256 of the seed, a label, an index and a counter.
+class ByteStream {
+ public:
+  ByteStream(uint64_t seed, std::string_view label, uint64_t index) {
+    ScopedCBB cbb;
+    Require(CBB_init(cbb.get(), 64));
+    Require(CBB_add_u64(cbb.get(), seed));
+    AddBytes(cbb.get(), label);
+    Require(CBB_add_u64(cbb.get(), index));
+    prefix_ = ToString(cbb.get());
+  }
+
+  void Generate(uint8_t* out, size_t len) {
+    while (len != 0) {
+      std::string block = prefix_;
+      for (int i = 7; i >= 0; i--) {
+        block.push_back(static_cast<char>(counter_ >> (8 * i)));
+      }
+      counter_++;
+      uint8_t digest[kSHA256DigestLength];
+      SHA256(block.data(), block.size(), digest);
+      const size_t n = len < sizeof(digest) ? len : sizeof(digest);
+      for (size_t i = 0; i < n; i++) {
+        out[i] = digest[i];
+      }
+      out += n;
+      len -= n;
+    }
+  }
+
+  Limbs GenerateLimbs(size_t num) {
+    std::vector<uint8_t> bytes(num * 8);
+    Generate(bytes.data(), bytes.size());
+    Limbs r(num);
+    bn_from_bytes_be(r.data(), num, bytes.data(), bytes.size());
+    return r;
+  }
+
+ private:
+  std::string prefix_;
+  uint64_t counter_ = 0;
+};
+
+Limbs FromBytes(const uint8_t* in, size_t len, size_t num) {
+  Limbs r(num);
+  bn_from_bytes_be(r.data(), num, in, len);
+  return r;
+}
+
+std::string ToBytes(const Limbs& a, size_t len) {
+  std::string out(len, '\0');
+  for (size_t i = 0; i < len && i / 8 < a.size(); i++) {
+    out[len - 1 - i] = static_cast<char>(a[i / 8] >> (8 * (i % 8)));
+  }
+  return out;
+}
+
+bool IsZero(const Limbs& a) {
+  for (uint64_t limb : a) {
+    if (limb != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compares |a| and |b| of the same length.
+bool IsLess(const Limbs& a, const Limbs& b) {
+  for (size_t i = a.size(); i-- > 0;) {
+    if (a[i] != b[i]) {
+      return a[i] < b[i];
+    }
+  }
+  return false;
+}
+
+bool TestBit(const Limbs& a, size_t bit) {
+  return (a[bit / 64] >> (bit % 64)) & 1;
+}
+
+Limbs Multiply(const Limbs& a, const Limbs& b) {
+  Limbs r(a.size() + b.size(), 0);
+  for (size_t i = 0; i < a.size(); i++) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < b.size(); j++) {
+      r[i + j] = bn_mul_add(a[i], b[j], r[i + j], carry, &carry);
+    }
+    r[i + b.size()] = carry;
+  }
+  return r;
+}
+
+// Sets |a| to |a| * |k| + |c|, which must fit.
+void MultiplyAdd(Limbs* a, uint64_t k, uint64_t c) {
+  for (uint64_t& limb : *a) {
+    limb = bn_mul_add(limb, k, c, 0, &c);
+  }
+}
+
+// Divides |a| by |m| < 2^32 and returns the remainder.
+uint64_t DivideSmall(Limbs* a, uint64_t m) {
+  uint64_t r = 0;
+  for (size_t i = a->size(); i-- > 0;) {
+    const uint64_t hi = (r << 32) | ((*a)[i] >> 32);
+    r = hi % m;
+    const uint64_t lo = (r << 32) | ((*a)[i] & 0xffffffff);
+    r = lo % m;
+    (*a)[i] = ((hi / m) << 32) | (lo / m);
+  }
+  return r;
+}
+
+uint64_t ModSmall(Limbs a, uint64_t m) {
+  return DivideSmall(&a, m);
+}
+
+// Arithmetic modulo an odd |m|, with values in the Montgomery domain.
+class Montgomery {
+ public:
+  explicit Montgomery(Limbs m)
+      : m_(std::move(m)), n0_(bn_neg_inverse_u64(m_[0])), rr_(size(), 0) {
+    // R^2 mod m, by doubling 1 for the 2 * 64 * size() bits of R^2.
+    rr_[0] = 1;
+    for (size_t i = 0; i < 128 * size(); i++) {
+      rr_ = Add(rr_, rr_);
+    }
+  }
+
+  size_t size() const { return m_.size(); }
+  const Limbs& modulus() const { return m_; }
+
+  // Returns |a| * |b| / R mod m, for |a| < R and |b| < m.
+  Limbs Mul(const Limbs& a, const Limbs& b) const {
+    const size_t k = size();
+    Limbs t(k + 2, 0);
+    for (size_t i = 0; i < k; i++) {
+      uint64_t carry = 0;
+      for (size_t j = 0; j < k; j++) {
+        t[j] = bn_mul_add(a[i], b[j], t[j], carry, &carry);
+      }
+      t[k] += carry;
+      t[k + 1] = t[k] < carry;
+
+      const uint64_t u = t[0] * n0_;
+      bn_mul_add(u, m_[0], t[0], 0, &carry);
+      for (size_t j = 1; j < k; j++) {
+        t[j - 1] = bn_mul_add(u, m_[j], t[j], carry, &carry);
+      }
+      t[k - 1] = t[k] + carry;
+      t[k] = t[k + 1] + (t[k - 1] < carry);
+    }
+    Limbs r(t.begin(), t.begin() + k);
+    if (t[k] != 0 || !IsLess(r, m_)) {
+      bn_sub_words(r.data(), r.data(), m_.data(), k);
+    }
+    return r;
+  }
+
+  Limbs ToMont(const Limbs& a) const { return Mul(a, rr_); }
+  Limbs FromMont(const Limbs& a) const { return Mul(a, Unit()); }
+  Limbs One() const { return ToMont(Unit()); }
+
+  Limbs Add(const Limbs& a, const Limbs& b) const {
+    Limbs r(size());
+    uint64_t carry = 0;
+    for (size_t i = 0; i < size(); i++) {
+      const uint64_t sum = a[i] + carry;
+      carry = sum < carry;
+      r[i] = sum + b[i];
+      carry += r[i] < sum;
+    }
+    if (carry != 0 || !IsLess(r, m_)) {
+      bn_sub_words(r.data(), r.data(), m_.data(), size());
+    }
+    return r;
+  }
+
+  Limbs Sub(const Limbs& a, const Limbs& b) const {
+    Limbs r(size());
+    if (bn_sub_words(r.data(), a.data(), b.data(), size())) {
+      // Adding m wraps around to the difference.
+      uint64_t carry = 0;
+      for (size_t i = 0; i < size(); i++) {
+        const uint64_t sum = r[i] + carry;
+        carry = sum < carry;
+        r[i] = sum + m_[i];
+        carry += r[i] < sum;
+      }
+    }
+    return r;
+  }
+
+  // Returns |base|^|exponent|, with |base| and the result in the Montgomery
+  // domain.
+  Limbs Exp(const Limbs& base, const Limbs& exponent) const {
+    Limbs r = One();
+    for (size_t bit = exponent.size() * 64; bit-- > 0;) {
+      r = Mul(r, r);
+      if (TestBit(exponent, bit)) {
+        r = Mul(r, base);
+      }
+    }
+    return r;
+  }
+
+ private:
+  Limbs Unit() const {
+    Limbs one(size(), 0);
+    one[0] = 1;
+    return one;
+  }
+
+  const Limbs m_;
+  const uint64_t n0_;
+  Limbs rr_;
+};
+
+// Subtracts 2 from an odd prime, for inversion by Fermat's little theorem.
+Limbs MinusTwo(Limbs m) {
+  Limbs two(m.size(), 0);
+  two[0] = 2;
+  bn_sub_words(m.data(), m.data(), two.data(), m.size());
+  return m;
+}
+
+// P-256 in Jacobian coordinates over the Montgomery domain. The point at
+// infinity has z == 0.
+struct Point {
+  Limbs x;
+  Limbs y;
+  Limbs z;
+};
+
+class P256 {
+ public:
+  P256()
+      : field_({0xffffffffffffffff, 0x00000000ffffffff, 0x0000000000000000,
+                0xffffffff00000001}),
+        order_({0xf3b9cac2fc632551, 0xbce6faada7179e84, 0xffffffffffffffff,
+                0xffffffff00000000}) {
+    generator_.x = field_.ToMont({0xf4a13945d898c296, 0x77037d812deb33a0,
+                                  0xf8bce6e563a440f2, 0x6b17d1f2e12c4247});
+    generator_.y = field_.ToMont({0xcbb6406837bf51f5, 0x2bce33576b315ece,
+                                  0x8ee7eb4a7c0f9e16, 0x4fe342e2fe1a7f9b});
+    generator_.z = field_.One();
+  }
+
+  const Montgomery& order() const { return order_; }
+
+  // Sets |x| and |y| to the affine coordinates of |scalar| * G.
+  void MultiplyGenerator(const Limbs& scalar, Limbs* x, Limbs* y) const {
+    Point r = {Limbs(4, 0), Limbs(4, 0), Limbs(4, 0)};
+    for (size_t bit = 256; bit-- > 0;) {
+      r = Double(r);
+      if (TestBit(scalar, bit)) {
+        r = Add(r, generator_);
+      }
+    }
+    const Limbs z_inverse = field_.Exp(r.z, MinusTwo(field_.modulus()));
+    const Limbs z_inverse2 = field_.Mul(z_inverse, z_inverse);
+    *x = field_.FromMont(field_.Mul(r.x, z_inverse2));
+    *y = field_.FromMont(field_.Mul(r.y, field_.Mul(z_inverse2, z_inverse)));
+  }
+
+ private:
+  // dbl-2001-b from the Explicit-Formulas Database, for a = -3.
+  Point Double(const Point& a) const {
+    if (IsZero(a.z)) {
+      return a;
+    }
+    const Montgomery& f = field_;
+    const Limbs delta = f.Mul(a.z, a.z);
+    const Limbs gamma = f.Mul(a.y, a.y);
+    const Limbs beta = f.Mul(a.x, gamma);
+    const Limbs t = f.Mul(f.Sub(a.x, delta), f.Add(a.x, delta));
+    const Limbs alpha = f.Add(f.Add(t, t), t);
+    const Limbs beta4 = f.Add(f.Add(beta, beta), f.Add(beta, beta));
+    Point r;
+    r.x = f.Sub(f.Mul(alpha, alpha), f.Add(beta4, beta4));
+    const Limbs y_plus_z = f.Add(a.y, a.z);
+    r.z = f.Sub(f.Sub(f.Mul(y_plus_z, y_plus_z), gamma), delta);
+    const Limbs gamma2 = f.Mul(gamma, gamma);
+    const Limbs gamma2_4 = f.Add(f.Add(gamma2, gamma2), f.Add(gamma2, gamma2));
+    r.y = f.Sub(f.Mul(alpha, f.Sub(beta4, r.x)), f.Add(gamma2_4, gamma2_4));
+    return r;
+  }
+
+  // add-2007-bl from the Explicit-Formulas Database.
+  Point Add(const Point& a, const Point& b) const {
+    if (IsZero(a.z)) {
+      return b;
+    }
+    if (IsZero(b.z)) {
+      return a;
+    }
+    const Montgomery& f = field_;
+    const Limbs z1z1 = f.Mul(a.z, a.z);
+    const Limbs z2z2 = f.Mul(b.z, b.z);
+    const Limbs u1 = f.Mul(a.x, z2z2);
+    const Limbs u2 = f.Mul(b.x, z1z1);
+    const Limbs s1 = f.Mul(a.y, f.Mul(b.z, z2z2));
+    const Limbs s2 = f.Mul(b.y, f.Mul(a.z, z1z1));
+    const Limbs h = f.Sub(u2, u1);
+    const Limbs s_diff = f.Sub(s2, s1);
+    if (IsZero(h)) {
+      if (IsZero(s_diff)) {
+        return Double(a);
+      }
+      return {Limbs(4, 0), Limbs(4, 0), Limbs(4, 0)};
+    }
+    const Limbs h2 = f.Add(h, h);
+    const Limbs i = f.Mul(h2, h2);
+    const Limbs j = f.Mul(h, i);
+    const Limbs r = f.Add(s_diff, s_diff);
+    const Limbs v = f.Mul(u1, i);
+    Point out;
+    out.x = f.Sub(f.Sub(f.Mul(r, r), j), f.Add(v, v));
+    const Limbs s1j = f.Mul(s1, j);
+    out.y = f.Sub(f.Mul(r, f.Sub(v, out.x)), f.Add(s1j, s1j));
+    const Limbs z_sum = f.Add(a.z, b.z);
+    out.z = f.Mul(f.Sub(f.Sub(f.Mul(z_sum, z_sum), z1z1), z2z2), h);
+    return out;
+  }
+
+  Montgomery field_;
+  Montgomery order_;
+  Point generator_;
+};
+
+const P256& Curve() {
+  static auto* curve = new P256();
+  return *curve;
+}
+
+// Returns a scalar in [1, n).
+Limbs GenerateScalar(ByteStream* stream) {
+  const Limbs& n = Curve().order().modulus();
+  while (true) {
+    Limbs scalar = stream->GenerateLimbs(4);
+    if (!IsZero(scalar) && IsLess(scalar, n)) {
+      return scalar;
+    }
+  }
+}
+
+void AddInteger(CBB* out, std::string_view big_endian) {
+  while (big_endian.size() > 1 && big_endian[0] == 0) {
+    big_endian.remove_prefix(1);
+  }
+  CBB integer;
+  Require(CBB_add_asn1(out, &integer, CBS_ASN1_INTEGER));
+  if (static_cast<uint8_t>(big_endian[0]) & 0x80) {
+    Require(CBB_add_u8(&integer, 0));
+  }
+  AddBytes(&integer, big_endian);
+  Require(CBB_flush(out));
+}
+
+void AddOid(CBB* out, const char* oid) {
+  CBB child;
+  Require(CBB_add_asn1(out, &child, CBS_ASN1_OBJECT));
+  Require(CBB_add_asn1_oid_from_text(&child, oid, strlen(oid)));
+  Require(CBB_flush(out));
+}
+
+void AddBitString(CBB* out, std::string_view bytes) {
+  CBB bits;
+  Require(CBB_add_asn1(out, &bits, CBS_ASN1_BITSTRING));
+  Require(CBB_add_u8(&bits, 0));
+  AddBytes(&bits, bytes);
+  Require(CBB_flush(out));
+}
+
+std::string ECDSASignature(const Limbs& r, const Limbs& s) {
+  ScopedCBB cbb;
+  CBB signature;
+  Require(CBB_init(cbb.get(), 72));
+  Require(CBB_add_asn1(cbb.get(), &signature, CBS_ASN1_SEQUENCE));
+  AddInteger(&signature, ToBytes(r, 32));
+  AddInteger(&signature, ToBytes(s, 32));
+  return ToString(cbb.get());
+}
+
+std::string SubjectPublicKeyInfo(const char* algorithm,
+                                 const char* parameters,
+                                 std::string_view key) {
+  ScopedCBB cbb;
+  CBB spki, algorithm_identifier, null;
+  Require(CBB_init(cbb.get(), key.size() + 32));
+  Require(CBB_add_asn1(cbb.get(), &spki, CBS_ASN1_SEQUENCE));
+  Require(CBB_add_asn1(&spki, &algorithm_identifier, CBS_ASN1_SEQUENCE));
+  AddOid(&algorithm_identifier, algorithm);
+  if (parameters) {
+    AddOid(&algorithm_identifier, parameters);
+  } else {
+    Require(CBB_add_asn1(&algorithm_identifier, &null, CBS_ASN1_NULL));
+  }
+  Require(CBB_flush(&spki));
+  AddBitString(&spki, key);
+  return ToString(cbb.get());
+}
+
+// Miller-Rabin with the first primes as bases, which is plenty for random
+// candidates.
+bool IsProbablePrime(const Limbs& p) {
+  const Montgomery mont(p);
+  Limbs exponent = p;
+  exponent[0] -= 1;
+  size_t shift = 0;
+  while (!TestBit(exponent, shift)) {
+    shift++;
+  }
+  Limbs odd_part(p.size(), 0);
+  for (size_t bit = shift; bit < p.size() * 64; bit++) {
+    if (TestBit(exponent, bit)) {
+      odd_part[(bit - shift) / 64] |= uint64_t{1} << ((bit - shift) % 64);
+    }
+  }
+
+  const Limbs one = mont.One();
+  const Limbs minus_one = mont.Sub(Limbs(p.size(), 0), one);
+  for (uint64_t base : {2, 3, 5, 7, 11, 13, 17, 19}) {
+    Limbs base_limbs(p.size(), 0);
+    base_limbs[0] = base;
+    Limbs x = mont.Exp(mont.ToMont(base_limbs), odd_part);
+    if (x == one || x == minus_one) {
+      continue;
+    }
+    bool witness = true;
+    for (size_t i = 1; i < shift && witness; i++) {
+      x = mont.Mul(x, x);
+      witness = x != minus_one;
+    }
+    if (witness) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const std::vector<uint64_t>& SmallPrimes() {
+  static auto* primes = [] {
+    auto* primes = new std::vector<uint64_t>();
+    std::vector<bool> composite(2048, false);
+    for (uint64_t i = 3; i < composite.size(); i += 2) {
+      if (!composite[i]) {
+        primes->push_back(i);
+        for (uint64_t j = i * i; j < composite.size(); j += 2 * i) {
+          composite[j] = true;
+        }
+      }
+    }
+    return primes;
+  }();
+  return *primes;
+}
+
+// Returns a 1024-bit prime p with the top two bits set, so that the product
+// of two has 2048 bits, and with p - 1 coprime to the public exponent.
+Limbs GeneratePrime(ByteStream* stream) {
+  while (true) {
+    Limbs p = stream->GenerateLimbs(kRSAPrimeLimbs);
+    p.back() |= uint64_t{3} << 62;
+    p[0] |= 1;
+    bool composite = ModSmall(p, kRSAExponent) == 1;
+    for (uint64_t prime : SmallPrimes()) {
+      if (composite) {
+        break;
+      }
+      composite = ModSmall(p, prime) == 0;
+    }
+    if (!composite && IsProbablePrime(p)) {
+      return p;
+    }
+  }
+}
+
+uint64_t PowSmall(uint64_t base, uint64_t exponent, uint64_t m) {
+  uint64_t r = 1;
+  base %= m;
+  while (exponent != 0) {
+    if (exponent & 1) {
+      r = r * base % m;
+    }
+    base = base * base % m;
+    exponent >>= 1;
+  }
+  return r;
+}
+
+}  // namespace
+
+struct ChainGenerator::Key {
+  bool rsa = false;
+  // The EC private scalar, or the RSA private exponent.
+  Limbs secret;
+  // The RSA modulus.
+  std::unique_ptr<Montgomery> modulus;
+  std::string spki;
+  std::string key_id;
+
+  static std::unique_ptr<Key> GenerateEC(ByteStream* stream) {
+    auto key = std::make_unique<Key>();
+    key->secret = GenerateScalar(stream);
+    Limbs x, y;
+    Curve().MultiplyGenerator(key->secret, &x, &y);
+    key->spki = SubjectPublicKeyInfo("1.2.840.10045.2.1", "1.2.840.10045.3.1.7",
+                                     "\x04" + ToBytes(x, 32) + ToBytes(y, 32));
+    key->SetKeyId();
+    return key;
+  }
+
+  static std::unique_ptr<Key> GenerateRSA(ByteStream* stream) {
+    Limbs p = GeneratePrime(stream);
+    Limbs q = GeneratePrime(stream);
+    const Limbs n = Multiply(p, q);
+    p[0] -= 1;
+    q[0] -= 1;
+    // d = (1 + k * phi) / e for the k that makes it divide, which is
+    // -phi^-1 mod e.
+    Limbs d = Multiply(p, q);
+    const uint64_t phi_mod_e = ModSmall(d, kRSAExponent);
+    const uint64_t k =
+        (kRSAExponent - PowSmall(phi_mod_e, kRSAExponent - 2, kRSAExponent)) %
+        kRSAExponent;
+    d.push_back(0);
+    MultiplyAdd(&d, k, 1);
+    DivideSmall(&d, kRSAExponent);
+    d.pop_back();
+
+    auto key = std::make_unique<Key>();
+    key->rsa = true;
+    key->secret = std::move(d);
+    key->modulus = std::make_unique<Montgomery>(n);
+    ScopedCBB cbb;
+    CBB rsa_key;
+    Require(CBB_init(cbb.get(), 300));
+    Require(CBB_add_asn1(cbb.get(), &rsa_key, CBS_ASN1_SEQUENCE));
+    AddInteger(&rsa_key, ToBytes(n, n.size() * 8));
+    Require(CBB_add_asn1_uint64(&rsa_key, kRSAExponent));
+    key->spki = SubjectPublicKeyInfo("1.2.840.113549.1.1.1", nullptr,
+                                     ToString(cbb.get()));
+    key->SetKeyId();
+    return key;
+  }
+
+  void SetKeyId() {
+    uint8_t digest[kSHA256DigestLength];
+    SHA256(spki.data(), spki.size(), digest);
+    key_id.assign(reinterpret_cast<const char*>(digest), sizeof(digest));
+  }
+
+  // Signs the SHA-256 digest of |data|, taking ECDSA nonces from |stream|.
+  std::string Sign(std::string_view data, ByteStream* stream) const {
+    uint8_t digest[kSHA256DigestLength];
+    SHA256(data.data(), data.size(), digest);
+    return rsa ? SignRSA(digest) : SignEC(digest, stream);
+  }
+
+  std::string SignEC(const uint8_t digest[32], ByteStream* stream) const {
+    const Montgomery& order = Curve().order();
+    Limbs z = FromBytes(digest, 32, 4);
+    if (!IsLess(z, order.modulus())) {
+      bn_sub_words(z.data(), z.data(), order.modulus().data(), 4);
+    }
+    while (true) {
+      const Limbs k = GenerateScalar(stream);
+      Limbs r, unused;
+      Curve().MultiplyGenerator(k, &r, &unused);
+      if (!IsLess(r, order.modulus())) {
+        bn_sub_words(r.data(), r.data(), order.modulus().data(), 4);
+      }
+      if (IsZero(r)) {
+        continue;
+      }
+      const Limbs k_inverse =
+          order.Exp(order.ToMont(k), MinusTwo(order.modulus()));
+      const Limbs s = order.FromMont(order.Mul(
+          k_inverse, order.Add(order.ToMont(z),
+                               order.Mul(order.ToMont(r),
+                                         order.ToMont(secret)))));
+      if (!IsZero(s)) {
+        return ECDSASignature(r, s);
+      }
+    }
+  }
+
+  // RSASSA-PKCS1-v1_5 with SHA-256.
+  std::string SignRSA(const uint8_t digest[32]) const {
+    static const uint8_t kDigestInfo[] = {
+        0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+        0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20,
+    };
+    const size_t size = modulus->size() * 8;
+    std::vector<uint8_t> encoded(size, 0xff);
+    encoded[0] = 0;
+    encoded[1] = 1;
+    const size_t suffix = sizeof(kDigestInfo) + 32;
+    encoded[size - suffix - 1] = 0;
+    for (size_t i = 0; i < sizeof(kDigestInfo); i++) {
+      encoded[size - suffix + i] = kDigestInfo[i];
+    }
+    for (size_t i = 0; i < 32; i++) {
+      encoded[size - 32 + i] = digest[i];
+    }
+    const Limbs m = FromBytes(encoded.data(), size, modulus->size());
+    return ToBytes(
+        modulus->FromMont(modulus->Exp(modulus->ToMont(m), secret)), size);
+  }
+};
+
+struct ChainGenerator::Issuer {
+  std::unique_ptr<Key> key;
+  std::string name;
+  std::string cert;
+};
+
+namespace {
+
+struct Extension {
+  const char* oid;
+  bool critical;
+  // The DER inside the extension's OCTET STRING.
+  std::string value;
+};
+
+void AddName(CBB* out, const std::string& common_name) {
+  CBB name, rdn, attribute, value;
+  Require(CBB_add_asn1(out, &name, CBS_ASN1_SEQUENCE));
+  Require(CBB_add_asn1(&name, &rdn, CBS_ASN1_SET));
+  Require(CBB_add_asn1(&rdn, &attribute, CBS_ASN1_SEQUENCE));
+  AddOid(&attribute, "2.5.4.3");
+  Require(CBB_add_asn1(&attribute, &value, CBS_ASN1_UTF8STRING));
+  AddBytes(&value, common_name);
+  Require(CBB_flush(out));
+}
+
+void AddSignatureAlgorithm(CBB* out) {
+  CBB algorithm;
+  Require(CBB_add_asn1(out, &algorithm, CBS_ASN1_SEQUENCE));
+  // ecdsa-with-SHA256; every issuer has a P-256 key.
+  AddOid(&algorithm, "1.2.840.10045.4.3.2");
+  Require(CBB_flush(out));
+}
+
+std::string BuildTBSCertificate(std::string_view serial,
+                                const std::string& issuer,
+                                const std::string& subject,
+                                std::string_view spki,
+                                const std::vector<Extension>& extensions) {
+  ScopedCBB cbb;
+  CBB tbs, version, validity, time, extensions_wrap, extension_list;
+  Require(CBB_init(cbb.get(), 512));
+  Require(CBB_add_asn1(cbb.get(), &tbs, CBS_ASN1_SEQUENCE));
+  Require(CBB_add_asn1(
+      &tbs, &version, CBS_ASN1_CONTEXT_SPECIFIC | CBS_ASN1_CONSTRUCTED | 0));
+  Require(CBB_add_asn1_uint64(&version, 2));
+  AddInteger(&tbs, serial);
+  AddSignatureAlgorithm(&tbs);
+  AddName(&tbs, issuer);
+  Require(CBB_add_asn1(&tbs, &validity, CBS_ASN1_SEQUENCE));
+  for (const char* date : {"230101000000Z", "330101000000Z"}) {
+    Require(CBB_add_asn1(&validity, &time, CBS_ASN1_UTCTIME));
+    AddBytes(&time, date);
+    Require(CBB_flush(&validity));
+  }
+  AddName(&tbs, subject);
+  AddBytes(&tbs, spki);
+  // Always present, so that removing the SCT list from a leaf whose only
+  // extension it is gives the same encoding.
+  Require(CBB_add_asn1(
+      &tbs, &extensions_wrap,
+      CBS_ASN1_CONTEXT_SPECIFIC | CBS_ASN1_CONSTRUCTED | 3));
+  Require(CBB_add_asn1(&extensions_wrap, &extension_list, CBS_ASN1_SEQUENCE));
+  for (const Extension& extension : extensions) {
+    CBB element, value;
+    Require(CBB_add_asn1(&extension_list, &element, CBS_ASN1_SEQUENCE));
+    AddOid(&element, extension.oid);
+    if (extension.critical) {
+      Require(CBB_add_asn1_bool(&element, 1));
+    }
+    Require(CBB_add_asn1(&element, &value, CBS_ASN1_OCTETSTRING));
+    AddBytes(&value, extension.value);
+    Require(CBB_flush(&extension_list));
+  }
+  return ToString(cbb.get());
+}
+
+std::string SignCertificate(const std::string& tbs,
+                            const std::string& signature) {
+  ScopedCBB cbb;
+  CBB cert;
+  Require(CBB_init(cbb.get(), tbs.size() + signature.size() + 32));
+  Require(CBB_add_asn1(cbb.get(), &cert, CBS_ASN1_SEQUENCE));
+  AddBytes(&cert, tbs);
+  AddSignatureAlgorithm(&cert);
+  AddBitString(&cert, signature);
+  return ToString(cbb.get());
+}
+
+std::string OctetString(std::string_view contents) {
+  ScopedCBB cbb;
+  Require(CBB_init(cbb.get(), contents.size() + 4));
+  Require(CBB_add_asn1_octet_string(
+      cbb.get(), reinterpret_cast<const uint8_t*>(contents.data()),
+      contents.size()));
+  return ToString(cbb.get());
+}
+
+std::string Serial(ByteStream* stream) {
+  uint8_t serial[16];
+  stream->Generate(serial, sizeof(serial));
+  serial[0] = (serial[0] & 0x7f) | 0x40;
+  return std::string(reinterpret_cast<const char*>(serial), sizeof(serial));
+}
+
+}  // namespace
+
+ChainGenerator::ChainGenerator(const ChainGeneratorOptions& options)
+    : options_(options) {
+  for (size_t i = 0; i < options_.ec_logs; i++) {
+    ByteStream stream(options_.seed, "ec log", i);
+    log_keys_.push_back(Key::GenerateEC(&stream));
+  }
+  for (size_t i = 0; i < options_.rsa_logs; i++) {
+    ByteStream stream(options_.seed, "rsa log", i);
+    log_keys_.push_back(Key::GenerateRSA(&stream));
+  }
+  for (const auto& key : log_keys_) {
+    logs_.push_back(key->spki);
+  }
+
+  for (size_t i = 0; i < options_.issuers; i++) {
+    ByteStream stream(options_.seed, "issuer", i);
+    auto issuer = std::make_unique<Issuer>();
+    issuer->key = Key::GenerateEC(&stream);
+    issuer->name = "Generated CA " + std::to_string(i);
+    ScopedCBB cbb;
+    CBB basic_constraints;
+    Require(CBB_init(cbb.get(), 8));
+    Require(CBB_add_asn1(cbb.get(), &basic_constraints, CBS_ASN1_SEQUENCE));
+    Require(CBB_add_asn1_bool(&basic_constraints, 1));
+    const std::string tbs = BuildTBSCertificate(
+        Serial(&stream), issuer->name, issuer->name, issuer->key->spki,
+        {{"2.5.29.19", true, ToString(cbb.get())}});
+    issuer->cert = SignCertificate(tbs, issuer->key->Sign(tbs, &stream));
+    issuers_.push_back(std::move(issuer));
+  }
+}
+
+ChainGenerator::~ChainGenerator() = default;
+
+GeneratedChain ChainGenerator::Generate(uint64_t index) const {
+  ByteStream stream(options_.seed, "chain", index);
+  const Issuer& issuer = *issuers_[index % issuers_.size()];
+  const std::unique_ptr<Key> leaf_key = Key::GenerateEC(&stream);
+  const std::string serial = Serial(&stream);
+  const std::string subject = "leaf-" + std::to_string(index) + ".example";
+
+  std::vector<std::string> oids;
+  for (size_t i = 0; i < options_.extensions; i++) {
+    oids.push_back("1.3.6.1.4.1.55555.1." + std::to_string(i));
+  }
+  std::vector<Extension> extensions;
+  for (const std::string& oid : oids) {
+    uint8_t value[8];
+    stream.Generate(value, sizeof(value));
+    extensions.push_back(
+        {oid.c_str(), false,
+         OctetString(std::string_view(reinterpret_cast<const char*>(value),
+                                      sizeof(value)))});
+  }
+
+  // The precertificate TBSCertificate the logs sign is the leaf's without
+  // the SCT list, which goes last.
+  const std::string precert_tbs = BuildTBSCertificate(
+      serial, issuer.name, subject, leaf_key->spki, extensions);
+  uint8_t issuer_key_hash[kSHA256DigestLength];
+  SHA256(issuer.key->spki.data(), issuer.key->spki.size(), issuer_key_hash);
+
+  ScopedCBB list_cbb;
+  CBB list;
+  Require(CBB_init(list_cbb.get(), 128 * options_.scts_per_chain));
+  Require(CBB_add_u16_length_prefixed(list_cbb.get(), &list));
+  for (size_t i = 0; i < options_.scts_per_chain && !log_keys_.empty(); i++) {
+    const Key& log = *log_keys_[(index + i) % log_keys_.size()];
+
+    // RFC 6962, Section 3.2: the digitally-signed struct of a precert entry.
+    ScopedCBB signed_cbb;
+    CBB tbs, extensions_field;
+    Require(CBB_init(signed_cbb.get(), precert_tbs.size() + 64));
+    Require(CBB_add_u8(signed_cbb.get(), 0));  // v1
+    Require(CBB_add_u8(signed_cbb.get(), 0));  // certificate_timestamp
+    Require(CBB_add_u64(signed_cbb.get(), options_.sct_timestamp));
+    Require(CBB_add_u16(signed_cbb.get(), 1));  // precert_entry
+    Require(CBB_add_bytes(signed_cbb.get(), issuer_key_hash,
+                          sizeof(issuer_key_hash)));
+    Require(CBB_add_u24_length_prefixed(signed_cbb.get(), &tbs));
+    AddBytes(&tbs, precert_tbs);
+    Require(CBB_add_u16_length_prefixed(signed_cbb.get(), &extensions_field));
+    const std::string signature = log.Sign(ToString(signed_cbb.get()), &stream);
+
+    CBB sct, sct_extensions, signature_field;
+    Require(CBB_add_u16_length_prefixed(&list, &sct));
+    Require(CBB_add_u8(&sct, 0));
+    AddBytes(&sct, log.key_id);
+    Require(CBB_add_u64(&sct, options_.sct_timestamp));
+    Require(CBB_add_u16_length_prefixed(&sct, &sct_extensions));
+    Require(CBB_add_u8(&sct, 4));  // sha256
+    Require(CBB_add_u8(&sct, log.rsa ? 1 : 3));
+    Require(CBB_add_u16_length_prefixed(&sct, &signature_field));
+    AddBytes(&signature_field, signature);
+    Require(CBB_flush(&list));
+  }
+  extensions.push_back({"1.3.6.1.4.1.11129.2.4.2", false,
+                        OctetString(ToString(list_cbb.get()))});
+
+  const std::string tbs = BuildTBSCertificate(serial, issuer.name, subject,
+                                              leaf_key->spki, extensions);
+  GeneratedChain chain;
+  chain.leaf_cert = SignCertificate(tbs, issuer.key->Sign(tbs, &stream));
+  chain.issuer_cert = issuer.cert;
+  return chain;
+}
+
+}  // namespace test
+}  // namespace certificate_transparency
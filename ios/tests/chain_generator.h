@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace certificate_transparency {
+namespace test {
+
+struct ChainGeneratorOptions {
+  // Everything generated follows from the seed: the same options give the
+  // same logs and chains, byte for byte.
+  uint64_t seed = 1;
+  // Logs with P-256 and with RSA-2048 keys. RSA keys take a while to find.
+  size_t ec_logs = 2;
+  size_t rsa_logs = 0;
+  // Issuers the chains take turns being issued by.
+  size_t issuers = 1;
+  // SCTs embedded in each leaf, from the logs in turn. More SCTs than logs
+  // gives several SCTs from the same log.
+  size_t scts_per_chain = 2;
+  // Extensions in each leaf besides the SCT list.
+  size_t extensions = 2;
+  // The time every SCT is issued at, in milliseconds since the epoch.
+  uint64_t sct_timestamp = 1700000000000;
+};
+
+struct GeneratedChain {
+  // DER encoded certificates. The leaf carries the SCT list; the issuer is a
+  // self-signed CA.
+  std::string leaf_cert;
+  std::string issuer_cert;
+};
+
+// Builds chains with SCTs for load and scale tests, and the logs that signed
+// them. Keys are made and signatures computed with slow, variable-time code
+// that is only fit for test data.
+class ChainGenerator {
+ public:
+  explicit ChainGenerator(const ChainGeneratorOptions& options);
+  ~ChainGenerator();
+
+  ChainGenerator(const ChainGenerator&) = delete;
+  ChainGenerator& operator=(const ChainGenerator&) = delete;
+
+  // The SubjectPublicKeyInfo of every log, as MultiLogVerifier takes them.
+  const std::vector<std::string>& logs() const { return logs_; }
+
+  // Returns chain |index|, which only depends on the options and |index|.
+  GeneratedChain Generate(uint64_t index) const;
+
+ private:
+  struct Key;
+  struct Issuer;
+
+  const ChainGeneratorOptions options_;
+  std::vector<std::unique_ptr<Key>> log_keys_;
+  std::vector<std::string> logs_;
+  std::vector<std::unique_ptr<Issuer>> issuers_;
+};
+
+}  // namespace test
+}  // namespace certificate_transparency
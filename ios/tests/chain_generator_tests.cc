@@ -0,0 +1,112 @@
+#include <string>
+
+#include "chain_generator.h"
+#include "multi_log_verifier.h"
+#include "public_key.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kSCTTimestamp = 1700000000000;
+
+test::ChainGeneratorOptions MakeOptions() {
+  test::ChainGeneratorOptions options;
+  options.seed = 42;
+  options.ec_logs = 3;
+  options.issuers = 2;
+  options.scts_per_chain = 2;
+  options.extensions = 3;
+  options.sct_timestamp = kSCTTimestamp;
+  return options;
+}
+
+}  // namespace
+
+TEST(GeneratedChainsVerify) {
+  const test::ChainGenerator generator(MakeOptions());
+  EXPECT_EQ(generator.logs().size(), 3u);
+  const ct::MultiLogVerifier verifier(generator.logs());
+  for (uint64_t i = 0; i < 4; i++) {
+    const test::GeneratedChain chain = generator.Generate(i);
+    const ct::VerificationDetails details = verifier.VerifyDetailed(
+        chain.leaf_cert, chain.issuer_cert, kSCTTimestamp);
+    EXPECT_TRUE(details.verified);
+    EXPECT_EQ(details.sct_count, 2u);
+    EXPECT_EQ(details.distinct_logs, 2u);
+  }
+
+  // SCTs from the future, and from logs the verifier doesn't know, fail.
+  const test::GeneratedChain chain = generator.Generate(0);
+  EXPECT_FALSE(
+      verifier.Verify(chain.leaf_cert, chain.issuer_cert, kSCTTimestamp - 1));
+  const ct::MultiLogVerifier other_logs({generator.logs()[2]});
+  EXPECT_FALSE(
+      other_logs.Verify(chain.leaf_cert, chain.issuer_cert, kSCTTimestamp));
+}
+
+TEST(GeneratedChainsFollowSeed) {
+  const test::ChainGenerator generator(MakeOptions());
+  const test::ChainGenerator same(MakeOptions());
+  test::ChainGeneratorOptions options = MakeOptions();
+  options.seed++;
+  const test::ChainGenerator other(options);
+
+  EXPECT_TRUE(generator.logs() == same.logs());
+  EXPECT_FALSE(generator.logs() == other.logs());
+  EXPECT_EQ(generator.Generate(7).leaf_cert, same.Generate(7).leaf_cert);
+  EXPECT_EQ(generator.Generate(7).issuer_cert, same.Generate(7).issuer_cert);
+  EXPECT_FALSE(generator.Generate(7).leaf_cert == other.Generate(7).leaf_cert);
+  EXPECT_FALSE(generator.Generate(7).leaf_cert ==
+               generator.Generate(8).leaf_cert);
+  // Chains take turns between the issuers.
+  EXPECT_EQ(generator.Generate(1).issuer_cert,
+            generator.Generate(3).issuer_cert);
+  EXPECT_FALSE(generator.Generate(1).issuer_cert ==
+               generator.Generate(2).issuer_cert);
+}
+
+TEST(GeneratedRSALogsVerify) {
+  test::ChainGeneratorOptions options = MakeOptions();
+  options.ec_logs = 0;
+  options.rsa_logs = 2;
+  const test::ChainGenerator generator(options);
+  for (const std::string& log : generator.logs()) {
+    EXPECT_EQ(ct::PublicKey::Parse(log).type(), ct::PublicKey::kRSA);
+  }
+  const ct::MultiLogVerifier verifier(generator.logs());
+  const test::GeneratedChain chain = generator.Generate(0);
+  const ct::VerificationDetails details =
+      verifier.VerifyDetailed(chain.leaf_cert, chain.issuer_cert,
+                              kSCTTimestamp);
+  EXPECT_TRUE(details.verified);
+  EXPECT_EQ(details.signature_checks, 2u);
+}
+
+TEST(GeneratedChainsHaveRequestedShape) {
+  test::ChainGeneratorOptions options = MakeOptions();
+  options.scts_per_chain = 5;
+  options.extensions = 20;
+  const test::ChainGenerator generator(options);
+  const test::GeneratedChain chain = generator.Generate(0);
+
+  // Five SCTs from three logs: the repeats are skipped.
+  const ct::MultiLogVerifier verifier(generator.logs());
+  const ct::VerificationDetails details = verifier.VerifyDetailed(
+      chain.leaf_cert, chain.issuer_cert, kSCTTimestamp);
+  EXPECT_TRUE(details.verified);
+  EXPECT_EQ(details.sct_count, 5u);
+
+  // 21 extensions with the SCT list.
+  ct::VerificationLimits limits;
+  limits.max_extensions = 20;
+  const ct::MultiLogVerifier limited(generator.logs(), limits);
+  EXPECT_FALSE(limited.Verify(chain.leaf_cert, chain.issuer_cert,
+                              kSCTTimestamp));
+  limits.max_extensions = 21;
+  const ct::MultiLogVerifier enough(generator.logs(), limits);
+  EXPECT_TRUE(enough.Verify(chain.leaf_cert, chain.issuer_cert,
+                            kSCTTimestamp));
+}
@@ -0,0 +1,152 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "chain_recorder.h"
+#include "multi_log_verifier.h"
+#include "presented_chain_evaluator.h"
+#include "root_index.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "verification_pipeline.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+// A path for a recording, removed with the object.
+class TemporaryPath {
+ public:
+  TemporaryPath() {
+    char path[] = "/tmp/chain_recording_XXXXXX";
+    const int fd = mkstemp(path);
+    close(fd);
+    // The recorder creates the file and writes its header.
+    unlink(path);
+    path_ = path;
+  }
+  ~TemporaryPath() { unlink(path_.c_str()); }
+
+  const std::string& get() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+}  // namespace
+
+TEST(ChainRecorderRoundTrips) {
+  TemporaryPath path;
+  {
+    auto recorder = ct::ChainRecorder::Open(path.get());
+    EXPECT_TRUE(recorder != nullptr);
+    recorder->Record(test::ValidTimestampsLeaf(), test::SubRootCA(), 1);
+    recorder->Record(test::NoTimestampsLeaf(), test::SubRootCA(), 2);
+    EXPECT_EQ(recorder->recorded(), 2u);
+  }
+  // Reopening appends to the same recording.
+  ct::ChainRecorder::Open(path.get())->Record("leaf", "issuer", 3);
+
+  const auto chains = ct::ReadChainRecording(path.get());
+  EXPECT_TRUE(chains.has_value());
+  EXPECT_EQ(chains->size(), 3u);
+  EXPECT_EQ((*chains)[0].leaf_cert, std::string(test::ValidTimestampsLeaf()));
+  EXPECT_EQ((*chains)[0].issuer_cert, std::string(test::SubRootCA()));
+  EXPECT_EQ((*chains)[0].timestamp, 1u);
+  EXPECT_EQ((*chains)[1].leaf_cert, std::string(test::NoTimestampsLeaf()));
+  EXPECT_EQ((*chains)[2].issuer_cert, std::string("issuer"));
+  EXPECT_EQ((*chains)[2].timestamp, 3u);
+}
+
+TEST(ChainRecorderSamples) {
+  TemporaryPath path;
+  auto recorder = ct::ChainRecorder::Open(path.get(), 3);
+  for (uint64_t i = 0; i < 7; i++) {
+    recorder->Record("leaf", "issuer", i);
+  }
+  EXPECT_EQ(recorder->recorded(), 3u);
+  const auto chains = ct::ReadChainRecording(path.get());
+  EXPECT_EQ(chains->size(), 3u);
+  EXPECT_EQ((*chains)[1].timestamp, 3u);
+}
+
+TEST(ChainRecordingIgnoresTruncatedRecord) {
+  TemporaryPath path;
+  ct::ChainRecorder::Open(path.get())->Record("leaf", "issuer", 1);
+  FILE* file = fopen(path.get().c_str(), "ab");
+  fwrite("\x00\x00\x04le", 1, 5, file);
+  fclose(file);
+
+  const auto chains = ct::ReadChainRecording(path.get());
+  EXPECT_EQ(chains->size(), 1u);
+  EXPECT_FALSE(ct::ReadChainRecording(path.get() + ".missing"));
+}
+
+TEST(VerifierRecordsChains) {
+  TemporaryPath path;
+  {
+    ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+    verifier.SetChainRecorder(ct::ChainRecorder::Open(path.get()));
+    EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                                kFarFuture));
+    EXPECT_FALSE(verifier.Verify(test::NoTimestampsLeaf(), test::SubRootCA(),
+                                 kFarFuture));
+  }
+
+  const auto chains = ct::ReadChainRecording(path.get());
+  EXPECT_EQ(chains->size(), 2u);
+  const ct::MultiLogVerifier replayer(ct::GetBuiltinLogs());
+  EXPECT_TRUE(replayer.Verify((*chains)[0].leaf_cert,
+                              (*chains)[0].issuer_cert,
+                              (*chains)[0].timestamp));
+  EXPECT_FALSE(replayer.Verify((*chains)[1].leaf_cert,
+                               (*chains)[1].issuer_cert,
+                               (*chains)[1].timestamp));
+}
+
+TEST(VerifierRecordsPipelinedChains) {
+  TemporaryPath path;
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  verifier.SetChainRecorder(ct::ChainRecorder::Open(path.get()));
+  ct::RootIndex roots;
+  roots.Add(test::RootCA());
+  const std::vector<std::string_view> presented = {
+      test::ValidTimestampsLeaf(), test::SubRootCA(), test::RootCA()};
+  ct::PresentedChainEvaluator evaluator(presented, &roots,
+                                        std::chrono::milliseconds(1));
+  // Prepared on the calling thread, from copies that are gone by the commit.
+  ct::VerificationPipeline pipeline(
+      verifier.limits(), [](ct::VerificationPipeline::Task task) { task(); });
+  EXPECT_TRUE(pipeline
+                  .Verify(&evaluator, presented[0], presented[1],
+                          [&](const ct::PreparedChain& chain) {
+                            return verifier.Verify(chain, kFarFuture);
+                          })
+                  .trusted);
+
+  // Chains prepared by the caller are recorded unless their views were
+  // cleared.
+  ct::PreparedChain chain;
+  ct::PrepareChain(test::NoTimestampsLeaf(), test::SubRootCA(),
+                   verifier.limits(), &chain);
+  EXPECT_FALSE(verifier.Verify(chain, 2));
+  chain.leaf_cert = {};
+  EXPECT_FALSE(verifier.Verify(chain, 3));
+
+  const auto chains = ct::ReadChainRecording(path.get());
+  EXPECT_EQ(chains->size(), 2u);
+  EXPECT_EQ((*chains)[0].leaf_cert, std::string(test::ValidTimestampsLeaf()));
+  EXPECT_EQ((*chains)[0].issuer_cert, std::string(test::SubRootCA()));
+  EXPECT_EQ((*chains)[1].leaf_cert, std::string(test::NoTimestampsLeaf()));
+  EXPECT_EQ((*chains)[1].timestamp, 2u);
+}
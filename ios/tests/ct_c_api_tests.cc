@@ -0,0 +1,151 @@
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "ct_c_api.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "test_keys_data.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+ct_span Span(std::string_view bytes) {
+  return {reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size()};
+}
+
+ct_chain Chain(std::string_view leaf, std::string_view issuer) {
+  return {Span(leaf), Span(issuer)};
+}
+
+}  // namespace
+
+TEST(CAPIVerifiesWithBuiltinLogs) {
+  EXPECT_EQ(ct_c_api_version(), static_cast<uint32_t>(CT_C_API_VERSION));
+  const ct_verifier* verifier = ct_verifier_builtin();
+  const ct_chain valid = Chain(test::ValidTimestampsLeaf(), test::SubRootCA());
+  const ct_chain missing = Chain(test::NoTimestampsLeaf(), test::SubRootCA());
+  EXPECT_EQ(ct_verify(verifier, &valid, kFarFuture), 1);
+  EXPECT_EQ(ct_verify(verifier, &valid, 0), 0);
+  EXPECT_EQ(ct_verify(verifier, &missing, kFarFuture), 0);
+  // Freeing the builtin verifier is harmless.
+  ct_verifier_free(const_cast<ct_verifier*>(verifier));
+  EXPECT_EQ(ct_verify(ct_verifier_builtin(), &valid, kFarFuture), 1);
+}
+
+TEST(CAPIVerifiesWithGivenKeys) {
+  const std::vector<std::string> logs = ct::GetBuiltinLogs();
+  std::vector<ct_span> keys;
+  for (const std::string& log : logs) {
+    keys.push_back(Span(log));
+  }
+  ct_verifier* verifier = ct_verifier_new_from_keys(keys.data(), keys.size());
+  const ct_chain valid = Chain(test::ValidTimestampsLeaf(), test::SubRootCA());
+  EXPECT_EQ(ct_verify(verifier, &valid, kFarFuture), 1);
+  ct_verifier_free(verifier);
+
+  const ct_span other_log = Span(test::RSA2048Key());
+  verifier = ct_verifier_new_from_keys(&other_log, 1);
+  EXPECT_EQ(ct_verify(verifier, &valid, kFarFuture), 0);
+  ct_verifier_free(verifier);
+
+}
+
+TEST(CAPIRejectsBadKeys) {
+  // A key that doesn't parse fails the whole set, even with good ones, so
+  // a caller can't end up enforcing fewer logs than it asked for.
+  const std::vector<std::string> logs = ct::GetBuiltinLogs();
+  const ct_span bad = Span("not a key");
+  EXPECT_TRUE(ct_verifier_new_from_keys(&bad, 1) == nullptr);
+  const ct_span keys[] = {Span(logs[0]), Span(logs[1]), bad};
+  EXPECT_TRUE(ct_verifier_new_from_keys(keys, 3) == nullptr);
+  const ct_span empty = {nullptr, 0};
+  EXPECT_TRUE(ct_verifier_new_from_keys(&empty, 1) == nullptr);
+  // No keys at all would let every chain pass.
+  EXPECT_TRUE(ct_verifier_new_from_keys(nullptr, 0) == nullptr);
+}
+
+TEST(CAPIReadsLogLists) {
+  // A list without valid logs would let every chain pass.
+  for (const std::string_view empty :
+       {R"({"operators": []})",
+        R"({"operators": [{"logs": [{"key": "bm90IGEga2V5"}]}]})"}) {
+    EXPECT_TRUE(ct_verifier_new_from_log_list(
+                    reinterpret_cast<const uint8_t*>(empty.data()),
+                    empty.size()) == nullptr);
+  }
+
+  const std::string_view invalid = "[]";
+  EXPECT_TRUE(ct_verifier_new_from_log_list(
+                  reinterpret_cast<const uint8_t*>(invalid.data()),
+                  invalid.size()) == nullptr);
+  EXPECT_TRUE(ct_verifier_new_from_log_list(nullptr, 0) == nullptr);
+}
+
+TEST(CAPIBatchSetsVerdictBits) {
+  const ct_chain valid = Chain(test::ValidTimestampsLeaf(), test::SubRootCA());
+  const ct_chain missing = Chain(test::NoTimestampsLeaf(), test::SubRootCA());
+  const ct_chain truncated =
+      Chain(test::ValidTimestampsLeaf().substr(0, 100), test::SubRootCA());
+  // Valid at 0, 3, 8 and 10, spanning two bytes of verdicts.
+  std::vector<ct_chain> chains(11, missing);
+  chains[0] = chains[3] = chains[8] = chains[10] = valid;
+  chains[5] = truncated;
+  chains[9] = Chain(std::string_view(), std::string_view());
+
+  uint8_t verdicts[3];
+  memset(verdicts, 0xff, sizeof(verdicts));
+  EXPECT_EQ(ct_verify_batch(ct_verifier_builtin(), chains.data(),
+                            chains.size(), kFarFuture, verdicts),
+            4u);
+  EXPECT_EQ(verdicts[0], 0x09);
+  EXPECT_EQ(verdicts[1], 0x05);
+  // Bytes past (count + 7) / 8 are not written.
+  EXPECT_EQ(verdicts[2], 0xff);
+
+  EXPECT_EQ(ct_verify_batch(ct_verifier_builtin(), nullptr, 0, kFarFuture,
+                            verdicts),
+            0u);
+}
+
+TEST(CAPIReportsEachSCT) {
+  const ct_chain valid = Chain(test::ValidTimestampsLeaf(), test::SubRootCA());
+  const ct_chain missing = Chain(test::NoTimestampsLeaf(), test::SubRootCA());
+  ct_sct_result results[16];
+
+  // Every SCT is checked, although the first two pass the quorum.
+  const size_t count = ct_verify_scts(ct_verifier_builtin(), &valid,
+                                      kFarFuture, results, 16);
+  EXPECT_TRUE(count > 2);
+  for (size_t i = 0; i < count; i++) {
+    EXPECT_TRUE(results[i].status == CT_SCT_OK ||
+                results[i].status == CT_SCT_UNKNOWN_LOG);
+    EXPECT_TRUE(results[i].timestamp > 0);
+  }
+  EXPECT_EQ(ct_verify_scts(ct_verifier_builtin(), &valid, kFarFuture,
+                           results, 1),
+            count);
+  EXPECT_EQ(ct_verify_scts(ct_verifier_builtin(), &valid, 0, results, 16),
+            count);
+  EXPECT_EQ(results[0].status,
+            static_cast<uint32_t>(CT_SCT_FUTURE_TIMESTAMP));
+  EXPECT_EQ(ct_verify_scts(ct_verifier_builtin(), &missing, kFarFuture,
+                           results, 16),
+            0u);
+
+  // With other logs, every SCT is from an unknown log.
+  const ct_span other_log = Span(test::RSA2048Key());
+  ct_verifier* verifier = ct_verifier_new_from_keys(&other_log, 1);
+  EXPECT_EQ(ct_verify_scts(verifier, &valid, kFarFuture, results, 16), count);
+  for (size_t i = 0; i < count; i++) {
+    EXPECT_EQ(results[i].status, static_cast<uint32_t>(CT_SCT_UNKNOWN_LOG));
+  }
+  ct_verifier_free(verifier);
+}
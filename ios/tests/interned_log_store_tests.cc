@@ -0,0 +1,97 @@
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "interned_log_store.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "test_keys_data.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+std::vector<std::string_view> Views(const std::vector<std::string>& logs) {
+  return std::vector<std::string_view>(logs.begin(), logs.end());
+}
+
+}  // namespace
+
+TEST(InternedLogStoreSharesVerifiers) {
+  ct::InternedLogStore store;
+  const std::vector<std::string> logs = ct::GetBuiltinLogs();
+  auto verifier = store.GetVerifier(Views(logs));
+  EXPECT_TRUE(verifier->Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                               kFarFuture));
+  EXPECT_EQ(verifier->generation(),
+            ct::GetBuiltinLogVerifier().generation());
+
+  // The order of the keys does not matter, and the keys are not copied.
+  std::vector<std::string_view> reversed(logs.rbegin(), logs.rend());
+  EXPECT_TRUE(store.GetVerifier(reversed) == verifier);
+  EXPECT_EQ(store.verifier_count(), 1u);
+  EXPECT_EQ(store.log_count(), logs.size());
+
+  // Another set shares the logs it has in common.
+  std::vector<std::string_view> more = Views(logs);
+  more.push_back(test::RSA2048Key());
+  auto other = store.GetVerifier(more);
+  EXPECT_TRUE(other != verifier);
+  EXPECT_EQ(store.verifier_count(), 2u);
+  EXPECT_EQ(store.log_count(), logs.size() + 1);
+}
+
+TEST(InternedLogStoreReleasesUnusedLogs) {
+  ct::InternedLogStore store;
+  const std::string key(test::RSA2048Key());
+  auto verifier = store.GetVerifier({key});
+  auto log = store.GetLog(key);
+  EXPECT_TRUE(log->IsValid());
+  EXPECT_EQ(store.log_count(), 1u);
+
+  verifier.reset();
+  EXPECT_EQ(store.verifier_count(), 0u);
+  // The log is still held by |log|, and the next verifier uses it.
+  EXPECT_EQ(store.log_count(), 1u);
+  verifier = store.GetVerifier({key});
+  EXPECT_EQ(store.GetLog(key).get(), log.get());
+
+  verifier.reset();
+  log.reset();
+  EXPECT_EQ(store.log_count(), 0u);
+
+  // Invalid keys are interned too, and skipped by verifiers.
+  EXPECT_FALSE(store.GetLog("not a key")->IsValid());
+  verifier = store.GetVerifier({"not a key"});
+  EXPECT_TRUE(verifier->Verify(test::NoTimestampsLeaf(), test::SubRootCA(),
+                               kFarFuture));
+}
+
+TEST(InternedLogStoreRacesBuildOneVerifier) {
+  ct::InternedLogStore store;
+  const std::vector<std::string> logs = ct::GetBuiltinLogs();
+  constexpr int kThreads = 8;
+  std::vector<std::shared_ptr<const ct::MultiLogVerifier>> verifiers(
+      kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back(
+        [&, t] { verifiers[t] = store.GetVerifier(Views(logs)); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  bool all_same = true;
+  for (const auto& verifier : verifiers) {
+    all_same = all_same && verifier == verifiers[0];
+  }
+  EXPECT_TRUE(all_same);
+  EXPECT_EQ(&ct::InternedLogStore::Shared(), &ct::InternedLogStore::Shared());
+}
@@ -0,0 +1,79 @@
+#include <optional>
+#include <string>
+
+#include "log_list_parser.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+
+TEST(DecodeBase64) {
+  EXPECT_EQ(ct::DecodeBase64(""), std::string());
+  EXPECT_EQ(ct::DecodeBase64("Zg=="), std::string("f"));
+  EXPECT_EQ(ct::DecodeBase64("Zm8="), std::string("fo"));
+  EXPECT_EQ(ct::DecodeBase64("Zm9v"), std::string("foo"));
+  EXPECT_EQ(ct::DecodeBase64("+/+/"), std::string("\xfb\xff\xbf"));
+
+  EXPECT_FALSE(ct::DecodeBase64("Zm9"));
+  EXPECT_FALSE(ct::DecodeBase64("Zm9v!A=="));
+  EXPECT_FALSE(ct::DecodeBase64("Z==="));
+  EXPECT_FALSE(ct::DecodeBase64("Zg==Zm9v"));
+  EXPECT_FALSE(ct::DecodeBase64("Zg=v"));
+}
+
+TEST(ParseLogList) {
+  auto logs = ct::ParseLogList(R"({
+    "version": "1.0",
+    "operators": [
+      {"name": "a", "logs": [{"key": "Zm9v", "mmd": 86400}, {"key": "YmFy"}]},
+      {"name": "b", "logs": [{"key": "YmF6"}]}
+    ]
+  })");
+  EXPECT_TRUE(logs);
+  EXPECT_EQ(logs->size(), 3u);
+  EXPECT_EQ((*logs)[0], "foo");
+  EXPECT_EQ((*logs)[1], "bar");
+  EXPECT_EQ((*logs)[2], "baz");
+}
+
+TEST(ParseLogListSkipsUnexpectedEntries) {
+  auto logs = ct::ParseLogList(R"({"operators": [
+    1, {"logs": {}}, {"logs": [null, {"key": 5}, {"key": "!!"}, {}]},
+    {"logs": [{"key": "Zm9v"}]}
+  ]})");
+  EXPECT_TRUE(logs);
+  EXPECT_EQ(logs->size(), 1u);
+}
+
+TEST(ParseLogListRejectsMalformedDocuments) {
+  EXPECT_FALSE(ct::ParseLogList(""));
+  EXPECT_FALSE(ct::ParseLogList("[]"));
+  EXPECT_FALSE(ct::ParseLogList("{}"));
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": {}})"));
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": []} x)"));
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": [],})"));
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": [01.]})"));
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": ["\x"]})"));
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": ["\ud800"]})"));
+  EXPECT_FALSE(ct::ParseLogList("{\"operators\": [\"\n\"]}"));
+  EXPECT_TRUE(ct::ParseLogList(R"({"operators": [-1.5e+3, true, "😀"]})"));
+
+  std::string deep = R"({"operators": )";
+  deep += std::string(1000, '[') + std::string(1000, ']') + "}";
+  EXPECT_FALSE(ct::ParseLogList(deep));
+}
+
+TEST(ParseLogListRevocations) {
+  std::optional<std::string> revocations;
+  EXPECT_TRUE(ct::ParseLogList(R"({"operators": []})", &revocations));
+  EXPECT_FALSE(revocations);
+  EXPECT_TRUE(ct::ParseLogList(R"({"operators": [], "revocations": "Zm9v"})",
+                               &revocations));
+  EXPECT_EQ(revocations, std::string("foo"));
+
+  // A damaged index fails the document, which is not left half-read.
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": [], "revocations": "Zm9"})",
+                                &revocations));
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": [], "revocations": 5})",
+                                &revocations));
+  EXPECT_FALSE(ct::ParseLogList(R"({"operators": [], "revocations": "!"})"));
+}
@@ -0,0 +1,228 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "file_log_list_source.h"
+#include "file_log_list_storage.h"
+#include "http_log_list_transport.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+
+namespace {
+
+std::string EncodeBase64(const std::string& data) {
+  static const char kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string result;
+  for (size_t i = 0; i < data.size(); i += 3) {
+    uint32_t group = static_cast<uint8_t>(data[i]) << 16;
+    if (i + 1 < data.size()) {
+      group |= static_cast<uint8_t>(data[i + 1]) << 8;
+    }
+    if (i + 2 < data.size()) {
+      group |= static_cast<uint8_t>(data[i + 2]);
+    }
+    result.push_back(kAlphabet[(group >> 18) & 63]);
+    result.push_back(kAlphabet[(group >> 12) & 63]);
+    result.push_back(i + 1 < data.size() ? kAlphabet[(group >> 6) & 63] : '=');
+    result.push_back(i + 2 < data.size() ? kAlphabet[group & 63] : '=');
+  }
+  return result;
+}
+
+std::string MakeLogListJson(const std::vector<std::string>& logs) {
+  std::string json = R"({"operators": [{"name": "test", "logs": [)";
+  for (size_t i = 0; i < logs.size(); i++) {
+    json += i ? ", " : "";
+    json += R"({"key": ")" + EncodeBase64(logs[i]) + R"("})";
+  }
+  return json + "]}]}";
+}
+
+class TemporaryDirectory {
+ public:
+  TemporaryDirectory() {
+    char path[] = "/tmp/log_list_XXXXXX";
+    path_ = mkdtemp(path) ? path : "/tmp";
+  }
+  ~TemporaryDirectory() {
+    for (const auto& file : files_) {
+      unlink(file.c_str());
+    }
+    rmdir(path_.c_str());
+  }
+
+  // Returns the path of |name| in the directory, removed with it.
+  std::string File(const std::string& name) {
+    files_.push_back(path_ + "/" + name);
+    return files_.back();
+  }
+
+ private:
+  std::string path_;
+  std::vector<std::string> files_;
+};
+
+void WriteFile(const std::string& path, const std::string& contents) {
+  FILE* file = fopen(path.c_str(), "wb");
+  fwrite(contents.data(), 1, contents.size(), file);
+  fclose(file);
+}
+
+ct::LogListTransport::FetchResult FetchNow(ct::LogListTransport* transport,
+                                           std::optional<std::string> tag) {
+  std::optional<ct::LogListTransport::FetchResult> result;
+  transport->Fetch(tag, [&result](ct::LogListTransport::FetchResult r,
+                                   const ct::ScheduleHints&) {
+    result = std::move(r);
+  });
+  return std::move(*result);
+}
+
+}  // namespace
+
+TEST(FileTransportReadsLogList) {
+  TemporaryDirectory directory;
+  const std::string path = directory.File("ctlog.json");
+  ct::FileLogListTransport transport(path);
+  EXPECT_EQ(std::get<ct::LogListTransport::ErrorCode>(
+                FetchNow(&transport, std::nullopt)),
+            ct::FileLogListTransport::kReadError);
+
+  WriteFile(path, MakeLogListJson(ct::GetBuiltinLogs()));
+  auto result = FetchNow(&transport, std::nullopt);
+  auto* ok = std::get_if<ct::LogListTransport::Ok>(&result);
+  EXPECT_TRUE(ok && ok->logs == ct::GetBuiltinLogs() && ok->tag);
+
+  // The same file is not modified, whatever the previous tag was.
+  result = FetchNow(&transport, ok->tag);
+  EXPECT_TRUE(
+      std::holds_alternative<ct::LogListTransport::NotModified>(result));
+
+  WriteFile(path, "{");
+  EXPECT_EQ(std::get<ct::LogListTransport::ErrorCode>(
+                FetchNow(&transport, std::nullopt)),
+            ct::FileLogListTransport::kParseError);
+}
+
+TEST(FileStorageRoundTrip) {
+  TemporaryDirectory directory;
+  const std::string path = directory.File("state");
+  directory.File("state.tmp");
+  ct::FileLogListStorage storage(path);
+  ct::LogListState state = storage.Load();
+  EXPECT_FALSE(state.next_update || state.tag || state.logs);
+
+  state.next_update = 12345;
+  state.tag = "\"etag\"";
+  state.logs = ct::GetBuiltinLogs();
+  state.failures = 3;
+  storage.Save(state);
+
+  ct::LogListState loaded = ct::FileLogListStorage(path).Load();
+  EXPECT_EQ(loaded.next_update, state.next_update);
+  EXPECT_EQ(loaded.tag, state.tag);
+  EXPECT_EQ(loaded.logs, state.logs);
+  EXPECT_FALSE(loaded.revocations);
+  EXPECT_EQ(loaded.failures, 3u);
+
+  // Revocation indexes may be larger than any other field.
+  state.revocations = std::string(1 << 17, 'r');
+  storage.Save(state);
+  loaded = storage.Load();
+  EXPECT_EQ(loaded.revocations, state.revocations);
+  EXPECT_EQ(loaded.logs, state.logs);
+
+  WriteFile(path, "garbage");
+  loaded = storage.Load();
+  EXPECT_FALSE(loaded.next_update || loaded.tag || loaded.logs);
+}
+
+#if defined(__linux__)
+TEST(FileWatcherSeesReplacement) {
+  TemporaryDirectory directory;
+  const std::string path = directory.File("ctlog.json");
+  const std::string temporary_path = directory.File("ctlog.json.new");
+  WriteFile(path, "{}");
+
+  std::mutex lock;
+  std::condition_variable changed;
+  int changes = 0;
+  ct::LogListFileWatcher watcher(path, [&] {
+    std::lock_guard guard(lock);
+    changes++;
+    changed.notify_all();
+  });
+  EXPECT_TRUE(watcher.Start());
+
+  // Deployments write a new file and rename it into place.
+  WriteFile(temporary_path, MakeLogListJson(ct::GetBuiltinLogs()));
+  rename(temporary_path.c_str(), path.c_str());
+
+  std::unique_lock guard(lock);
+  EXPECT_TRUE(changed.wait_for(guard, std::chrono::seconds(5),
+                               [&] { return changes > 0; }));
+}
+#endif
+
+TEST(HttpTransportSendsConditionalRequest) {
+  std::vector<ct::HttpLogListTransport::Request> requests;
+  ct::HttpLogListTransport::Response response;
+  ct::HttpLogListTransport transport(
+      "https://example.com/ctlog.json",
+      [&](ct::HttpLogListTransport::Request request,
+          ct::HttpLogListTransport::ResponseCallback callback) {
+        requests.push_back(std::move(request));
+        callback(response);
+      });
+
+  response.status = 200;
+  response.headers = {{"etag", "\"v1\""}};
+  response.body = MakeLogListJson(ct::GetBuiltinLogs());
+  auto result = FetchNow(&transport, std::nullopt);
+  auto* ok = std::get_if<ct::LogListTransport::Ok>(&result);
+  EXPECT_TRUE(ok && ok->logs == ct::GetBuiltinLogs());
+  EXPECT_TRUE(ok && ok->tag == std::string("\"v1\""));
+  EXPECT_TRUE(ok && !ok->revocations);
+  EXPECT_EQ(requests.back().url, "https://example.com/ctlog.json");
+  for (const auto& header : requests.back().headers) {
+    EXPECT_FALSE(header.first == "If-None-Match");
+  }
+
+  response = {};
+  response.status = 304;
+  result = FetchNow(&transport, std::string("\"v1\""));
+  EXPECT_TRUE(
+      std::holds_alternative<ct::LogListTransport::NotModified>(result));
+  bool sent_tag = false;
+  for (const auto& header : requests.back().headers) {
+    sent_tag |= header.first == "If-None-Match" && header.second == "\"v1\"";
+  }
+  EXPECT_TRUE(sent_tag);
+
+  response.status = 503;
+  EXPECT_EQ(std::get<ct::LogListTransport::ErrorCode>(
+                FetchNow(&transport, std::nullopt)),
+            503);
+  response.status = 0;
+  EXPECT_EQ(std::get<ct::LogListTransport::ErrorCode>(
+                FetchNow(&transport, std::nullopt)),
+            ct::HttpLogListTransport::kNoResponse);
+  response.status = 200;
+  response.body = R"({"operators": [], "revocations": "Zm9v"})";
+  result = FetchNow(&transport, std::nullopt);
+  ok = std::get_if<ct::LogListTransport::Ok>(&result);
+  EXPECT_TRUE(ok && ok->revocations == std::string("foo"));
+  response.body = "<html>";
+  EXPECT_EQ(std::get<ct::LogListTransport::ErrorCode>(
+                FetchNow(&transport, std::nullopt)),
+            ct::HttpLogListTransport::kParseError);
+}
@@ -0,0 +1,257 @@
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "ct_objects_extractor.h"
+#include "log_list_updater.h"
+#include "revocation_index.h"
+#include "system_updater_clock.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "updater_fakes.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kStart = 1700000000000;
+constexpr uint64_t kSecond = 1000;
+constexpr uint64_t kHour = 60 * 60 * kSecond;
+constexpr uint64_t kDay = 24 * kHour;
+// FakeClock jitters by half the range, which puts the first fetch 32 seconds
+// after start and keeps the success interval at a day.
+constexpr uint64_t kFirstFetch = 32 * kSecond;
+
+struct Updater {
+  std::shared_ptr<test::FakeClock> clock;
+  test::FakeTransport* transport;
+  std::shared_ptr<ct::LogListState> state;
+  std::shared_ptr<ct::LogListUpdater> updater;
+};
+
+Updater StartUpdater(ct::LogListState initial_state = {},
+                     double random = 0.5) {
+  Updater result;
+  result.clock = std::make_shared<test::FakeClock>(kStart);
+  result.clock->set_random(random);
+  auto transport = std::make_unique<test::FakeTransport>();
+  result.transport = transport.get();
+  result.state = std::make_shared<ct::LogListState>(initial_state);
+  result.updater = ct::LogListUpdater::Create(
+      std::move(transport), result.clock,
+      std::make_unique<test::MemoryStorage>(result.state));
+  return result;
+}
+
+}  // namespace
+
+TEST(UpdaterFetchesAfterInitialDelay) {
+  Updater u = StartUpdater();
+  auto builtin_verifier = u.updater->GetVerifier();
+  u.transport->Enqueue(test::MakeOk("v1", ct::GetBuiltinLogs()));
+
+  u.clock->Advance(kFirstFetch - 1);
+  EXPECT_EQ(u.transport->requested_tags().size(), 0u);
+  u.clock->Advance(1);
+  EXPECT_EQ(u.transport->requested_tags().size(), 1u);
+  EXPECT_FALSE(u.transport->requested_tags()[0]);
+
+  EXPECT_EQ(u.state->tag, std::string("v1"));
+  EXPECT_EQ(u.state->logs, ct::GetBuiltinLogs());
+  EXPECT_EQ(u.state->next_update, kStart + kFirstFetch + kDay);
+  // The new list replaced the verifier, which callers may still hold.
+  EXPECT_FALSE(u.updater->GetVerifier() == builtin_verifier);
+  EXPECT_TRUE(builtin_verifier->Verify(test::ValidTimestampsLeaf(),
+                                       test::SubRootCA(), kStart));
+}
+
+TEST(UpdaterSendsTagAndKeepsListWhenNotModified) {
+  Updater u = StartUpdater();
+  u.transport->Enqueue(test::MakeOk("v1", ct::GetBuiltinLogs()));
+  u.clock->Advance(kFirstFetch);
+  auto verifier = u.updater->GetVerifier();
+
+  u.transport->Enqueue(ct::LogListTransport::NotModified());
+  u.clock->Advance(kDay);
+  EXPECT_EQ(u.transport->requested_tags().size(), 2u);
+  EXPECT_EQ(u.transport->requested_tags()[1], std::string("v1"));
+  EXPECT_TRUE(u.updater->GetVerifier() == verifier);
+  EXPECT_EQ(u.updater->verifier_builds(), 1u);
+  EXPECT_EQ(u.state->tag, std::string("v1"));
+  EXPECT_EQ(u.state->next_update, kStart + kFirstFetch + 2 * kDay);
+}
+
+TEST(UpdaterBacksOffExponentially) {
+  Updater u = StartUpdater();
+  u.clock->Advance(kFirstFetch);
+  EXPECT_FALSE(u.state->logs);
+
+  // 15 minutes doubling up to a day, jittered to 3/4 of that here.
+  const uint64_t kMinute = 60 * kSecond;
+  const uint64_t expected_delays[] = {
+      15 * kMinute, 30 * kMinute, 60 * kMinute, 120 * kMinute,
+      240 * kMinute, 480 * kMinute, 960 * kMinute, kDay, kDay,
+  };
+  for (uint64_t expected_delay : expected_delays) {
+    u.transport->Respond(ct::LogListTransport::ErrorCode(500));
+    EXPECT_EQ(*u.state->next_update - u.clock->Now(),
+              expected_delay / 4 * 3);
+    u.clock->Advance(*u.state->next_update - u.clock->Now());
+  }
+  EXPECT_EQ(u.state->failures, 9u);
+
+  u.transport->Respond(test::MakeOk(std::nullopt, ct::GetBuiltinLogs()));
+  EXPECT_TRUE(u.state->logs);
+  EXPECT_EQ(u.state->failures, 0u);
+  EXPECT_EQ(*u.state->next_update - u.clock->Now(), kDay);
+}
+
+TEST(UpdaterFollowsServerDirections) {
+  Updater u = StartUpdater();
+  ct::ScheduleHints hints;
+  hints.max_age = 6 * kHour;
+  u.transport->Enqueue(test::MakeOk("v1", ct::GetBuiltinLogs()), hints);
+  u.clock->Advance(kFirstFetch);
+  EXPECT_EQ(*u.state->next_update - u.clock->Now(), 6 * kHour);
+
+  // Too short a max-age is raised to an hour.
+  hints.max_age = kSecond;
+  u.transport->Enqueue(ct::LogListTransport::NotModified(), hints);
+  u.clock->Advance(6 * kHour);
+  EXPECT_EQ(*u.state->next_update - u.clock->Now(), kHour);
+
+  // Retry-After replaces the backoff, plus up to a tenth.
+  hints = {};
+  hints.retry_after = 2 * kHour;
+  u.transport->Enqueue(ct::LogListTransport::ErrorCode(503), hints);
+  u.clock->Advance(kHour);
+  EXPECT_EQ(*u.state->next_update - u.clock->Now(), 2 * kHour / 20 * 21);
+}
+
+TEST(UpdaterJittersSchedule) {
+  Updater early = StartUpdater({}, 0);
+  Updater late = StartUpdater({}, 0.99);
+  EXPECT_EQ(*early.clock->NextTaskTime(), kStart + 2 * kSecond);
+  EXPECT_EQ(*late.clock->NextTaskTime(), kStart + 2 * kSecond + 59400);
+
+  early.transport->Enqueue(ct::LogListTransport::NotModified());
+  late.transport->Enqueue(ct::LogListTransport::NotModified());
+  early.clock->Advance(2 * kSecond);
+  late.clock->Advance(2 * kSecond + 59400);
+  EXPECT_EQ(*early.state->next_update - early.clock->Now(), kDay / 10 * 9);
+  EXPECT_EQ(*late.state->next_update - late.clock->Now(),
+            kDay / 1000 * 1098);
+}
+
+TEST(UpdaterResumesFromStoredState) {
+  ct::LogListState state;
+  state.next_update = kStart + 5 * kHour;
+  state.tag = "stored";
+  // An empty log list accepts every chain, unlike the builtin one.
+  state.logs.emplace();
+  Updater u = StartUpdater(state);
+  EXPECT_TRUE(u.updater->Verify(test::NoTimestampsLeaf(), test::SubRootCA(),
+                                kStart));
+
+  u.transport->Enqueue(ct::LogListTransport::NotModified());
+  u.clock->Advance(5 * kHour - 1);
+  EXPECT_EQ(u.transport->requested_tags().size(), 0u);
+  u.clock->Advance(1);
+  EXPECT_EQ(u.transport->requested_tags().size(), 1u);
+  EXPECT_EQ(u.transport->requested_tags()[0], std::string("stored"));
+}
+
+TEST(UpdaterUpdateNowFollowsFetchInFlight) {
+  Updater u = StartUpdater();
+  u.updater->UpdateNow();
+  u.updater->UpdateNow();
+  u.updater->UpdateNow();
+  EXPECT_EQ(u.transport->pending(), 1u);
+
+  u.transport->Respond(test::MakeOk("v1", ct::GetBuiltinLogs()));
+  EXPECT_EQ(u.transport->pending(), 1u);
+  EXPECT_EQ(u.transport->requested_tags().back(), std::string("v1"));
+
+  u.transport->Respond(ct::LogListTransport::NotModified());
+  EXPECT_EQ(u.transport->pending(), 0u);
+  // The timer set at start was superseded by the fetches.
+  u.clock->Advance(kDay - 1);
+  EXPECT_EQ(u.transport->requested_tags().size(), 2u);
+}
+
+TEST(UpdaterFailsRevokedChains) {
+  Updater u = StartUpdater();
+  EXPECT_FALSE(u.updater->GetRevocationIndex());
+  EXPECT_TRUE(u.updater->Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                                kStart));
+
+  std::string_view serial;
+  std::array<uint8_t, 32> issuer_key_hash;
+  ct::ExtractSerialNumber(test::ValidTimestampsLeaf(), &serial);
+  ct::GetIssuerKeyHash(test::SubRootCA(), &issuer_key_hash);
+  auto ok = test::MakeOk("v1", ct::GetBuiltinLogs());
+  ok.revocations =
+      ct::RevocationIndex::Build({{issuer_key_hash, std::string(serial)}});
+  u.transport->Enqueue(ok);
+  u.clock->Advance(kFirstFetch);
+  EXPECT_TRUE(u.updater->GetRevocationIndex());
+  EXPECT_EQ(u.state->revocations, ok.revocations);
+  EXPECT_FALSE(u.updater->Verify(test::ValidTimestampsLeaf(),
+                                 test::SubRootCA(), kStart));
+  ct::PreparedChain prepared;
+  ct::PrepareChain(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                   u.updater->GetVerifier()->limits(), &prepared);
+  EXPECT_FALSE(u.updater->Verify(prepared, kStart));
+
+  // A damaged index fails the fetch, keeping the list and index before it.
+  auto damaged = test::MakeOk("v2", {});
+  damaged.revocations = "damaged";
+  u.transport->Enqueue(damaged);
+  u.updater->UpdateNow();
+  EXPECT_EQ(u.state->tag, std::string("v1"));
+  EXPECT_EQ(u.state->failures, 1u);
+  EXPECT_FALSE(u.updater->Verify(test::ValidTimestampsLeaf(),
+                                 test::SubRootCA(), kStart));
+
+  // The index is stored with the list.
+  Updater restarted = StartUpdater(*u.state);
+  EXPECT_FALSE(restarted.updater->Verify(test::ValidTimestampsLeaf(),
+                                         test::SubRootCA(), kStart));
+}
+
+TEST(UpdaterStopsWhenDestroyed) {
+  Updater u = StartUpdater();
+  // The transport goes with the updater; nothing else may touch it.
+  u.transport = nullptr;
+  u.updater.reset();
+  u.clock->Advance(kDay);
+  EXPECT_FALSE(u.state->next_update);
+}
+
+TEST(SystemClockRunsTasksInOrder) {
+  std::mutex lock;
+  std::condition_variable done;
+  std::vector<int> order;
+  {
+    ct::SystemUpdaterClock clock;
+    EXPECT_TRUE(clock.Now() > kStart);
+    for (int i : {3, 1, 2}) {
+      clock.PostDelayed(i * 10, [&, i] {
+        std::lock_guard guard(lock);
+        order.push_back(i);
+        done.notify_all();
+      });
+    }
+    clock.PostDelayed(kDay, [&] { order.push_back(0); });
+
+    std::unique_lock guard(lock);
+    done.wait(guard, [&] { return order.size() == 3; });
+  }
+  EXPECT_EQ(order, std::vector<int>({1, 2, 3}));
+}
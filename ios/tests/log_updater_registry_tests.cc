@@ -0,0 +1,84 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log_list_updater.h"
+#include "log_updater_registry.h"
+#include "test_harness.h"
+#include "updater_fakes.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+struct CountingFactory {
+  std::shared_ptr<ct::LogListUpdater> operator()(const std::string&) {
+    (*created)++;
+    return ct::LogListUpdater::Create(
+        std::make_unique<test::FakeTransport>(), clock,
+        std::make_unique<test::MemoryStorage>(
+            std::make_shared<ct::LogListState>()));
+  }
+
+  std::atomic<int>* created;
+  std::shared_ptr<test::FakeClock> clock;
+};
+
+using Registry = ct::LogUpdaterRegistry<ct::LogListUpdater>;
+
+Registry::Factory MakeFactory(std::atomic<int>* created) {
+  return CountingFactory {created, std::make_shared<test::FakeClock>(0)};
+}
+
+}  // namespace
+
+TEST(RegistrySharesUpdaterPerURL) {
+  std::atomic<int> created {0};
+  Registry registry;
+  auto first = registry.Get("https://a/", MakeFactory(&created));
+  auto second = registry.Get("https://a/", MakeFactory(&created));
+  auto other = registry.Get("https://b/", MakeFactory(&created));
+
+  EXPECT_TRUE(first == second);
+  EXPECT_TRUE(first->GetVerifier() == second->GetVerifier());
+  EXPECT_FALSE(first == other);
+  EXPECT_EQ(created.load(), 2);
+  EXPECT_EQ(registry.size(), 2u);
+}
+
+TEST(RegistryDropsUnusedUpdaters) {
+  std::atomic<int> created {0};
+  Registry registry;
+  auto first = registry.Get("https://a/", MakeFactory(&created));
+  std::weak_ptr<ct::LogListUpdater> weak_first = first;
+  first.reset();
+  EXPECT_TRUE(weak_first.expired());
+  EXPECT_EQ(registry.size(), 0u);
+
+  auto second = registry.Get("https://a/", MakeFactory(&created));
+  EXPECT_TRUE(second != nullptr);
+  EXPECT_EQ(created.load(), 2);
+}
+
+TEST(RegistryCreatesOnceUnderContention) {
+  std::atomic<int> created {0};
+  Registry registry;
+  std::vector<std::shared_ptr<ct::LogListUpdater>> updaters(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < updaters.size(); i++) {
+    threads.emplace_back([&, i] {
+      updaters[i] = registry.Get("https://a/", MakeFactory(&created));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(created.load(), 1);
+  for (const auto& updater : updaters) {
+    EXPECT_TRUE(updater == updaters.front());
+  }
+}
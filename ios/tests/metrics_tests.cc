@@ -0,0 +1,134 @@
+#include <limits>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "metrics.h"
+#include "multi_log_verifier.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+bool Contains(const std::string& text, const std::string& part) {
+  return text.find(part) != std::string::npos;
+}
+
+}  // namespace
+
+#if defined(CERTIFICATE_TRANSPARENCY_METRICS)
+
+TEST(MetricsCountVerificationStages) {
+  const ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  const ct::MetricsSnapshot before = ct::GetMetricsSnapshot();
+  // Recorded on another thread, which exits before the second snapshot.
+  std::thread([&] {
+    verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                    kFarFuture);
+    verifier.Verify(test::NoTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+  }).join();
+  const ct::MetricsSnapshot after = ct::GetMetricsSnapshot();
+
+  using Counter = ct::MetricsCounter;
+  using Stage = ct::MetricsStage;
+  EXPECT_EQ(after.counter(Counter::kChainsChecked) -
+                before.counter(Counter::kChainsChecked),
+            2u);
+  EXPECT_EQ(after.counter(Counter::kChainsVerified) -
+                before.counter(Counter::kChainsVerified),
+            1u);
+  EXPECT_EQ(after.stage(Stage::kVerify).count -
+                before.stage(Stage::kVerify).count,
+            2u);
+  EXPECT_EQ(after.stage(Stage::kExtractSCTList).count -
+                before.stage(Stage::kExtractSCTList).count,
+            2u);
+  EXPECT_EQ(after.stage(Stage::kRebuildTBS).count -
+                before.stage(Stage::kRebuildTBS).count,
+            1u);
+  EXPECT_TRUE(after.stage(Stage::kCheckSignature).count -
+                  before.stage(Stage::kCheckSignature).count >=
+              2u);
+  EXPECT_TRUE(after.stage(Stage::kVerify).sum_ns >
+              before.stage(Stage::kVerify).sum_ns);
+}
+
+namespace {
+
+class RecordingObserver : public ct::StageObserver {
+ public:
+  void OnStageStart(ct::MetricsStage stage) override {
+    events.push_back({true, stage});
+  }
+  void OnStageEnd(ct::MetricsStage stage) override {
+    events.push_back({false, stage});
+  }
+
+  std::vector<std::pair<bool, ct::MetricsStage>> events;
+};
+
+}  // namespace
+
+TEST(MetricsTellObserverAboutNestedStages) {
+  const ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  RecordingObserver observer;
+  ct::SetStageObserver(&observer);
+  verifier.Verify(test::NoTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+  ct::SetStageObserver(nullptr);
+
+  using Stage = ct::MetricsStage;
+  const std::vector<std::pair<bool, Stage>> expected = {
+      {true, Stage::kVerify},
+      {true, Stage::kExtractSCTList},
+      {false, Stage::kExtractSCTList},
+      {false, Stage::kVerify},
+  };
+  EXPECT_TRUE(observer.events == expected);
+}
+
+#else
+
+TEST(MetricsAreCompiledOut) {
+  const ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+  const ct::MetricsSnapshot snapshot = ct::GetMetricsSnapshot();
+  EXPECT_EQ(snapshot.counter(ct::MetricsCounter::kChainsChecked), 0u);
+  EXPECT_EQ(snapshot.stage(ct::MetricsStage::kVerify).count, 0u);
+}
+
+#endif
+
+TEST(MetricsExportText) {
+  ct::MetricsSnapshot snapshot;
+  snapshot.counters[static_cast<size_t>(ct::MetricsCounter::kChainsChecked)] =
+      3;
+  auto& verify =
+      snapshot.stages[static_cast<size_t>(ct::MetricsStage::kVerify)];
+  verify.buckets[0] = 1;
+  verify.buckets[2] = 2;
+  verify.count = 3;
+  verify.sum_ns = 5000;
+
+  const std::string text = ct::ExportMetricsText(snapshot);
+  EXPECT_TRUE(Contains(text,
+                       "# TYPE ct_chains_checked_total counter\n"
+                       "ct_chains_checked_total 3\n"));
+  EXPECT_TRUE(Contains(text, "ct_verdict_store_hits_total 0\n"));
+  const std::string bucket =
+      "ct_stage_duration_seconds_bucket{stage=\"verify\",";
+  EXPECT_TRUE(Contains(text, bucket + "le=\"1e-06\"} 1\n" + bucket +
+                                 "le=\"2e-06\"} 1\n" + bucket +
+                                 "le=\"4e-06\"} 3\n"));
+  EXPECT_TRUE(Contains(
+      text, bucket + "le=\"+Inf\"} 3\n"
+                     "ct_stage_duration_seconds_sum{stage=\"verify\"} "
+                     "0.000005000\n"
+                     "ct_stage_duration_seconds_count{stage=\"verify\"} 3\n"));
+}
@@ -0,0 +1,174 @@
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "log_verifier.h"
+#include "multi_log_verifier.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "test_keys_data.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+}  // namespace
+
+TEST(BuiltinLogsAreValid) {
+  for (const auto& log : ct::GetBuiltinLogs()) {
+    EXPECT_TRUE(ct::LogVerifier(log).IsValid());
+  }
+}
+
+TEST(MalformedLogIsInvalid) {
+  std::string log = ct::GetBuiltinLogs().front();
+  log.back() ^= 1;
+  EXPECT_FALSE(ct::LogVerifier(log).IsValid());
+  EXPECT_FALSE(ct::LogVerifier(log.substr(0, log.size() - 1)).IsValid());
+}
+
+TEST(ValidTimestamps) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                              kFarFuture));
+}
+
+TEST(NoTimestamps) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  EXPECT_FALSE(verifier.Verify(test::NoTimestampsLeaf(), test::SubRootCA(),
+                               kFarFuture));
+}
+
+TEST(TimestampsFromTheFuture) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  EXPECT_FALSE(
+      verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(), 0));
+}
+
+TEST(WrongIssuer) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  EXPECT_FALSE(verifier.Verify(test::ValidTimestampsLeaf(), test::RootCA(),
+                               kFarFuture));
+}
+
+TEST(DefaultLimitsAreNotHit) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs(),
+                                ct::VerificationLimits());
+  EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                              kFarFuture));
+  const ct::VerificationLimitCounters counters = verifier.limit_counters();
+  EXPECT_EQ(counters.sct_limit_hits, 0u);
+  EXPECT_EQ(counters.signature_limit_hits, 0u);
+  EXPECT_EQ(counters.duplicate_log_skips, 0u);
+  EXPECT_EQ(counters.extension_limit_hits, 0u);
+}
+
+TEST(SCTLimit) {
+  ct::VerificationLimits limits;
+  limits.max_scts = 1;
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs(), limits);
+  EXPECT_FALSE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                               kFarFuture));
+  EXPECT_EQ(verifier.limit_counters().sct_limit_hits, 1u);
+}
+
+TEST(SignatureCheckLimit) {
+  ct::VerificationLimits limits;
+  limits.max_signature_checks = 1;
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs(), limits);
+  EXPECT_FALSE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                               kFarFuture));
+  EXPECT_EQ(verifier.limit_counters().signature_limit_hits, 1u);
+
+  limits.max_signature_checks = 2;
+  ct::MultiLogVerifier relaxed_verifier(ct::GetBuiltinLogs(), limits);
+  EXPECT_TRUE(relaxed_verifier.Verify(test::ValidTimestampsLeaf(),
+                                      test::SubRootCA(), kFarFuture));
+  EXPECT_EQ(relaxed_verifier.limit_counters().signature_limit_hits, 0u);
+}
+
+TEST(MismatchedAlgorithmsDontSpendSignatureChecks) {
+  ct::VerificationLimits limits;
+  limits.max_signature_checks = 2;
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs(), limits);
+  ct::PreparedChain chain;
+  ct::PrepareChain(test::ValidTimestampsLeaf(), test::SubRootCA(), limits,
+                   &chain);
+  // SCTs of the chain's logs with the wrong algorithm, listed first.
+  std::vector<ct::SignedCertificateTimestamp> mismatched(chain.scts);
+  for (auto& sct : mismatched) {
+    sct.signature.signature_algorithm = ct::DigitallySigned::SIG_ALGO_DSA;
+  }
+  chain.scts.insert(chain.scts.begin(), mismatched.begin(), mismatched.end());
+
+  const ct::VerificationDetails details =
+      verifier.VerifyDetailed(chain, kFarFuture);
+  EXPECT_TRUE(details.verified);
+  EXPECT_EQ(details.signature_checks, 2);
+  for (size_t i = 0; i < mismatched.size(); i++) {
+    EXPECT_TRUE(details.sct_status[i] == ct::SCTStatus::kBadParams);
+  }
+  EXPECT_EQ(verifier.limit_counters().signature_limit_hits, 0u);
+}
+
+TEST(ExtensionLimit) {
+  ct::VerificationLimits limits;
+  limits.max_extensions = 1;
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs(), limits);
+  EXPECT_FALSE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                               kFarFuture));
+  EXPECT_EQ(verifier.limit_counters().extension_limit_hits, 1u);
+}
+
+TEST(DetailedResultOfValidChain) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  const ct::VerificationDetails details = verifier.VerifyDetailed(
+      test::ValidTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+  EXPECT_TRUE(details.verified);
+  EXPECT_FALSE(details.from_verdict_store);
+  EXPECT_FALSE(details.malformed);
+  EXPECT_TRUE(details.sct_count >= 2);
+  EXPECT_EQ(details.undecodable_scts, 0);
+  EXPECT_EQ(details.signature_checks, 2);
+  EXPECT_EQ(details.distinct_logs, 2);
+  EXPECT_TRUE(details.sct_status[0] == ct::SCTStatus::kOk);
+  EXPECT_TRUE(details.sct_status[1] == ct::SCTStatus::kOk);
+  // The quorum was met before the rest were looked at.
+  for (size_t i = 2; i < details.sct_count; i++) {
+    EXPECT_TRUE(details.sct_status[i] == ct::SCTStatus::kNotChecked);
+  }
+}
+
+TEST(DetailedResultOfRejectedChains) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  ct::VerificationDetails details = verifier.VerifyDetailed(
+      test::ValidTimestampsLeaf(), test::SubRootCA(), 0);
+  EXPECT_FALSE(details.verified);
+  EXPECT_EQ(details.signature_checks, 0);
+  for (size_t i = 0; i < details.sct_count; i++) {
+    EXPECT_TRUE(details.sct_status[i] == ct::SCTStatus::kFutureTimestamp);
+  }
+
+  details = verifier.VerifyDetailed(test::ValidTimestampsLeaf(),
+                                    test::RootCA(), kFarFuture);
+  EXPECT_FALSE(details.verified);
+  EXPECT_EQ(details.signature_checks, details.sct_count);
+  EXPECT_EQ(details.distinct_logs, 0);
+  EXPECT_TRUE(details.sct_status[0] == ct::SCTStatus::kBadSignature);
+
+  details = verifier.VerifyDetailed(test::NoTimestampsLeaf(),
+                                    test::SubRootCA(), kFarFuture);
+  EXPECT_FALSE(details.verified);
+  EXPECT_TRUE(details.malformed);
+  EXPECT_EQ(details.sct_count, 0);
+
+  ct::MultiLogVerifier other_log_verifier({std::string(test::RSA2048Key())});
+  details = other_log_verifier.VerifyDetailed(
+      test::ValidTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+  EXPECT_FALSE(details.verified);
+  EXPECT_TRUE(details.sct_status[0] == ct::SCTStatus::kUnknownLog);
+}
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "adversarial_inputs.h"
+#include "certificate_bundle.h"
+#include "crypto_bytestring.h"
+#include "ct_objects_extractor.h"
+#include "ct_serialization.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Well above what any parser spends per byte, and well below what a pass
+// over the input per element would cost. Sanitizers instrument every access
+// and get more.
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+constexpr double kMaxNanosPerByte = 2000;
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+constexpr double kMaxNanosPerByte = 2000;
+#else
+constexpr double kMaxNanosPerByte = 100;
+#endif
+#else
+constexpr double kMaxNanosPerByte = 100;
+#endif
+// The per-byte cost may grow this much from an input to one 8 times larger,
+// for cache effects. Quadratic parsing would grow it 8 times.
+constexpr double kMaxGrowth = 4;
+
+size_t sink = 0;
+
+// The least time per byte |parse| takes on |input|, over rounds long enough
+// for the clock.
+template <typename Parse>
+double NanosPerByte(const std::string& input, const Parse& parse) {
+  double best = std::numeric_limits<double>::max();
+  for (int round = 0; round < 3; round++) {
+    size_t runs = 0;
+    const Clock::time_point start = Clock::now();
+    Clock::duration elapsed;
+    do {
+      sink += parse(input);
+      runs++;
+      elapsed = Clock::now() - start;
+    } while (elapsed < std::chrono::milliseconds(2));
+    best = std::min(
+        best, std::chrono::duration<double, std::nano>(elapsed).count() /
+                  runs / input.size());
+  }
+  return best;
+}
+
+// Returns true if |parse| takes about as long per byte on the input |make|
+// makes for |size| as on the one for 8 times |size|, and within
+// kMaxNanosPerByte on both.
+template <typename Make, typename Parse>
+bool IsLinear(const char* name,
+              size_t size,
+              const Make& make,
+              const Parse& parse) {
+  const std::string small = make(size);
+  const std::string large = make(size * 8);
+  const double small_cost = NanosPerByte(small, parse);
+  const double large_cost = NanosPerByte(large, parse);
+  if (large_cost > kMaxGrowth * small_cost || small_cost > kMaxNanosPerByte ||
+      large_cost > kMaxNanosPerByte) {
+    fprintf(stderr, "%s: %.2f ns/byte for %zu bytes, %.2f for %zu\n", name,
+            small_cost, small.size(), large_cost, large.size());
+    return false;
+  }
+  return true;
+}
+
+size_t ParseLeaf(const std::string& cert) {
+  std::string sct_list;
+  ct::SignedEntryData entry;
+  return ct::ExtractEmbeddedSCTList(cert, &sct_list) +
+         ct::GetPrecertSignedEntry(cert, cert, &entry);
+}
+
+size_t DecodeSCTs(const std::string& list) {
+  std::vector<std::string_view> scts;
+  if (!ct::DecodeSCTList(list, &scts)) {
+    return 0;
+  }
+  size_t decoded = 0;
+  for (std::string_view sct : scts) {
+    ct::SignedCertificateTimestamp decoded_sct;
+    decoded += ct::DecodeSignedCertificateTimestamp(&sct, &decoded_sct);
+  }
+  return decoded;
+}
+
+size_t CountElements(const std::string& input) {
+  ct::CBS cbs;
+  ct::CBS_init(&cbs, reinterpret_cast<const uint8_t*>(input.data()),
+               input.size());
+  size_t count = 0;
+  while (ct::CBS_get_any_asn1_element(&cbs, nullptr, nullptr, nullptr)) {
+    count++;
+  }
+  return count;
+}
+
+size_t CountBERElements(const std::string& input) {
+  ct::CBS cbs;
+  ct::CBS_init(&cbs, reinterpret_cast<const uint8_t*>(input.data()),
+               input.size());
+  size_t count = 0;
+  int ber_found, indefinite;
+  while (ct::CBS_get_any_ber_asn1_element(&cbs, nullptr, nullptr, nullptr,
+                                          &ber_found, &indefinite)) {
+    count++;
+  }
+  return count;
+}
+
+// Scans |bundle| in ranges of 4 KB, as threads would.
+size_t ScanInRanges(const std::string& bundle) {
+  ct::CertificateArena arena;
+  std::vector<ct::BundleChain> chains;
+  size_t malformed = 0;
+  for (const auto& range : ct::SplitBundle(bundle, 4096)) {
+    malformed +=
+        ct::ScanBundle(bundle, range.first, range.second, &arena, &chains);
+  }
+  return malformed + chains.size();
+}
+
+}  // namespace
+
+TEST(ParsersAreLinearInExtensions) {
+  const auto make = [](size_t count) {
+    return test::CertificateWithExtensions(count, test::SCTListWithSCTs(2));
+  };
+  EXPECT_EQ(ParseLeaf(make(8000)), 2u);
+  // The verifier's limit stops at the 65th extension.
+  ct::ExtensionLimit limit;
+  limit.max_extensions = 64;
+  std::string sct_list;
+  EXPECT_FALSE(ct::ExtractEmbeddedSCTList(make(8000), &limit, &sct_list));
+  EXPECT_TRUE(limit.exceeded);
+  EXPECT_TRUE(IsLinear("extensions", 1000, make, ParseLeaf));
+}
+
+TEST(ParsersAreLinearInNesting) {
+  const auto make = [](size_t depth) {
+    return test::CertificateWithNestedSubject(depth, test::SCTListWithSCTs(2));
+  };
+  EXPECT_EQ(ParseLeaf(make(8000)), 2u);
+  EXPECT_TRUE(IsLinear("nesting", 1000, make, ParseLeaf));
+}
+
+TEST(ParsersAreLinearInSCTs) {
+  EXPECT_EQ(DecodeSCTs(test::SCTListWithSCTs(1337)), 1337u);
+  EXPECT_TRUE(IsLinear("scts", 160, test::SCTListWithSCTs, DecodeSCTs));
+
+  const auto count_items = [](const std::string& list) {
+    std::vector<std::string_view> items;
+    return ct::DecodeSCTList(list, &items) ? items.size() : 0;
+  };
+  EXPECT_EQ(count_items(test::SCTListWithItems(21845)), 21845u);
+  EXPECT_TRUE(
+      IsLinear("sct items", 2500, test::SCTListWithItems, count_items));
+}
+
+TEST(ParsersAreLinearInElements) {
+  EXPECT_EQ(CountElements(test::ElementRun(1000)), 1000u);
+  EXPECT_TRUE(IsLinear("elements", 500, test::ElementRun, CountElements));
+  EXPECT_EQ(CountBERElements(test::IndefiniteLengthRun(1000)), 1000u);
+  EXPECT_TRUE(IsLinear("indefinite lengths", 5000, test::IndefiniteLengthRun,
+                       CountBERElements));
+}
+
+TEST(ParsersAreLinearInPEM) {
+  // Each block without an END marker ends at the next BEGIN marker.
+  EXPECT_EQ(ScanInRanges(test::PEMWithMarkers(1000)), 1000u);
+  EXPECT_TRUE(
+      IsLinear("pem markers", 1000, test::PEMWithMarkers, ScanInRanges));
+  // The ranges inside a large block skip it rather than each decoding it.
+  EXPECT_EQ(ScanInRanges(test::PEMWithGiantBlock(1 << 20)), 1u);
+  EXPECT_TRUE(IsLinear("pem block", 1 << 18, test::PEMWithGiantBlock,
+                       ScanInRanges));
+}
@@ -0,0 +1,83 @@
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "log_list_updater.h"
+#include "multi_log_verifier.h"
+#include "prewarm.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "updater_fakes.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+TEST(BuiltinLogVerifierIsBuiltOnce) {
+  std::vector<const ct::MultiLogVerifier*> verifiers(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < verifiers.size(); i++) {
+    threads.emplace_back(
+        [&, i] { verifiers[i] = &ct::GetBuiltinLogVerifier(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto* verifier : verifiers) {
+    EXPECT_TRUE(verifier == verifiers.front());
+  }
+  EXPECT_TRUE(verifiers.front()->Verify(test::ValidTimestampsLeaf(),
+                                        test::SubRootCA(), 1700000000000));
+}
+
+namespace {
+
+std::shared_ptr<ct::LogListUpdater> MakeUpdater() {
+  auto state = std::make_shared<ct::LogListState>();
+  state->logs.emplace();
+  return ct::LogListUpdater::Create(
+      std::make_unique<test::FakeTransport>(),
+      std::make_shared<test::FakeClock>(0),
+      std::make_unique<test::MemoryStorage>(state));
+}
+
+// Runs PrewarmInBackground() and |during| meanwhile, then waits for the
+// prewarm to finish.
+template <typename F>
+void Prewarm(std::shared_ptr<ct::LogListUpdater> updater, F&& during) {
+  std::mutex lock;
+  std::condition_variable done;
+  bool finished = false;
+  ct::PrewarmInBackground(std::move(updater), [&] {
+    std::lock_guard guard(lock);
+    finished = true;
+    done.notify_all();
+  });
+  during();
+  std::unique_lock guard(lock);
+  done.wait(guard, [&] { return finished; });
+}
+
+}  // namespace
+
+TEST(PrewarmBuildsUpdaterVerifier) {
+  auto updater = MakeUpdater();
+  EXPECT_EQ(updater->verifier_builds(), 0u);
+  Prewarm(updater, [] {});
+  // Built by the prewarm thread, and not again by the first verification.
+  EXPECT_EQ(updater->verifier_builds(), 1u);
+  auto verifier = updater->GetVerifier();
+  EXPECT_EQ(updater->verifier_builds(), 1u);
+  EXPECT_TRUE(verifier->Verify(test::NoTimestampsLeaf(), test::SubRootCA(), 0));
+}
+
+TEST(PrewarmIsNotRepeatedByRacingVerification) {
+  auto updater = MakeUpdater();
+  std::shared_ptr<const ct::MultiLogVerifier> verifier;
+  Prewarm(updater, [&] { verifier = updater->GetVerifier(); });
+  // Whichever came first built the verifier, and the other got it.
+  EXPECT_EQ(updater->verifier_builds(), 1u);
+  EXPECT_TRUE(updater->GetVerifier() == verifier);
+}
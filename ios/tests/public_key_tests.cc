@@ -0,0 +1,48 @@
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "log_verifier.h"
+#include "public_key.h"
+#include "test_harness.h"
+#include "test_keys_data.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+TEST(RSAKeysVerify) {
+  const std::pair<std::string_view, std::string_view> keys[] = {
+      {test::RSA2048Key(), test::RSA2048Signature()},
+      {test::RSA4096Key(), test::RSA4096Signature()},
+  };
+  for (const auto& [spki, signature] : keys) {
+    ct::PublicKey key = ct::PublicKey::Parse(spki);
+    EXPECT_TRUE(key.IsValid());
+    EXPECT_EQ(key.type(), ct::PublicKey::kRSA);
+    EXPECT_TRUE(key.VerifySignature(test::SignedMessage(), signature));
+
+    std::string tampered(signature);
+    tampered[tampered.size() / 2] ^= 1;
+    EXPECT_FALSE(key.VerifySignature(test::SignedMessage(), tampered));
+    EXPECT_FALSE(key.VerifySignature(test::SignedMessage(),
+                                     signature.substr(1)));
+    EXPECT_FALSE(key.VerifySignature(test::SignedMessage().substr(1),
+                                     signature));
+  }
+}
+
+TEST(RSAKeysAreLogs) {
+  EXPECT_TRUE(ct::LogVerifier(test::RSA2048Key()).IsValid());
+  EXPECT_TRUE(ct::LogVerifier(test::RSA4096Key()).IsValid());
+}
+
+TEST(TruncatedRSAKeyIsInvalid) {
+  std::string_view spki = test::RSA2048Key();
+  EXPECT_FALSE(ct::PublicKey::Parse(spki.substr(0, spki.size() - 1)).IsValid());
+}
+
+TEST(SignatureOfOtherKeyFails) {
+  ct::PublicKey key = ct::PublicKey::Parse(test::RSA4096Key());
+  EXPECT_FALSE(key.VerifySignature(test::SignedMessage(),
+                                   test::RSA2048Signature()));
+}
@@ -0,0 +1,158 @@
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ct_objects_extractor.h"
+#include "multi_log_verifier.h"
+#include "revocation_index.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+std::array<uint8_t, 32> IssuerKeyHash(uint8_t fill) {
+  std::array<uint8_t, 32> hash;
+  hash.fill(fill);
+  return hash;
+}
+
+// Serial numbers in sequence share all but their last bytes.
+std::string Serial(uint32_t number) {
+  return std::string{'\x01', static_cast<char>(number >> 24),
+                     static_cast<char>(number >> 16),
+                     static_cast<char>(number >> 8),
+                     static_cast<char>(number)};
+}
+
+// Three issuers revoking the even serial numbers below 2 * |count| each,
+// plus a duplicate and a few of other lengths.
+std::vector<ct::RevokedCertificate> SomeRevokedCertificates(uint32_t count) {
+  std::vector<ct::RevokedCertificate> revoked;
+  for (uint8_t issuer = 1; issuer <= 3; issuer++) {
+    for (uint32_t i = 0; i < count; i++) {
+      revoked.push_back({IssuerKeyHash(issuer), Serial(2 * i)});
+    }
+  }
+  revoked.push_back({IssuerKeyHash(1), Serial(0)});
+  revoked.push_back({IssuerKeyHash(1), std::string(1, '\x05')});
+  revoked.push_back({IssuerKeyHash(1), std::string(20, '\x7f')});
+  revoked.push_back({IssuerKeyHash(1), std::string("\x00\x80", 2)});
+  return revoked;
+}
+
+bool ChecksAll(const ct::RevocationIndex& index,
+               const std::vector<ct::RevokedCertificate>& revoked) {
+  for (const auto& cert : revoked) {
+    if (!index.IsRevoked(cert.issuer_key_hash, cert.serial)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(RevocationIndexFindsRevokedSerials) {
+  const auto revoked = SomeRevokedCertificates(100);
+  auto data = ct::RevocationIndex::Build(revoked);
+  EXPECT_TRUE(data);
+  auto index = ct::RevocationIndex::Parse(*data);
+  EXPECT_TRUE(index);
+  EXPECT_EQ(index->size(), 303u);
+  EXPECT_TRUE(ChecksAll(*index, revoked));
+
+  // Neighbours, other issuers, prefixes and extensions are not revoked.
+  size_t found = 0;
+  for (uint32_t i = 0; i < 100; i++) {
+    found += index->IsRevoked(IssuerKeyHash(1), Serial(2 * i + 1));
+  }
+  EXPECT_EQ(found, 0u);
+  EXPECT_FALSE(index->IsRevoked(IssuerKeyHash(1), Serial(200)));
+  EXPECT_FALSE(index->IsRevoked(IssuerKeyHash(4), Serial(0)));
+  EXPECT_FALSE(index->IsRevoked(IssuerKeyHash(2), std::string(1, '\x05')));
+  EXPECT_FALSE(index->IsRevoked(IssuerKeyHash(1), Serial(2).substr(0, 4)));
+  EXPECT_FALSE(index->IsRevoked(IssuerKeyHash(1), Serial(2) + '\0'));
+  EXPECT_FALSE(index->IsRevoked(IssuerKeyHash(1), std::string_view()));
+
+  // An empty index is well-formed and revokes nothing.
+  auto empty = ct::RevocationIndex::Parse(*ct::RevocationIndex::Build({}));
+  EXPECT_TRUE(empty);
+  EXPECT_EQ(empty->size(), 0u);
+  EXPECT_FALSE(empty->IsRevoked(IssuerKeyHash(1), Serial(0)));
+
+  EXPECT_FALSE(ct::RevocationIndex::Build({{IssuerKeyHash(1), ""}}));
+  EXPECT_FALSE(
+      ct::RevocationIndex::Build({{IssuerKeyHash(1), std::string(256, 'x')}}));
+}
+
+TEST(RevocationIndexChecksChains) {
+  std::string_view serial;
+  std::array<uint8_t, 32> issuer_key_hash;
+  EXPECT_TRUE(ct::ExtractSerialNumber(test::ValidTimestampsLeaf(), &serial));
+  EXPECT_TRUE(ct::GetIssuerKeyHash(test::SubRootCA(), &issuer_key_hash));
+  auto index = ct::RevocationIndex::Parse(
+      *ct::RevocationIndex::Build({{issuer_key_hash, std::string(serial)}}));
+  EXPECT_TRUE(index);
+
+  EXPECT_TRUE(index->IsRevoked(test::ValidTimestampsLeaf(), test::SubRootCA()));
+  // The same serial number from another issuer is another certificate.
+  EXPECT_FALSE(index->IsRevoked(test::ValidTimestampsLeaf(), test::RootCA()));
+  EXPECT_FALSE(index->IsRevoked(test::SubRootCA(), test::RootCA()));
+  EXPECT_FALSE(index->IsRevoked("not a certificate", test::SubRootCA()));
+
+  // A prepared chain's entry has its issuer key hash and serial number.
+  ct::PreparedChain prepared;
+  ct::PrepareChain(test::ValidTimestampsLeaf(), test::SubRootCA(), {},
+                   &prepared);
+  EXPECT_TRUE(prepared.valid);
+  EXPECT_TRUE(index->IsRevoked(prepared.entry));
+}
+
+TEST(RevocationIndexRejectsMalformedData) {
+  const auto revoked = SomeRevokedCertificates(20);
+  const std::string data = *ct::RevocationIndex::Build(revoked);
+  EXPECT_FALSE(ct::RevocationIndex::Parse(""));
+  EXPECT_FALSE(ct::RevocationIndex::Parse(data + '\0'));
+  size_t parsed = 0;
+  for (size_t size = 0; size < data.size(); size++) {
+    parsed += ct::RevocationIndex::Parse(data.substr(0, size)) != nullptr;
+  }
+  EXPECT_EQ(parsed, 0u);
+
+  // Damage that the tables don't show is caught by lookups, which must stay
+  // within the index.
+  for (size_t i = 0; i < data.size(); i++) {
+    std::string damaged = data;
+    damaged[i] ^= 0x5a;
+    if (auto index = ct::RevocationIndex::Parse(damaged)) {
+      ChecksAll(*index, revoked);
+    }
+  }
+}
+
+TEST(RevocationIndexMapsFiles) {
+  const auto revoked = SomeRevokedCertificates(1000);
+  const std::string data = *ct::RevocationIndex::Build(revoked);
+  char path[] = "/tmp/revocation_index_XXXXXX";
+  const int fd = mkstemp(path);
+  EXPECT_EQ(write(fd, data.data(), data.size()),
+            static_cast<ssize_t>(data.size()));
+  close(fd);
+
+  auto index = ct::RevocationIndex::Open(path);
+  EXPECT_TRUE(index);
+  EXPECT_EQ(index->size(), 3003u);
+  EXPECT_TRUE(ChecksAll(*index, revoked));
+  EXPECT_FALSE(index->IsRevoked(IssuerKeyHash(3), Serial(1)));
+  unlink(path);
+
+  EXPECT_FALSE(ct::RevocationIndex::Open(path));
+}
@@ -0,0 +1,35 @@
+#include <string>
+
+#include "root_index.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+TEST(RootIndexFindsAddedCerts) {
+  ct::RootIndex index;
+  EXPECT_FALSE(index.Contains(test::SubRootCA()));
+
+  index.Add(test::SubRootCA());
+  index.Add(test::SubRootCA());
+  EXPECT_EQ(index.size(), 1u);
+  EXPECT_TRUE(index.Contains(test::SubRootCA()));
+  EXPECT_FALSE(index.Contains(test::ValidTimestampsLeaf()));
+
+  // Only exact encodings match.
+  std::string truncated(test::SubRootCA());
+  truncated.pop_back();
+  EXPECT_FALSE(index.Contains(truncated));
+}
+
+TEST(RootIndexScalesToManyRoots) {
+  ct::RootIndex index;
+  for (int i = 0; i < 1000; i++) {
+    index.Add("root " + std::to_string(i));
+  }
+  EXPECT_EQ(index.size(), 1000u);
+  EXPECT_TRUE(index.Contains("root 0"));
+  EXPECT_TRUE(index.Contains("root 999"));
+  EXPECT_FALSE(index.Contains("root 1000"));
+}
@@ -0,0 +1,148 @@
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "log_verifier.h"
+#include "multi_log_verifier.h"
+#include "signature_scheduler.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+// The builtin log that issued the first SCT of |chain|.
+ct::LogVerifier LogOfFirstSCT(const ct::PreparedChain& chain) {
+  for (const std::string& key : ct::GetBuiltinLogs()) {
+    ct::LogVerifier log(key);
+    if (log.key_id() == chain.scts[0].log_id) {
+      return log;
+    }
+  }
+  return ct::LogVerifier("");
+}
+
+}  // namespace
+
+TEST(SignatureSchedulerKeepsVerdicts) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  auto scheduler =
+      std::make_shared<ct::SignatureScheduler>(ct::SignatureScheduler::Options{
+          /*worker_threads=*/2, /*max_batch_size=*/4, /*batch_window_us=*/0});
+  verifier.SetSignatureScheduler(scheduler);
+  EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                              kFarFuture));
+  EXPECT_FALSE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                               0));
+  EXPECT_FALSE(verifier.Verify(test::NoTimestampsLeaf(), test::SubRootCA(),
+                               kFarFuture));
+  const auto details = verifier.VerifyDetailed(
+      test::ValidTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+  EXPECT_TRUE(details.verified);
+  // Only the first verification and this one reached the signatures.
+  EXPECT_EQ(scheduler->stats().checks, 2u * details.signature_checks);
+}
+
+TEST(SignatureSchedulerRunsFullBatchesEarly) {
+  ct::PreparedChain chain;
+  ct::PrepareChain(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                   ct::VerificationLimits(), &chain);
+  const ct::LogVerifier log = LogOfFirstSCT(chain);
+  EXPECT_TRUE(log.IsValid());
+
+  // A window far longer than the test: only a full batch can run.
+  ct::SignatureScheduler scheduler({/*worker_threads=*/1,
+                                    /*max_batch_size=*/4,
+                                    /*batch_window_us=*/60'000'000});
+  std::atomic<int> valid{0};
+  std::atomic<int> called{0};
+  for (int i = 0; i < 4; i++) {
+    scheduler.Submit(log, chain.entry, chain.scts[0], [&](bool result) {
+      valid += result;
+      called++;
+    });
+  }
+  while (called < 4) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(valid.load(), 4);
+  const auto stats = scheduler.stats();
+  EXPECT_EQ(stats.checks, 4u);
+  EXPECT_EQ(stats.batches, 1u);
+  EXPECT_EQ(stats.full_batches, 1u);
+}
+
+TEST(SignatureSchedulerChecksChainInOneBatch) {
+  ct::PreparedChain chain;
+  ct::PrepareChain(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                   ct::VerificationLimits(), &chain);
+  // A window far longer than the test: the verification only finishes if
+  // the SCTs of the chain fill one batch together.
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  auto scheduler =
+      std::make_shared<ct::SignatureScheduler>(ct::SignatureScheduler::Options{
+          /*worker_threads=*/1, /*max_batch_size=*/chain.scts.size(),
+          /*batch_window_us=*/60'000'000});
+  verifier.SetSignatureScheduler(scheduler);
+  const auto details = verifier.VerifyDetailed(chain, kFarFuture);
+  EXPECT_TRUE(details.verified);
+  EXPECT_EQ(details.signature_checks, chain.scts.size());
+  const auto stats = scheduler->stats();
+  EXPECT_EQ(stats.checks, chain.scts.size());
+  EXPECT_EQ(stats.batches, 1u);
+  EXPECT_EQ(stats.full_batches, 1u);
+}
+
+TEST(SignatureSchedulerRunsQueuedChecksWhenDestroyed) {
+  ct::PreparedChain chain;
+  ct::PrepareChain(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                   ct::VerificationLimits(), &chain);
+  const ct::LogVerifier log = LogOfFirstSCT(chain);
+  int valid = 0;
+  {
+    ct::SignatureScheduler scheduler({/*worker_threads=*/1,
+                                      /*max_batch_size=*/100,
+                                      /*batch_window_us=*/60'000'000});
+    for (int i = 0; i < 3; i++) {
+      scheduler.Submit(log, chain.entry, chain.scts[0],
+                       [&valid](bool result) { valid += result; });
+    }
+  }
+  EXPECT_EQ(valid, 3);
+}
+
+TEST(SignatureSchedulerBatchesConcurrentVerifications) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  auto scheduler =
+      std::make_shared<ct::SignatureScheduler>(ct::SignatureScheduler::Options{
+          /*worker_threads=*/2, /*max_batch_size=*/8,
+          /*batch_window_us=*/200});
+  verifier.SetSignatureScheduler(scheduler);
+  constexpr int kThreads = 8;
+  constexpr int kIterations = 5;
+  std::atomic<int> verified{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < kIterations; i++) {
+        verified += verifier.Verify(test::ValidTimestampsLeaf(),
+                                    test::SubRootCA(), kFarFuture);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(verified.load(), kThreads * kIterations);
+  const auto stats = scheduler->stats();
+  EXPECT_TRUE(stats.batches > 0);
+  EXPECT_TRUE(stats.batches <= stats.checks);
+}
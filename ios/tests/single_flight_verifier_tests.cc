@@ -0,0 +1,164 @@
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "multi_log_verifier.h"
+#include "single_flight_verifier.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+// Queues tasks until the test runs them.
+class ManualExecutor {
+ public:
+  ct::SingleFlightVerifier::Executor executor() {
+    return [this](ct::SingleFlightVerifier::Task task) {
+      tasks_.push_back(std::move(task));
+    };
+  }
+
+  size_t pending() const { return tasks_.size(); }
+
+  void RunAll() {
+    std::vector<ct::SingleFlightVerifier::Task> tasks;
+    tasks.swap(tasks_);
+    for (auto& task : tasks) {
+      task();
+    }
+  }
+
+ private:
+  std::vector<ct::SingleFlightVerifier::Task> tasks_;
+};
+
+}  // namespace
+
+TEST(SingleFlightVerifiesChain) {
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  ct::SingleFlightVerifier single_flight(
+      [&verifier](std::string_view leaf, std::string_view issuer,
+                  uint64_t now) { return verifier.Verify(leaf, issuer, now); });
+  EXPECT_TRUE(single_flight.Verify(test::ValidTimestampsLeaf(),
+                                   test::SubRootCA(), kFarFuture));
+  EXPECT_FALSE(single_flight.Verify(test::NoTimestampsLeaf(),
+                                    test::SubRootCA(), kFarFuture));
+  EXPECT_EQ(single_flight.coalesced_count(), 0u);
+}
+
+TEST(SingleFlightCoalescesAsyncRequests) {
+  int runs = 0;
+  ct::SingleFlightVerifier single_flight(
+      [&runs](std::string_view leaf, std::string_view, uint64_t) {
+        runs++;
+        return leaf == "good";
+      });
+
+  ManualExecutor executor;
+  int verified = 0;
+  int rejected = 0;
+  auto callback = [&](bool result) { result ? verified++ : rejected++; };
+  for (int i = 0; i < 3; i++) {
+    single_flight.VerifyAsync("good", "issuer", 0, executor.executor(),
+                              callback);
+  }
+  single_flight.VerifyAsync("bad", "issuer", 0, executor.executor(),
+                            callback);
+  // The issuer is part of the key too.
+  single_flight.VerifyAsync("good", "other issuer", 0, executor.executor(),
+                            callback);
+  EXPECT_EQ(executor.pending(), 3u);
+  EXPECT_EQ(single_flight.coalesced_count(), 2u);
+
+  executor.RunAll();
+  EXPECT_EQ(runs, 3);
+  EXPECT_EQ(verified, 4);
+  EXPECT_EQ(rejected, 1);
+
+  // Verdicts are not cached after the flight lands.
+  single_flight.VerifyAsync("good", "issuer", 0, executor.executor(),
+                            callback);
+  EXPECT_EQ(executor.pending(), 1u);
+  executor.RunAll();
+  EXPECT_EQ(runs, 4);
+}
+
+TEST(SingleFlightCoalescesBlockingRequests) {
+  std::mutex lock;
+  std::condition_variable cv;
+  bool started = false;
+  bool release = false;
+  std::atomic<int> runs {0};
+  ct::SingleFlightVerifier single_flight(
+      [&](std::string_view, std::string_view, uint64_t) {
+        runs++;
+        std::unique_lock guard(lock);
+        started = true;
+        cv.notify_all();
+        cv.wait(guard, [&] { return release; });
+        return true;
+      });
+
+  std::atomic<int> verified {0};
+  std::thread first([&] {
+    verified += single_flight.Verify("leaf", "issuer", 0);
+  });
+  {
+    std::unique_lock guard(lock);
+    cv.wait(guard, [&] { return started; });
+  }
+
+  std::vector<std::thread> others;
+  for (int i = 0; i < 4; i++) {
+    others.emplace_back([&] {
+      verified += single_flight.Verify("leaf", "issuer", 0);
+    });
+  }
+  while (single_flight.coalesced_count() < others.size()) {
+    std::this_thread::yield();
+  }
+  {
+    std::lock_guard guard(lock);
+    release = true;
+  }
+  cv.notify_all();
+
+  first.join();
+  for (auto& thread : others) {
+    thread.join();
+  }
+  EXPECT_EQ(runs.load(), 1);
+  EXPECT_EQ(verified.load(), 5);
+}
+
+TEST(SingleFlightRunsGivenVerification) {
+  int runs = 0;
+  ct::SingleFlightVerifier single_flight(
+      [&runs](std::string_view, std::string_view, uint64_t) {
+        runs++;
+        return true;
+      });
+  const auto chain =
+      ct::GetChainDigest(test::ValidTimestampsLeaf(), test::SubRootCA());
+  EXPECT_FALSE(single_flight.Verify(chain, [] { return false; }));
+  EXPECT_TRUE(single_flight.Verify(test::ValidTimestampsLeaf(),
+                                   test::SubRootCA(), kFarFuture));
+  EXPECT_EQ(runs, 1);
+}
+
+TEST(SingleFlightWithoutVerifyFunction) {
+  ct::SingleFlightVerifier single_flight;
+  const auto chain =
+      ct::GetChainDigest(test::ValidTimestampsLeaf(), test::SubRootCA());
+  EXPECT_TRUE(single_flight.Verify(chain, [] { return true; }));
+  EXPECT_EQ(single_flight.coalesced_count(), 0u);
+}
@@ -0,0 +1,631 @@
+#include "test_certs_data.h"
+
+namespace certificate_transparency {
+namespace test {
+namespace {
+
+const unsigned char kRootCA[] = {
+    0x30, 0x82, 0x05, 0xc2, 0x30, 0x82, 0x03, 0xaa, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x02, 0x10, 0x00, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48,
+    0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x70, 0x31, 0x0b,
+    0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x52, 0x55, 0x31,
+    0x3f, 0x30, 0x3d, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x36, 0x54, 0x68,
+    0x65, 0x20, 0x4d, 0x69, 0x6e, 0x69, 0x73, 0x74, 0x72, 0x79, 0x20, 0x6f,
+    0x66, 0x20, 0x44, 0x69, 0x67, 0x69, 0x74, 0x61, 0x6c, 0x20, 0x44, 0x65,
+    0x76, 0x65, 0x6c, 0x6f, 0x70, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x61, 0x6e,
+    0x64, 0x20, 0x43, 0x6f, 0x6d, 0x6d, 0x75, 0x6e, 0x69, 0x63, 0x61, 0x74,
+    0x69, 0x6f, 0x6e, 0x73, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04,
+    0x03, 0x0c, 0x17, 0x52, 0x75, 0x73, 0x73, 0x69, 0x61, 0x6e, 0x20, 0x54,
+    0x72, 0x75, 0x73, 0x74, 0x65, 0x64, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20,
+    0x43, 0x41, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x32, 0x30, 0x33, 0x30, 0x31,
+    0x32, 0x31, 0x30, 0x34, 0x31, 0x35, 0x5a, 0x17, 0x0d, 0x33, 0x32, 0x30,
+    0x32, 0x32, 0x37, 0x32, 0x31, 0x30, 0x34, 0x31, 0x35, 0x5a, 0x30, 0x70,
+    0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x52,
+    0x55, 0x31, 0x3f, 0x30, 0x3d, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x36,
+    0x54, 0x68, 0x65, 0x20, 0x4d, 0x69, 0x6e, 0x69, 0x73, 0x74, 0x72, 0x79,
+    0x20, 0x6f, 0x66, 0x20, 0x44, 0x69, 0x67, 0x69, 0x74, 0x61, 0x6c, 0x20,
+    0x44, 0x65, 0x76, 0x65, 0x6c, 0x6f, 0x70, 0x6d, 0x65, 0x6e, 0x74, 0x20,
+    0x61, 0x6e, 0x64, 0x20, 0x43, 0x6f, 0x6d, 0x6d, 0x75, 0x6e, 0x69, 0x63,
+    0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03,
+    0x55, 0x04, 0x03, 0x0c, 0x17, 0x52, 0x75, 0x73, 0x73, 0x69, 0x61, 0x6e,
+    0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x65, 0x64, 0x20, 0x52, 0x6f, 0x6f,
+    0x74, 0x20, 0x43, 0x41, 0x30, 0x82, 0x02, 0x22, 0x30, 0x0d, 0x06, 0x09,
+    0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03,
+    0x82, 0x02, 0x0f, 0x00, 0x30, 0x82, 0x02, 0x0a, 0x02, 0x82, 0x02, 0x01,
+    0x00, 0xc7, 0xc5, 0x39, 0x9f, 0x29, 0x50, 0x02, 0xf7, 0xfa, 0xbd, 0xa7,
+    0xaa, 0xa1, 0x34, 0x66, 0x9e, 0x76, 0xb1, 0xe9, 0x57, 0xb0, 0xa1, 0x85,
+    0x62, 0x81, 0xb4, 0x18, 0xce, 0x5b, 0xc3, 0x3d, 0x5b, 0x48, 0x5b, 0x42,
+    0xb7, 0xe0, 0x19, 0x40, 0xc8, 0x64, 0x59, 0x08, 0x5e, 0x23, 0x7a, 0x68,
+    0x64, 0x04, 0xe8, 0x60, 0x9b, 0xba, 0xf6, 0x91, 0xcb, 0x29, 0x2e, 0x90,
+    0x5c, 0x18, 0xb0, 0x04, 0x2d, 0x5c, 0xbf, 0x36, 0x26, 0x51, 0x82, 0x8c,
+    0x61, 0x90, 0xbb, 0x8c, 0x4e, 0x58, 0x84, 0x45, 0x36, 0x6d, 0x22, 0xf4,
+    0x99, 0x7e, 0xcd, 0x68, 0xcc, 0x4c, 0x0e, 0x61, 0xf6, 0xfc, 0xdc, 0x2e,
+    0x39, 0x54, 0x63, 0xf0, 0xe2, 0x26, 0x55, 0xae, 0x6c, 0xd4, 0x5e, 0x14,
+    0xce, 0x7e, 0x0a, 0xbf, 0x73, 0xc5, 0x94, 0x30, 0x63, 0x8d, 0x28, 0xd7,
+    0x29, 0x56, 0x3d, 0x92, 0x68, 0xd4, 0x06, 0xc5, 0xd0, 0xac, 0x81, 0xde,
+    0x6a, 0xa9, 0x94, 0x22, 0xc3, 0xc8, 0x94, 0xd5, 0x94, 0x9e, 0x29, 0x97,
+    0x4b, 0x42, 0x34, 0x69, 0xb1, 0x31, 0xaa, 0x46, 0xdd, 0xad, 0x76, 0xd7,
+    0x63, 0x00, 0x8e, 0x5e, 0x13, 0x8e, 0xda, 0x90, 0xd4, 0xc7, 0x77, 0x24,
+    0x98, 0x99, 0x42, 0x31, 0x41, 0x9a, 0x71, 0x44, 0xe7, 0xca, 0x5c, 0x90,
+    0x5b, 0x65, 0x6c, 0x24, 0x8c, 0x88, 0x18, 0x0f, 0x15, 0xd3, 0x1c, 0xdd,
+    0x69, 0xe5, 0x17, 0x83, 0x45, 0x59, 0xe9, 0x99, 0x8d, 0x52, 0xbe, 0x58,
+    0x05, 0xea, 0xff, 0x10, 0x03, 0x8b, 0x3d, 0xbf, 0x0d, 0x62, 0x9b, 0x00,
+    0x84, 0x97, 0xb6, 0x99, 0x78, 0xcc, 0x07, 0xf2, 0x7d, 0x1c, 0xdb, 0x28,
+    0x14, 0xc0, 0x45, 0x27, 0x49, 0x4b, 0x39, 0x3f, 0xfe, 0x75, 0x0b, 0xe3,
+    0x6d, 0xd4, 0x59, 0xa0, 0xe4, 0xfc, 0x7a, 0xa2, 0x69, 0x5a, 0x75, 0x43,
+    0x53, 0xe4, 0x0b, 0xfe, 0xa1, 0x19, 0x9f, 0x3e, 0x7b, 0x37, 0xcf, 0x0e,
+    0x58, 0xcd, 0xeb, 0x69, 0xb2, 0x64, 0x44, 0xd7, 0x54, 0xfd, 0x9e, 0xf1,
+    0xe5, 0x21, 0x48, 0x33, 0xd1, 0x6b, 0xaa, 0xd3, 0x7c, 0xc5, 0xec, 0x2c,
+    0x88, 0x15, 0x81, 0x23, 0x42, 0xba, 0x5c, 0x5b, 0x8e, 0x04, 0xe4, 0xc3,
+    0xe1, 0x5d, 0x3c, 0xa3, 0x84, 0xf3, 0x27, 0xcf, 0x82, 0x72, 0xae, 0x57,
+    0x94, 0x25, 0x16, 0xd8, 0xbe, 0x3c, 0xa5, 0x93, 0x42, 0x62, 0xe0, 0x43,
+    0x7c, 0x18, 0x7b, 0x17, 0x19, 0x01, 0xee, 0xa0, 0xe0, 0x18, 0x38, 0x9a,
+    0x7e, 0xd1, 0x24, 0x65, 0x97, 0xc0, 0xa5, 0x18, 0x36, 0x13, 0xe3, 0x3d,
+    0x1b, 0xcc, 0x24, 0x34, 0xa4, 0xcf, 0x2c, 0x37, 0x38, 0xc0, 0x7d, 0x05,
+    0x0d, 0x38, 0xa3, 0x86, 0x0c, 0x51, 0xdd, 0x8e, 0x0f, 0x89, 0x2d, 0x47,
+    0x2f, 0x66, 0x61, 0xc3, 0xb6, 0xc3, 0xdc, 0x26, 0xec, 0x96, 0x61, 0x06,
+    0x81, 0xf9, 0xe7, 0x66, 0x88, 0xcd, 0x90, 0x9b, 0x5c, 0x2d, 0xe0, 0x47,
+    0x04, 0xb6, 0xb9, 0xdb, 0xf7, 0x52, 0xc0, 0xd5, 0x38, 0x59, 0x62, 0xee,
+    0x6d, 0xa6, 0x12, 0x88, 0x09, 0x80, 0xf4, 0x85, 0x0c, 0x5f, 0x5f, 0xd1,
+    0xa5, 0xfa, 0x71, 0x3b, 0x17, 0x78, 0x62, 0x49, 0xa1, 0xcf, 0xde, 0xe8,
+    0x15, 0xb5, 0x1a, 0x0c, 0x91, 0x62, 0xa4, 0x88, 0x20, 0xc7, 0x9b, 0x17,
+    0x78, 0xf0, 0x25, 0x91, 0x37, 0x56, 0x9e, 0xff, 0x91, 0x58, 0x1c, 0x65,
+    0x27, 0x03, 0x10, 0xdb, 0x9a, 0x04, 0x1e, 0x64, 0x60, 0xb8, 0xd6, 0x1f,
+    0xe1, 0x9a, 0xff, 0x47, 0x1a, 0xfd, 0x71, 0x2f, 0x77, 0x63, 0xe9, 0x9d,
+    0x5c, 0x86, 0x5a, 0x04, 0x41, 0x34, 0x29, 0x2d, 0xa2, 0x2d, 0x1a, 0x9a,
+    0x3a, 0x25, 0x81, 0x92, 0x2f, 0x48, 0x31, 0x05, 0x38, 0xa6, 0x1a, 0x8f,
+    0x38, 0x10, 0x1a, 0x1b, 0xb0, 0x3e, 0x78, 0xff, 0x0f, 0x02, 0x03, 0x01,
+    0x00, 0x01, 0xa3, 0x66, 0x30, 0x64, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d,
+    0x0e, 0x04, 0x16, 0x04, 0x14, 0xe1, 0xd1, 0x81, 0xe5, 0xce, 0x5a, 0x5f,
+    0x04, 0xaa, 0xd2, 0xe9, 0xb6, 0x9d, 0x66, 0xb1, 0xc5, 0xfa, 0xac, 0x2c,
+    0x87, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16,
+    0x80, 0x14, 0xe1, 0xd1, 0x81, 0xe5, 0xce, 0x5a, 0x5f, 0x04, 0xaa, 0xd2,
+    0xe9, 0xb6, 0x9d, 0x66, 0xb1, 0xc5, 0xfa, 0xac, 0x2c, 0x87, 0x30, 0x12,
+    0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x08, 0x30, 0x06,
+    0x01, 0x01, 0xff, 0x02, 0x01, 0x04, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d,
+    0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x86, 0x30, 0x0d,
+    0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05,
+    0x00, 0x03, 0x82, 0x02, 0x01, 0x00, 0x00, 0xb2, 0x18, 0xd7, 0x09, 0x22,
+    0x96, 0xdf, 0xee, 0xad, 0xf1, 0x15, 0x33, 0x9b, 0xca, 0xce, 0xbe, 0xae,
+    0xb4, 0xe7, 0x83, 0x58, 0x25, 0x1c, 0xce, 0x65, 0x97, 0xfd, 0x15, 0xf8,
+    0x96, 0x3a, 0x51, 0x76, 0x01, 0x7e, 0xe5, 0xf0, 0x08, 0x4b, 0x8b, 0xc7,
+    0xb6, 0x65, 0xe4, 0xaa, 0x94, 0x82, 0x39, 0x57, 0x96, 0x52, 0xb2, 0x55,
+    0xf5, 0x0b, 0xd9, 0x9f, 0xa2, 0xf6, 0xdb, 0xb6, 0x70, 0xb8, 0x4d, 0x79,
+    0x71, 0x68, 0xbc, 0x0c, 0x20, 0xda, 0x97, 0x75, 0x1e, 0xf7, 0x45, 0xa0,
+    0x00, 0x92, 0x59, 0x31, 0xf4, 0xec, 0x84, 0xde, 0x0e, 0x23, 0xc7, 0x2a,
+    0x5b, 0xd1, 0x38, 0x10, 0x6f, 0x70, 0x82, 0x56, 0xc4, 0xb4, 0xc9, 0xce,
+    0x6c, 0x79, 0x66, 0xb3, 0xc1, 0x77, 0x08, 0x79, 0xab, 0xc3, 0x79, 0x3a,
+    0x2a, 0x65, 0x24, 0x58, 0x6a, 0x1a, 0xfb, 0xf1, 0x0d, 0x99, 0xc5, 0x65,
+    0xeb, 0xcb, 0xbf, 0x70, 0xc4, 0x65, 0xd4, 0x96, 0xd6, 0xd9, 0xb3, 0x3e,
+    0xff, 0x70, 0x3e, 0x48, 0x08, 0x36, 0x73, 0xa8, 0x8f, 0x0e, 0x57, 0xa1,
+    0x73, 0x32, 0xb1, 0xda, 0x86, 0xbd, 0xe5, 0x05, 0xb4, 0x4a, 0x43, 0xcf,
+    0x58, 0x6b, 0x8d, 0x03, 0xf0, 0x84, 0xf0, 0x2a, 0x72, 0x00, 0xd2, 0x21,
+    0xbb, 0xd5, 0xc5, 0xae, 0x3d, 0xd1, 0x43, 0x71, 0x2a, 0x79, 0x17, 0x12,
+    0x01, 0x04, 0x28, 0x77, 0x54, 0x4d, 0xb8, 0x7a, 0x5f, 0x11, 0x32, 0xd4,
+    0xfc, 0x0d, 0xa0, 0x32, 0x6b, 0xe7, 0xff, 0x0f, 0xec, 0xc7, 0xb4, 0xc1,
+    0xdd, 0x6e, 0x41, 0x3e, 0xce, 0xab, 0xa6, 0xb3, 0x80, 0xdf, 0xbb, 0x6e,
+    0xb4, 0xfa, 0xbd, 0xbb, 0xa1, 0x53, 0x64, 0xe7, 0x06, 0xd4, 0xea, 0xa3,
+    0x0b, 0xf0, 0x7b, 0xc9, 0x3a, 0xa0, 0x23, 0xba, 0xdb, 0xca, 0xfa, 0x31,
+    0xec, 0x31, 0x17, 0xa1, 0x7e, 0xeb, 0x22, 0x21, 0x2a, 0xc8, 0xd3, 0x54,
+    0x82, 0xe4, 0xe4, 0xfe, 0xed, 0xd2, 0x67, 0x85, 0x57, 0x13, 0x69, 0x26,
+    0xc5, 0xd9, 0x92, 0x87, 0x74, 0xd0, 0xbf, 0x26, 0xdf, 0x6e, 0x75, 0xd5,
+    0xe0, 0x96, 0xc2, 0x65, 0x56, 0xaa, 0x89, 0x9a, 0xda, 0xa9, 0xce, 0xe8,
+    0x64, 0xc9, 0xd1, 0xa1, 0x6a, 0xd7, 0x44, 0x6d, 0xf3, 0xb5, 0xb9, 0xdb,
+    0x7a, 0xcf, 0xfd, 0xaa, 0x14, 0x46, 0x23, 0xb3, 0xea, 0x5e, 0xa7, 0x8a,
+    0x24, 0x1c, 0xed, 0xc5, 0x14, 0xc4, 0x56, 0x3f, 0x0e, 0x36, 0xcd, 0x5d,
+    0x58, 0xde, 0x6c, 0xcd, 0x3c, 0x1a, 0x3c, 0x8b, 0xe1, 0x92, 0x13, 0xb7,
+    0x08, 0xee, 0x44, 0xad, 0x4d, 0xab, 0x55, 0xd5, 0x2b, 0xf3, 0xdc, 0x0a,
+    0xa4, 0xd5, 0xdb, 0x04, 0xe0, 0xc5, 0x29, 0x1b, 0x60, 0xc5, 0x44, 0xfb,
+    0xd1, 0x8a, 0x66, 0x27, 0x8e, 0x95, 0x55, 0xaa, 0x9d, 0x02, 0x13, 0x99,
+    0x0f, 0xd1, 0x14, 0x52, 0x7e, 0x18, 0x69, 0xe2, 0xda, 0x4b, 0xc0, 0x23,
+    0x48, 0x5f, 0xe1, 0xed, 0x49, 0x23, 0x3a, 0x26, 0xcd, 0x73, 0x8a, 0x95,
+    0x0e, 0x23, 0xcf, 0xfa, 0xb9, 0x1e, 0x84, 0x55, 0x8c, 0xeb, 0xa3, 0xd5,
+    0x9c, 0xfd, 0x4c, 0xb2, 0x1f, 0x77, 0xb5, 0xcf, 0xad, 0x68, 0x87, 0xc2,
+    0x11, 0x85, 0x4c, 0xc6, 0x38, 0x7c, 0xcc, 0xd6, 0xc5, 0xba, 0x87, 0x3b,
+    0x7f, 0x3b, 0xef, 0xac, 0x52, 0x0b, 0x2d, 0xee, 0xe2, 0x7e, 0xf1, 0x08,
+    0x52, 0xa4, 0x95, 0x20, 0x2f, 0xc0, 0xce, 0x99, 0x4c, 0xfc, 0x9c, 0x70,
+    0xed, 0xbb, 0x97, 0x15, 0xe1, 0x8f, 0xd6, 0xa5, 0x42, 0x04, 0x41, 0xea,
+    0xdf, 0xdd, 0x5d, 0xff, 0xd4, 0x40, 0x7d, 0xa6, 0x75, 0xdb, 0x39, 0x30,
+    0x16, 0xc9, 0x7e, 0x20, 0xac, 0x04, 0xfc, 0xe6, 0x71, 0x5b, 0xc0, 0x07,
+    0x6b, 0xd8, 0xb5, 0xa7, 0x81, 0x8e, 0xd1, 0x84, 0x8d, 0xb9, 0xcc, 0xf3,
+    0x12, 0x6e,
+};
+
+const unsigned char kSubRootCA[] = {
+    0x30, 0x82, 0x07, 0x42, 0x30, 0x82, 0x05, 0x2a, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x02, 0x10, 0x02, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48,
+    0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x70, 0x31, 0x0b,
+    0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x52, 0x55, 0x31,
+    0x3f, 0x30, 0x3d, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x36, 0x54, 0x68,
+    0x65, 0x20, 0x4d, 0x69, 0x6e, 0x69, 0x73, 0x74, 0x72, 0x79, 0x20, 0x6f,
+    0x66, 0x20, 0x44, 0x69, 0x67, 0x69, 0x74, 0x61, 0x6c, 0x20, 0x44, 0x65,
+    0x76, 0x65, 0x6c, 0x6f, 0x70, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x61, 0x6e,
+    0x64, 0x20, 0x43, 0x6f, 0x6d, 0x6d, 0x75, 0x6e, 0x69, 0x63, 0x61, 0x74,
+    0x69, 0x6f, 0x6e, 0x73, 0x31, 0x20, 0x30, 0x1e, 0x06, 0x03, 0x55, 0x04,
+    0x03, 0x0c, 0x17, 0x52, 0x75, 0x73, 0x73, 0x69, 0x61, 0x6e, 0x20, 0x54,
+    0x72, 0x75, 0x73, 0x74, 0x65, 0x64, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20,
+    0x43, 0x41, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x32, 0x30, 0x33, 0x30, 0x32,
+    0x31, 0x31, 0x32, 0x35, 0x31, 0x39, 0x5a, 0x17, 0x0d, 0x32, 0x37, 0x30,
+    0x33, 0x30, 0x36, 0x31, 0x31, 0x32, 0x35, 0x31, 0x39, 0x5a, 0x30, 0x6f,
+    0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x52,
+    0x55, 0x31, 0x3f, 0x30, 0x3d, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x36,
+    0x54, 0x68, 0x65, 0x20, 0x4d, 0x69, 0x6e, 0x69, 0x73, 0x74, 0x72, 0x79,
+    0x20, 0x6f, 0x66, 0x20, 0x44, 0x69, 0x67, 0x69, 0x74, 0x61, 0x6c, 0x20,
+    0x44, 0x65, 0x76, 0x65, 0x6c, 0x6f, 0x70, 0x6d, 0x65, 0x6e, 0x74, 0x20,
+    0x61, 0x6e, 0x64, 0x20, 0x43, 0x6f, 0x6d, 0x6d, 0x75, 0x6e, 0x69, 0x63,
+    0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x31, 0x1f, 0x30, 0x1d, 0x06, 0x03,
+    0x55, 0x04, 0x03, 0x0c, 0x16, 0x52, 0x75, 0x73, 0x73, 0x69, 0x61, 0x6e,
+    0x20, 0x54, 0x72, 0x75, 0x73, 0x74, 0x65, 0x64, 0x20, 0x53, 0x75, 0x62,
+    0x20, 0x43, 0x41, 0x30, 0x82, 0x02, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a,
+    0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82,
+    0x02, 0x0f, 0x00, 0x30, 0x82, 0x02, 0x0a, 0x02, 0x82, 0x02, 0x01, 0x00,
+    0xf5, 0x83, 0xea, 0x04, 0xa3, 0xa4, 0xd7, 0xd3, 0x45, 0xca, 0x6a, 0xc4,
+    0xc1, 0xe8, 0x73, 0xae, 0x10, 0x44, 0x81, 0x3d, 0x9a, 0xb4, 0xb7, 0xb3,
+    0xa5, 0xdb, 0x81, 0xdb, 0x89, 0x90, 0xec, 0x28, 0x8e, 0x6b, 0xf1, 0xd5,
+    0xa4, 0x50, 0x83, 0x45, 0x9c, 0xdd, 0xc6, 0xa9, 0x61, 0xf1, 0xda, 0xe4,
+    0xbb, 0x8d, 0x3c, 0xfe, 0xd4, 0xe6, 0x5b, 0x39, 0x4d, 0x1f, 0xf6, 0xeb,
+    0x1e, 0xe4, 0x21, 0x67, 0xf9, 0xa2, 0x58, 0xa3, 0x9f, 0xdf, 0x99, 0x69,
+    0x2b, 0x38, 0xf2, 0x05, 0xde, 0x93, 0x3c, 0xcd, 0xb7, 0xb8, 0x07, 0xc9,
+    0xbc, 0x43, 0x90, 0xdb, 0xf7, 0x67, 0x28, 0x61, 0x89, 0x6e, 0xc5, 0x28,
+    0xd7, 0xfb, 0x9d, 0x29, 0x2b, 0xf1, 0x43, 0x05, 0x47, 0xa5, 0x5b, 0xf7,
+    0x4b, 0xcd, 0x0e, 0x96, 0x5b, 0x8a, 0x7e, 0x15, 0x8f, 0x0c, 0x45, 0xd0,
+    0xa6, 0x0c, 0x85, 0xa8, 0x8c, 0xcf, 0xa3, 0x12, 0x10, 0x4c, 0xb6, 0x74,
+    0x75, 0xe8, 0xab, 0x67, 0x03, 0x15, 0x1d, 0xaa, 0xd9, 0xe6, 0xef, 0x07,
+    0xa8, 0x77, 0xad, 0x46, 0xe0, 0x2d, 0x98, 0xed, 0x99, 0x0c, 0x64, 0x27,
+    0xbd, 0x53, 0x89, 0x60, 0x08, 0xe5, 0xb3, 0xe1, 0xe2, 0xb9, 0xea, 0xbb,
+    0x2e, 0x3e, 0xce, 0x71, 0xee, 0xc2, 0x42, 0xc4, 0xf0, 0x55, 0x97, 0x8f,
+    0xf9, 0x74, 0x31, 0xdb, 0xc3, 0xc0, 0x68, 0x46, 0x77, 0xcb, 0xab, 0x10,
+    0x12, 0xde, 0xab, 0x2f, 0x4e, 0x9d, 0x76, 0x94, 0x9d, 0xa1, 0x33, 0x29,
+    0x06, 0x70, 0xaa, 0x4d, 0xbc, 0x56, 0xf9, 0xe5, 0x8c, 0xca, 0x39, 0x08,
+    0x9f, 0xab, 0x7d, 0x18, 0x1b, 0x54, 0x57, 0x8e, 0x72, 0x07, 0x51, 0x24,
+    0x1c, 0xd9, 0xe3, 0xd8, 0x4c, 0x78, 0x1b, 0x00, 0xa2, 0x37, 0xd4, 0xfc,
+    0xe1, 0x04, 0x23, 0x29, 0x2a, 0xfe, 0xf1, 0xfd, 0x29, 0xb0, 0x6a, 0xd9,
+    0xbc, 0xf6, 0xc2, 0x6d, 0x00, 0x30, 0x34, 0x52, 0x63, 0x8a, 0xc2, 0xe2,
+    0xc6, 0x78, 0xe5, 0x18, 0xf2, 0xca, 0x6b, 0x9b, 0xce, 0x98, 0xdc, 0x08,
+    0x87, 0xf2, 0xc0, 0xc9, 0x45, 0xb9, 0x0e, 0x3a, 0x64, 0x0b, 0x1d, 0x34,
+    0xe0, 0xb3, 0xc3, 0xba, 0xa3, 0xe9, 0x16, 0xc2, 0x97, 0x34, 0xaa, 0x5a,
+    0x2f, 0x60, 0xe6, 0xea, 0xe7, 0x34, 0xc7, 0x82, 0x68, 0xe6, 0x6f, 0xa0,
+    0x51, 0x35, 0x4e, 0x44, 0x1e, 0xa1, 0x39, 0x2c, 0xd6, 0x9d, 0x60, 0xe3,
+    0xd8, 0x65, 0x9f, 0xa2, 0x62, 0xf3, 0xcf, 0x28, 0xc6, 0xf3, 0x50, 0xd1,
+    0x18, 0x50, 0x69, 0x72, 0x8f, 0xce, 0xf7, 0x7c, 0xde, 0x72, 0xc2, 0x0d,
+    0xdd, 0x22, 0xf6, 0x62, 0xc8, 0xe9, 0xab, 0x5c, 0xdd, 0xa1, 0x2d, 0x35,
+    0x08, 0xc6, 0x31, 0x89, 0xef, 0xff, 0xf7, 0x35, 0xaf, 0x63, 0x0c, 0xc8,
+    0xdb, 0x9f, 0xce, 0x66, 0x28, 0x2d, 0x9e, 0x90, 0x88, 0xad, 0xc7, 0x76,
+    0x8f, 0x56, 0x3a, 0x74, 0xc5, 0x05, 0x40, 0x0c, 0xc0, 0xb4, 0x71, 0x3e,
+    0xaa, 0xc5, 0xdf, 0x95, 0x22, 0xfc, 0x1c, 0x84, 0xbe, 0x20, 0x91, 0x05,
+    0x21, 0x0a, 0x1b, 0x2e, 0x56, 0x21, 0x1e, 0x4a, 0x04, 0xdd, 0xab, 0xe0,
+    0x37, 0x1e, 0x63, 0x96, 0xef, 0x8e, 0x2d, 0x87, 0xb4, 0x74, 0x5d, 0x18,
+    0x93, 0x1d, 0x4f, 0x18, 0xd8, 0xdb, 0xc2, 0xab, 0xd3, 0x5f, 0x7e, 0xd1,
+    0x0a, 0x7d, 0xf6, 0x34, 0xc8, 0xe5, 0xa2, 0xd5, 0xb6, 0x41, 0xc1, 0x84,
+    0x66, 0x10, 0xca, 0x8f, 0xed, 0xee, 0xad, 0x98, 0xb3, 0xa7, 0x9c, 0x5d,
+    0x4c, 0xf6, 0x62, 0xb4, 0x0f, 0x9a, 0x12, 0x36, 0x4c, 0xfc, 0xd8, 0xbb,
+    0xd5, 0x53, 0x9d, 0x88, 0xe3, 0xf4, 0x8a, 0x06, 0xf0, 0xe9, 0xab, 0x19,
+    0xd9, 0xfc, 0x5d, 0xa3, 0x36, 0x75, 0x4e, 0x74, 0x92, 0x60, 0xd6, 0x2f,
+    0x34, 0x04, 0xf0, 0xb6, 0x13, 0x66, 0x67, 0x2b, 0x02, 0x03, 0x01, 0x00,
+    0x01, 0xa3, 0x82, 0x01, 0xe5, 0x30, 0x82, 0x01, 0xe1, 0x30, 0x12, 0x06,
+    0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x08, 0x30, 0x06, 0x01,
+    0x01, 0xff, 0x02, 0x01, 0x00, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f,
+    0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x86, 0x30, 0x1d, 0x06,
+    0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0xd1, 0xe1, 0x71, 0x0d,
+    0x0b, 0x2d, 0x81, 0x4e, 0x6e, 0x8a, 0x4a, 0x8f, 0x4c, 0x23, 0xb3, 0x4c,
+    0x5e, 0xab, 0x69, 0x0b, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04,
+    0x18, 0x30, 0x16, 0x80, 0x14, 0xe1, 0xd1, 0x81, 0xe5, 0xce, 0x5a, 0x5f,
+    0x04, 0xaa, 0xd2, 0xe9, 0xb6, 0x9d, 0x66, 0xb1, 0xc5, 0xfa, 0xac, 0x2c,
+    0x87, 0x30, 0x81, 0xc7, 0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07,
+    0x01, 0x01, 0x04, 0x81, 0xba, 0x30, 0x81, 0xb7, 0x30, 0x3b, 0x06, 0x08,
+    0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02, 0x86, 0x2f, 0x68, 0x74,
+    0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x6f, 0x73, 0x74, 0x65, 0x6c, 0x65,
+    0x63, 0x6f, 0x6d, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70, 0x2f, 0x72,
+    0x6f, 0x6f, 0x74, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72, 0x73,
+    0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74, 0x30, 0x3b, 0x06,
+    0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02, 0x86, 0x2f, 0x68,
+    0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x63, 0x6f, 0x6d, 0x70, 0x61, 0x6e,
+    0x79, 0x2e, 0x72, 0x74, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70, 0x2f,
+    0x72, 0x6f, 0x6f, 0x74, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72,
+    0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74, 0x30, 0x3b,
+    0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02, 0x86, 0x2f,
+    0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x65, 0x65, 0x73, 0x74,
+    0x72, 0x2d, 0x70, 0x6b, 0x69, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70,
+    0x2f, 0x72, 0x6f, 0x6f, 0x74, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f,
+    0x72, 0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74, 0x30,
+    0x81, 0xb0, 0x06, 0x03, 0x55, 0x1d, 0x1f, 0x04, 0x81, 0xa8, 0x30, 0x81,
+    0xa5, 0x30, 0x35, 0xa0, 0x33, 0xa0, 0x31, 0x86, 0x2f, 0x68, 0x74, 0x74,
+    0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x6f, 0x73, 0x74, 0x65, 0x6c, 0x65, 0x63,
+    0x6f, 0x6d, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70, 0x2f, 0x72, 0x6f,
+    0x6f, 0x74, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72, 0x73, 0x61,
+    0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x6c, 0x30, 0x35, 0xa0, 0x33,
+    0xa0, 0x31, 0x86, 0x2f, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x63,
+    0x6f, 0x6d, 0x70, 0x61, 0x6e, 0x79, 0x2e, 0x72, 0x74, 0x2e, 0x72, 0x75,
+    0x2f, 0x63, 0x64, 0x70, 0x2f, 0x72, 0x6f, 0x6f, 0x74, 0x63, 0x61, 0x5f,
+    0x73, 0x73, 0x6c, 0x5f, 0x72, 0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e,
+    0x63, 0x72, 0x6c, 0x30, 0x35, 0xa0, 0x33, 0xa0, 0x31, 0x86, 0x2f, 0x68,
+    0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x65, 0x65, 0x73, 0x74, 0x72,
+    0x2d, 0x70, 0x6b, 0x69, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70, 0x2f,
+    0x72, 0x6f, 0x6f, 0x74, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72,
+    0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x6c, 0x30, 0x0d,
+    0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05,
+    0x00, 0x03, 0x82, 0x02, 0x01, 0x00, 0x44, 0x15, 0x73, 0x66, 0x5b, 0x3b,
+    0xf4, 0x07, 0x62, 0x48, 0x2a, 0x5a, 0xaf, 0x5e, 0x5d, 0x03, 0x91, 0xeb,
+    0xfe, 0xba, 0xd3, 0xe1, 0x66, 0xeb, 0x39, 0xfc, 0xe5, 0xa4, 0x8f, 0xb1,
+    0xac, 0xb7, 0x91, 0x3e, 0xb5, 0x06, 0xe9, 0xe5, 0x16, 0x21, 0x6e, 0x2f,
+    0x4a, 0xe8, 0xb5, 0xcb, 0x1d, 0xe2, 0xa8, 0x62, 0xc2, 0x8c, 0xf7, 0x0a,
+    0x6f, 0xe1, 0xce, 0x4f, 0x0a, 0x11, 0x31, 0xb2, 0x3a, 0xca, 0xd3, 0xff,
+    0x9d, 0xda, 0x77, 0x4e, 0x56, 0x2e, 0x6b, 0x66, 0x9d, 0xbd, 0x80, 0x44,
+    0x85, 0x2b, 0xe3, 0xb3, 0xee, 0x2f, 0x0d, 0x93, 0x70, 0x5e, 0xbf, 0xc3,
+    0x6a, 0x76, 0xf0, 0x21, 0x67, 0x6e, 0xad, 0x99, 0x95, 0x89, 0x04, 0x41,
+    0x0c, 0x57, 0x9b, 0xa6, 0x4b, 0xe7, 0x22, 0xfa, 0xee, 0xfd, 0x1a, 0x56,
+    0xb9, 0xdf, 0xf9, 0xaf, 0xad, 0xb8, 0x5a, 0x9f, 0x2f, 0xa1, 0x93, 0x11,
+    0xb6, 0x3f, 0xdc, 0x9b, 0xa6, 0x88, 0xf4, 0xbb, 0x6f, 0x05, 0xf4, 0xfd,
+    0x71, 0xfc, 0xe1, 0x39, 0xa7, 0xb1, 0x23, 0xff, 0x7d, 0x73, 0x5e, 0x1d,
+    0xca, 0x2b, 0xa4, 0xd7, 0xee, 0x90, 0x85, 0xdc, 0x0a, 0x68, 0x24, 0x53,
+    0x73, 0x59, 0x9d, 0x7c, 0xd4, 0x26, 0x9d, 0xf5, 0x8d, 0x45, 0xb7, 0xd6,
+    0x85, 0x60, 0x65, 0x2b, 0x78, 0x78, 0x18, 0x61, 0x3d, 0x24, 0xad, 0xf7,
+    0x1a, 0x4f, 0x19, 0x4b, 0xc0, 0xcc, 0xae, 0x47, 0x40, 0x87, 0x4c, 0x5b,
+    0xcb, 0x8c, 0x40, 0x43, 0xf9, 0x92, 0x58, 0x07, 0xd6, 0xac, 0x19, 0x9f,
+    0xce, 0x53, 0xaa, 0x1b, 0x2a, 0x01, 0xd5, 0x4e, 0x3b, 0x59, 0x33, 0x9e,
+    0xa8, 0xd6, 0xd6, 0x92, 0x4a, 0x00, 0x3f, 0x6c, 0xac, 0xf7, 0x8f, 0xac,
+    0x26, 0x0e, 0x0d, 0x4e, 0x48, 0x83, 0x56, 0xd5, 0xd1, 0x17, 0xa9, 0xeb,
+    0xe9, 0xf6, 0x22, 0xd1, 0xb4, 0x8e, 0xbc, 0xe1, 0x60, 0xd0, 0x84, 0x2b,
+    0x31, 0x73, 0xb6, 0x63, 0xc8, 0x32, 0x83, 0xd0, 0x11, 0x74, 0xf2, 0x70,
+    0x2a, 0xdb, 0xd6, 0x5f, 0xc5, 0x4f, 0x00, 0x30, 0x98, 0x32, 0x25, 0x87,
+    0x87, 0x89, 0xfc, 0x6d, 0x9a, 0x24, 0x22, 0xb2, 0x26, 0x54, 0xa2, 0xc3,
+    0x40, 0xa1, 0xd8, 0xe2, 0x30, 0xac, 0x34, 0x3d, 0x87, 0x1d, 0xd2, 0x5f,
+    0x9e, 0xb7, 0x4b, 0xd9, 0x82, 0x70, 0xd6, 0xa1, 0x6c, 0x90, 0xd3, 0xb8,
+    0x71, 0x23, 0x66, 0x67, 0x27, 0x70, 0xd1, 0x69, 0x20, 0x8e, 0xff, 0x64,
+    0x17, 0xe2, 0xb1, 0xaa, 0xb0, 0xca, 0x94, 0x1f, 0x0c, 0x66, 0xed, 0x87,
+    0x72, 0x5a, 0x61, 0xea, 0xff, 0xc2, 0x67, 0x47, 0xd0, 0xf5, 0x8b, 0x84,
+    0xf3, 0xf9, 0x6c, 0x1d, 0x9d, 0x10, 0x73, 0x61, 0xf2, 0x89, 0x23, 0x27,
+    0xbe, 0x38, 0x0a, 0xe5, 0xf0, 0xdc, 0xdd, 0x30, 0xf8, 0x7d, 0xaf, 0x05,
+    0x13, 0xc8, 0x0c, 0x36, 0xea, 0xcc, 0xfa, 0x45, 0x7c, 0x3d, 0x3f, 0x0b,
+    0x34, 0x83, 0x3e, 0xe1, 0x9b, 0x3e, 0x2c, 0xa1, 0x15, 0xf2, 0x7a, 0x91,
+    0x58, 0x16, 0xb1, 0x90, 0x85, 0x49, 0x19, 0xe9, 0x24, 0x54, 0xa3, 0xbc,
+    0xc4, 0x30, 0x4e, 0x1b, 0xf6, 0x8d, 0xeb, 0x60, 0x19, 0x28, 0x73, 0x9e,
+    0x19, 0xcc, 0x88, 0x76, 0xee, 0xf2, 0x34, 0xc3, 0x11, 0x8a, 0x11, 0x95,
+    0x64, 0x26, 0x2b, 0xf2, 0xb6, 0x22, 0x26, 0x82, 0xa2, 0x3b, 0x30, 0xea,
+    0x3a, 0x43, 0xe4, 0x2c, 0xe3, 0xdd, 0x86, 0xd5, 0x65, 0x82, 0x78, 0x68,
+    0xc3, 0x31, 0xc3, 0xc4, 0xc1, 0xcd, 0x0f, 0xf1, 0x36, 0x58, 0x0e, 0x69,
+    0x64, 0x7b, 0x8d, 0x33, 0xf9, 0xb4, 0x4d, 0x7b, 0x76, 0xc1, 0x34, 0xcf,
+    0x2f, 0xb2, 0x47, 0xd9, 0x80, 0xb4, 0x80, 0xfc, 0xff, 0x06, 0xfb, 0xd2,
+    0xce, 0x39, 0x2c, 0x83, 0x35, 0x39, 0xac, 0xb6, 0xd1, 0xc9, 0x42, 0x90,
+    0x92, 0x05,
+};
+
+const unsigned char kValidTimestamps[] = {
+    0x30, 0x82, 0x08, 0x04, 0x30, 0x82, 0x05, 0xec, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x0e, 0x01, 0x8a, 0x6a, 0xcd, 0x59, 0x46, 0x0a, 0xb2, 0xaf,
+    0xb3, 0xce, 0x29, 0xb0, 0xc7, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48,
+    0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x6f, 0x31, 0x0b,
+    0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x52, 0x55, 0x31,
+    0x3f, 0x30, 0x3d, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x36, 0x54, 0x68,
+    0x65, 0x20, 0x4d, 0x69, 0x6e, 0x69, 0x73, 0x74, 0x72, 0x79, 0x20, 0x6f,
+    0x66, 0x20, 0x44, 0x69, 0x67, 0x69, 0x74, 0x61, 0x6c, 0x20, 0x44, 0x65,
+    0x76, 0x65, 0x6c, 0x6f, 0x70, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x61, 0x6e,
+    0x64, 0x20, 0x43, 0x6f, 0x6d, 0x6d, 0x75, 0x6e, 0x69, 0x63, 0x61, 0x74,
+    0x69, 0x6f, 0x6e, 0x73, 0x31, 0x1f, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x04,
+    0x03, 0x0c, 0x16, 0x52, 0x75, 0x73, 0x73, 0x69, 0x61, 0x6e, 0x20, 0x54,
+    0x72, 0x75, 0x73, 0x74, 0x65, 0x64, 0x20, 0x53, 0x75, 0x62, 0x20, 0x43,
+    0x41, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x33, 0x30, 0x39, 0x30, 0x36, 0x31,
+    0x34, 0x30, 0x32, 0x33, 0x37, 0x5a, 0x17, 0x0d, 0x32, 0x34, 0x30, 0x39,
+    0x30, 0x35, 0x31, 0x34, 0x30, 0x32, 0x33, 0x37, 0x5a, 0x30, 0x6c, 0x31,
+    0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x52, 0x55,
+    0x31, 0x0f, 0x30, 0x0d, 0x06, 0x03, 0x55, 0x04, 0x08, 0x0c, 0x06, 0x4d,
+    0x6f, 0x73, 0x63, 0x6f, 0x77, 0x31, 0x0f, 0x30, 0x0d, 0x06, 0x03, 0x55,
+    0x04, 0x07, 0x0c, 0x06, 0x4d, 0x6f, 0x73, 0x63, 0x6f, 0x77, 0x31, 0x16,
+    0x30, 0x14, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x0d, 0x50, 0x4a, 0x53,
+    0x43, 0x20, 0x53, 0x62, 0x65, 0x72, 0x62, 0x61, 0x6e, 0x6b, 0x31, 0x0d,
+    0x30, 0x0b, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x04, 0x30, 0x30, 0x43,
+    0x41, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0b,
+    0x73, 0x62, 0x65, 0x72, 0x62, 0x61, 0x6e, 0x6b, 0x2e, 0x72, 0x75, 0x30,
+    0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7,
+    0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00, 0x30,
+    0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xb6, 0x83, 0x0f, 0x69,
+    0x0e, 0x61, 0xd6, 0xba, 0xab, 0xb4, 0xd8, 0xb5, 0xb0, 0xbd, 0x2c, 0xdc,
+    0xfb, 0x6b, 0x98, 0xa8, 0x3f, 0x5c, 0x30, 0x7e, 0xbe, 0xb0, 0xef, 0x6d,
+    0x58, 0x01, 0x7a, 0xd0, 0xe7, 0xcd, 0x16, 0x3e, 0x31, 0xf6, 0x98, 0x38,
+    0x66, 0x6c, 0xc9, 0x6c, 0xd3, 0x92, 0xe8, 0x10, 0xd8, 0x3d, 0x63, 0xbe,
+    0x71, 0xf4, 0x8d, 0x46, 0x13, 0x26, 0x83, 0x71, 0x35, 0x0e, 0xa2, 0x71,
+    0xa6, 0x51, 0x33, 0x8b, 0xa0, 0xde, 0x9a, 0xf2, 0x2a, 0x50, 0x16, 0xb4,
+    0xb8, 0x5c, 0x95, 0x71, 0xb7, 0x3f, 0xc2, 0xb3, 0x67, 0x8c, 0x06, 0x6e,
+    0x17, 0x63, 0x4f, 0x9b, 0x67, 0xa6, 0xf1, 0x2f, 0x43, 0xfd, 0x2a, 0x81,
+    0xa6, 0x30, 0xc6, 0x5b, 0x25, 0x16, 0xc3, 0x27, 0xc4, 0xf4, 0x3d, 0x7d,
+    0x7c, 0xca, 0x1a, 0xae, 0x7f, 0x65, 0x26, 0x44, 0xb9, 0xc1, 0xd3, 0x5f,
+    0x34, 0xec, 0x01, 0x38, 0x5a, 0x2c, 0xed, 0x81, 0x47, 0xc1, 0xd7, 0xb1,
+    0x8a, 0x6f, 0x83, 0xb0, 0x73, 0x80, 0xa9, 0x79, 0x61, 0xb6, 0x0c, 0x38,
+    0x8a, 0xe2, 0x4c, 0x42, 0x34, 0x95, 0xa6, 0xbe, 0x0e, 0xd1, 0x67, 0x91,
+    0x4d, 0x2c, 0xfb, 0xe5, 0xd5, 0x31, 0xe9, 0x29, 0x55, 0x16, 0x19, 0x09,
+    0x95, 0xc8, 0x77, 0x0b, 0x29, 0x46, 0xe2, 0xdc, 0x96, 0x92, 0xa3, 0x73,
+    0xe1, 0x73, 0xdd, 0xa9, 0x51, 0x27, 0x2d, 0x73, 0x0b, 0x7f, 0x89, 0x9d,
+    0x6a, 0x94, 0x98, 0x4a, 0x8c, 0xc8, 0xbb, 0x73, 0x40, 0x23, 0xfb, 0x8e,
+    0xff, 0xc2, 0x8b, 0x0f, 0xfc, 0x75, 0x07, 0x63, 0xbb, 0xdb, 0xb9, 0xe0,
+    0x80, 0x5d, 0xaf, 0x81, 0x19, 0x47, 0x21, 0x7e, 0xce, 0xfa, 0x58, 0xe6,
+    0xd4, 0x49, 0xf7, 0xe7, 0x77, 0x79, 0x2e, 0x4c, 0x1c, 0xeb, 0x21, 0xe9,
+    0x2f, 0xfa, 0x64, 0x60, 0x9d, 0xef, 0xc8, 0x1e, 0x8f, 0x60, 0xc0, 0x05,
+    0x02, 0x03, 0x01, 0x00, 0x01, 0xa3, 0x82, 0x03, 0x9f, 0x30, 0x82, 0x03,
+    0x9b, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14,
+    0xd6, 0x41, 0xa3, 0xdc, 0x8c, 0xba, 0x01, 0x92, 0xb9, 0x03, 0x58, 0xc9,
+    0x2b, 0x53, 0x05, 0x56, 0xd6, 0xe5, 0x97, 0xf3, 0x30, 0x1f, 0x06, 0x03,
+    0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0xd1, 0xe1, 0x71,
+    0x0d, 0x0b, 0x2d, 0x81, 0x4e, 0x6e, 0x8a, 0x4a, 0x8f, 0x4c, 0x23, 0xb3,
+    0x4c, 0x5e, 0xab, 0x69, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x1d, 0x13,
+    0x04, 0x02, 0x30, 0x00, 0x30, 0x0b, 0x06, 0x03, 0x55, 0x1d, 0x0f, 0x04,
+    0x04, 0x03, 0x02, 0x04, 0xf0, 0x30, 0x13, 0x06, 0x03, 0x55, 0x1d, 0x25,
+    0x04, 0x0c, 0x30, 0x0a, 0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07,
+    0x03, 0x01, 0x30, 0x3d, 0x06, 0x03, 0x55, 0x1d, 0x11, 0x04, 0x36, 0x30,
+    0x34, 0x82, 0x0b, 0x73, 0x62, 0x65, 0x72, 0x62, 0x61, 0x6e, 0x6b, 0x2e,
+    0x72, 0x75, 0x82, 0x0f, 0x77, 0x77, 0x77, 0x2e, 0x73, 0x62, 0x65, 0x72,
+    0x62, 0x61, 0x6e, 0x6b, 0x2e, 0x72, 0x75, 0x82, 0x07, 0x73, 0x62, 0x72,
+    0x66, 0x2e, 0x72, 0x75, 0x82, 0x0b, 0x77, 0x77, 0x77, 0x2e, 0x73, 0x62,
+    0x72, 0x66, 0x2e, 0x72, 0x75, 0x30, 0x81, 0xc4, 0x06, 0x08, 0x2b, 0x06,
+    0x01, 0x05, 0x05, 0x07, 0x01, 0x01, 0x04, 0x81, 0xb7, 0x30, 0x81, 0xb4,
+    0x30, 0x3a, 0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02,
+    0x86, 0x2e, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x6f, 0x73,
+    0x74, 0x65, 0x6c, 0x65, 0x63, 0x6f, 0x6d, 0x2e, 0x72, 0x75, 0x2f, 0x63,
+    0x64, 0x70, 0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c,
+    0x5f, 0x72, 0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74,
+    0x30, 0x3a, 0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02,
+    0x86, 0x2e, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x63, 0x6f, 0x6d,
+    0x70, 0x61, 0x6e, 0x79, 0x2e, 0x72, 0x74, 0x2e, 0x72, 0x75, 0x2f, 0x63,
+    0x64, 0x70, 0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c,
+    0x5f, 0x72, 0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74,
+    0x30, 0x3a, 0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02,
+    0x86, 0x2e, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x65, 0x65,
+    0x73, 0x74, 0x72, 0x2d, 0x70, 0x6b, 0x69, 0x2e, 0x72, 0x75, 0x2f, 0x63,
+    0x64, 0x70, 0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c,
+    0x5f, 0x72, 0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74,
+    0x30, 0x81, 0xa4, 0x06, 0x03, 0x55, 0x1d, 0x1f, 0x04, 0x81, 0x9c, 0x30,
+    0x81, 0x99, 0x30, 0x81, 0x96, 0xa0, 0x81, 0x93, 0xa0, 0x81, 0x90, 0x86,
+    0x2e, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x6f, 0x73, 0x74,
+    0x65, 0x6c, 0x65, 0x63, 0x6f, 0x6d, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64,
+    0x70, 0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f,
+    0x72, 0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x6c, 0x86,
+    0x2e, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x63, 0x6f, 0x6d, 0x70,
+    0x61, 0x6e, 0x79, 0x2e, 0x72, 0x74, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64,
+    0x70, 0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f,
+    0x72, 0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x6c, 0x86,
+    0x2e, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x65, 0x65, 0x73,
+    0x74, 0x72, 0x2d, 0x70, 0x6b, 0x69, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64,
+    0x70, 0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f,
+    0x72, 0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x6c, 0x30,
+    0x82, 0x01, 0x7d, 0x06, 0x0a, 0x2b, 0x06, 0x01, 0x04, 0x01, 0xd6, 0x79,
+    0x02, 0x04, 0x02, 0x04, 0x82, 0x01, 0x6d, 0x04, 0x82, 0x01, 0x69, 0x01,
+    0x67, 0x00, 0x75, 0x00, 0x4e, 0xba, 0xe5, 0x95, 0x27, 0x92, 0xd7, 0xe8,
+    0x27, 0xab, 0x8c, 0x70, 0x2f, 0x01, 0x9c, 0xdd, 0x63, 0x4f, 0x59, 0x29,
+    0xfc, 0x47, 0x48, 0x18, 0x8d, 0xd1, 0x2f, 0x5e, 0x9b, 0x01, 0x02, 0x63,
+    0x00, 0x00, 0x01, 0x8a, 0x6a, 0xcd, 0x5b, 0x9d, 0x00, 0x00, 0x04, 0x03,
+    0x00, 0x46, 0x30, 0x44, 0x02, 0x20, 0x43, 0xc5, 0x90, 0xc5, 0x03, 0x6e,
+    0xc5, 0xdf, 0xbe, 0xe3, 0xe3, 0x2e, 0xb0, 0x4b, 0x1f, 0x69, 0x16, 0x7c,
+    0x92, 0x25, 0xb6, 0x12, 0x8f, 0x98, 0x38, 0x7b, 0x74, 0x48, 0x00, 0xaf,
+    0xf6, 0x6b, 0x02, 0x20, 0x12, 0xd0, 0xdf, 0xf6, 0xce, 0x8b, 0x59, 0x9b,
+    0x61, 0x81, 0x35, 0x09, 0xbf, 0x94, 0x18, 0x09, 0x6c, 0xc9, 0x59, 0x40,
+    0xa1, 0xdf, 0xb1, 0x0a, 0xa6, 0x0f, 0xf8, 0x0d, 0xfe, 0xa2, 0x8b, 0x70,
+    0x00, 0x76, 0x00, 0x95, 0xb3, 0x72, 0x89, 0x20, 0x29, 0x94, 0xb4, 0x5a,
+    0x0c, 0x59, 0x24, 0x24, 0xa4, 0x59, 0x20, 0xfd, 0x14, 0xb1, 0x24, 0x67,
+    0xc4, 0x74, 0x8b, 0x67, 0x3a, 0x03, 0xe0, 0x12, 0x55, 0x33, 0xd7, 0x00,
+    0x00, 0x01, 0x8a, 0x6a, 0xcd, 0x5c, 0x3d, 0x00, 0x00, 0x04, 0x03, 0x00,
+    0x47, 0x30, 0x45, 0x02, 0x20, 0x4a, 0x1e, 0x33, 0x8e, 0x56, 0xe5, 0xae,
+    0x07, 0xe8, 0x48, 0xe3, 0xad, 0xfb, 0x65, 0x41, 0x57, 0x3c, 0x3e, 0x69,
+    0xdb, 0x48, 0x21, 0x45, 0x28, 0xa3, 0xc9, 0x0e, 0x26, 0x45, 0xa8, 0x9d,
+    0xad, 0x02, 0x21, 0x00, 0xb4, 0x84, 0xe8, 0x8e, 0xba, 0x6e, 0xcd, 0x2c,
+    0x03, 0xe4, 0xae, 0x35, 0x6b, 0xc5, 0x56, 0xfd, 0x3c, 0xdd, 0xaa, 0x31,
+    0x6f, 0xc0, 0xe5, 0x9e, 0x3d, 0x5d, 0x55, 0x1b, 0xd6, 0x9c, 0xf1, 0x80,
+    0x00, 0x76, 0x00, 0xac, 0x3c, 0x3f, 0x50, 0xe1, 0x37, 0x6b, 0xb6, 0x34,
+    0x74, 0x56, 0xdd, 0xf1, 0x3b, 0xb2, 0x91, 0xd9, 0xfe, 0xcc, 0x7b, 0x6d,
+    0xf2, 0xf1, 0x23, 0xba, 0x6f, 0xf2, 0xa8, 0xd4, 0xb9, 0xa2, 0x42, 0x00,
+    0x00, 0x01, 0x8a, 0x6a, 0xcd, 0x5c, 0xa8, 0x00, 0x00, 0x04, 0x03, 0x00,
+    0x47, 0x30, 0x45, 0x02, 0x21, 0x00, 0x94, 0x0d, 0x1e, 0x22, 0x2e, 0x7e,
+    0x0d, 0xc2, 0x0f, 0x1e, 0x15, 0x6b, 0xfd, 0x7f, 0xb6, 0x5f, 0x62, 0x1d,
+    0xf6, 0xc6, 0xbc, 0x15, 0x65, 0x33, 0x4c, 0x7e, 0xcd, 0xe5, 0xdc, 0x90,
+    0xa6, 0x42, 0x02, 0x20, 0x20, 0x6a, 0x03, 0x6b, 0x40, 0x60, 0x63, 0x82,
+    0x52, 0x6a, 0xf0, 0x08, 0xbf, 0x5c, 0x5f, 0xcb, 0x2d, 0x25, 0x53, 0x39,
+    0xea, 0x10, 0x78, 0x4c, 0x84, 0x5a, 0x8f, 0xa8, 0x01, 0xd2, 0x9b, 0x2f,
+    0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01,
+    0x0b, 0x05, 0x00, 0x03, 0x82, 0x02, 0x01, 0x00, 0x08, 0xd2, 0xc1, 0x31,
+    0xbe, 0x21, 0x6e, 0x42, 0x44, 0x3d, 0x65, 0x8a, 0x0b, 0xe1, 0x4f, 0x62,
+    0xba, 0x75, 0xc4, 0x3d, 0xf0, 0xa6, 0x64, 0x60, 0x72, 0x43, 0xab, 0x5c,
+    0xdc, 0xaa, 0xdb, 0xbb, 0xb6, 0x18, 0xdf, 0xd8, 0xe8, 0xf9, 0x3d, 0x65,
+    0x26, 0xfa, 0x56, 0xd4, 0xc0, 0x59, 0x16, 0xc8, 0x18, 0xa1, 0x43, 0x20,
+    0xfb, 0x8d, 0x07, 0x23, 0x3b, 0x7c, 0x4d, 0x44, 0x7b, 0x6c, 0xae, 0xc3,
+    0xb8, 0xc0, 0xeb, 0x67, 0xf0, 0x63, 0x15, 0xa2, 0x20, 0xd2, 0x63, 0x11,
+    0x78, 0x00, 0x6b, 0xb2, 0xb4, 0xce, 0x5e, 0xf0, 0x37, 0xe3, 0x91, 0xdf,
+    0x03, 0x2c, 0xd1, 0x06, 0xc6, 0xeb, 0xae, 0x17, 0x75, 0x52, 0x32, 0x86,
+    0x99, 0xd5, 0x68, 0xb2, 0xf0, 0xe0, 0xd9, 0x1d, 0x24, 0xb6, 0xe5, 0x4c,
+    0xac, 0x70, 0x7f, 0x1d, 0x5a, 0x40, 0xa6, 0x7f, 0x26, 0x4b, 0xc7, 0xd2,
+    0x62, 0xf2, 0x3b, 0x6c, 0xea, 0xcb, 0x7e, 0x66, 0x04, 0xa1, 0x4b, 0x91,
+    0xae, 0x7f, 0x18, 0x9e, 0xc4, 0xcc, 0x3e, 0xce, 0xa9, 0xf2, 0xab, 0x6f,
+    0x11, 0xf7, 0xc9, 0xe7, 0x14, 0xf8, 0x96, 0x89, 0xce, 0x04, 0x95, 0x4a,
+    0xde, 0x13, 0x34, 0xc2, 0x8a, 0x2a, 0x44, 0xb3, 0x41, 0xd9, 0x24, 0xc0,
+    0xf0, 0x97, 0x58, 0x73, 0xe4, 0x69, 0xc7, 0x4b, 0x57, 0x26, 0x72, 0x2d,
+    0xaa, 0x2c, 0xf6, 0x27, 0x6b, 0xe8, 0xea, 0xde, 0x4c, 0xd2, 0xd4, 0x0f,
+    0xe8, 0xba, 0xfc, 0x45, 0x2c, 0x11, 0xce, 0x67, 0x98, 0x17, 0xf7, 0x32,
+    0x82, 0x19, 0xf3, 0xe4, 0xae, 0x11, 0xf0, 0x28, 0x68, 0x17, 0x1d, 0x75,
+    0x7a, 0x37, 0x09, 0xa0, 0xb5, 0x60, 0x4a, 0x3a, 0xd5, 0x90, 0x0f, 0x25,
+    0xdf, 0xfa, 0x69, 0xc3, 0x12, 0xef, 0xd9, 0x1a, 0x84, 0x0f, 0x82, 0x29,
+    0xcf, 0x5f, 0x2f, 0xf8, 0x1f, 0x60, 0x7d, 0x79, 0x68, 0xbb, 0xd0, 0x39,
+    0xc6, 0x22, 0x1b, 0x26, 0x34, 0xda, 0x8a, 0x93, 0xec, 0x00, 0x0e, 0xd0,
+    0x2d, 0xc7, 0xc2, 0x6f, 0x30, 0xc5, 0xeb, 0xaf, 0xd7, 0x3d, 0x67, 0x5a,
+    0xdd, 0xf4, 0x22, 0xa9, 0x51, 0x72, 0x6e, 0x88, 0xdf, 0xe0, 0xf7, 0xff,
+    0x92, 0x40, 0xc3, 0xed, 0x94, 0xa4, 0x06, 0xb8, 0xe7, 0x53, 0x52, 0xef,
+    0xd8, 0x2d, 0x7a, 0xc6, 0x6e, 0x15, 0x24, 0x46, 0x6d, 0x4e, 0xbc, 0x89,
+    0xf0, 0xb1, 0x2c, 0x58, 0x18, 0xd2, 0x19, 0xa9, 0x83, 0x88, 0x4c, 0xb3,
+    0x3a, 0x20, 0xdb, 0xe7, 0xf6, 0xcf, 0xaf, 0xd7, 0x08, 0x23, 0x3f, 0x7d,
+    0xa5, 0x66, 0xc7, 0xe8, 0x31, 0x06, 0xaf, 0x37, 0x8d, 0xd6, 0x28, 0xd0,
+    0x9d, 0x2a, 0xce, 0x1d, 0x8c, 0x5d, 0x31, 0x46, 0x7e, 0x00, 0x1e, 0x93,
+    0x3f, 0xba, 0x0e, 0xa7, 0x3d, 0x2c, 0xb0, 0xbc, 0xc7, 0xc2, 0x46, 0x20,
+    0x0a, 0x2a, 0xca, 0xc6, 0xb8, 0x2b, 0x04, 0xb5, 0xf8, 0xd8, 0x88, 0xd1,
+    0xa1, 0x03, 0xe7, 0x74, 0xcd, 0x7b, 0xa2, 0xd4, 0x9b, 0x17, 0x7a, 0x37,
+    0x8c, 0x57, 0xbf, 0xd9, 0xf0, 0x82, 0x36, 0x7f, 0x1d, 0xe5, 0xd8, 0xac,
+    0xe6, 0xb6, 0x14, 0x8f, 0x17, 0xc9, 0xae, 0x16, 0xc7, 0x23, 0x43, 0xd3,
+    0xac, 0x10, 0x83, 0xae, 0x16, 0x89, 0x09, 0x0c, 0x42, 0x78, 0x76, 0xfb,
+    0x91, 0x49, 0x15, 0x1f, 0x00, 0x39, 0x57, 0x82, 0x3a, 0xcf, 0x7a, 0x77,
+    0xcd, 0xcc, 0x36, 0xeb, 0x31, 0x22, 0x4b, 0x0d, 0x30, 0x74, 0xd5, 0x67,
+    0xe0, 0x8a, 0x46, 0x0d, 0x78, 0x6d, 0x9b, 0x4f, 0xd8, 0xc6, 0xe7, 0x43,
+    0x8e, 0x27, 0xf6, 0xea, 0xde, 0xc6, 0xb5, 0xdf, 0xbc, 0x5e, 0xcd, 0xd1,
+    0x21, 0x38, 0x81, 0xbf, 0xba, 0x8a, 0xb1, 0x71, 0xe1, 0x38, 0x3e, 0xaa,
+    0xb0, 0x3b, 0x8a, 0xf7, 0x52, 0x7b, 0x4e, 0x04, 0xe4, 0x16, 0x3e, 0x83,
+    0x91, 0x88, 0x68, 0x0d,
+};
+
+const unsigned char kNoTimestamps[] = {
+    0x30, 0x82, 0x06, 0x7d, 0x30, 0x82, 0x04, 0x65, 0xa0, 0x03, 0x02, 0x01,
+    0x02, 0x02, 0x03, 0x11, 0x10, 0x04, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86,
+    0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x6f, 0x31,
+    0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x52, 0x55,
+    0x31, 0x3f, 0x30, 0x3d, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x36, 0x54,
+    0x68, 0x65, 0x20, 0x4d, 0x69, 0x6e, 0x69, 0x73, 0x74, 0x72, 0x79, 0x20,
+    0x6f, 0x66, 0x20, 0x44, 0x69, 0x67, 0x69, 0x74, 0x61, 0x6c, 0x20, 0x44,
+    0x65, 0x76, 0x65, 0x6c, 0x6f, 0x70, 0x6d, 0x65, 0x6e, 0x74, 0x20, 0x61,
+    0x6e, 0x64, 0x20, 0x43, 0x6f, 0x6d, 0x6d, 0x75, 0x6e, 0x69, 0x63, 0x61,
+    0x74, 0x69, 0x6f, 0x6e, 0x73, 0x31, 0x1f, 0x30, 0x1d, 0x06, 0x03, 0x55,
+    0x04, 0x03, 0x0c, 0x16, 0x52, 0x75, 0x73, 0x73, 0x69, 0x61, 0x6e, 0x20,
+    0x54, 0x72, 0x75, 0x73, 0x74, 0x65, 0x64, 0x20, 0x53, 0x75, 0x62, 0x20,
+    0x43, 0x41, 0x30, 0x1e, 0x17, 0x0d, 0x32, 0x32, 0x30, 0x33, 0x30, 0x34,
+    0x31, 0x34, 0x35, 0x39, 0x32, 0x31, 0x5a, 0x17, 0x0d, 0x32, 0x33, 0x30,
+    0x33, 0x30, 0x34, 0x31, 0x34, 0x35, 0x39, 0x32, 0x31, 0x5a, 0x30, 0x81,
+    0x8f, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02,
+    0x52, 0x55, 0x31, 0x17, 0x30, 0x15, 0x06, 0x03, 0x55, 0x04, 0x08, 0x13,
+    0x0e, 0x53, 0x74, 0x2e, 0x20, 0x50, 0x65, 0x74, 0x65, 0x72, 0x73, 0x62,
+    0x75, 0x72, 0x67, 0x31, 0x17, 0x30, 0x15, 0x06, 0x03, 0x55, 0x04, 0x07,
+    0x13, 0x0e, 0x53, 0x74, 0x2e, 0x20, 0x50, 0x65, 0x74, 0x65, 0x72, 0x73,
+    0x62, 0x75, 0x72, 0x67, 0x31, 0x18, 0x30, 0x16, 0x06, 0x03, 0x55, 0x04,
+    0x0a, 0x13, 0x0f, 0x56, 0x54, 0x42, 0x20, 0x42, 0x61, 0x6e, 0x6b, 0x20,
+    0x28, 0x50, 0x4a, 0x53, 0x43, 0x29, 0x31, 0x16, 0x30, 0x14, 0x06, 0x03,
+    0x55, 0x04, 0x0b, 0x13, 0x0d, 0x49, 0x54, 0x20, 0x44, 0x65, 0x70, 0x61,
+    0x72, 0x74, 0x6d, 0x65, 0x6e, 0x74, 0x31, 0x1c, 0x30, 0x1a, 0x06, 0x03,
+    0x55, 0x04, 0x03, 0x13, 0x13, 0x6f, 0x6e, 0x6c, 0x69, 0x6e, 0x65, 0x2d,
+    0x61, 0x6c, 0x70, 0x68, 0x61, 0x2e, 0x76, 0x74, 0x62, 0x2e, 0x72, 0x75,
+    0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+    0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00,
+    0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xcc, 0x33, 0x8a,
+    0xf7, 0xdc, 0xd8, 0xe2, 0xfc, 0x08, 0x35, 0xef, 0x1e, 0xfd, 0x17, 0x9e,
+    0x70, 0xcd, 0x39, 0xce, 0x1f, 0xc7, 0x79, 0xe2, 0x6a, 0x94, 0x84, 0xfe,
+    0xdb, 0x15, 0x97, 0x26, 0xeb, 0xa6, 0xd8, 0xc7, 0xab, 0x01, 0x1b, 0x88,
+    0x5e, 0x09, 0x70, 0x14, 0x2e, 0xd1, 0xce, 0xb5, 0x19, 0x28, 0xea, 0xab,
+    0x9b, 0xfe, 0xd5, 0x5e, 0xbd, 0x36, 0x5f, 0x5d, 0xb4, 0x4c, 0x38, 0x91,
+    0x62, 0xc9, 0xdc, 0x37, 0x36, 0xc2, 0xfc, 0x23, 0xa5, 0x2b, 0xe2, 0x56,
+    0xe2, 0x8b, 0xb4, 0x42, 0xa1, 0xa3, 0xf3, 0xef, 0x45, 0x92, 0x7a, 0x6b,
+    0x35, 0xc7, 0x6d, 0xb0, 0xe5, 0x65, 0x1c, 0x33, 0x30, 0x04, 0xa3, 0xb5,
+    0x38, 0xeb, 0x73, 0xf5, 0xc0, 0x5e, 0x0c, 0x1a, 0x3a, 0xb5, 0x05, 0x24,
+    0x6f, 0x2e, 0xa9, 0xc1, 0x01, 0xd4, 0x84, 0xf3, 0x27, 0x1d, 0x0a, 0x10,
+    0xc8, 0x9e, 0x92, 0x77, 0x0b, 0x59, 0x7d, 0x9f, 0x04, 0xe2, 0x39, 0x29,
+    0xfb, 0x05, 0xea, 0x09, 0x77, 0x6d, 0x2b, 0x37, 0x89, 0x01, 0xfb, 0xb2,
+    0x67, 0x43, 0xbb, 0x6d, 0xdc, 0xbb, 0xb2, 0xa9, 0xd5, 0xed, 0x47, 0x8d,
+    0x0c, 0xd6, 0xf0, 0xb4, 0x41, 0x6d, 0x52, 0xd2, 0x44, 0xe4, 0x1a, 0xb0,
+    0x20, 0xa5, 0xe0, 0x2f, 0xc2, 0xff, 0xbb, 0x87, 0xbe, 0x4a, 0x92, 0x60,
+    0xd9, 0x24, 0xbf, 0x18, 0x4d, 0x8c, 0x79, 0x55, 0x51, 0xfb, 0x2f, 0xeb,
+    0xcc, 0x2d, 0x8c, 0x26, 0xce, 0x4c, 0xa5, 0x0c, 0x03, 0x72, 0x1f, 0x65,
+    0x67, 0x3b, 0x21, 0x48, 0x06, 0x08, 0x6b, 0x6d, 0x89, 0x5d, 0x24, 0x1b,
+    0xb0, 0x4b, 0x89, 0x67, 0x42, 0xf6, 0xc8, 0xbb, 0x2f, 0x50, 0xda, 0x37,
+    0xb9, 0xd9, 0x4c, 0x2c, 0x9d, 0xf1, 0x4d, 0x50, 0xdb, 0x9b, 0x12, 0x02,
+    0xec, 0x8b, 0x18, 0xb0, 0x8a, 0x1c, 0xeb, 0x72, 0xa7, 0xdb, 0xee, 0xc2,
+    0xd1, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3, 0x82, 0x01, 0xff, 0x30, 0x82,
+    0x01, 0xfb, 0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04,
+    0x14, 0xc0, 0x80, 0x5b, 0x01, 0x38, 0x1d, 0x43, 0x69, 0x04, 0xdf, 0x93,
+    0x7c, 0x97, 0x8c, 0xd0, 0xb8, 0x67, 0x78, 0x24, 0x04, 0x30, 0x1f, 0x06,
+    0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0xd1, 0xe1,
+    0x71, 0x0d, 0x0b, 0x2d, 0x81, 0x4e, 0x6e, 0x8a, 0x4a, 0x8f, 0x4c, 0x23,
+    0xb3, 0x4c, 0x5e, 0xab, 0x69, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x1d,
+    0x13, 0x04, 0x02, 0x30, 0x00, 0x30, 0x0b, 0x06, 0x03, 0x55, 0x1d, 0x0f,
+    0x04, 0x04, 0x03, 0x02, 0x05, 0xa0, 0x30, 0x13, 0x06, 0x03, 0x55, 0x1d,
+    0x25, 0x04, 0x0c, 0x30, 0x0a, 0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05,
+    0x07, 0x03, 0x01, 0x30, 0x81, 0xc4, 0x06, 0x08, 0x2b, 0x06, 0x01, 0x05,
+    0x05, 0x07, 0x01, 0x01, 0x04, 0x81, 0xb7, 0x30, 0x81, 0xb4, 0x30, 0x3a,
+    0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02, 0x86, 0x2e,
+    0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x6f, 0x73, 0x74, 0x65,
+    0x6c, 0x65, 0x63, 0x6f, 0x6d, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70,
+    0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72,
+    0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74, 0x30, 0x3a,
+    0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02, 0x86, 0x2e,
+    0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x63, 0x6f, 0x6d, 0x70, 0x61,
+    0x6e, 0x79, 0x2e, 0x72, 0x74, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70,
+    0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72,
+    0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74, 0x30, 0x3a,
+    0x06, 0x08, 0x2b, 0x06, 0x01, 0x05, 0x05, 0x07, 0x30, 0x02, 0x86, 0x2e,
+    0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x65, 0x65, 0x73, 0x74,
+    0x72, 0x2d, 0x70, 0x6b, 0x69, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70,
+    0x2f, 0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72,
+    0x73, 0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x74, 0x30, 0x81,
+    0xa4, 0x06, 0x03, 0x55, 0x1d, 0x1f, 0x04, 0x81, 0x9c, 0x30, 0x81, 0x99,
+    0x30, 0x81, 0x96, 0xa0, 0x81, 0x93, 0xa0, 0x81, 0x90, 0x86, 0x2e, 0x68,
+    0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x6f, 0x73, 0x74, 0x65, 0x6c,
+    0x65, 0x63, 0x6f, 0x6d, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70, 0x2f,
+    0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72, 0x73,
+    0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x6c, 0x86, 0x2e, 0x68,
+    0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x63, 0x6f, 0x6d, 0x70, 0x61, 0x6e,
+    0x79, 0x2e, 0x72, 0x74, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70, 0x2f,
+    0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72, 0x73,
+    0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x6c, 0x86, 0x2e, 0x68,
+    0x74, 0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x72, 0x65, 0x65, 0x73, 0x74, 0x72,
+    0x2d, 0x70, 0x6b, 0x69, 0x2e, 0x72, 0x75, 0x2f, 0x63, 0x64, 0x70, 0x2f,
+    0x73, 0x75, 0x62, 0x63, 0x61, 0x5f, 0x73, 0x73, 0x6c, 0x5f, 0x72, 0x73,
+    0x61, 0x32, 0x30, 0x32, 0x32, 0x2e, 0x63, 0x72, 0x6c, 0x30, 0x1e, 0x06,
+    0x03, 0x55, 0x1d, 0x11, 0x04, 0x17, 0x30, 0x15, 0x82, 0x13, 0x6f, 0x6e,
+    0x6c, 0x69, 0x6e, 0x65, 0x2d, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x2e, 0x76,
+    0x74, 0x62, 0x2e, 0x72, 0x75, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48,
+    0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03, 0x82, 0x02, 0x01,
+    0x00, 0x2d, 0xaf, 0x3b, 0xed, 0x64, 0xe2, 0x68, 0x45, 0x16, 0x1b, 0x92,
+    0x67, 0xa0, 0x42, 0xbd, 0x5f, 0x9f, 0xc0, 0x9d, 0xbb, 0x38, 0x16, 0xee,
+    0xb6, 0xe1, 0xa2, 0xa1, 0xf5, 0x78, 0x31, 0x53, 0xcb, 0x70, 0xde, 0x6d,
+    0x8f, 0x70, 0xef, 0xd2, 0xe2, 0x9f, 0x6e, 0x29, 0x9c, 0xe4, 0x21, 0x93,
+    0x50, 0x48, 0x39, 0x92, 0x3c, 0x4d, 0x44, 0x4d, 0xa2, 0xbc, 0x7f, 0x1a,
+    0x85, 0xec, 0xd3, 0xe3, 0xb8, 0xd2, 0x07, 0xb0, 0xab, 0x18, 0xd5, 0x74,
+    0xdd, 0xe3, 0xe5, 0xda, 0x69, 0x98, 0xd2, 0x5d, 0xc6, 0x09, 0x00, 0x27,
+    0xc4, 0x45, 0x59, 0xdf, 0x92, 0xed, 0x77, 0xc3, 0x5f, 0x5e, 0x2a, 0x3a,
+    0xe9, 0xe7, 0x42, 0x47, 0x0c, 0x43, 0xa0, 0x19, 0xb7, 0xa9, 0xac, 0xf1,
+    0x3e, 0x97, 0x23, 0x36, 0x1b, 0x19, 0xed, 0x35, 0x76, 0xc3, 0xa9, 0x19,
+    0xd3, 0x40, 0x9d, 0x70, 0x5f, 0x82, 0xa4, 0x48, 0x69, 0x94, 0xde, 0x53,
+    0x9e, 0x15, 0x25, 0x40, 0x3c, 0xd7, 0x7c, 0x96, 0x81, 0x9e, 0xf1, 0xa6,
+    0x6d, 0xe9, 0x24, 0x01, 0x9c, 0x3d, 0x60, 0xac, 0x93, 0xad, 0x9e, 0xff,
+    0xf3, 0x26, 0x84, 0x1c, 0xf1, 0x95, 0x93, 0x36, 0x7f, 0x38, 0x3f, 0xb0,
+    0x52, 0x43, 0xcd, 0x74, 0x1d, 0xf5, 0xee, 0xcc, 0xbe, 0x39, 0xc1, 0x2e,
+    0x77, 0xdd, 0xef, 0x7a, 0x32, 0xb9, 0x16, 0x1f, 0x96, 0x13, 0x71, 0xad,
+    0x68, 0xbe, 0x16, 0x4c, 0xae, 0x6a, 0xae, 0xf9, 0x76, 0xff, 0x3c, 0xe1,
+    0x3d, 0xdb, 0x0e, 0xdb, 0x70, 0x18, 0xdd, 0x4b, 0xa6, 0xe1, 0xdf, 0xbb,
+    0xc0, 0xc2, 0x0e, 0xcd, 0xb8, 0xdd, 0x17, 0x10, 0x80, 0xd6, 0x11, 0xa7,
+    0xde, 0xfe, 0xe0, 0x4a, 0xac, 0x39, 0x14, 0x78, 0xed, 0xf7, 0x71, 0xb3,
+    0x1d, 0x8c, 0xe0, 0x65, 0xea, 0x68, 0x13, 0x97, 0x0f, 0x61, 0x47, 0x91,
+    0x17, 0x76, 0x57, 0xc0, 0x00, 0x84, 0x9e, 0x26, 0xbb, 0x0c, 0x6b, 0xad,
+    0x58, 0x80, 0xcb, 0x8b, 0x0c, 0xc9, 0xa4, 0x26, 0x63, 0xe9, 0x3c, 0xb5,
+    0x23, 0xe8, 0x4f, 0xe1, 0xe8, 0x4d, 0x2a, 0x26, 0xa9, 0x7c, 0x81, 0x3a,
+    0x32, 0x99, 0x2c, 0xc2, 0xd3, 0x1f, 0xc7, 0x82, 0x7f, 0xef, 0xd8, 0x88,
+    0x2e, 0xcc, 0x31, 0x0b, 0x4e, 0xb8, 0x7a, 0xa8, 0xa4, 0x63, 0xec, 0xfb,
+    0x54, 0xdc, 0xa1, 0x8a, 0x3b, 0xdf, 0x78, 0x83, 0x5a, 0xd0, 0xb8, 0x42,
+    0xb7, 0x66, 0x26, 0x2c, 0xc9, 0x2c, 0xc8, 0xf3, 0xbc, 0xc8, 0x8a, 0x71,
+    0x5e, 0xbd, 0x21, 0x5c, 0x10, 0x83, 0x79, 0xab, 0x38, 0xb5, 0xa4, 0xb6,
+    0x04, 0x07, 0x16, 0x16, 0xda, 0x5c, 0x04, 0xd7, 0xbb, 0x89, 0xd6, 0x49,
+    0xb9, 0xe7, 0x33, 0x7a, 0x26, 0x94, 0x56, 0xc5, 0x0d, 0x26, 0x47, 0x3b,
+    0xf5, 0x3f, 0x70, 0xdf, 0xbf, 0x47, 0x51, 0x4d, 0xd5, 0xb1, 0xc5, 0x7a,
+    0x60, 0x2e, 0x8c, 0x67, 0xa5, 0x52, 0x71, 0x20, 0x01, 0x4b, 0x30, 0x68,
+    0x5c, 0x9c, 0x21, 0xf1, 0xab, 0x8d, 0x7f, 0x63, 0xf6, 0x61, 0x73, 0x20,
+    0x99, 0xf5, 0x30, 0x2d, 0x09, 0x36, 0x86, 0xa8, 0xc9, 0x9a, 0x51, 0x95,
+    0x1d, 0xb9, 0xaf, 0xee, 0x0b, 0x06, 0x13, 0x8a, 0x7d, 0x43, 0x79, 0x57,
+    0x58, 0x27, 0x4e, 0xce, 0xf5, 0x30, 0x54, 0x9c, 0xf3, 0x77, 0xfa, 0x3e,
+    0xd5, 0x1b, 0x6a, 0x58, 0x30, 0x4f, 0xd8, 0x9f, 0xdb, 0x13, 0x2b, 0x23,
+    0xf9, 0x40, 0x37, 0x55, 0x55, 0xd5, 0x59, 0x2e, 0xfa, 0xc1, 0x3d, 0xa8,
+    0xad, 0x87, 0x8b, 0x52, 0xac, 0xda, 0xa7, 0xb3, 0x88, 0xf4, 0xdb, 0x8f,
+    0xcf, 0x8a, 0x2a, 0x54, 0xea, 0x90, 0x0f, 0x9d, 0x58, 0x59, 0xe2, 0x09,
+    0x4d, 0x17, 0x62, 0x3f, 0x44, 0xff, 0x75, 0x32, 0x65, 0x76, 0x12, 0x53,
+    0x6c, 0xc3, 0x08, 0x8e, 0x59, 0xc1, 0xfb, 0xc9, 0x4d,
+};
+
+}  // namespace
+
+std::string_view RootCA() {
+  return {reinterpret_cast<const char*>(kRootCA), sizeof(kRootCA)};
+}
+
+std::string_view SubRootCA() {
+  return {reinterpret_cast<const char*>(kSubRootCA), sizeof(kSubRootCA)};
+}
+
+std::string_view ValidTimestampsLeaf() {
+  return {reinterpret_cast<const char*>(kValidTimestamps),
+          sizeof(kValidTimestamps)};
+}
+
+std::string_view NoTimestampsLeaf() {
+  return {reinterpret_cast<const char*>(kNoTimestamps),
+          sizeof(kNoTimestamps)};
+}
+
+}  // namespace test
+}  // namespace certificate_transparency
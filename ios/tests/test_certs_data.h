@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string_view>
+
+namespace certificate_transparency {
+namespace test {
+
+// DER encoded certificates of the test chain. Both leaves are issued by
+// SubRootCA(), which is issued by RootCA().
+std::string_view RootCA();
+std::string_view SubRootCA();
+// A precertificate-derived leaf with SCTs from the builtin logs.
+std::string_view ValidTimestampsLeaf();
+// A leaf without the embedded SCT list extension.
+std::string_view NoTimestampsLeaf();
+
+}  // namespace test
+}  // namespace certificate_transparency
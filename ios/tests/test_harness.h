@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdio>
+
+// A minimal test harness for the portable C++ core, which has to build without
+// XCTest or any third-party framework.
+
+namespace certificate_transparency {
+namespace test {
+
+using TestFunction = void (*)();
+
+struct TestRegistration {
+  TestRegistration(const char* name, TestFunction function);
+};
+
+// Runs every registered test and returns the number of failed ones.
+int RunAllTests();
+
+void ReportFailure(const char* file, int line, const char* expression);
+
+}  // namespace test
+}  // namespace certificate_transparency
+
+#define TEST(name)                                                  \
+  static void name();                                               \
+  static const ::certificate_transparency::test::TestRegistration \
+      name##_registration(#name, name);                             \
+  static void name()
+
+#define EXPECT_TRUE(condition)                                           \
+  do {                                                                   \
+    if (!(condition)) {                                                  \
+      ::certificate_transparency::test::ReportFailure(__FILE__, __LINE__, \
+                                                      #condition);       \
+    }                                                                    \
+  } while (0)
+
+#define EXPECT_FALSE(condition) EXPECT_TRUE(!(condition))
+#define EXPECT_EQ(a, b) EXPECT_TRUE((a) == (b))
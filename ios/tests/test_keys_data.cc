@@ -0,0 +1,182 @@
+#include "test_keys_data.h"
+
+namespace certificate_transparency {
+namespace test {
+namespace {
+
+const char kSignedMessage[] = "certificate transparency";
+
+const unsigned char kRSA2048Key[] = {
+    0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+    0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x01, 0x0f, 0x00,
+    0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01, 0x00, 0xa5, 0x75, 0xd0,
+    0xcf, 0x4e, 0xa1, 0x71, 0x3f, 0x3f, 0xed, 0xb9, 0x4b, 0x76, 0xf4, 0x9a,
+    0xa3, 0x92, 0xa6, 0x46, 0x03, 0xa2, 0xe2, 0xb5, 0xd7, 0x55, 0xcc, 0x7f,
+    0x60, 0x8f, 0x77, 0xb0, 0x5f, 0x52, 0xa0, 0x00, 0x11, 0x74, 0x5c, 0xdc,
+    0x84, 0x38, 0x5b, 0x31, 0x29, 0x06, 0x44, 0x50, 0xfc, 0x37, 0x08, 0x4e,
+    0x53, 0x3f, 0x83, 0x01, 0x53, 0x09, 0x1f, 0x7a, 0x5d, 0x39, 0xe0, 0x81,
+    0x5a, 0xe3, 0x9f, 0xa7, 0x7d, 0x36, 0xbc, 0x82, 0xfb, 0xc7, 0x82, 0x15,
+    0x6e, 0x60, 0xda, 0x14, 0xcd, 0x80, 0xb1, 0xe3, 0x3b, 0x72, 0x77, 0x12,
+    0x36, 0xdd, 0x35, 0xf9, 0xc1, 0xfb, 0xbc, 0x69, 0x9e, 0x42, 0x84, 0x1d,
+    0xd5, 0x24, 0x75, 0x12, 0x0e, 0x65, 0x1d, 0xb5, 0x88, 0xc4, 0xa7, 0x33,
+    0x5b, 0x17, 0xe2, 0x7a, 0xaf, 0x5e, 0x09, 0x80, 0xba, 0x86, 0xa7, 0x2a,
+    0xff, 0xc6, 0x99, 0x0e, 0xaa, 0x8c, 0x24, 0xfb, 0x5d, 0x6f, 0xba, 0xc2,
+    0x84, 0xf9, 0x1a, 0xcd, 0x40, 0xf5, 0xb8, 0xaf, 0x02, 0xe2, 0x16, 0xab,
+    0x81, 0x9b, 0x64, 0xb1, 0xb8, 0x9b, 0x55, 0x40, 0x1a, 0xf5, 0x7d, 0xa6,
+    0xc6, 0x74, 0x06, 0x36, 0x43, 0x1f, 0x94, 0x8a, 0x6b, 0xf2, 0xae, 0xc3,
+    0x0e, 0xe3, 0xc7, 0x28, 0x84, 0xf0, 0xc9, 0xc1, 0x55, 0x66, 0xf6, 0xdf,
+    0x92, 0x2a, 0x7c, 0x5e, 0xf9, 0x72, 0x93, 0x01, 0x3f, 0x28, 0xfc, 0x51,
+    0x9b, 0x22, 0xd5, 0x22, 0xc1, 0x24, 0xa1, 0x84, 0x95, 0x98, 0xb1, 0x73,
+    0x4e, 0xeb, 0xe0, 0xe6, 0x54, 0x20, 0xa3, 0x9a, 0x56, 0x1a, 0x31, 0xc0,
+    0xeb, 0xab, 0x29, 0xe8, 0x17, 0x3d, 0x56, 0xd0, 0x17, 0x74, 0x39, 0x9c,
+    0xd0, 0x4a, 0x77, 0x2f, 0x9d, 0xcb, 0x06, 0x47, 0x48, 0xe1, 0xfb, 0x1c,
+    0x5e, 0x16, 0x90, 0xde, 0xa5, 0x6c, 0xd0, 0x9b, 0x36, 0xa2, 0x62, 0x57,
+    0xf1, 0x02, 0x03, 0x01, 0x00, 0x01,
+};
+
+const unsigned char kRSA2048Signature[] = {
+    0x9e, 0x7b, 0xb7, 0xfb, 0x4c, 0xcb, 0x36, 0x98, 0xf6, 0xb0, 0x9d, 0x96,
+    0x14, 0x47, 0x88, 0x13, 0xde, 0x73, 0xf8, 0x71, 0x24, 0xf5, 0x88, 0x47,
+    0xb5, 0x79, 0x32, 0x20, 0x98, 0x96, 0x39, 0xaa, 0xf2, 0x51, 0x0b, 0x32,
+    0xa1, 0x86, 0xd5, 0xc7, 0xe3, 0x4b, 0xa1, 0x2d, 0x39, 0x07, 0xd1, 0xbe,
+    0x25, 0xca, 0xd7, 0x88, 0x7c, 0xa4, 0x4e, 0xf6, 0xd7, 0x31, 0x5d, 0xa2,
+    0xc3, 0x9c, 0x45, 0x02, 0x7e, 0x05, 0x57, 0x9f, 0x37, 0x0b, 0x12, 0xa8,
+    0x76, 0x84, 0x73, 0x29, 0x17, 0xdd, 0xab, 0xae, 0xdb, 0xaf, 0x5b, 0xff,
+    0x43, 0x00, 0xad, 0x7f, 0xff, 0x78, 0x8a, 0xf3, 0xe5, 0xc2, 0x25, 0xe9,
+    0xdd, 0x30, 0xc0, 0x4e, 0xd9, 0xc3, 0x54, 0xce, 0xff, 0x9f, 0x73, 0x90,
+    0xba, 0x1d, 0xd1, 0xc3, 0x1a, 0xbb, 0x6c, 0x40, 0x19, 0xd7, 0xc1, 0xfd,
+    0x31, 0x38, 0x96, 0xfc, 0x83, 0x0e, 0x02, 0x77, 0x90, 0x3b, 0x57, 0x34,
+    0x96, 0x19, 0xb2, 0x3a, 0x49, 0x64, 0x5c, 0x11, 0x93, 0xab, 0x92, 0x6d,
+    0x28, 0x9b, 0x40, 0x1e, 0xab, 0x01, 0x72, 0x43, 0x9d, 0x06, 0xad, 0xfe,
+    0x49, 0xa4, 0xc3, 0x10, 0x08, 0xdb, 0xe4, 0xb0, 0x62, 0xd4, 0xac, 0x5b,
+    0x3a, 0xb1, 0x58, 0xb9, 0x4b, 0x34, 0xd3, 0x45, 0x24, 0xc0, 0xc7, 0xb0,
+    0x64, 0x6c, 0x22, 0xce, 0xd1, 0x5d, 0xa0, 0xe3, 0x34, 0xac, 0x26, 0x5f,
+    0x5b, 0xb8, 0xa6, 0xb5, 0x79, 0x57, 0x76, 0xdb, 0x36, 0x4c, 0xa8, 0xc8,
+    0xdc, 0xee, 0x7b, 0x71, 0x3c, 0x02, 0x46, 0xaa, 0xc8, 0x8e, 0xc1, 0x2d,
+    0xe0, 0x2a, 0x1e, 0x6a, 0xd5, 0x92, 0x10, 0x29, 0x0f, 0x1e, 0xa1, 0xf1,
+    0x94, 0x80, 0x5d, 0xec, 0xee, 0xc8, 0xfb, 0xc4, 0x91, 0x31, 0x41, 0xb1,
+    0xb4, 0xb1, 0x45, 0xeb, 0x05, 0xe8, 0xd0, 0x43, 0x8d, 0x79, 0x7d, 0xf9,
+    0xfc, 0x6a, 0x8f, 0x0b,
+};
+
+const unsigned char kRSA4096Key[] = {
+    0x30, 0x82, 0x02, 0x22, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+    0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03, 0x82, 0x02, 0x0f, 0x00,
+    0x30, 0x82, 0x02, 0x0a, 0x02, 0x82, 0x02, 0x01, 0x00, 0x95, 0x5c, 0x9d,
+    0xf3, 0xda, 0x32, 0x0f, 0x85, 0xab, 0xf9, 0x7e, 0xb3, 0xee, 0x46, 0xef,
+    0x8b, 0x3e, 0x77, 0xb0, 0x10, 0x76, 0x1e, 0x05, 0xce, 0xc2, 0xaf, 0x36,
+    0x42, 0x5a, 0xfb, 0x8c, 0x91, 0xd6, 0x01, 0x71, 0xa3, 0x97, 0xf2, 0xd3,
+    0x92, 0x66, 0xf1, 0x15, 0xbc, 0xbc, 0x89, 0x3d, 0x17, 0xb9, 0xfb, 0x9b,
+    0x0d, 0x4f, 0x16, 0x4d, 0xff, 0x45, 0xc7, 0xc4, 0x62, 0xde, 0xd2, 0xbf,
+    0x51, 0x45, 0x01, 0x77, 0x79, 0x8a, 0x51, 0xb3, 0xbb, 0xbf, 0x9d, 0x0f,
+    0x74, 0x53, 0x7a, 0x0e, 0xbe, 0xb8, 0x95, 0xbb, 0x0e, 0xa8, 0x38, 0xd8,
+    0x01, 0xe0, 0x75, 0x44, 0x5d, 0xe0, 0xa2, 0x1c, 0x15, 0x59, 0xca, 0x06,
+    0xa2, 0x4a, 0xa9, 0xf7, 0xac, 0x61, 0xff, 0xc2, 0x70, 0xbd, 0x36, 0xaf,
+    0x28, 0x51, 0x61, 0x98, 0x6b, 0x44, 0x2d, 0x77, 0x1d, 0x38, 0x2f, 0xb8,
+    0xa7, 0x5f, 0x8a, 0xad, 0x6b, 0xc4, 0xb1, 0xf1, 0xfa, 0x79, 0xdb, 0x43,
+    0xc2, 0x2c, 0x5a, 0xce, 0x2d, 0x7d, 0xb0, 0x3e, 0xa6, 0x0c, 0xcf, 0x8d,
+    0x23, 0x42, 0x20, 0xa2, 0x00, 0x9b, 0x13, 0x52, 0xcd, 0x1e, 0xd9, 0x23,
+    0xa8, 0xfb, 0x09, 0x02, 0x42, 0x27, 0xc9, 0xe4, 0xb5, 0x60, 0x31, 0xf6,
+    0x67, 0x03, 0xea, 0xdc, 0xf0, 0x9b, 0xf5, 0x27, 0x5a, 0x2b, 0x8d, 0xb2,
+    0x5a, 0x67, 0x44, 0x56, 0xdb, 0x13, 0xb3, 0x21, 0xb7, 0xb6, 0xcb, 0x22,
+    0x57, 0x71, 0xb0, 0x80, 0x89, 0x03, 0x46, 0xe1, 0xea, 0x78, 0x55, 0x4b,
+    0x3f, 0x2c, 0x28, 0xc1, 0x1d, 0x57, 0x8b, 0x02, 0x3a, 0x6b, 0x98, 0xc3,
+    0x62, 0x45, 0x31, 0x0b, 0x5d, 0x09, 0xcd, 0xc7, 0x1e, 0x8f, 0xa7, 0xb4,
+    0x3a, 0xb5, 0x95, 0xee, 0xaf, 0xcb, 0x45, 0x09, 0x9a, 0x6f, 0xe9, 0x5e,
+    0xa0, 0x6b, 0x8e, 0x75, 0xad, 0x37, 0xa2, 0x1c, 0x4a, 0x1f, 0x23, 0x71,
+    0x82, 0x98, 0x5f, 0xe5, 0x33, 0xc0, 0x54, 0x76, 0x68, 0x3c, 0x3a, 0x5a,
+    0xb1, 0x94, 0xb5, 0xff, 0xcb, 0x79, 0xc6, 0xd6, 0x2a, 0x09, 0x85, 0x2c,
+    0x0c, 0x21, 0x95, 0x7a, 0xd1, 0xf4, 0x1b, 0xe2, 0xf7, 0x90, 0x2e, 0xd9,
+    0x6d, 0xed, 0x40, 0xbc, 0x83, 0x54, 0x03, 0xf4, 0xb3, 0xe7, 0x80, 0x98,
+    0xdf, 0x84, 0xdf, 0xf4, 0xc6, 0x98, 0x5e, 0x8d, 0xf7, 0xde, 0xb0, 0xad,
+    0x96, 0x88, 0x85, 0xa4, 0xf2, 0xc8, 0xba, 0x50, 0xb6, 0xd0, 0x44, 0xdd,
+    0x92, 0xc6, 0x0f, 0x00, 0xb9, 0xd2, 0x57, 0x14, 0x16, 0x8d, 0x2d, 0xb9,
+    0x06, 0xc3, 0x10, 0x8c, 0xa1, 0x46, 0x7e, 0x83, 0x3f, 0x9c, 0x00, 0x88,
+    0x3f, 0x23, 0x85, 0x08, 0xc2, 0xe0, 0x51, 0x14, 0xef, 0xbf, 0x77, 0x06,
+    0x43, 0x9c, 0x64, 0xd1, 0x7c, 0xd9, 0x2c, 0xd9, 0x67, 0x2b, 0x01, 0xdd,
+    0x4c, 0x6b, 0xdb, 0x5b, 0x8a, 0xd7, 0x5d, 0xb7, 0x8b, 0xf5, 0xd0, 0x49,
+    0x97, 0xe9, 0x2c, 0x18, 0x50, 0x87, 0xf0, 0x47, 0x09, 0xc4, 0xde, 0x27,
+    0xef, 0xdd, 0x2e, 0xed, 0xe8, 0xe5, 0x2a, 0x06, 0x29, 0x47, 0x24, 0x5b,
+    0xd0, 0xbe, 0x5b, 0x34, 0xf1, 0xed, 0xd4, 0xb0, 0x9b, 0x18, 0x04, 0x7c,
+    0xaa, 0xa5, 0x9a, 0x36, 0x0a, 0x0a, 0x58, 0x7e, 0x17, 0xe5, 0xbc, 0x4c,
+    0xf1, 0x2d, 0x2b, 0x26, 0xbd, 0x26, 0xb6, 0x34, 0x99, 0x45, 0x04, 0x74,
+    0x61, 0xa6, 0xd0, 0xef, 0x06, 0xab, 0x1a, 0x77, 0x27, 0x88, 0x2c, 0xc5,
+    0xa1, 0xec, 0x0d, 0x9d, 0x4c, 0xce, 0x8b, 0xbd, 0xc3, 0x00, 0x03, 0x4a,
+    0x1b, 0x6b, 0xad, 0x24, 0x98, 0xed, 0x47, 0xdc, 0xa6, 0xda, 0xe1, 0xbe,
+    0x53, 0x5a, 0x35, 0x6d, 0xe7, 0x95, 0x44, 0xba, 0xb1, 0x0c, 0x0f, 0xe5,
+    0xb6, 0xf0, 0x73, 0xd5, 0xdc, 0x72, 0xd9, 0xff, 0x34, 0xcc, 0xba, 0x74,
+    0xa0, 0xdc, 0x80, 0x2e, 0x4f, 0x02, 0x03, 0x01, 0x00, 0x01,
+};
+
+const unsigned char kRSA4096Signature[] = {
+    0x0f, 0x0f, 0xcd, 0x4b, 0x13, 0x84, 0x87, 0x03, 0x98, 0x3a, 0x1e, 0xdf,
+    0xad, 0x9c, 0xc1, 0x6d, 0xf1, 0x04, 0xf9, 0x4a, 0xbd, 0x2b, 0xe0, 0x3c,
+    0x5c, 0x75, 0x56, 0xab, 0x52, 0x5a, 0xc9, 0x35, 0x1c, 0x53, 0x77, 0x97,
+    0x3a, 0x5c, 0xb0, 0x97, 0x24, 0x20, 0x44, 0xf0, 0x56, 0xcc, 0x53, 0xa6,
+    0xc2, 0x27, 0xb3, 0x71, 0x6b, 0xf1, 0xef, 0x52, 0xa5, 0xc9, 0x41, 0xc8,
+    0xc6, 0xf7, 0x28, 0xff, 0xd7, 0x6a, 0xf0, 0x00, 0xf4, 0x1c, 0x0a, 0x85,
+    0xe7, 0xd6, 0xce, 0xe3, 0x4a, 0x2b, 0x6f, 0xb0, 0x3e, 0xfb, 0xad, 0x31,
+    0x3a, 0xb7, 0x27, 0x06, 0x9a, 0x60, 0x52, 0x14, 0x91, 0x15, 0x2a, 0x2d,
+    0x20, 0xfc, 0xd8, 0xf0, 0x13, 0x18, 0xcf, 0xb4, 0x2f, 0xe8, 0xf3, 0xfb,
+    0x26, 0x5b, 0xff, 0x85, 0x58, 0x24, 0x8d, 0xcd, 0x3a, 0x66, 0x6a, 0x26,
+    0x84, 0xfe, 0xf5, 0x59, 0x46, 0xba, 0xd8, 0xb0, 0xd5, 0xd2, 0x1a, 0x22,
+    0xf3, 0x1c, 0x4e, 0xeb, 0xa7, 0x9a, 0xd6, 0x20, 0xbe, 0xf3, 0x32, 0xa0,
+    0x19, 0x55, 0xc0, 0x8c, 0x41, 0x76, 0x3c, 0x19, 0xdb, 0xe1, 0x9c, 0x67,
+    0x22, 0x76, 0x8c, 0x78, 0x69, 0x23, 0x49, 0x29, 0x95, 0x3f, 0x87, 0x32,
+    0xd0, 0xd3, 0xef, 0xef, 0x98, 0x12, 0x1e, 0x62, 0xb6, 0x92, 0x2e, 0x48,
+    0xc8, 0x49, 0xc1, 0xf2, 0x9f, 0x61, 0xc6, 0x32, 0x94, 0x3f, 0x90, 0xb5,
+    0xa9, 0x92, 0x12, 0x33, 0x4f, 0xee, 0xd2, 0xd4, 0x1a, 0x5d, 0x7b, 0xc3,
+    0x42, 0xef, 0xc5, 0xe7, 0x77, 0x9d, 0xe1, 0x26, 0xce, 0x6f, 0xa2, 0x73,
+    0x23, 0x26, 0xc3, 0x16, 0x6d, 0xa7, 0x61, 0xe9, 0x55, 0x01, 0x16, 0xab,
+    0x62, 0x04, 0xd3, 0xb8, 0xcf, 0x3b, 0xe5, 0xb4, 0x99, 0x53, 0x9b, 0xc0,
+    0xaf, 0x81, 0x6d, 0x1a, 0x03, 0xf2, 0xb7, 0xf3, 0x16, 0x1b, 0xc3, 0xf9,
+    0x67, 0xd8, 0x23, 0x83, 0xda, 0x4c, 0xab, 0xd5, 0xc5, 0xe4, 0xc0, 0x68,
+    0x89, 0xfb, 0xa8, 0x28, 0x57, 0x20, 0xab, 0xca, 0x84, 0xf7, 0x6b, 0xd5,
+    0x9b, 0xc9, 0xd3, 0x44, 0x71, 0xad, 0x3d, 0x6b, 0x84, 0x3d, 0x3f, 0xb6,
+    0x1f, 0x50, 0xaa, 0xd9, 0x08, 0x1f, 0x2e, 0xe7, 0x06, 0x2f, 0x90, 0x17,
+    0xa3, 0x7e, 0x3e, 0x6c, 0xf5, 0x1f, 0x3d, 0x2f, 0xbc, 0x41, 0x61, 0xc9,
+    0x7d, 0x85, 0x69, 0x2f, 0x07, 0x67, 0xb1, 0x82, 0xa0, 0x8d, 0x89, 0x00,
+    0xe9, 0xcd, 0x68, 0x48, 0x36, 0x14, 0xaa, 0xa9, 0x21, 0x31, 0xa3, 0x17,
+    0x04, 0xc5, 0xc6, 0x86, 0x74, 0x8b, 0x0c, 0x5b, 0xa0, 0xc5, 0x04, 0xe4,
+    0xca, 0xca, 0x00, 0xca, 0x1c, 0xe6, 0x8f, 0x93, 0x7f, 0xbf, 0x8b, 0xbf,
+    0xcd, 0x40, 0xdc, 0x25, 0x74, 0x44, 0x7f, 0xd3, 0xc0, 0x5c, 0xa9, 0xe0,
+    0x62, 0xf2, 0xf1, 0x4b, 0xa0, 0x29, 0x5b, 0xd0, 0xfc, 0x61, 0x88, 0x91,
+    0xc7, 0x7b, 0x68, 0xb0, 0x5e, 0x7f, 0x53, 0x31, 0xfe, 0xe0, 0x64, 0x92,
+    0x72, 0x59, 0xc4, 0x2b, 0xbf, 0xaa, 0xda, 0xb1, 0xf8, 0x43, 0xea, 0xe6,
+    0x10, 0x3a, 0x4e, 0x97, 0x16, 0xf9, 0x3f, 0x68, 0xe3, 0x2e, 0x87, 0x0d,
+    0xd5, 0xd8, 0x72, 0xfe, 0xb6, 0xae, 0x7b, 0xeb, 0xd3, 0x7a, 0x84, 0xc5,
+    0x82, 0x40, 0xed, 0x10, 0x8a, 0x3e, 0x68, 0x3e, 0x67, 0x57, 0x72, 0x4c,
+    0xa2, 0xf0, 0x77, 0x35, 0x11, 0x10, 0xe8, 0x09, 0xe8, 0x19, 0xe0, 0x08,
+    0x15, 0x40, 0xa8, 0x6f, 0xbb, 0x25, 0xdf, 0x5d, 0x04, 0xbb, 0xfa, 0xe9,
+    0x4e, 0x21, 0x8b, 0xc1, 0xe9, 0xbc, 0xd0, 0x99, 0xa6, 0x27, 0x4d, 0x57,
+    0x54, 0xef, 0xb5, 0x9b, 0x96, 0x96, 0x81, 0xc1, 0x95, 0xa1, 0x8e, 0x9e,
+    0x04, 0x88, 0x54, 0x19, 0x56, 0xa5, 0x23, 0x28, 0x36, 0x8f, 0xe4, 0x50,
+    0xef, 0xf4, 0xae, 0x76, 0x42, 0xbd, 0x73, 0x4d,
+};
+
+}  // namespace
+
+std::string_view SignedMessage() {
+  return {kSignedMessage, sizeof(kSignedMessage) - 1};
+}
+
+std::string_view RSA2048Key() {
+  return {reinterpret_cast<const char*>(kRSA2048Key), sizeof(kRSA2048Key)};
+}
+
+std::string_view RSA2048Signature() {
+  return {reinterpret_cast<const char*>(kRSA2048Signature),
+          sizeof(kRSA2048Signature)};
+}
+
+std::string_view RSA4096Key() {
+  return {reinterpret_cast<const char*>(kRSA4096Key), sizeof(kRSA4096Key)};
+}
+
+std::string_view RSA4096Signature() {
+  return {reinterpret_cast<const char*>(kRSA4096Signature),
+          sizeof(kRSA4096Signature)};
+}
+
+}  // namespace test
+}  // namespace certificate_transparency
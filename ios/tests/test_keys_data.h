@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string_view>
+
+namespace certificate_transparency {
+namespace test {
+
+// The message signed by every test key below.
+std::string_view SignedMessage();
+
+// RSA test log keys as DER SubjectPublicKeyInfo, with e = 65537, and
+// RSASSA-PKCS1-v1_5 SHA-256 signatures of SignedMessage().
+std::string_view RSA2048Key();
+std::string_view RSA2048Signature();
+std::string_view RSA4096Key();
+std::string_view RSA4096Signature();
+
+}  // namespace test
+}  // namespace certificate_transparency
@@ -0,0 +1,49 @@
+#include "test_harness.h"
+
+#include <vector>
+
+namespace certificate_transparency {
+namespace test {
+namespace {
+
+struct Test {
+  const char* name;
+  TestFunction function;
+};
+
+std::vector<Test>& Registry() {
+  static std::vector<Test> tests;
+  return tests;
+}
+
+bool current_test_failed = false;
+
+}  // namespace
+
+TestRegistration::TestRegistration(const char* name, TestFunction function) {
+  Registry().push_back({name, function});
+}
+
+void ReportFailure(const char* file, int line, const char* expression) {
+  fprintf(stderr, "%s:%d: expected %s\n", file, line, expression);
+  current_test_failed = true;
+}
+
+int RunAllTests() {
+  int failed = 0;
+  for (const auto& test : Registry()) {
+    current_test_failed = false;
+    test.function();
+    printf("[%s] %s\n", current_test_failed ? "FAILED" : "  OK  ", test.name);
+    failed += current_test_failed;
+  }
+  printf("%zu tests, %d failed\n", Registry().size(), failed);
+  return failed;
+}
+
+}  // namespace test
+}  // namespace certificate_transparency
+
+int main() {
+  return certificate_transparency::test::RunAllTests() == 0 ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+#include <atomic>
+#include <limits>
+#include <string>
+#include <thread>
+
+#include "builtin_logs.h"
+#include "multi_log_verifier.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "trace.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+size_t CountSpans(const std::string& trace, const std::string& name) {
+  const std::string needle = "{\"name\":\"" + name + "\"";
+  size_t count = 0;
+  for (size_t pos = trace.find(needle); pos != std::string::npos;
+       pos = trace.find(needle, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(TraceRecordsVerificationStages) {
+  const ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  ct::StartTracing();
+  EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                              kFarFuture));
+  ct::StopTracing();
+  verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(), kFarFuture);
+
+  const std::string trace = ct::ExportChromeTrace();
+  const std::string header = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  EXPECT_EQ(trace.compare(0, header.size(), header), 0);
+  EXPECT_EQ(CountSpans(trace, "verify"), 1u);
+  EXPECT_EQ(CountSpans(trace, "extract_sct_list"), 1u);
+  EXPECT_EQ(CountSpans(trace, "rebuild_tbs"), 1u);
+  EXPECT_EQ(CountSpans(trace, "decode_scts"), 1u);
+  EXPECT_TRUE(CountSpans(trace, "sct") >= 2u);
+  // Every SCT is looked up, and signatures are checked until two logs pass.
+  EXPECT_EQ(CountSpans(trace, "check_signature"), 2u);
+  EXPECT_TRUE(trace.find("\"key_type\":\"EC\"") != std::string::npos);
+}
+
+TEST(TraceKeepsLatestSpansPerThread) {
+  ct::StartTracing();
+  std::thread([] {
+    for (size_t i = 0; i < ct::kTraceEventsPerThread + 10; i++) {
+      ct::TraceSpan span("wrap");
+    }
+  }).join();
+  ct::StopTracing();
+  EXPECT_EQ(CountSpans(ct::ExportChromeTrace(), "wrap"),
+            ct::kTraceEventsPerThread);
+
+  // A new trace drops the spans of the previous one.
+  ct::StartTracing();
+  ct::StopTracing();
+  EXPECT_EQ(CountSpans(ct::ExportChromeTrace(), "wrap"), 0u);
+}
+
+TEST(TraceExportsWhileRecording) {
+  ct::StartTracing();
+  std::atomic<bool> stop{false};
+  std::thread writer([&] {
+    while (!stop.load()) {
+      ct::TraceSpan span("busy");
+    }
+  });
+  size_t spans = 0;
+  for (int i = 0; i < 20; i++) {
+    spans = CountSpans(ct::ExportChromeTrace(), "busy");
+  }
+  stop = true;
+  writer.join();
+  ct::StopTracing();
+  EXPECT_TRUE(spans <= ct::kTraceEventsPerThread);
+}
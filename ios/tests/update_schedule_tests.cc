@@ -0,0 +1,49 @@
+#include "test_harness.h"
+#include "update_schedule.h"
+
+namespace ct = certificate_transparency;
+
+TEST(ParseCacheControlMaxAge) {
+  EXPECT_EQ(ct::ParseCacheControlMaxAge("max-age=3600"), 3600000u);
+  EXPECT_EQ(ct::ParseCacheControlMaxAge("public, Max-Age=60 , immutable"),
+            60000u);
+  EXPECT_EQ(ct::ParseCacheControlMaxAge("s-maxage=10, max-age=20"), 20000u);
+  EXPECT_FALSE(ct::ParseCacheControlMaxAge("no-cache"));
+  EXPECT_FALSE(ct::ParseCacheControlMaxAge("max-age="));
+  EXPECT_FALSE(ct::ParseCacheControlMaxAge("max-age=-1"));
+  EXPECT_TRUE(ct::ParseCacheControlMaxAge("max-age=99999999999999999999"));
+}
+
+TEST(ParseRetryAfter) {
+  EXPECT_EQ(ct::ParseRetryAfter("120"), 120000u);
+  EXPECT_EQ(ct::ParseRetryAfter(" 5 "), 5000u);
+  EXPECT_FALSE(ct::ParseRetryAfter("Wed, 21 Oct 2015 07:28:00 GMT"));
+  EXPECT_FALSE(ct::ParseRetryAfter(""));
+  EXPECT_FALSE(ct::ParseRetryAfter("1.5"));
+}
+
+TEST(InitialDelayRespectsStoredTime) {
+  const uint64_t now = 1000000;
+  EXPECT_EQ(ct::GetInitialUpdateDelay(std::nullopt, now, 0), 2000u);
+  EXPECT_EQ(ct::GetInitialUpdateDelay(now - 1, now, 0), 2000u);
+  EXPECT_EQ(ct::GetInitialUpdateDelay(now + 500000, now, 0), 500000u);
+  // Restarted clients with an overdue update spread over a minute.
+  EXPECT_EQ(ct::GetInitialUpdateDelay(now - 1, now, 0.5), 32000u);
+}
+
+TEST(FailureDelayIsCapped) {
+  const ct::ScheduleHints no_hints;
+  uint64_t previous = 0;
+  for (uint32_t failures = 1; failures < 100; failures++) {
+    const uint64_t delay = ct::GetFailureUpdateDelay(failures, no_hints, 1);
+    EXPECT_TRUE(delay >= previous);
+    EXPECT_TRUE(delay <= 24 * 60 * 60 * 1000u);
+    previous = delay;
+  }
+
+  ct::ScheduleHints hints;
+  hints.retry_after = 0;
+  EXPECT_EQ(ct::GetFailureUpdateDelay(1, hints, 0), 60000u);
+  hints.retry_after = UINT64_MAX;
+  EXPECT_EQ(ct::GetFailureUpdateDelay(1, hints, 0), 7 * 24 * 60 * 60 * 1000u);
+}
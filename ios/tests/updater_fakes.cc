@@ -0,0 +1,87 @@
+#include "updater_fakes.h"
+
+#include <utility>
+
+namespace certificate_transparency {
+namespace test {
+
+FakeClock::FakeClock(uint64_t now) : now_(now) {}
+
+FakeClock::~FakeClock() = default;
+
+uint64_t FakeClock::Now() {
+  return now_;
+}
+
+void FakeClock::PostDelayed(uint64_t delay, std::function<void()> task) {
+  tasks_.emplace(now_ + delay, std::move(task));
+}
+
+void FakeClock::Advance(uint64_t delta) {
+  const uint64_t target = now_ + delta;
+  while (!tasks_.empty() && tasks_.begin()->first <= target) {
+    auto next = tasks_.begin();
+    now_ = next->first;
+    std::function<void()> task = std::move(next->second);
+    tasks_.erase(next);
+    task();
+  }
+  now_ = target;
+}
+
+std::optional<uint64_t> FakeClock::NextTaskTime() const {
+  if (tasks_.empty()) {
+    return {};
+  }
+  return tasks_.begin()->first;
+}
+
+FakeTransport::FakeTransport() = default;
+
+FakeTransport::~FakeTransport() = default;
+
+void FakeTransport::Fetch(const std::optional<std::string>& tag,
+                          FetchCallback callback) {
+  requested_tags_.push_back(tag);
+  if (results_.empty()) {
+    pending_.push_back(std::move(callback));
+    return;
+  }
+  auto [result, hints] = std::move(results_.front());
+  results_.pop_front();
+  callback(std::move(result), hints);
+}
+
+void FakeTransport::Enqueue(FetchResult result, ScheduleHints hints) {
+  results_.emplace_back(std::move(result), hints);
+}
+
+void FakeTransport::Respond(FetchResult result, ScheduleHints hints) {
+  FetchCallback callback = std::move(pending_.front());
+  pending_.pop_front();
+  callback(std::move(result), hints);
+}
+
+MemoryStorage::MemoryStorage(std::shared_ptr<LogListState> state)
+    : state_(std::move(state)) {}
+
+MemoryStorage::~MemoryStorage() = default;
+
+LogListState MemoryStorage::Load() {
+  return *state_;
+}
+
+void MemoryStorage::Save(const LogListState& state) {
+  *state_ = state;
+}
+
+LogListTransport::Ok MakeOk(const std::optional<std::string>& tag,
+                            const std::vector<std::string>& logs) {
+  LogListTransport::Ok ok;
+  ok.tag = tag;
+  ok.logs = logs;
+  return ok;
+}
+
+}  // namespace test
+}  // namespace certificate_transparency
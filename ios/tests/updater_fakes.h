@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "log_list_updater.h"
+
+namespace certificate_transparency {
+namespace test {
+
+// A clock that only moves when told to, running due tasks as it does.
+class FakeClock : public UpdaterClock {
+ public:
+  explicit FakeClock(uint64_t now);
+  ~FakeClock() override;
+
+  uint64_t Now() override;
+  void PostDelayed(uint64_t delay, std::function<void()> task) override;
+
+  double RandomFraction() override { return random_; }
+  void set_random(double random) { random_ = random; }
+
+  void Advance(uint64_t delta);
+  // The time of the earliest pending task, if any.
+  std::optional<uint64_t> NextTaskTime() const;
+
+ private:
+  uint64_t now_;
+  double random_ = 0.5;
+  std::multimap<uint64_t, std::function<void()>> tasks_;
+};
+
+// Answers fetches with queued results, or keeps them pending if there are
+// none until Respond() is called.
+class FakeTransport : public LogListTransport {
+ public:
+  FakeTransport();
+  ~FakeTransport() override;
+
+  void Fetch(const std::optional<std::string>& tag,
+             FetchCallback callback) override;
+
+  void Enqueue(FetchResult result, ScheduleHints hints = {});
+  // Completes the oldest pending fetch.
+  void Respond(FetchResult result, ScheduleHints hints = {});
+
+  size_t pending() const { return pending_.size(); }
+  const std::vector<std::optional<std::string>>& requested_tags() const {
+    return requested_tags_;
+  }
+
+ private:
+  std::deque<std::pair<FetchResult, ScheduleHints>> results_;
+  std::deque<FetchCallback> pending_;
+  std::vector<std::optional<std::string>> requested_tags_;
+};
+
+// Keeps the state in memory shared with the test.
+class MemoryStorage : public LogListStorage {
+ public:
+  explicit MemoryStorage(std::shared_ptr<LogListState> state);
+  ~MemoryStorage() override;
+
+  LogListState Load() override;
+  void Save(const LogListState& state) override;
+
+ private:
+  std::shared_ptr<LogListState> state_;
+};
+
+LogListTransport::Ok MakeOk(const std::optional<std::string>& tag,
+                            const std::vector<std::string>& logs);
+
+}  // namespace test
+}  // namespace certificate_transparency
@@ -0,0 +1,204 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "chain_digest.h"
+#include "multi_log_verifier.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "verdict_store.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+// A file name for a table, removed when the test ends.
+class TemporaryPath {
+ public:
+  TemporaryPath() {
+    char path[] = "/tmp/verdict_store_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd >= 0) {
+      close(fd);
+    }
+    path_ = path;
+  }
+  ~TemporaryPath() { unlink(path_.c_str()); }
+
+  const std::string& get() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+ct::ChainDigest Chain(int i) {
+  std::string leaf = "leaf " + std::to_string(i);
+  return ct::GetChainDigest(leaf, "issuer");
+}
+
+}  // namespace
+
+TEST(VerdictStoreRejectsBadCapacity) {
+  TemporaryPath path;
+  EXPECT_FALSE(ct::VerdictStore::Open(path.get(), 0));
+  EXPECT_FALSE(ct::VerdictStore::Open(path.get(), 100));
+  EXPECT_TRUE(ct::VerdictStore::Open(path.get(), 64));
+  // The file is sized for 64 entries now.
+  EXPECT_FALSE(ct::VerdictStore::Open(path.get(), 128));
+}
+
+TEST(VerdictStoreLookup) {
+  TemporaryPath path;
+  auto store = ct::VerdictStore::Open(path.get(), 64);
+  bool verified = false;
+  EXPECT_FALSE(store->Lookup(Chain(1), 7, 100, &verified));
+
+  EXPECT_TRUE(store->Store(Chain(1), 7, 100, 200, true));
+  EXPECT_TRUE(store->Store(Chain(2), 7, 100, 200, false));
+  EXPECT_TRUE(store->Lookup(Chain(1), 7, 150, &verified));
+  EXPECT_TRUE(verified);
+  EXPECT_TRUE(store->Lookup(Chain(2), 7, 150, &verified));
+  EXPECT_FALSE(verified);
+
+  // Other generations and expired entries miss.
+  EXPECT_FALSE(store->Lookup(Chain(1), 8, 150, &verified));
+  EXPECT_FALSE(store->Lookup(Chain(1), 7, 200, &verified));
+
+  // Storing again replaces the verdict.
+  EXPECT_TRUE(store->Store(Chain(1), 7, 150, 300, false));
+  EXPECT_TRUE(store->Lookup(Chain(1), 7, 250, &verified));
+  EXPECT_FALSE(verified);
+}
+
+TEST(VerdictStoreEvictsWhenFull) {
+  TemporaryPath path;
+  auto store = ct::VerdictStore::Open(path.get(), 16);
+  for (int i = 0; i < 64; i++) {
+    EXPECT_TRUE(store->Store(Chain(i), 1, 0, 1000 + i, true));
+  }
+  bool verified = false;
+  EXPECT_TRUE(store->Lookup(Chain(63), 1, 0, &verified));
+  int found = 0;
+  for (int i = 0; i < 64; i++) {
+    found += store->Lookup(Chain(i), 1, 0, &verified);
+  }
+  EXPECT_TRUE(found <= 16);
+}
+
+TEST(VerdictStoreSurvivesReopen) {
+  TemporaryPath path;
+  EXPECT_TRUE(
+      ct::VerdictStore::Open(path.get(), 64)->Store(Chain(1), 1, 0, 10, true));
+
+  auto store = ct::VerdictStore::Open(path.get(), 64);
+  bool verified = false;
+  EXPECT_TRUE(store->Lookup(Chain(1), 1, 0, &verified));
+  EXPECT_TRUE(verified);
+}
+
+TEST(VerdictStoreIsSharedBetweenProcesses) {
+  TemporaryPath path;
+  auto store = ct::VerdictStore::Open(path.get(), 64);
+  pid_t child = fork();
+  if (child == 0) {
+    auto child_store = ct::VerdictStore::Open(path.get(), 64);
+    _exit(child_store && child_store->Store(Chain(1), 1, 0, 10, true) ? 0 : 1);
+  }
+  int status = 0;
+  EXPECT_EQ(waitpid(child, &status, 0), child);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  bool verified = false;
+  EXPECT_TRUE(store->Lookup(Chain(1), 1, 0, &verified));
+  EXPECT_TRUE(verified);
+}
+
+TEST(VerdictStoreConcurrentWriters) {
+  TemporaryPath path;
+  auto store = ct::VerdictStore::Open(path.get(), 256);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&store, t] {
+      for (int round = 0; round < 1000; round++) {
+        const int i = round % 32;
+        // Verdicts alternate per chain, never per writer, so a torn entry
+        // would show up as a wrong verdict.
+        store->Store(Chain(i), 1, 0, 10, i % 2 == 0);
+        bool verified = false;
+        if (store->Lookup(Chain(i + t), 1, 0, &verified) &&
+            verified != ((i + t) % 2 == 0)) {
+          EXPECT_TRUE(false);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(MultiLogVerifierUsesVerdictStore) {
+  TemporaryPath path;
+  std::shared_ptr<ct::VerdictStore> store =
+      ct::VerdictStore::Open(path.get(), 64);
+
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  verifier.SetVerdictStore(store, 1000);
+  EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                              kFarFuture - 1));
+
+  bool verified = false;
+  const ct::ChainDigest chain =
+      ct::GetChainDigest(test::ValidTimestampsLeaf(), test::SubRootCA());
+  EXPECT_TRUE(store->Lookup(chain, verifier.generation(), 0, &verified));
+  EXPECT_TRUE(verified);
+
+  // A verifier for another log set does not see the verdict.
+  std::vector<std::string> logs = ct::GetBuiltinLogs();
+  logs.pop_back();
+  ct::MultiLogVerifier other_verifier(logs);
+  EXPECT_FALSE(other_verifier.generation() == verifier.generation());
+
+  // A verdict recorded by another verifier of the same log set is reused.
+  EXPECT_TRUE(store->Store(chain, verifier.generation(), 0, 10, false));
+  ct::MultiLogVerifier same_verifier(ct::GetBuiltinLogs());
+  same_verifier.SetVerdictStore(store, 1000);
+  EXPECT_FALSE(same_verifier.Verify(test::ValidTimestampsLeaf(),
+                                    test::SubRootCA(), 5));
+}
+
+TEST(MultiLogVerifierDoesNotStoreFailuresOfFutureSCTs) {
+  TemporaryPath path;
+  std::shared_ptr<ct::VerdictStore> store =
+      ct::VerdictStore::Open(path.get(), 64);
+  ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  verifier.SetVerdictStore(store, 1000);
+
+  // Before its SCTs were issued the chain fails, but only until they were.
+  const ct::VerificationDetails details = verifier.VerifyDetailed(
+      test::ValidTimestampsLeaf(), test::SubRootCA(), 1);
+  EXPECT_FALSE(details.verified);
+  EXPECT_TRUE(details.future_timestamps > 0);
+  bool verified = false;
+  const ct::ChainDigest chain =
+      ct::GetChainDigest(test::ValidTimestampsLeaf(), test::SubRootCA());
+  EXPECT_FALSE(store->Lookup(chain, verifier.generation(), 1, &verified));
+  EXPECT_TRUE(verifier.Verify(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                              kFarFuture - 1));
+
+  // Failures for other reasons are stored.
+  EXPECT_FALSE(verifier.Verify(test::NoTimestampsLeaf(), test::SubRootCA(), 1));
+  EXPECT_TRUE(store->Lookup(
+      ct::GetChainDigest(test::NoTimestampsLeaf(), test::SubRootCA()),
+      verifier.generation(), 1, &verified));
+  EXPECT_FALSE(verified);
+}
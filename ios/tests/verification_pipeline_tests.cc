@@ -0,0 +1,114 @@
+#include <chrono>
+#include <limits>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "builtin_logs.h"
+#include "multi_log_verifier.h"
+#include "presented_chain_evaluator.h"
+#include "root_index.h"
+#include "test_certs_data.h"
+#include "test_harness.h"
+#include "verification_pipeline.h"
+
+namespace ct = certificate_transparency;
+namespace test = certificate_transparency::test;
+
+namespace {
+
+constexpr uint64_t kFarFuture = std::numeric_limits<uint64_t>::max();
+
+void RunOnNewThread(ct::VerificationPipeline::Task task) {
+  std::thread(std::move(task)).detach();
+}
+
+// Builds the chain from a fixed issuer, whatever was presented.
+class ReissuingEvaluator : public ct::ChainEvaluator {
+ public:
+  ct::ChainEvaluation Evaluate() override {
+    ct::ChainEvaluation evaluation;
+    evaluation.trusted = true;
+    evaluation.has_custom_root = true;
+    evaluation.leaf_cert = std::string(test::ValidTimestampsLeaf());
+    evaluation.issuer_cert = std::string(test::SubRootCA());
+    return evaluation;
+  }
+};
+
+}  // namespace
+
+TEST(PreparedChainVerifiesLikeCertificates) {
+  const ct::MultiLogVerifier verifier(ct::GetBuiltinLogs());
+  for (auto leaf : {test::ValidTimestampsLeaf(), test::NoTimestampsLeaf()}) {
+    ct::PreparedChain chain;
+    ct::PrepareChain(leaf, test::SubRootCA(), verifier.limits(), &chain);
+    EXPECT_TRUE(chain.chain == ct::GetChainDigest(leaf, test::SubRootCA()));
+    EXPECT_EQ(verifier.Verify(chain, kFarFuture),
+              verifier.Verify(leaf, test::SubRootCA(), kFarFuture));
+  }
+
+  ct::PreparedChain chain;
+  ct::PrepareChain(test::ValidTimestampsLeaf(), test::SubRootCA(),
+                   verifier.limits(), &chain);
+  EXPECT_TRUE(chain.valid);
+  EXPECT_FALSE(chain.scts.empty());
+  // SCTs from before the log existed do not count.
+  EXPECT_FALSE(verifier.Verify(chain, 0));
+}
+
+TEST(PipelineCommitsTrustedChain) {
+  ct::RootIndex roots;
+  roots.Add(test::RootCA());
+  const std::vector<std::string_view> presented = {
+      test::ValidTimestampsLeaf(), test::SubRootCA(), test::RootCA()};
+  ct::PresentedChainEvaluator evaluator(presented, &roots,
+                                        std::chrono::milliseconds(1));
+
+  const auto& verifier = ct::GetBuiltinLogVerifier();
+  ct::VerificationPipeline pipeline(verifier.limits(), RunOnNewThread);
+  int commits = 0;
+  const auto verdict = pipeline.Verify(
+      &evaluator, presented[0], presented[1],
+      [&](const ct::PreparedChain& chain) {
+        commits++;
+        return verifier.Verify(chain, kFarFuture);
+      });
+  EXPECT_TRUE(verdict.trusted);
+  EXPECT_TRUE(verdict.has_custom_root);
+  EXPECT_EQ(commits, 1);
+  EXPECT_EQ(pipeline.speculation_misses(), 0u);
+}
+
+TEST(PipelineSkipsCommitForUntrustedChain) {
+  ct::RootIndex roots;
+  roots.Add(test::RootCA());
+  const std::vector<std::string_view> presented = {test::ValidTimestampsLeaf(),
+                                                   test::SubRootCA()};
+  ct::PresentedChainEvaluator evaluator(presented, &roots,
+                                        std::chrono::microseconds(0));
+
+  ct::VerificationPipeline pipeline(ct::VerificationLimits(), RunOnNewThread);
+  int commits = 0;
+  const auto verdict =
+      pipeline.Verify(&evaluator, presented[0], presented[1],
+                      [&](const ct::PreparedChain&) { return ++commits; });
+  EXPECT_FALSE(verdict.trusted);
+  EXPECT_FALSE(verdict.has_custom_root);
+  EXPECT_EQ(commits, 0);
+}
+
+TEST(PipelinePreparesRebuiltChain) {
+  const auto& verifier = ct::GetBuiltinLogVerifier();
+  ct::VerificationPipeline pipeline(verifier.limits(), RunOnNewThread);
+  ReissuingEvaluator evaluator;
+  // The server sent the wrong intermediate; the evaluator found the right
+  // one, so the speculative preparation is of no use.
+  const auto verdict = pipeline.Verify(
+      &evaluator, test::ValidTimestampsLeaf(), test::RootCA(),
+      [&](const ct::PreparedChain& chain) {
+        return verifier.Verify(chain, kFarFuture);
+      });
+  EXPECT_TRUE(verdict.trusted);
+  EXPECT_EQ(pipeline.speculation_misses(), 1u);
+}
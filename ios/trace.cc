@@ -0,0 +1,209 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "safe_cstring.h"
+
+namespace certificate_transparency {
+
+namespace internal {
+std::atomic<bool> tracing_armed{false};
+}  // namespace internal
+
+namespace {
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// A span in a ring buffer slot. Every field is atomic so that an export
+// racing the owning thread is well defined; |sequence| works as a seqlock.
+struct Slot {
+  // 2 * index + 1 while event |index| of the thread is written into the slot,
+  // 2 * index + 2 once it is complete.
+  std::atomic<uint64_t> sequence{0};
+  std::atomic<const char*> name{nullptr};
+  std::atomic<uint64_t> start_ns{0};
+  std::atomic<uint64_t> duration_ns{0};
+  std::atomic<uint64_t> log_id_prefix{0};
+  std::atomic<const char*> key_type{nullptr};
+};
+
+struct Event {
+  const char* name;
+  uint64_t start_ns;
+  uint64_t duration_ns;
+  uint64_t log_id_prefix;
+  const char* key_type;
+};
+
+// The spans of one thread. Only that thread writes them.
+class ThreadBuffer {
+ public:
+  explicit ThreadBuffer(uint64_t thread_id) : thread_id_(thread_id) {}
+
+  void Write(const Event& event) {
+    const uint64_t index = next_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[index % kTraceEventsPerThread];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.start_ns.store(event.start_ns, std::memory_order_relaxed);
+    slot.duration_ns.store(event.duration_ns, std::memory_order_relaxed);
+    slot.log_id_prefix.store(event.log_id_prefix, std::memory_order_relaxed);
+    slot.key_type.store(event.key_type, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    next_.store(index + 1, std::memory_order_release);
+  }
+
+  // Appends the complete events that started at or after |since_ns|.
+  void Read(uint64_t since_ns, std::vector<Event>* events) const {
+    const uint64_t end = next_.load(std::memory_order_acquire);
+    const uint64_t begin =
+        end > kTraceEventsPerThread ? end - kTraceEventsPerThread : 0;
+    for (uint64_t index = begin; index < end; index++) {
+      const Slot& slot = slots_[index % kTraceEventsPerThread];
+      if (slot.sequence.load(std::memory_order_acquire) != 2 * index + 2) {
+        continue;
+      }
+      Event event;
+      event.name = slot.name.load(std::memory_order_relaxed);
+      event.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+      event.duration_ns = slot.duration_ns.load(std::memory_order_relaxed);
+      event.log_id_prefix = slot.log_id_prefix.load(std::memory_order_relaxed);
+      event.key_type = slot.key_type.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != 2 * index + 2 ||
+          event.start_ns < since_ns) {
+        continue;
+      }
+      events->push_back(event);
+    }
+  }
+
+  uint64_t thread_id() const { return thread_id_; }
+
+ private:
+  const uint64_t thread_id_;
+  std::atomic<uint64_t> next_{0};
+  Slot slots_[kTraceEventsPerThread];
+};
+
+struct Registry {
+  std::mutex lock;
+  // Buffers of exited threads stay until the next StartTracing().
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  uint64_t next_thread_id = 1;
+  // When the current trace started.
+  uint64_t since_ns = 0;
+};
+
+Registry& GetRegistry() {
+  // Never destroyed, so threads exiting after main() can still trace.
+  static auto* registry = new Registry();
+  return *registry;
+}
+
+// Allocated on the first span a thread records while tracing is armed.
+ThreadBuffer& GetThreadBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if (!buffer) {
+    Registry& registry = GetRegistry();
+    std::lock_guard guard(registry.lock);
+    buffer = std::make_shared<ThreadBuffer>(registry.next_thread_id++);
+    registry.buffers.push_back(buffer);
+  }
+  return *buffer;
+}
+
+}  // namespace
+
+void StartTracing() {
+  Registry& registry = GetRegistry();
+  {
+    std::lock_guard guard(registry.lock);
+    std::vector<std::shared_ptr<ThreadBuffer>> live_buffers;
+    for (auto& buffer : registry.buffers) {
+      if (buffer.use_count() > 1) {
+        live_buffers.push_back(std::move(buffer));
+      }
+    }
+    registry.buffers.swap(live_buffers);
+    registry.since_ns = NowNs();
+  }
+  internal::tracing_armed.store(true, std::memory_order_relaxed);
+}
+
+void StopTracing() {
+  internal::tracing_armed.store(false, std::memory_order_relaxed);
+}
+
+std::string ExportChromeTrace() {
+  Registry& registry = GetRegistry();
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  uint64_t since_ns;
+  {
+    std::lock_guard guard(registry.lock);
+    buffers = registry.buffers;
+    since_ns = registry.since_ns;
+  }
+
+  std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  std::vector<Event> events;
+  char line[256];
+  for (const auto& buffer : buffers) {
+    events.clear();
+    buffer->Read(since_ns, &events);
+    for (const Event& event : events) {
+      snprintf(line, sizeof(line),
+               "%s{\"name\":\"%s\",\"cat\":\"ct\",\"ph\":\"X\",\"pid\":1,"
+               "\"tid\":%" PRIu64 ",\"ts\":%.3f,\"dur\":%.3f",
+               first ? "" : ",", event.name, buffer->thread_id(),
+               (event.start_ns - since_ns) / 1e3, event.duration_ns / 1e3);
+      json += line;
+      if (event.key_type) {
+        snprintf(line, sizeof(line),
+                 ",\"args\":{\"log_id\":\"%016" PRIx64
+                 "\",\"key_type\":\"%s\"}",
+                 event.log_id_prefix, event.key_type);
+        json += line;
+      }
+      json += "}";
+      first = false;
+    }
+  }
+  json += "]}\n";
+  return json;
+}
+
+void TraceSpan::Begin() {
+  armed_ = true;
+  start_ns_ = NowNs();
+}
+
+void TraceSpan::End() {
+  const uint64_t end_ns = NowNs();
+  GetThreadBuffer().Write(
+      {name_, start_ns_, end_ns - start_ns_, log_id_prefix_, key_type_});
+}
+
+void TraceSpan::SetLogArgs(std::string_view log_id, const char* key_type) {
+  uint8_t prefix[sizeof(log_id_prefix_)] = {};
+  safe_memcpy(prefix, log_id.data(), std::min(log_id.size(), sizeof(prefix)));
+  log_id_prefix_ = 0;
+  for (uint8_t byte : prefix) {
+    log_id_prefix_ = (log_id_prefix_ << 8) | byte;
+  }
+  key_type_ = key_type;
+}
+
+}  // namespace certificate_transparency
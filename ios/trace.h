@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace certificate_transparency {
+
+namespace internal {
+extern std::atomic<bool> tracing_armed;
+}  // namespace internal
+
+// Starts recording trace spans on every thread. Spans recorded before are
+// discarded.
+void StartTracing();
+void StopTracing();
+
+inline bool IsTracingArmed() {
+  return internal::tracing_armed.load(std::memory_order_relaxed);
+}
+
+// Returns the spans recorded since StartTracing() in the Chrome trace-event
+// JSON format, which chrome://tracing and Perfetto load. Each thread keeps
+// only its latest kTraceEventsPerThread spans. Spans may be recorded while
+// the trace is exported; those being written are left out.
+std::string ExportChromeTrace();
+
+constexpr size_t kTraceEventsPerThread = 4096;
+
+// Records the time from its construction to its destruction as a span named
+// |name|, which must be a string literal, on the calling thread. While
+// tracing is not armed, it costs a relaxed load and a branch.
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name) : name_(name) {
+    if (IsTracingArmed()) {
+      Begin();
+    }
+  }
+  ~TraceSpan() {
+    if (armed_) {
+      End();
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  // Tags the span with the log an SCT came from: the first bytes of its
+  // |log_id| and its |key_type|, a string literal.
+  void SetLog(std::string_view log_id, const char* key_type) {
+    if (armed_) {
+      SetLogArgs(log_id, key_type);
+    }
+  }
+
+ private:
+  void Begin();
+  void End();
+  void SetLogArgs(std::string_view log_id, const char* key_type);
+
+  const char* const name_;
+  bool armed_ = false;
+  uint64_t start_ns_ = 0;
+  uint64_t log_id_prefix_ = 0;
+  const char* key_type_ = nullptr;
+};
+
+#define CT_TRACE_SPAN(name) \
+  ::certificate_transparency::TraceSpan ct_trace_span(name)
+
+}  // namespace certificate_transparency
@@ -0,0 +1,128 @@
+#include "update_schedule.h"
+
+#include <strings.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace certificate_transparency {
+namespace {
+
+using std::chrono::milliseconds;
+
+constexpr milliseconds kInitialDelay = std::chrono::seconds(2);
+constexpr milliseconds kInitialJitter = std::chrono::minutes(1);
+constexpr milliseconds kSucceedUpdateInterval = std::chrono::hours(24);
+constexpr milliseconds kMinUpdateInterval = std::chrono::hours(1);
+constexpr milliseconds kMaxUpdateInterval = std::chrono::hours(7 * 24);
+constexpr milliseconds kFailedUpdateInterval = std::chrono::minutes(15);
+constexpr milliseconds kMaxFailedUpdateInterval = std::chrono::hours(24);
+constexpr milliseconds kMinRetryAfter = std::chrono::minutes(1);
+// Successful intervals vary by up to this fraction either way.
+constexpr double kJitter = 0.1;
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Parses a delta-seconds value at the start of |value| and returns it in
+// milliseconds, saturating rather than overflowing.
+std::optional<uint64_t> ParseDeltaSeconds(std::string_view value) {
+  if (value.empty() || !IsDigit(value[0])) {
+    return {};
+  }
+  uint64_t seconds = 0;
+  for (size_t i = 0; i < value.size() && IsDigit(value[i]); i++) {
+    seconds = std::min<uint64_t>(seconds * 10 + (value[i] - '0'),
+                                 UINT64_MAX / 1000 / 10);
+  }
+  return seconds * 1000;
+}
+
+std::string_view Trim(std::string_view value) {
+  while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
+uint64_t Scale(uint64_t delay, double factor) {
+  return static_cast<uint64_t>(static_cast<double>(delay) * factor);
+}
+
+}  // namespace
+
+std::optional<uint64_t> ParseCacheControlMaxAge(std::string_view value) {
+  constexpr std::string_view kMaxAge = "max-age=";
+  while (!value.empty()) {
+    const size_t comma = value.find(',');
+    std::string_view directive = Trim(value.substr(0, comma));
+    value = comma == std::string_view::npos ? std::string_view()
+                                            : value.substr(comma + 1);
+
+    if (directive.size() > kMaxAge.size() &&
+        strncasecmp(directive.data(), kMaxAge.data(), kMaxAge.size()) == 0) {
+      directive.remove_prefix(kMaxAge.size());
+      return ParseDeltaSeconds(directive);
+    }
+  }
+  return {};
+}
+
+std::optional<uint64_t> ParseRetryAfter(std::string_view value) {
+  value = Trim(value);
+  for (char c : value) {
+    if (!IsDigit(c)) {
+      return {};
+    }
+  }
+  return ParseDeltaSeconds(value);
+}
+
+uint64_t GetInitialUpdateDelay(std::optional<uint64_t> next_update,
+                               uint64_t now,
+                               double random) {
+  const uint64_t delay =
+      kInitialDelay.count() + Scale(kInitialJitter.count(), random);
+  if (next_update && *next_update > now) {
+    // The stored time was jittered when it was chosen.
+    return std::max(delay, *next_update - now);
+  }
+  return delay;
+}
+
+uint64_t GetSuccessUpdateDelay(const ScheduleHints& hints, double random) {
+  uint64_t delay = kSucceedUpdateInterval.count();
+  if (hints.max_age) {
+    delay = std::clamp<uint64_t>(*hints.max_age, kMinUpdateInterval.count(),
+                                 kMaxUpdateInterval.count());
+  }
+  return Scale(delay, 1 - kJitter + 2 * kJitter * random);
+}
+
+uint64_t GetFailureUpdateDelay(uint32_t failures,
+                               const ScheduleHints& hints,
+                               double random) {
+  if (hints.retry_after) {
+    // Never earlier than asked, but not all at the same second either.
+    const uint64_t delay =
+        std::clamp<uint64_t>(*hints.retry_after, kMinRetryAfter.count(),
+                             kMaxUpdateInterval.count());
+    return Scale(delay, 1 + kJitter * random);
+  }
+
+  uint64_t delay = kFailedUpdateInterval.count();
+  for (uint32_t i = 1; i < failures && delay < kMaxFailedUpdateInterval.count();
+       i++) {
+    delay *= 2;
+  }
+  delay = std::min<uint64_t>(delay, kMaxFailedUpdateInterval.count());
+  // Spread retries over the upper half of the interval, so clients that
+  // failed together do not retry together.
+  return Scale(delay, 0.5 + 0.5 * random);
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace certificate_transparency {
+
+// What the server said about when to ask again, in milliseconds.
+struct ScheduleHints {
+  // From Cache-Control: max-age on a successful or not modified response.
+  std::optional<uint64_t> max_age;
+  // From Retry-After on a failed response.
+  std::optional<uint64_t> retry_after;
+};
+
+// Returns the max-age directive of a Cache-Control header value.
+std::optional<uint64_t> ParseCacheControlMaxAge(std::string_view value);
+
+// Returns a Retry-After header value given in seconds. HTTP dates are not
+// supported and yield nullopt.
+std::optional<uint64_t> ParseRetryAfter(std::string_view value);
+
+// The update schedule. Every delay is spread by |random|, uniform in [0, 1),
+// so that clients installed or restarted together drift apart instead of
+// reaching the server in waves.
+//
+// Returns the delay before the first fetch after start, given the stored
+// time of the next update.
+uint64_t GetInitialUpdateDelay(std::optional<uint64_t> next_update,
+                               uint64_t now,
+                               double random);
+
+// Returns the delay before the next fetch after a successful or not modified
+// one: max-age if the server gave one, within sane bounds, or a day.
+uint64_t GetSuccessUpdateDelay(const ScheduleHints& hints, double random);
+
+// Returns the delay before the next fetch after |failures| consecutive failed
+// ones: Retry-After if the server gave one, otherwise a backoff that doubles
+// with every failure up to a day.
+uint64_t GetFailureUpdateDelay(uint32_t failures,
+                               const ScheduleHints& hints,
+                               double random);
+
+}  // namespace certificate_transparency
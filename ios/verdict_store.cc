@@ -0,0 +1,209 @@
+#include "verdict_store.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+
+namespace certificate_transparency {
+namespace {
+
+// "CTVRDCT" followed by the layout version.
+constexpr uint64_t kMagic = 0x4354565244435401;
+constexpr size_t kMaxProbes = 8;
+constexpr size_t kDigestWords = sizeof(ChainDigest) / sizeof(uint64_t);
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "the table is shared between processes");
+
+uint64_t LoadWord(const ChainDigest& chain, size_t i) {
+  uint64_t word = 0;
+  for (size_t j = 0; j < sizeof(word); j++) {
+    word = (word << 8) | chain[i * sizeof(word) + j];
+  }
+  return word;
+}
+
+}  // namespace
+
+struct VerdictStore::Header {
+  std::atomic<uint64_t> magic;
+  std::atomic<uint64_t> capacity;
+  uint64_t reserved[6];
+};
+
+struct VerdictStore::Entry {
+  // Odd while a writer owns the slot. Zero for a slot never written.
+  std::atomic<uint64_t> sequence;
+  std::atomic<uint64_t> chain[kDigestWords];
+  std::atomic<uint64_t> generation;
+  // Zero for an empty slot.
+  std::atomic<uint64_t> expiry;
+  std::atomic<uint64_t> verified;
+};
+
+// static
+std::unique_ptr<VerdictStore> VerdictStore::Open(const std::string& path,
+                                                 size_t capacity) {
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+    return nullptr;
+  }
+
+  const size_t size = sizeof(Header) + capacity * sizeof(Entry);
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+
+  // A new file is grown to |size| and reads back as an empty table. Processes
+  // racing to create the file all grow it to the same size.
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      (st.st_size == 0 && ftruncate(fd, static_cast<off_t>(size)) != 0) ||
+      (st.st_size != 0 && static_cast<size_t>(st.st_size) != size)) {
+    close(fd);
+    return nullptr;
+  }
+
+  void* mapping =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+
+  std::unique_ptr<VerdictStore> store(
+      new VerdictStore(mapping, size, capacity));
+  Header* header = static_cast<Header*>(mapping);
+  uint64_t expected_capacity = 0;
+  header->capacity.compare_exchange_strong(expected_capacity, capacity);
+  uint64_t expected_magic = 0;
+  header->magic.compare_exchange_strong(expected_magic, kMagic);
+  if (header->capacity.load() != capacity || header->magic.load() != kMagic) {
+    return nullptr;
+  }
+  return store;
+}
+
+VerdictStore::VerdictStore(void* mapping, size_t mapping_size, size_t capacity)
+    : mapping_(mapping),
+      mapping_size_(mapping_size),
+      capacity_(capacity),
+      entries_(reinterpret_cast<Entry*>(static_cast<uint8_t*>(mapping) +
+                                        sizeof(Header))) {
+  static_assert(sizeof(Header) == 64, "entries are cache line aligned");
+  static_assert(sizeof(Entry) == 64, "an entry fills one cache line");
+}
+
+VerdictStore::~VerdictStore() {
+  munmap(mapping_, mapping_size_);
+}
+
+size_t VerdictStore::FirstSlot(const ChainDigest& chain,
+                               uint64_t generation) const {
+  // The digest is uniformly distributed already; mix in the generation so a
+  // log list update does not land on the slots of the previous one.
+  const uint64_t hash =
+      LoadWord(chain, 0) ^ (generation * 0x9e3779b97f4a7c15);
+  return static_cast<size_t>(hash) & (capacity_ - 1);
+}
+
+bool VerdictStore::Lookup(const ChainDigest& chain,
+                          uint64_t generation,
+                          uint64_t now,
+                          bool* verified) const {
+  const size_t first_slot = FirstSlot(chain, generation);
+  for (size_t probe = 0; probe < kMaxProbes; probe++) {
+    const Entry& entry = entries_[(first_slot + probe) & (capacity_ - 1)];
+    const uint64_t sequence = entry.sequence.load(std::memory_order_acquire);
+    if (sequence == 0) {
+      // Slots are never cleared, so the chain is not further along.
+      return false;
+    }
+    if (sequence & 1) {
+      continue;
+    }
+
+    bool matches = entry.generation.load(std::memory_order_relaxed) ==
+                   generation;
+    for (size_t i = 0; matches && i < kDigestWords; i++) {
+      matches = entry.chain[i].load(std::memory_order_relaxed) ==
+                LoadWord(chain, i);
+    }
+    const uint64_t expiry = entry.expiry.load(std::memory_order_relaxed);
+    const bool entry_verified =
+        entry.verified.load(std::memory_order_relaxed) != 0;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry.sequence.load(std::memory_order_relaxed) != sequence) {
+      continue;
+    }
+    if (matches) {
+      if (expiry <= now) {
+        return false;
+      }
+      *verified = entry_verified;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool VerdictStore::Store(const ChainDigest& chain,
+                         uint64_t generation,
+                         uint64_t now,
+                         uint64_t expiry,
+                         bool verified) {
+  // Pick the slot already holding the chain, else the first free or expired
+  // one, else the one closest to expiry. The choice is made on unlocked
+  // reads; claiming the slot validates that it has not changed meanwhile.
+  const size_t first_slot = FirstSlot(chain, generation);
+  Entry* victim = nullptr;
+  uint64_t victim_sequence = 0;
+  uint64_t victim_expiry = UINT64_MAX;
+  for (size_t probe = 0; probe < kMaxProbes; probe++) {
+    Entry& entry = entries_[(first_slot + probe) & (capacity_ - 1)];
+    const uint64_t sequence = entry.sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+      continue;
+    }
+
+    bool matches = entry.generation.load(std::memory_order_relaxed) ==
+                   generation;
+    for (size_t i = 0; matches && i < kDigestWords; i++) {
+      matches = entry.chain[i].load(std::memory_order_relaxed) ==
+                LoadWord(chain, i);
+    }
+    const uint64_t entry_expiry =
+        sequence == 0 ? 0 : entry.expiry.load(std::memory_order_relaxed);
+    if (matches || entry_expiry <= now) {
+      victim = &entry;
+      victim_sequence = sequence;
+      break;
+    }
+    if (entry_expiry < victim_expiry) {
+      victim = &entry;
+      victim_sequence = sequence;
+      victim_expiry = entry_expiry;
+    }
+  }
+  if (!victim || !victim->sequence.compare_exchange_strong(
+                     victim_sequence, victim_sequence + 1,
+                     std::memory_order_acquire, std::memory_order_relaxed)) {
+    return false;
+  }
+
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < kDigestWords; i++) {
+    victim->chain[i].store(LoadWord(chain, i), std::memory_order_relaxed);
+  }
+  victim->generation.store(generation, std::memory_order_relaxed);
+  victim->expiry.store(expiry, std::memory_order_relaxed);
+  victim->verified.store(verified, std::memory_order_relaxed);
+  victim->sequence.store(victim_sequence + 2, std::memory_order_release);
+  return true;
+}
+
+}  // namespace certificate_transparency
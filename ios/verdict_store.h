@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "chain_digest.h"
+
+namespace certificate_transparency {
+
+// A fixed-size table of verification verdicts in a memory-mapped file, shared
+// by every process that opens the same file and kept across restarts.
+//
+// Entries are keyed by chain digest and log set generation and expire at a
+// caller-given time. The table uses open addressing with a short probe
+// sequence and evicts the entry closest to expiry when the sequence is full.
+// Every slot is guarded by a sequence counter: writers claim a slot with a
+// compare-and-swap, and readers treat a slot that is being written as a miss.
+// Nothing blocks, and a lost update only costs a verification.
+//
+// A process killed in the middle of a write leaves that one slot unusable
+// until the file is deleted.
+class VerdictStore {
+ public:
+  // Maps the table at |path|, creating it with room for |capacity| entries if
+  // it does not exist. |capacity| must be a power of two and match the file.
+  // Returns nullptr on failure.
+  static std::unique_ptr<VerdictStore> Open(const std::string& path,
+                                            size_t capacity);
+
+  ~VerdictStore();
+
+  VerdictStore(const VerdictStore&) = delete;
+  VerdictStore& operator=(const VerdictStore&) = delete;
+
+  // Returns true and sets |verified| if the table holds a verdict for |chain|
+  // and |generation| that expires after |now|.
+  bool Lookup(const ChainDigest& chain,
+              uint64_t generation,
+              uint64_t now,
+              bool* verified) const;
+
+  // Records |verified| for |chain| and |generation| until |expiry|. Returns
+  // false if every candidate slot was being written by another thread.
+  bool Store(const ChainDigest& chain,
+             uint64_t generation,
+             uint64_t now,
+             uint64_t expiry,
+             bool verified);
+
+  size_t capacity() const { return capacity_; }
+
+ private:
+  struct Header;
+  struct Entry;
+
+  VerdictStore(void* mapping, size_t mapping_size, size_t capacity);
+
+  size_t FirstSlot(const ChainDigest& chain, uint64_t generation) const;
+
+  void* mapping_;
+  size_t mapping_size_;
+  size_t capacity_;
+  Entry* entries_;
+};
+
+}  // namespace certificate_transparency
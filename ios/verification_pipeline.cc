@@ -0,0 +1,98 @@
+#include "verification_pipeline.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "metrics.h"
+#include "trace.h"
+
+namespace certificate_transparency {
+namespace {
+
+// Shared with the preparation task, which may outlive Verify() if the chain
+// is rejected before the task finishes.
+struct Speculation {
+  std::mutex lock;
+  std::condition_variable done;
+  bool finished = false;
+  PreparedChain chain;
+};
+
+}  // namespace
+
+VerificationPipeline::VerificationPipeline(const VerificationLimits& limits,
+                                           Executor executor)
+    : limits_(limits), executor_(std::move(executor)) {}
+
+VerificationPipeline::~VerificationPipeline() = default;
+
+PipelineVerdict VerificationPipeline::Verify(ChainEvaluator* evaluator,
+                                             std::string_view leaf_cert,
+                                             std::string_view issuer_cert,
+                                             const CommitFunction& commit) {
+  CT_TRACE_SPAN("pipeline");
+  std::shared_ptr<Speculation> speculation;
+  if (!issuer_cert.empty()) {
+    speculation = std::make_shared<Speculation>();
+    executor_([speculation, leaf = std::string(leaf_cert),
+               issuer = std::string(issuer_cert), limits = limits_] {
+      PreparedChain chain;
+      {
+        CT_TRACE_SPAN("prepare_chain");
+        PrepareChain(leaf, issuer, limits, &chain);
+        // The copies die with the task.
+        chain.leaf_cert = {};
+        chain.issuer_cert = {};
+      }
+      {
+        std::lock_guard guard(speculation->lock);
+        speculation->chain = std::move(chain);
+        speculation->finished = true;
+      }
+      speculation->done.notify_all();
+    });
+  }
+
+  ChainEvaluation evaluation;
+  {
+    CT_TRACE_SPAN("evaluate_chain");
+    evaluation = evaluator->Evaluate();
+  }
+  PipelineVerdict verdict;
+  verdict.trusted = evaluation.trusted;
+  verdict.has_custom_root = evaluation.has_custom_root;
+  if (!verdict.trusted || !verdict.has_custom_root) {
+    return verdict;
+  }
+  if (evaluation.issuer_cert.empty()) {
+    verdict.trusted = false;
+    return verdict;
+  }
+
+  TraceSpan commit_span("commit");
+  PreparedChain chain;
+  if (speculation && evaluation.leaf_cert == leaf_cert &&
+      evaluation.issuer_cert == issuer_cert) {
+    std::unique_lock guard(speculation->lock);
+    speculation->done.wait(guard, [&] { return speculation->finished; });
+    chain = std::move(speculation->chain);
+    chain.leaf_cert = evaluation.leaf_cert;
+    chain.issuer_cert = evaluation.issuer_cert;
+  } else {
+    speculation_misses_.fetch_add(1, std::memory_order_relaxed);
+    CT_METRICS_INCREMENT(kSpeculationMisses);
+    PrepareChain(evaluation.leaf_cert, evaluation.issuer_cert, limits_,
+                 &chain);
+  }
+  verdict.trusted = commit(chain);
+  return verdict;
+}
+
+uint64_t VerificationPipeline::speculation_misses() const {
+  return speculation_misses_.load(std::memory_order_relaxed);
+}
+
+}  // namespace certificate_transparency
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "chain_evaluator.h"
+#include "multi_log_verifier.h"
+
+namespace certificate_transparency {
+
+struct PipelineVerdict {
+  bool trusted = false;
+  bool has_custom_root = false;
+};
+
+// Verifies a chain in two overlapping stages.
+//
+// Evaluating the chain's trust can take as long as checking its SCTs, but the
+// SCT work up to the signature checks needs only the certificates. While the
+// evaluator runs, the pipeline prepares the presented chain on |executor|:
+// it extracts and decodes the SCTs and rebuilds the precertificate entry.
+// Once the chain is found trusted and custom-rooted, the prepared chain is
+// committed, that is, its signatures are checked. Otherwise the preparation
+// is dropped.
+//
+// If the evaluator built the chain from a different issuer than the presented
+// one, the chain it built is prepared again before the commit.
+class VerificationPipeline {
+ public:
+  using Task = std::function<void()>;
+  // Runs a task, possibly on another thread.
+  using Executor = std::function<void(Task task)>;
+  // Checks the SCTs of a chain, e.g. with MultiLogVerifier::Verify().
+  using CommitFunction = std::function<bool(const PreparedChain& chain)>;
+
+  // Chains are prepared with |limits|, which should be those of the verifier
+  // commits go to.
+  VerificationPipeline(const VerificationLimits& limits, Executor executor);
+  ~VerificationPipeline();
+
+  VerificationPipeline(const VerificationPipeline&) = delete;
+  VerificationPipeline& operator=(const VerificationPipeline&) = delete;
+
+  // Evaluates the chain on the calling thread and, if it is trusted and ends
+  // in a custom root, returns the verdict of |commit| on it as |trusted|.
+  // |leaf_cert| and |issuer_cert| are the first two certificates presented;
+  // an empty |issuer_cert| skips the speculative preparation.
+  PipelineVerdict Verify(ChainEvaluator* evaluator,
+                         std::string_view leaf_cert,
+                         std::string_view issuer_cert,
+                         const CommitFunction& commit);
+
+  // The number of commits that could not use the speculative preparation,
+  // because the evaluator built a different chain.
+  uint64_t speculation_misses() const;
+
+ private:
+  const VerificationLimits limits_;
+  const Executor executor_;
+  std::atomic<uint64_t> speculation_misses_{0};
+};
+
+}  // namespace certificate_transparency